@@ -0,0 +1,116 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <string>
+#include <thread>
+#include "UnixLinx.h"
+
+// Well-known AF_UNIX socket of host name service
+const inline std::string LINX_NAME_SERVICE = "linx_name_service";
+// Registrations are refreshed by resolver every LINX_DEFAULT_NAME_REFRESH ms and expire in name service
+// when not refreshed for LINX_DEFAULT_NAME_LEASE ms (registering process died)
+const inline int LINX_DEFAULT_NAME_REFRESH = 1000;
+const inline int LINX_DEFAULT_NAME_LEASE = 3 * LINX_DEFAULT_NAME_REFRESH;
+
+// Registry of logical service names and their endpoints (AF_UNIX socket name, "ip:port" for UDP), one per host.
+// Resolvers querying a name are watching it: every registration, unregistration and lease expiry is pushed to them.
+class LinxNameService {
+  public:
+    // Returns nullptr when socket cannot be opened, e.g. name service already runs on it
+    static std::unique_ptr<LinxNameService> create(const std::string &socketName = LINX_NAME_SERVICE,
+                                                   int leaseMs = LINX_DEFAULT_NAME_LEASE);
+    ~LinxNameService();
+
+    bool start();
+    void stop();
+    size_t getRegisteredCount() const;
+
+  private:
+    struct Entry {
+        std::string endpoint;
+        // Socket of resolver which registered name
+        std::string owner;
+        uint32_t generation;
+        std::chrono::steady_clock::time_point expiry;
+    };
+
+    LinxNameService(const std::shared_ptr<AfUnixSimpleServer> &server, int leaseMs);
+
+    void task();
+    void handle(const LinxReceivedMessage &msg);
+    void expire();
+    // Sends current state of name to watchers, watchers not reachable anymore are removed
+    void notify(const std::string &name);
+    int sendUpdate(const std::string &name, const UnixInfo &to);
+
+    std::shared_ptr<AfUnixSimpleServer> server;
+    const std::chrono::milliseconds lease;
+    std::map<std::string, Entry> entries;
+    std::map<std::string, std::set<std::string>> watchers;
+    // Starts at random value, so restarted name service does not reuse generations known by resolvers
+    uint32_t nextGeneration;
+    mutable std::mutex mutex;
+    std::atomic<bool> running{false};
+    std::thread thread;
+};
+
+// Client side of name service: registers names of local servers and resolves names of remote ones.
+// Resolved names are cached and kept up to date by name service, so resolve() does not poll servers.
+class LinxNameResolver {
+  public:
+    // Called on every change of resolved name, endpoint is empty when name was unregistered or expired
+    using Listener = std::function<void(const std::string &name, const std::string &endpoint)>;
+
+    // Name service does not have to run yet, registrations and queries are sent until it answers
+    static std::shared_ptr<LinxNameResolver> create(const std::string &serviceName = LINX_NAME_SERVICE,
+                                                    int refreshMs = LINX_DEFAULT_NAME_REFRESH);
+    // Unregisters all names registered by this resolver
+    ~LinxNameResolver();
+
+    // Replaces previous registration of name, returns -1 on invalid name or endpoint
+    int registerName(const std::string &name, const std::string &endpoint);
+    // Returns -1 when name was not registered by this resolver
+    int unregisterName(const std::string &name);
+    // Returns endpoint of name, waits up to timeoutMs for its registration, empty string on timeout
+    std::string resolve(const std::string &name, int timeoutMs = INFINITE_TIMEOUT);
+    // Called from resolver thread, must not call resolver methods
+    void setListener(const Listener &listener);
+
+  private:
+    struct Registration {
+        std::string endpoint;
+        // Assigned by name service, 0 until registration is confirmed
+        uint32_t generation;
+    };
+    struct Resolved {
+        std::string endpoint;
+        uint32_t generation;
+        bool isAnswered;
+    };
+
+    LinxNameResolver(const std::shared_ptr<AfUnixSocket> &socket, const std::string &serviceName, int refreshMs);
+
+    void task();
+    void handleUpdate(const RawMessage &msg);
+    // Sends registrations and queries not confirmed yet, all of them when refresh is due
+    void sendPending(bool refresh);
+    int sendRecord(uint32_t reqId, const std::string &name, const std::string &endpoint, uint32_t generation = 0);
+
+    std::shared_ptr<AfUnixSocket> socket;
+    UnixInfo service;
+    const std::chrono::milliseconds refreshInterval;
+    std::map<std::string, Registration> registrations;
+    std::map<std::string, Resolved> cache;
+    Listener listener;
+    std::mutex mutex;
+    std::condition_variable changed;
+    std::atomic<bool> running{true};
+    std::thread thread;
+};
@@ -4,6 +4,13 @@
 
 class UdpSocket;
 
+// Bit of wire reqId marking fragment datagram, used only between peers with fragmentation enabled
+const inline uint32_t LINX_FRAGMENT_FLAG = 0x40000000;
+// Bit of wire reqId marking reliable data and ACK datagrams, used only between peers with reliable mode enabled
+const inline uint32_t LINX_RELIABLE_FLAG = 0x20000000;
+
+class LinxNameResolver;
+
 namespace UdpFactory {
     bool isMulticastIp(const std::string &ip);
     bool isBroadcastIp(const std::string &ip);
@@ -38,10 +45,58 @@ using UdpProtocol     = LinxProtocol<PortInfo>;
 using UdpSimpleServer = UdpProtocol::SimpleServer;
 using UdpServer       = UdpProtocol::Server;
 using UdpClient       = UdpProtocol::Client;
+using UdpClientPool   = UdpProtocol::ClientPool;
+
+// Topic of publish/subscribe layer: messages with reqId in [firstReqId, lastReqId] are published to multicast group
+struct LinxTopic {
+    uint32_t firstReqId;
+    uint32_t lastReqId;
+    std::string group;
+};
+
+// Publisher side fan-out: every message is sent once to each multicast group of topics matching its reqId
+class UdpPublisher {
+  public:
+    UdpPublisher(const std::string &name, const std::shared_ptr<UdpProtocol::Socket> &socket,
+                 const std::vector<LinxTopic> &topics, uint16_t port);
+    ~UdpPublisher();
+
+    // Returns number of groups message was sent to (0 when no topic matches), negative value on error
+    int publish(const IMessage &message);
+    LinxMetricsSnapshot getMetrics() const;
+    std::string getName() const;
+
+  private:
+    struct Route {
+        uint32_t firstReqId;
+        uint32_t lastReqId;
+        PortInfo to;
+    };
+
+    std::string name;
+    std::shared_ptr<UdpProtocol::Socket> socket;
+    std::vector<Route> routes;
+    LinxMetrics metrics;
+};
 
 namespace UdpFactory {
     std::shared_ptr<UdpSimpleServer> createSimpleServer(uint16_t port);
     std::shared_ptr<UdpServer> createMulticastServer(const std::string &multicastIp, uint16_t port, size_t queueSize = LINX_DEFAULT_QUEUE_SIZE);
     std::shared_ptr<UdpServer> createServer(uint16_t port, size_t queueSize = LINX_DEFAULT_QUEUE_SIZE);
+    // Create workers servers bound to the same port with SO_REUSEPORT, each with own socket, worker thread and queue.
+    // Kernel hashes sender address so every sender is always delivered to the same server.
+    std::vector<std::shared_ptr<UdpServer>> createShardedServer(uint16_t port, size_t workers,
+                                                                size_t queueSize = LINX_DEFAULT_QUEUE_SIZE);
     std::shared_ptr<UdpClient> createClient(const std::string &ip, uint16_t port);
+    // Single socket shared by clients created with UdpClientPool::createClient(), servers must be unicast
+    std::shared_ptr<UdpClientPool> createClientPool(size_t queueSize = LINX_DEFAULT_QUEUE_SIZE);
+    // Client of server registered in name service as serviceName with "ip:port" endpoint,
+    // waits up to timeoutMs for registration
+    std::shared_ptr<UdpClient> resolveClient(LinxNameResolver &resolver, const std::string &serviceName,
+                                             int timeoutMs = INFINITE_TIMEOUT);
+    // Subscriber joins multicast groups of topics (SO_REUSEPORT, several subscribers can share port) and receives
+    // only messages of topics, messages of other topics sent to the same group are dropped before deserialization
+    std::shared_ptr<UdpServer> createSubscriber(const std::vector<LinxTopic> &topics, uint16_t port,
+                                                size_t queueSize = LINX_DEFAULT_QUEUE_SIZE);
+    std::shared_ptr<UdpPublisher> createPublisher(const std::vector<LinxTopic> &topics, uint16_t port);
 }
@@ -4,6 +4,7 @@
 #include <memory>
 
 class AfUnixSocket;
+class LinxNameResolver;
 
 // String-based identifier wrapper
 class UnixInfo : public IIdentifier {
@@ -32,9 +33,15 @@ using UnixProtocol       = LinxProtocol<UnixInfo>;
 using AfUnixClient       = UnixProtocol::Client;
 using AfUnixSimpleServer = UnixProtocol::SimpleServer;
 using AfUnixServer       = UnixProtocol::Server;
+using AfUnixClientPool   = UnixProtocol::ClientPool;
 
 namespace AfUnixFactory {
     std::shared_ptr<AfUnixClient> createClient(const std::string &serverSocket);
+    // Single socket shared by clients created with AfUnixClientPool::createClient()
+    std::shared_ptr<AfUnixClientPool> createClientPool(size_t queueSize = LINX_DEFAULT_QUEUE_SIZE);
     std::shared_ptr<AfUnixSimpleServer> createSimpleServer(const std::string &socketName);
     std::shared_ptr<AfUnixServer> createServer(const std::string &socketName, size_t queueSize = LINX_DEFAULT_QUEUE_SIZE);
+    // Client of server registered in name service as serviceName, waits up to timeoutMs for registration
+    std::shared_ptr<AfUnixClient> resolveClient(LinxNameResolver &resolver, const std::string &serviceName,
+                                                int timeoutMs = INFINITE_TIMEOUT);
 }
@@ -0,0 +1,33 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+
+// Bit of wire reqId marking compressed payload, used only between peers with compression enabled
+const inline uint32_t LINX_COMPRESSED_FLAG = 0x80000000;
+// Upper limit of decompressed payload accepted by receiver
+const inline uint32_t LINX_MAX_DECOMPRESSED_SIZE = 16 * 1024 * 1024;
+
+// Payload codec, the same codec must be configured on both peers
+class LinxCompressor {
+  public:
+    virtual ~LinxCompressor() = default;
+    // Returns compressed size, 0 when result does not fit into dstCapacity (data not compressible)
+    virtual uint32_t compress(const uint8_t *src, uint32_t srcSize, uint8_t *dst, uint32_t dstCapacity) const = 0;
+    // Returns false when input is malformed or does not decompress to exactly dstSize bytes
+    virtual bool decompress(const uint8_t *src, uint32_t srcSize, uint8_t *dst, uint32_t dstSize) const = 0;
+    // Largest size srcSize compressed bytes can decompress to, receiver rejects larger claims before allocating
+    virtual uint64_t maxDecompressedSize(uint32_t srcSize) const {
+        return LINX_MAX_DECOMPRESSED_SIZE;
+    }
+};
+
+// Built-in byte oriented LZ77 codec (LZ4 style sequences, 64 KB window), favours speed over ratio
+class LinxLzCompressor : public LinxCompressor {
+  public:
+    uint32_t compress(const uint8_t *src, uint32_t srcSize, uint8_t *dst, uint32_t dstCapacity) const override;
+    bool decompress(const uint8_t *src, uint32_t srcSize, uint8_t *dst, uint32_t dstSize) const override;
+    uint64_t maxDecompressedSize(uint32_t srcSize) const override;
+
+    static std::shared_ptr<LinxCompressor> instance();
+};
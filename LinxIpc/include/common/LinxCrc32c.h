@@ -0,0 +1,15 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+// CRC32C (Castagnoli), computed with SSE4.2 or ARMv8 CRC instructions when CPU supports them
+namespace LinxCrc32c {
+
+// Continues crc of preceding data, crc 0 starts new checksum
+uint32_t compute(const void *data, size_t size, uint32_t crc = 0);
+// Table based implementation used when CPU has no CRC instructions
+uint32_t computeSoftware(const void *data, size_t size, uint32_t crc = 0);
+bool isHardwareAccelerated();
+
+} // namespace LinxCrc32c
@@ -0,0 +1,48 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+// HDR style latency histogram with log-linear buckets, relative error below 1%
+// record() is lock-free and may be called from many threads concurrently
+class LinxHistogram {
+  public:
+    // Values above maxValue (about 18 minutes in ns) are recorded as maxValue
+    static constexpr uint64_t maxValue = (1ULL << 40) - 1;
+
+    LinxHistogram() = default;
+    LinxHistogram(const LinxHistogram &) = delete;
+    LinxHistogram &operator=(const LinxHistogram &) = delete;
+
+    void record(uint64_t value);
+    void merge(const LinxHistogram &other);
+    void reset();
+
+    uint64_t getCount() const;
+    uint64_t getMin() const;
+    uint64_t getMax() const;
+    double getMean() const;
+    // Highest value equivalent to bucket holding given percentile (0..100), 0 when empty
+    uint64_t valueAtPercentile(double percentile) const;
+
+    // Compact binary form with non-empty buckets only, deserialize() returns nullptr on malformed input
+    std::vector<uint8_t> serialize() const;
+    static std::unique_ptr<LinxHistogram> deserialize(const uint8_t *data, size_t size);
+
+  private:
+    static constexpr int subBucketBits = 7;
+    static constexpr uint64_t subBucketHalf = 1ULL << subBucketBits;
+    static constexpr size_t bucketCount = (40 - subBucketBits + 1) * subBucketHalf;
+
+    std::array<std::atomic<uint64_t>, bucketCount> counts{};
+    std::atomic<uint64_t> totalCount{0};
+    std::atomic<uint64_t> sum{0};
+    std::atomic<uint64_t> minValue{UINT64_MAX};
+    std::atomic<uint64_t> maxRecorded{0};
+
+    static size_t bucketIndex(uint64_t value);
+    static uint64_t highestEquivalentValue(size_t index);
+};
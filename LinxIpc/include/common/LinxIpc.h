@@ -9,6 +9,18 @@ class IIdentifier;
 
 const inline uint32_t IPC_SIG_BASE = 0x10000000;
 const inline size_t LINX_DEFAULT_QUEUE_SIZE = 100;
+// UDP fragmentation: datagram fitting Ethernet MTU (1500 - IP and UDP headers), reassembly limits
+const inline uint32_t LINX_DEFAULT_DATAGRAM_SIZE = 1472;
+const inline int LINX_DEFAULT_REASSEMBLY_TIMEOUT = 1000;
+const inline size_t LINX_DEFAULT_REASSEMBLY_MEMORY = 32 * 1024 * 1024;
+// UDP reliable mode: unacknowledged datagrams per peer, time send() waits for free window slot
+const inline uint32_t LINX_DEFAULT_RELIABLE_WINDOW = 64;
+const inline int LINX_DEFAULT_RELIABLE_SEND_TIMEOUT = 1000;
+// GenericClient::connect() pause between ping attempts, doubles from MIN up to MAX ms
+const inline int LINX_CONNECT_BACKOFF_MIN = 10;
+const inline int LINX_CONNECT_BACKOFF_MAX = 500;
+// Time first coalesced message waits for more messages to the same destination
+const inline int LINX_DEFAULT_COALESCE_DELAY_US = 200;
 const inline int IMMEDIATE_TIMEOUT = 0;
 const inline int INFINITE_TIMEOUT = -1;
 const inline std::initializer_list<uint32_t> LINX_ANY_SIG({});
@@ -16,6 +28,10 @@ const inline IIdentifier *LINX_ANY_FROM = nullptr;
 
 #include "LinxMessage.h"
 #include "RawMessage.h"
+#include "MessageView.h"
+#include "LinxMessageSchema.h"
 #include "LinxClient.h"
 #include "LinxServer.h"
-#include "MyMessage.h"
\ No newline at end of file
+#include "MyMessage.h"
+#include "LinxLogLevels.h"
+#include "LinxCompression.h"
\ No newline at end of file
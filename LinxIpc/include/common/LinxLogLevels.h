@@ -0,0 +1,38 @@
+#pragma once
+
+#include <atomic>
+#include <string>
+
+// Library subsystems with independent runtime log levels
+enum class LinxLogModule {
+    QUEUE,
+    SOCKET,
+    SERVER,
+    CLIENT,
+    HANDLER,
+    GENERAL,
+    COUNT,
+};
+
+// Runtime log level (SEVERITY_* from trace.h, 0 - off) of each module, checked by LINX_* trace macros with
+// a single relaxed load before arguments are evaluated. Levels above TRACE_LEVEL have no effect since those
+// traces are not compiled in.
+// Initial level of all modules is LOG_LEVEL (or TRACE_LEVEL when not set), overridden per module by
+// LINX_LOG_LEVELS environment variable, e.g. LINX_LOG_LEVELS="server=4,socket=1"
+class LinxLogLevels {
+  public:
+    static bool isEnabled(LinxLogModule module, int severity) {
+        return levels[static_cast<int>(module)].load(std::memory_order_relaxed) >= severity;
+    }
+
+    static int get(LinxLogModule module);
+    // Returns -1 on invalid module or level
+    static int set(LinxLogModule module, int severity);
+    static int setAll(int severity);
+    // Applies "module=level,..." list or single level for all modules, returns -1 if any entry is invalid
+    // (valid entries are applied), modules: queue, socket, server, client, handler, general, all
+    static int configure(const std::string &levelsSpec);
+
+  private:
+    static std::atomic<int> levels[static_cast<int>(LinxLogModule::COUNT)];
+};
@@ -0,0 +1,78 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Point in time copy of LinxMetrics counters
+struct LinxMetricsSnapshot {
+    std::string name{};
+    uint64_t rxMessages = 0;
+    uint64_t rxBytes = 0;
+    uint64_t txMessages = 0;
+    uint64_t txBytes = 0;
+    uint64_t sendErrors = 0;
+    uint64_t receiveErrors = 0;     // socket receive failures
+    uint64_t deserializeErrors = 0; // received datagrams that could not be deserialized
+    uint64_t queueDrops = 0;        // messages discarded because server queue was full
+    uint64_t pings = 0;
+    uint64_t filterDrops = 0;       // messages outside server signal filter dropped in userspace
+    uint64_t queueDepth = 0;
+    uint64_t queueHighWater = 0;
+    uint64_t fragmentsSent = 0;         // UDP fragmentation, see setFragmentation()
+    uint64_t fragmentsReceived = 0;
+    uint64_t reassembledMessages = 0;
+    uint64_t reassemblyTimeouts = 0;    // incomplete messages dropped after reassembly timeout
+    uint64_t reassemblyDrops = 0;       // malformed fragments and incomplete messages dropped on memory limit
+    uint64_t retransmits = 0;           // UDP reliable mode, see setReliable()
+    uint64_t duplicatesReceived = 0;
+    uint64_t deliveryFailures = 0;      // datagrams dropped after last retransmission was not acknowledged
+    uint64_t coalescedMessages = 0;     // messages sent inside containers, see setCoalescing()
+    uint64_t coalescedBatches = 0;
+    uint64_t checksumErrors = 0;        // frames dropped on CRC32C mismatch, see setChecksum()
+    uint64_t unsubscribedDrops = 0;     // UDP subscriber, datagrams and messages of topics not subscribed
+    uint64_t unroutedDrops = 0;         // client pool, messages from senders without pooled client
+};
+
+// Counters updated from hot path with relaxed atomics, producer (rx) and consumer (tx) side
+// counters are kept on separate cache lines
+class LinxMetrics {
+  public:
+    void onReceive(size_t bytes) {
+        rxMessages.fetch_add(1, std::memory_order_relaxed);
+        rxBytes.fetch_add(bytes, std::memory_order_relaxed);
+    }
+    void onReceiveError() { receiveErrors.fetch_add(1, std::memory_order_relaxed); }
+    void onDeserializeError() { deserializeErrors.fetch_add(1, std::memory_order_relaxed); }
+    void onQueueDrop() { queueDrops.fetch_add(1, std::memory_order_relaxed); }
+    void onPing() { pings.fetch_add(1, std::memory_order_relaxed); }
+    void onFilterDrop() { filterDrops.fetch_add(1, std::memory_order_relaxed); }
+
+    void onSend(size_t bytes) {
+        txMessages.fetch_add(1, std::memory_order_relaxed);
+        txBytes.fetch_add(bytes, std::memory_order_relaxed);
+    }
+    void onSendError() { sendErrors.fetch_add(1, std::memory_order_relaxed); }
+
+    LinxMetricsSnapshot snapshot(const std::string &name) const;
+    void reset();
+
+    // Prometheus text exposition format, one sample per snapshot for each metric
+    static std::string formatPrometheus(const std::vector<LinxMetricsSnapshot> &snapshots);
+    // Write formatPrometheus() output to file atomically (temporary file + rename), returns 0 on success
+    static int writePrometheus(const std::string &path, const std::vector<LinxMetricsSnapshot> &snapshots);
+
+  private:
+    alignas(64) std::atomic<uint64_t> rxMessages{0};
+    std::atomic<uint64_t> rxBytes{0};
+    std::atomic<uint64_t> receiveErrors{0};
+    std::atomic<uint64_t> deserializeErrors{0};
+    std::atomic<uint64_t> queueDrops{0};
+    std::atomic<uint64_t> pings{0};
+    std::atomic<uint64_t> filterDrops{0};
+
+    alignas(64) std::atomic<uint64_t> txMessages{0};
+    std::atomic<uint64_t> txBytes{0};
+    std::atomic<uint64_t> sendErrors{0};
+};
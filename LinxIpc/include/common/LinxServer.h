@@ -1,10 +1,14 @@
 #pragma once
 
+#include <cstdint>
+#include <ctime>
 #include <functional>
 #include <unordered_map>
 #include <memory>
+#include <vector>
 
 class IIdentifier;
+class LinxHistogram;
 class LinxServer;
 struct LinxReceivedMessage;
 
@@ -13,10 +17,41 @@ using LinxReceivedMessageSharedPtr = std::shared_ptr<struct LinxReceivedMessage>
 using LinxReceivedMessageSharedPtr = std::shared_ptr<LinxReceivedMessage>;
 using LinxIpcCallback = std::function<int(const LinxReceivedMessageSharedPtr &msg, void *data)>;
 
+// Per-stage receive times in ns (CLOCK_REALTIME), all zero unless server timestamping is enabled
+struct LinxMessageTimestamps {
+    uint64_t kernelRx = 0;          // kernel receive time (SO_TIMESTAMPNS)
+    uint64_t socketDequeue = 0;     // message read from socket
+    uint64_t queueInsert = 0;       // message put into server queue
+    uint64_t consumerPickup = 0;    // message returned by receive()
+    uint64_t handlerStart = 0;      // LinxIpcHandler callback called
+    uint64_t handlerDone = 0;       // LinxIpcHandler callback returned
+
+    static uint64_t now() {
+        struct timespec ts;
+        clock_gettime(CLOCK_REALTIME, &ts);
+        return (uint64_t)ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+    }
+
+    // Time between kernel receive and socket read, -1 when not recorded
+    int64_t socketWaitNs() const { return elapsed(kernelRx, socketDequeue); }
+    // Time spent in server queue, -1 when not recorded
+    int64_t queueWaitNs() const { return elapsed(queueInsert, consumerPickup); }
+    // Time spent in handler callback, -1 when not recorded
+    int64_t handlerNs() const { return elapsed(handlerStart, handlerDone); }
+    // Time from kernel receive until handler finished or message picked up, -1 when not recorded
+    int64_t totalNs() const { return elapsed(kernelRx, handlerDone ? handlerDone : consumerPickup); }
+
+  private:
+    static int64_t elapsed(uint64_t from, uint64_t to) {
+        return (from && to) ? (int64_t)(to - from) : -1;
+    }
+};
+
 struct LinxReceivedMessage {
     RawMessagePtr message;
     std::unique_ptr<IIdentifier> from;
     std::weak_ptr<LinxServer> server;
+    LinxMessageTimestamps timestamps{};
 
     int sendResponse(const IMessage &response) const;
 };
@@ -31,6 +66,13 @@ class LinxServer : public std::enable_shared_from_this<LinxServer> {
                                       const std::vector<uint32_t> &sigsel = LINX_ANY_SIG,
                                       const IIdentifier *from = LINX_ANY_FROM) = 0;
 
+    // Wait up to timeoutMs for the first matching message, then take up to maxCount
+    // messages that are already available without waiting any further
+    virtual std::vector<LinxReceivedMessageSharedPtr> receiveBatch(size_t maxCount,
+                                      int timeoutMs = INFINITE_TIMEOUT,
+                                      const std::vector<uint32_t> &sigsel = LINX_ANY_SIG,
+                                      const IIdentifier *from = LINX_ANY_FROM) = 0;
+
     virtual int getPollFd() const = 0;
     virtual bool start() = 0;
     virtual void stop() = 0;
@@ -42,6 +84,7 @@ class LinxServer : public std::enable_shared_from_this<LinxServer> {
 struct IpcContainer {
     LinxIpcCallback callback;
     void *data;
+    std::shared_ptr<LinxHistogram> histogram{};
 };
 
 class LinxIpcHandler: public LinxServer {
@@ -50,9 +93,17 @@ class LinxIpcHandler: public LinxServer {
     virtual ~LinxIpcHandler();
 
     virtual int handleMessage(int timeoutMs = INFINITE_TIMEOUT);
+    // Dispatch up to maxCount already received messages, stop early when timeBudgetUs is used up
+    // Budget is checked after every message, messages not dispatched stay in the queue.
+    // Returns number of dispatched messages
+    virtual size_t handleMessages(size_t maxCount, int timeBudgetUs = INFINITE_TIMEOUT);
     LinxReceivedMessageSharedPtr receive(int timeoutMs = INFINITE_TIMEOUT,
                                       const std::vector<uint32_t> &sigsel = LINX_ANY_SIG,
                                       const IIdentifier *from = LINX_ANY_FROM) override;
+    std::vector<LinxReceivedMessageSharedPtr> receiveBatch(size_t maxCount,
+                                      int timeoutMs = INFINITE_TIMEOUT,
+                                      const std::vector<uint32_t> &sigsel = LINX_ANY_SIG,
+                                      const IIdentifier *from = LINX_ANY_FROM) override;
 
     bool start() override;
     void stop() override;
@@ -60,9 +111,15 @@ class LinxIpcHandler: public LinxServer {
     int send(const IMessage &message, const IIdentifier &to) override;
 
     LinxIpcHandler& registerCallback(uint32_t reqId, const LinxIpcCallback &callback, void *data = nullptr);
+    // Record handler execution time in ns for registered reqId, the same histogram can be shared by many reqIds
+    LinxIpcHandler& setHandlerHistogram(uint32_t reqId, const std::shared_ptr<LinxHistogram> &histogram);
+    std::shared_ptr<LinxHistogram> getHandlerHistogram(uint32_t reqId) const;
     std::string getName() const override;
 
   private:
     std::shared_ptr<LinxServer> server;
     std::unordered_map<uint32_t, IpcContainer> handlers;
+
+    int dispatch(const LinxReceivedMessageSharedPtr &msg);
+    int invoke(const IpcContainer &container, const LinxReceivedMessageSharedPtr &msg);
 };
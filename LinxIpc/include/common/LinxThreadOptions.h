@@ -0,0 +1,19 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <vector>
+#include <sched.h>
+
+// Scheduling setup for threads created by the library (server workers)
+struct LinxThreadOptions {
+    std::string name{};             // thread name, truncated to 15 characters, empty = server name
+    std::vector<int> cpus{};        // CPU affinity, empty = inherit from parent
+    int policy = SCHED_OTHER;       // SCHED_OTHER, SCHED_FIFO or SCHED_RR
+    int priority = 0;               // 1..99 for SCHED_FIFO and SCHED_RR
+    bool lockMemory = false;        // mlockall(MCL_CURRENT | MCL_FUTURE) for whole process
+    size_t stackPrefaultSize = 0;   // bytes of stack touched before thread enters its loop
+
+    // Apply options to the calling thread, returns 0 or negative value when any of the settings failed
+    int applyToCurrentThread() const;
+};
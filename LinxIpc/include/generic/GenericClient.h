@@ -8,6 +8,11 @@
 #include "LinxIpc.h"
 #include "IIdentifier.h"
 #include "GenericSocket.h"
+#include "GenericCoalescer.h"
+#include "LinxHistogram.h"
+#include "LinxMetrics.h"
+
+class LinxNameResolver;
 
 template<typename IdentifierType>
 class GenericClient : public LinxClient {
@@ -27,8 +32,38 @@ class GenericClient : public LinxClient {
     bool isEqual(const LinxClient &other) const override;
     std::string getName() const override;
 
+    // Spin for spinUs before blocking in receive, kernelBusyPoll also applies SO_BUSY_POLL on socket
+    int setBusyPoll(int spinUs, bool kernelBusyPoll = false);
+    // Compress payloads of at least thresholdBytes, server must enable compression as well
+    int setCompression(uint32_t thresholdBytes, const std::shared_ptr<LinxCompressor> &compressor = nullptr);
+    // Append CRC32C to every message and drop received messages with wrong checksum, server must enable it as well
+    int setChecksum(bool enable);
+    // Send messages above maxDatagramSize as fragments (UDP only), server must enable fragmentation as well
+    int setFragmentation(uint32_t maxDatagramSize,
+                         int reassemblyTimeoutMs = LINX_DEFAULT_REASSEMBLY_TIMEOUT,
+                         size_t reassemblyMemoryLimit = LINX_DEFAULT_REASSEMBLY_MEMORY);
+    // Acknowledge and retransmit lost datagrams (UDP only), server must enable reliable mode as well
+    int setReliable(bool enable, uint32_t windowSize = LINX_DEFAULT_RELIABLE_WINDOW,
+                    int sendTimeoutMs = LINX_DEFAULT_RELIABLE_SEND_TIMEOUT);
+    // Pack messages to the same destination into containers of up to maxBatchBytes, sent after delayUs
+    // or on flush(), 0 disables. Receiver unpacks containers without configuration.
+    int setCoalescing(uint32_t maxBatchBytes, int delayUs = LINX_DEFAULT_COALESCE_DELAY_US);
+    // Send pending coalesced messages now
+    int flush();
+    LinxMetricsSnapshot getMetrics() const;
+    // Record round trip time in ns of each successful sendReceive(), nullptr disables recording
+    void setLatencyHistogram(const std::shared_ptr<LinxHistogram> &histogram);
+    // connect() waits until server announces serverName (see GenericSimpleServer::setAnnouncement) before pinging
+    // it, so it completes as soon as server starts. nullptr disables waiting.
+    void setReadiness(const std::shared_ptr<LinxNameResolver> &resolver, const std::string &serverName);
+
   protected:
     std::string clientId;
     std::shared_ptr<GenericSocket<IdentifierType>> socket;
+    std::unique_ptr<GenericCoalescer<IdentifierType>> coalescer;
     IdentifierType identifier;
+    LinxMetrics metrics;
+    std::shared_ptr<LinxHistogram> latencyHistogram;
+    std::shared_ptr<LinxNameResolver> readinessResolver;
+    std::string readinessName;
 };
@@ -0,0 +1,71 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include "LinxIpc.h"
+#include "GenericSocket.h"
+#include "GenericClient.h"
+#include "LinxMetrics.h"
+
+// Many logical clients sharing one socket: received messages are routed to client of their sender (server
+// endpoint), each client has own queue of up to queueSize messages. Clients are driven either by their own
+// receive() calls (first blocked caller reads socket for all of them) or by external poller of getPollFd()
+// calling dispatch(). Socket options set on any client (compression, reliable mode, ...) apply to whole pool.
+template<typename IdentifierType>
+class GenericClientPool : public std::enable_shared_from_this<GenericClientPool<IdentifierType>> {
+  public:
+    using Client = GenericClient<IdentifierType>;
+
+    GenericClientPool(const std::string &name, const std::shared_ptr<GenericSocket<IdentifierType>> &socket,
+                      size_t queueSize = LINX_DEFAULT_QUEUE_SIZE);
+    ~GenericClientPool();
+
+    // Returns client already created for identifier while it is alive
+    std::shared_ptr<Client> createClient(const IdentifierType &identifier);
+    int getPollFd() const;
+    // Reads messages received within timeoutMs and routes them to clients, returns number of messages read,
+    // 0 when another thread is reading socket, negative value on error
+    int dispatch(int timeoutMs = IMMEDIATE_TIMEOUT);
+    size_t getClientCount() const;
+    LinxMetricsSnapshot getMetrics() const;
+    std::string getName() const;
+
+  private:
+    class PooledSocket;
+
+    struct Received {
+        RawMessagePtr message;
+        std::unique_ptr<IIdentifier> from;
+        int size;
+        uint64_t rxTimestamp;
+    };
+    struct Route {
+        const PooledSocket *owner = nullptr;
+        std::weak_ptr<Client> client;
+        std::deque<Received> queue;
+        std::condition_variable ready;
+        int waiters = 0;
+    };
+
+    std::string name;
+    std::shared_ptr<GenericSocket<IdentifierType>> socket;
+    const size_t queueSize;
+    std::map<std::string, Route> routes;
+    mutable std::mutex mutex;
+    // Single thread reads socket at a time, others wait for their messages
+    bool isReading = false;
+    LinxMetrics metrics;
+    std::atomic<uint64_t> unroutedDrops{0};
+
+    int receive(const std::string &key, Received *received, int timeoutMs);
+    // Called with mutex locked, returns result of socket receive
+    int readLocked(std::unique_lock<std::mutex> &lock, int timeoutMs);
+    // Wakes one waiting client to take over reading socket
+    void handOverLocked();
+    void release(const std::string &key, const PooledSocket *owner);
+};
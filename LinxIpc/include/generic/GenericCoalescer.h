@@ -0,0 +1,56 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "LinxIpc.h"
+#include "GenericSocket.h"
+#include "LinxMetrics.h"
+#include "LinxThreadOptions.h"
+
+// Packs small messages for the same destination into single container datagram (IPC_BATCH_MSG),
+// receiving socket unpacks it transparently. Container is sent when next message would not fit
+// into maxBatchBytes, delayUs after its first message was added, or on flush().
+template<typename IdentifierType>
+class GenericCoalescer {
+  public:
+    // threadOptions are applied to timer thread sending containers after delayUs
+    GenericCoalescer(const std::shared_ptr<GenericSocket<IdentifierType>> &socket, uint32_t maxBatchBytes, int delayUs,
+                     const LinxThreadOptions &threadOptions = {});
+    ~GenericCoalescer();
+
+    // Messages not fitting into container are sent directly, after pending container for the same destination
+    int send(const IMessage &message, const IdentifierType &to);
+    // Send all pending containers, returns last error or 0
+    int flush();
+    void addMetrics(LinxMetricsSnapshot &snapshot) const;
+
+  private:
+    struct Batch {
+        IdentifierType to;
+        std::vector<uint8_t> payload;
+        uint32_t count;
+        std::chrono::steady_clock::time_point deadline;
+    };
+
+    std::shared_ptr<GenericSocket<IdentifierType>> socket;
+    const uint32_t maxPayloadSize;
+    const std::chrono::microseconds delay;
+    std::map<std::string, Batch> batches;
+    std::mutex mutex;
+    std::condition_variable wakeup;
+    std::thread timerThread;
+    bool running = true;
+
+    std::atomic<uint64_t> coalescedMessages{0};
+    std::atomic<uint64_t> coalescedBatches{0};
+
+    int sendBatch(Batch &batch);
+    void timerTask();
+};
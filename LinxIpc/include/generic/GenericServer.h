@@ -6,6 +6,7 @@
 #include "LinxIpc.h"
 #include "IIdentifier.h"
 #include "GenericSimpleServer.h"
+#include "LinxThreadOptions.h"
 
 class LinxQueue;
 
@@ -21,14 +22,26 @@ class GenericServer: public GenericSimpleServer<IdentifierType> {
     LinxReceivedMessageSharedPtr receive(int timeoutMs = INFINITE_TIMEOUT,
                                       const std::vector<uint32_t> &sigsel = LINX_ANY_SIG,
                                       const IIdentifier *from = LINX_ANY_FROM) override;
+    std::vector<LinxReceivedMessageSharedPtr> receiveBatch(size_t maxCount,
+                                      int timeoutMs = INFINITE_TIMEOUT,
+                                      const std::vector<uint32_t> &sigsel = LINX_ANY_SIG,
+                                      const IIdentifier *from = LINX_ANY_FROM) override;
 
     int getPollFd() const override;
     bool start() override;
     void stop() override;
 
+    // Takes effect on next start() and setCoalescing(), helper threads get the same options under own name
+    void setThreadOptions(const LinxThreadOptions &options);
+    // Applies to both worker socket receive and consumer receive from queue
+    int setBusyPoll(int spinUs, bool kernelBusyPoll = false) override;
+    LinxMetricsSnapshot getMetrics() const override;
+
   protected:
     std::unique_ptr<LinxQueue> queue;
     std::thread workerThread;
+    LinxThreadOptions threadOptions;
 
+    LinxThreadOptions getHelperThreadOptions(const std::string &prefix) const override;
     void task();
 };
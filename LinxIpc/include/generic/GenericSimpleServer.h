@@ -1,10 +1,16 @@
 #pragma once
 
+#include <atomic>
 #include <memory>
+#include <mutex>
 #include <string>
 #include "LinxIpc.h"
 #include "IIdentifier.h"
 #include "GenericSocket.h"
+#include "GenericCoalescer.h"
+#include "LinxMetrics.h"
+
+class LinxNameResolver;
 
 template<typename IdentifierType>
 class GenericSimpleServer: public LinxServer {
@@ -17,6 +23,10 @@ class GenericSimpleServer: public LinxServer {
     LinxReceivedMessageSharedPtr receive(int timeoutMs = INFINITE_TIMEOUT,
                                       const std::vector<uint32_t> &sigsel = LINX_ANY_SIG,
                                       const IIdentifier *from = LINX_ANY_FROM) override;
+    std::vector<LinxReceivedMessageSharedPtr> receiveBatch(size_t maxCount,
+                                      int timeoutMs = INFINITE_TIMEOUT,
+                                      const std::vector<uint32_t> &sigsel = LINX_ANY_SIG,
+                                      const IIdentifier *from = LINX_ANY_FROM) override;
 
     int getPollFd() const override;
     bool start() override;
@@ -24,7 +34,58 @@ class GenericSimpleServer: public LinxServer {
     int send(const IMessage &message, const IIdentifier &to) override;
     std::string getName() const override;
 
+    // Spin for spinUs before blocking in receive, kernelBusyPoll also applies SO_BUSY_POLL on socket
+    // Must be called before start()
+    virtual int setBusyPoll(int spinUs, bool kernelBusyPoll = false);
+    // Record per-stage timestamps in LinxReceivedMessage::timestamps
+    // Must be called before start()
+    int setTimestamping(bool enable);
+    // Compress payloads of at least thresholdBytes, clients must enable compression as well
+    int setCompression(uint32_t thresholdBytes, const std::shared_ptr<LinxCompressor> &compressor = nullptr);
+    // Append CRC32C to every message and drop received messages with wrong checksum, clients must enable it as well
+    int setChecksum(bool enable);
+    // Send messages above maxDatagramSize as fragments (UDP only), clients must enable fragmentation as well
+    int setFragmentation(uint32_t maxDatagramSize,
+                         int reassemblyTimeoutMs = LINX_DEFAULT_REASSEMBLY_TIMEOUT,
+                         size_t reassemblyMemoryLimit = LINX_DEFAULT_REASSEMBLY_MEMORY);
+    // Acknowledge and retransmit lost datagrams (UDP only), clients must enable reliable mode as well
+    int setReliable(bool enable, uint32_t windowSize = LINX_DEFAULT_RELIABLE_WINDOW,
+                    int sendTimeoutMs = LINX_DEFAULT_RELIABLE_SEND_TIMEOUT);
+    // Deliver only messages with reqId in sigsel, others are dropped by socket filter in kernel where transport
+    // supports it (and in userspace otherwise). Empty sigsel (LINX_ANY_SIG) delivers everything.
+    int setSignalFilter(const std::vector<uint32_t> &sigsel);
+    // Pack messages to the same destination into containers of up to maxBatchBytes, sent after delayUs
+    // or on flush(), 0 disables. Receiver unpacks containers without configuration.
+    int setCoalescing(uint32_t maxBatchBytes, int delayUs = LINX_DEFAULT_COALESCE_DELAY_US);
+    // Send pending coalesced messages now
+    int flush();
+    virtual LinxMetricsSnapshot getMetrics() const;
+    // Register serverName -> endpoint in name service on start() and unregister it on stop(), clients waiting
+    // in connect() with GenericClient::setReadiness() complete as soon as server starts. Must be called before start()
+    void setAnnouncement(const std::shared_ptr<LinxNameResolver> &resolver, const std::string &serverName,
+                         const std::string &endpoint);
+
   protected:
     std::string serverId;
     std::shared_ptr<GenericSocket<IdentifierType>> socket;
+    std::unique_ptr<GenericCoalescer<IdentifierType>> coalescer;
+    bool timestamping = false;
+    LinxMetrics metrics;
+    // Sorted reqIds of setSignalFilter(), checked also in userspace for messages unpacked from containers
+    std::vector<uint32_t> signalFilter;
+    mutable std::mutex signalFilterMutex;
+    std::atomic<bool> hasSignalFilter{false};
+    std::shared_ptr<LinxNameResolver> announcementResolver;
+    std::string announcementName;
+    std::string announcementEndpoint;
+    // Set by stop() and cleared by start(), so that stop() from destructor does not withdraw and flush again
+    std::atomic<bool> stopped{false};
+
+    // Options of helper threads of server (coalescing timer), named prefix + server name
+    virtual LinxThreadOptions getHelperThreadOptions(const std::string &prefix) const;
+    void stampReceived(LinxReceivedMessage &msg, uint64_t rxTimestamp) const;
+    bool isFiltered(uint32_t reqId) const;
+    // Called once server is ready to answer pings
+    void announce();
+    void withdraw();
 };
@@ -1,6 +1,11 @@
 #pragma once
 
 #include "LinxIpc.h"
+#include "LinxCompression.h"
+#include "LinxMetrics.h"
+
+// receive() result for datagrams that can not be deserialized into message (malformed frame or batch)
+const inline int LINX_DESERIALIZE_ERROR = -6;
 
 template<typename IdentifierType>
 class GenericSocket {
@@ -12,9 +17,45 @@ class GenericSocket {
     virtual void close() = 0;
 
     virtual int getFd() const = 0;
+    // Fd for external pollers, readable while receive() would return without waiting, also for messages
+    // already read from socket into user space
+    virtual int getPollFd() const = 0;
 
     virtual int send(const IMessage &message, const Identifier &to) = 0;
-    virtual int receive(RawMessagePtr *msg, std::unique_ptr<IIdentifier> *from, int timeout) = 0;
+    // rxTimestamp receives kernel receive time in ns (CLOCK_REALTIME) of returned message, 0 when timestamping
+    // is disabled (messages of one container share time of container)
+    virtual int receive(RawMessagePtr *msg, std::unique_ptr<IIdentifier> *from, int timeout,
+                        uint64_t *rxTimestamp = nullptr) = 0;
 
     virtual int flush() = 0;
+
+    // Options below can be changed while other threads send and receive, messages in flight may use previous ones
+
+    // Spin for spinUs with non-blocking checks before blocking in receive(), 0 disables spinning
+    // kernelBusyPoll additionally applies SO_BUSY_POLL where transport supports it
+    virtual int setBusyPoll(int spinUs, bool kernelBusyPoll) = 0;
+
+    // Record kernel receive time (SO_TIMESTAMPNS) of each message, returned by receive(), disabled by default
+    virtual int setTimestamping(bool enable) = 0;
+
+    // Compress payloads of at least thresholdBytes on send and accept compressed messages on receive,
+    // thresholdBytes 0 disables, compressor nullptr selects built-in LZ codec
+    virtual int setCompression(uint32_t thresholdBytes, const std::shared_ptr<LinxCompressor> &compressor) = 0;
+
+    // Append CRC32C of every frame on send, verify and drop frames with wrong checksum on receive
+    virtual int setChecksum(bool enable) = 0;
+
+    // Split messages larger than maxDatagramSize into fragments reassembled by receiver, 0 disables
+    virtual int setFragmentation(uint32_t maxDatagramSize, int reassemblyTimeoutMs, size_t reassemblyMemoryLimit) = 0;
+
+    // Acknowledge and retransmit datagrams, send() waits up to sendTimeoutMs while windowSize datagrams
+    // to peer are unacknowledged
+    virtual int setReliable(bool enable, uint32_t windowSize, int sendTimeoutMs) = 0;
+
+    // Drop datagrams with reqId outside sigsel in kernel (classic BPF socket filter), internal messages always pass.
+    // Empty sigsel removes filter. Filter is rebuilt when options changing wire reqId flags are set.
+    virtual int setSignalFilter(const std::vector<uint32_t> &sigsel) = 0;
+
+    // Add transport level counters to snapshot
+    virtual void addMetrics(LinxMetricsSnapshot &snapshot) const = 0;
 };
@@ -4,6 +4,7 @@
 #include "GenericSimpleServer.h"
 #include "GenericServer.h"
 #include "GenericClient.h"
+#include "GenericClientPool.h"
 
 template<typename IdentifierType>
 struct LinxProtocol {
@@ -12,4 +13,5 @@ struct LinxProtocol {
     using SimpleServer = GenericSimpleServer<IdentifierType>;
     using Server       = GenericServer<IdentifierType>;
     using Client       = GenericClient<IdentifierType>;
+    using ClientPool   = GenericClientPool<IdentifierType>;
 };
@@ -0,0 +1,78 @@
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+// Field stored in fixed byte order inside wire structs, converted on every access.
+// Alignment is 1, so structs built from these fields can be viewed in place at any payload offset.
+template<typename T, bool BigEndianOrder>
+class LinxEndianValue {
+    static_assert(std::is_arithmetic_v<T> || std::is_enum_v<T>, "Endian value must be arithmetic or enum type");
+    static_assert(sizeof(T) == 1 || sizeof(T) == 2 || sizeof(T) == 4 || sizeof(T) == 8, "Unsupported size");
+
+  public:
+    LinxEndianValue() = default;
+    LinxEndianValue(T value) {
+        set(value);
+    }
+
+    T get() const {
+        T value;
+        auto raw = swap(load());
+        std::memcpy(&value, &raw, sizeof(T));
+        return value;
+    }
+
+    void set(T value) {
+        Raw raw;
+        std::memcpy(&raw, &value, sizeof(T));
+        raw = swap(raw);
+        std::memcpy(bytes, &raw, sizeof(T));
+    }
+
+    operator T() const {
+        return get();
+    }
+
+    LinxEndianValue &operator=(T value) {
+        set(value);
+        return *this;
+    }
+
+  private:
+    using Raw = std::conditional_t<sizeof(T) == 1, uint8_t,
+                std::conditional_t<sizeof(T) == 2, uint16_t,
+                std::conditional_t<sizeof(T) == 4, uint32_t, uint64_t>>>;
+
+    Raw load() const {
+        Raw raw;
+        std::memcpy(&raw, bytes, sizeof(T));
+        return raw;
+    }
+
+    static Raw swap(Raw raw) {
+        constexpr bool hostBigEndian = __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__;
+        if constexpr (sizeof(T) == 1 || hostBigEndian == BigEndianOrder) {
+            return raw;
+        } else if constexpr (sizeof(T) == 2) {
+            return __builtin_bswap16(raw);
+        } else if constexpr (sizeof(T) == 4) {
+            return __builtin_bswap32(raw);
+        } else {
+            return __builtin_bswap64(raw);
+        }
+    }
+
+    uint8_t bytes[sizeof(T)];
+};
+
+template<typename T>
+using BigEndian = LinxEndianValue<T, true>;
+
+template<typename T>
+using LittleEndian = LinxEndianValue<T, false>;
+
+// Byte order used by message header (reqId)
+template<typename T>
+using NetworkOrder = BigEndian<T>;
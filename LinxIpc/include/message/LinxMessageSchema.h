@@ -0,0 +1,217 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <type_traits>
+#include "LinxMessage.h"
+#include "RawMessage.h"
+
+enum class LinxByteOrder { LITTLE, BIG };
+
+// Field descriptors of message aggregate, fields are written to wire in listed order without padding:
+//   struct Data { uint32_t id; float values[8]; };
+//   template<> struct LinxMessageSchema<Data> : LinxSchemaFields<&Data::id, &Data::values> {};
+// Wire byte order is little endian unless schema declares:
+//   static constexpr LinxByteOrder byteOrder = LinxByteOrder::BIG;
+// Arithmetic and enum fields (also arrays of them) are converted to wire byte order,
+// other trivially copyable fields are copied as raw bytes.
+template<auto... Members>
+struct LinxSchemaFields {
+    static constexpr LinxByteOrder byteOrder = LinxByteOrder::LITTLE;
+};
+
+template<typename T>
+struct LinxMessageSchema;
+
+namespace linx_schema {
+
+template<typename M>
+struct MemberTraits;
+
+template<typename C, typename F>
+struct MemberTraits<F C::*> {
+    using Class = C;
+    using Field = F;
+};
+
+template<typename F>
+struct ElementTraits {
+    using Element = F;
+    static constexpr size_t count = 1;
+};
+
+template<typename E, size_t N>
+struct ElementTraits<E[N]> {
+    using Element = E;
+    static constexpr size_t count = N;
+};
+
+template<typename E, size_t N>
+struct ElementTraits<std::array<E, N>> {
+    using Element = E;
+    static constexpr size_t count = N;
+};
+
+template<typename F>
+constexpr bool needsSwap(LinxByteOrder order) {
+    using Element = typename ElementTraits<F>::Element;
+    constexpr bool hostBigEndian = __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__;
+    return (std::is_arithmetic_v<Element> || std::is_enum_v<Element>) && sizeof(Element) > 1 &&
+           (order == LinxByteOrder::BIG) != hostBigEndian;
+}
+
+template<size_t Size>
+struct SwapType;
+template<> struct SwapType<2> { using Type = uint16_t; };
+template<> struct SwapType<4> { using Type = uint32_t; };
+template<> struct SwapType<8> { using Type = uint64_t; };
+
+// Plain loop over elements, vectorized by compiler for arrays
+template<typename Element>
+inline void copySwapped(uint8_t *to, const uint8_t *from, size_t count) {
+    using Raw = typename SwapType<sizeof(Element)>::Type;
+    for (size_t i = 0; i < count; i++) {
+        Raw raw;
+        std::memcpy(&raw, from + i * sizeof(Raw), sizeof(Raw));
+        if constexpr (sizeof(Raw) == 2) {
+            raw = __builtin_bswap16(raw);
+        } else if constexpr (sizeof(Raw) == 4) {
+            raw = __builtin_bswap32(raw);
+        } else {
+            raw = __builtin_bswap64(raw);
+        }
+        std::memcpy(to + i * sizeof(Raw), &raw, sizeof(Raw));
+    }
+}
+
+template<typename F, LinxByteOrder Order>
+inline void copyField(uint8_t *to, const uint8_t *from) {
+    if constexpr (needsSwap<F>(Order)) {
+        copySwapped<typename ElementTraits<F>::Element>(to, from, ElementTraits<F>::count);
+    } else {
+        std::memcpy(to, from, sizeof(F));
+    }
+}
+
+template<auto... Members>
+constexpr uint32_t wireSize(const LinxSchemaFields<Members...> *) {
+    return (sizeof(typename MemberTraits<decltype(Members)>::Field) + ... + 0);
+}
+
+template<auto... Members>
+constexpr bool anySwap(const LinxSchemaFields<Members...> *, LinxByteOrder order) {
+    return (needsSwap<typename MemberTraits<decltype(Members)>::Field>(order) || ...);
+}
+
+} // namespace linx_schema
+
+// Serialization generated from LinxMessageSchema<T>, sizes and conversions are resolved at compile time
+template<typename T>
+class LinxSchemaCodec {
+    template<typename M>
+    using FieldOf = typename linx_schema::MemberTraits<M>::Field;
+
+    template<auto... Members>
+    static void write(const T &payload, uint8_t *buffer, const LinxSchemaFields<Members...> *) {
+        ((linx_schema::copyField<FieldOf<decltype(Members)>, byteOrder>(
+              buffer, reinterpret_cast<const uint8_t *>(&(payload.*Members))),
+          buffer += sizeof(payload.*Members)),
+         ...);
+    }
+
+    template<auto... Members>
+    static void read(const uint8_t *buffer, T &payload, const LinxSchemaFields<Members...> *) {
+        ((linx_schema::copyField<FieldOf<decltype(Members)>, byteOrder>(
+              reinterpret_cast<uint8_t *>(&(payload.*Members)), buffer),
+          buffer += sizeof(payload.*Members)),
+         ...);
+    }
+
+    // Member offsets are not constant expressions, checked once at runtime
+    template<auto... Members>
+    static bool isContiguous(const LinxSchemaFields<Members...> *) {
+        static const T probe{};
+        const uint8_t *base = reinterpret_cast<const uint8_t *>(&probe);
+        size_t offset = 0;
+        bool contiguous = true;
+        ((contiguous = contiguous && reinterpret_cast<const uint8_t *>(&(probe.*Members)) == base + offset,
+          offset += sizeof(probe.*Members)),
+         ...);
+        return contiguous;
+    }
+
+    static constexpr const LinxMessageSchema<T> *schema = nullptr;
+
+  public:
+    static_assert(std::is_trivially_copyable_v<T>, "Schema message payload must be trivially copyable");
+
+    static constexpr LinxByteOrder byteOrder = LinxMessageSchema<T>::byteOrder;
+    static constexpr uint32_t size = linx_schema::wireSize(schema);
+
+    // Fields cover whole aggregate and no conversion is needed: wire layout equals memory layout
+    static bool isMemcpyLayout() {
+        if constexpr (size != sizeof(T) || linx_schema::anySwap(schema, byteOrder)) {
+            return false;
+        } else {
+            static const bool contiguous = isContiguous(schema);
+            return contiguous;
+        }
+    }
+
+    static uint32_t serialize(const T &payload, uint8_t *buffer, uint32_t bufferSize) {
+        if (bufferSize < size) {
+            return 0;
+        }
+        if (isMemcpyLayout()) {
+            std::memcpy(buffer, &payload, size);
+        } else {
+            write(payload, buffer, schema);
+        }
+        return size;
+    }
+
+    static bool deserialize(const uint8_t *buffer, uint32_t bufferSize, T &payload) {
+        if (bufferSize < size) {
+            return false;
+        }
+        if (isMemcpyLayout()) {
+            std::memcpy(&payload, buffer, size);
+        } else {
+            read(buffer, payload, schema);
+        }
+        return true;
+    }
+};
+
+// Message with payload serialized according to LinxMessageSchema<T>
+template<typename T>
+class LinxSchemaMessage final : public IMessage {
+  public:
+    using Codec = LinxSchemaCodec<T>;
+
+    LinxSchemaMessage(uint32_t reqId, const T &payload = {}) : IMessage(reqId), payload(payload) {}
+
+    const T *getPayload() const {
+        return &payload;
+    }
+
+    uint32_t getPayloadSize() const override {
+        return Codec::size;
+    }
+
+    uint32_t serializePayload(uint8_t *buffer, uint32_t bufferSize) const override {
+        return Codec::serialize(payload, buffer, bufferSize);
+    }
+
+    static std::unique_ptr<LinxSchemaMessage<T>> fromRawMessage(const RawMessage &rawMsg) {
+        auto msg = std::make_unique<LinxSchemaMessage<T>>(rawMsg.getReqId());
+        if (!Codec::deserialize(rawMsg.getPayload(), rawMsg.getPayloadSize(), msg->payload)) {
+            return nullptr;
+        }
+        return msg;
+    }
+
+    T payload;
+};
@@ -0,0 +1,51 @@
+#pragma once
+
+#include <cstdint>
+#include <optional>
+#include <type_traits>
+#include "RawMessage.h"
+#include "LinxEndian.h"
+
+// Typed read-only view of message payload, payload is accessed in place without copying.
+// View does not own data: it is valid only as long as viewed RawMessage (or buffer) is alive and unchanged.
+// Multi-byte fields sent between hosts should be declared with BigEndian<T> / LittleEndian<T> (LinxEndian.h).
+template<typename T>
+class MessageView {
+    static_assert(std::is_trivially_copyable_v<T>, "MessageView requires trivially copyable payload type");
+
+  public:
+    // Returns empty optional when payload is smaller than T or not aligned for T
+    static std::optional<MessageView<T>> fromRawMessage(const RawMessage &rawMsg) {
+        return fromBuffer(rawMsg.getReqId(), rawMsg.getPayload(), rawMsg.getPayloadSize());
+    }
+
+    static std::optional<MessageView<T>> fromBuffer(uint32_t reqId, const void *payload, uint32_t payloadSize) {
+        if (payload == nullptr || payloadSize < sizeof(T) ||
+            reinterpret_cast<uintptr_t>(payload) % alignof(T) != 0) {
+            return std::nullopt;
+        }
+        return MessageView<T>(reqId, static_cast<const T *>(payload));
+    }
+
+    uint32_t getReqId() const {
+        return reqId;
+    }
+
+    const T *get() const {
+        return payload;
+    }
+
+    const T &operator*() const {
+        return *payload;
+    }
+
+    const T *operator->() const {
+        return payload;
+    }
+
+  private:
+    MessageView(uint32_t reqId, const T *payload) : reqId(reqId), payload(payload) {}
+
+    uint32_t reqId;
+    const T *payload;
+};
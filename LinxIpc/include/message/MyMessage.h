@@ -1,54 +1,54 @@
 #pragma once
 
 #include "LinxMessage.h"
-#include <arpa/inet.h>
-#include <cstring>
+#include "LinxMessageSchema.h"
 #include <memory>
-#include <optional>
+
+struct MyMessageData {
+    int32_t value;
+    float temperature;
+};
+
+template<>
+struct LinxMessageSchema<MyMessageData> : LinxSchemaFields<&MyMessageData::value, &MyMessageData::temperature> {
+    static constexpr LinxByteOrder byteOrder = LinxByteOrder::BIG;
+};
 
 class MyMessage : public IMessage {
-    struct Data {
-        int value;
-        float temperature;
-    };
+    using Codec = LinxSchemaCodec<MyMessageData>;
 
   public:
     MyMessage(uint32_t reqId, int value, float temperature)
-        : IMessage(reqId), value(value), temperature(temperature) {}
+        : IMessage(reqId), data{value, temperature} {}
 
     ~MyMessage() = default;
 
     // Getters
-    int getValue() const { return value; }
-    float getTemperature() const { return temperature; }
+    int getValue() const { return data.value; }
+    float getTemperature() const { return data.temperature; }
 
     // Setters
-    void setValue(int v) { value = v; }
-    void setTemperature(float t) { temperature = t; }
+    void setValue(int v) { data.value = v; }
+    void setTemperature(float t) { data.temperature = t; }
 
     uint32_t getPayloadSize() const override {
-        return sizeof(value) + sizeof(temperature);
+        return Codec::size;
     }
 
     virtual uint32_t serializePayload(uint8_t *buffer, uint32_t bufferSize) const override {
-        Data data = {
-            .value = static_cast<int>(htonl(value)),
-            .temperature = temperature
-        };
-
-        std::memcpy(buffer, &data, sizeof(data));
-        return this->getPayloadSize();
+        return Codec::serialize(data, buffer, bufferSize);
     }
 
     static std::unique_ptr<MyMessage> fromRawMessage(const RawMessage &rawMsg) {
-        Data data = *rawMsg.getPayloadAs<Data>();
-        int value = static_cast<int>(ntohl(data.value));
-        return std::make_unique<MyMessage>(rawMsg.getReqId(), value, data.temperature);
+        MyMessageData data;
+        if (!Codec::deserialize(rawMsg.getPayload(), rawMsg.getPayloadSize(), data)) {
+            return nullptr;
+        }
+        return std::make_unique<MyMessage>(rawMsg.getReqId(), data.value, data.temperature);
     }
 
   private:
-    int value;
-    float temperature;
+    MyMessageData data;
 };
 
 using MyMessagePtr = std::unique_ptr<MyMessage>;
@@ -0,0 +1,54 @@
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <poll.h>
+
+namespace BusyPoll {
+
+inline void cpuRelax() {
+#if defined(__x86_64__) || defined(__i386__)
+    __builtin_ia32_pause();
+#elif defined(__aarch64__)
+    asm volatile("yield");
+#endif
+}
+
+// End of spinning started at start, spinning never takes longer than finite timeoutMs
+inline std::chrono::steady_clock::time_point spinDeadline(std::chrono::steady_clock::time_point start, int timeoutMs,
+                                                          int spinUs) {
+    int64_t us = spinUs;
+    if (timeoutMs >= 0) {
+        us = std::min<int64_t>(us, (int64_t)timeoutMs * 1000);
+    }
+    return start + std::chrono::microseconds(us);
+}
+
+// Part of timeoutMs left after spinning since start, negative (infinite) timeout stays unchanged
+inline int remainingMs(int timeoutMs, std::chrono::steady_clock::time_point start) {
+    if (timeoutMs < 0) {
+        return timeoutMs;
+    }
+    auto elapsedUs = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start);
+    int64_t remainingUs = (int64_t)timeoutMs * 1000 - elapsedUs.count();
+    return remainingUs > 0 ? (int)(remainingUs / 1000) : 0;
+}
+
+// Spin with non-blocking poll for spinUs before falling back to blocking poll for the rest of timeoutMs
+inline int poll(struct pollfd *fds, nfds_t nfds, int timeoutMs, int spinUs) {
+    if (spinUs > 0 && timeoutMs != 0) {
+        auto start = std::chrono::steady_clock::now();
+        auto deadline = spinDeadline(start, timeoutMs, spinUs);
+        do {
+            if (int rc = ::poll(fds, nfds, 0); rc != 0) {
+                return rc;
+            }
+            cpuRelax();
+        } while (std::chrono::steady_clock::now() < deadline);
+        timeoutMs = remainingMs(timeoutMs, start);
+    }
+    return ::poll(fds, nfds, timeoutMs);
+}
+
+} // namespace BusyPoll
@@ -1,11 +1,17 @@
 #pragma once
 
+#include <algorithm>
+#include <chrono>
 #include <cstring>
+#include <thread>
 #include "Deadline.h"
+#include "LinxBackoff.h"
+#include "LinxNameService.h"
 #include "LinxTrace.h"
 #include "LinxMessageIds.h"
 #include "GenericSocket.h"
 #include "LinxMessageFilter.h"
+#include "GenericCoalescer.tpp"
 
 template<typename IdentifierType>
 GenericClient<IdentifierType>::GenericClient(const std::string &clientId,
@@ -16,17 +22,21 @@ GenericClient<IdentifierType>::GenericClient(const std::string &clientId,
 
 template<typename IdentifierType>
 GenericClient<IdentifierType>::~GenericClient() {
-    LINX_INFO("[%s] Stopping", getName().c_str());
+    LINX_INFO(CLIENT, "[%s] Stopping", getName().c_str());
+    coalescer.reset();
     this->socket->close();
 }
 
 template<typename IdentifierType>
 int GenericClient<IdentifierType>::send(const IMessage &message) {
-    LINX_DEBUG("[%s] Sending message reqId: 0x%x",
+    LINX_DEBUG(CLIENT, "[%s] Sending message reqId: 0x%x",
             getName().c_str(), message.getReqId());
-    auto ret = socket->send(message, identifier);
+    auto ret = coalescer ? coalescer->send(message, identifier) : socket->send(message, identifier);
     if (ret < 0) {
-        LINX_ERROR("[%s] Send error: %d", getName().c_str(), ret);
+        metrics.onSendError();
+        LINX_ERROR_RATELIMITED(CLIENT, "[%s] Send error: %d", getName().c_str(), ret);
+    } else {
+        metrics.onSend(message.getSize());
     }
     return ret;
 }
@@ -46,29 +56,54 @@ RawMessagePtr GenericClient<IdentifierType>::receive(int timeoutMs, const std::v
         int timeout = deadline.getRemainingTimeMs();
         int ret = socket->receive(&msg, &from, timeout);
         if (ret == 0) {
-            LINX_DEBUG("[%s] receive timeout", getName().c_str());
+            LINX_DEBUG(CLIENT, "[%s] receive timeout", getName().c_str());
             return nullptr;
         }
         if (ret < 0) {
-            LINX_ERROR("[%s] receive error: %d", getName().c_str(), ret);
+            if (ret == LINX_DESERIALIZE_ERROR) {
+                metrics.onDeserializeError();
+            } else {
+                metrics.onReceiveError();
+            }
+            LINX_ERROR_RATELIMITED(CLIENT, "[%s] receive error: %d", getName().c_str(), ret);
             return nullptr;
         }
+        metrics.onReceive(ret);
         if (predicate(msg, from)) {
             return msg;
         }
     } while (!deadline.isExpired());
 
-    LINX_ERROR("[%s] receive timed out", getName().c_str());
+    LINX_ERROR_RATELIMITED(CLIENT, "[%s] receive timed out", getName().c_str());
     return nullptr;
 }
 
 template<typename IdentifierType>
 RawMessagePtr GenericClient<IdentifierType>::sendReceive(const IMessage &message, int timeoutMs,
                                                                         const std::vector<uint32_t> &sigsel) {
-    if (send(message) < 0) {
+    // Request is not held back by coalescing delay, response is awaited right away
+    if (!latencyHistogram) {
+        if (send(message) < 0 || flush() < 0) {
+            return nullptr;
+        }
+        return receive(timeoutMs, sigsel);
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    if (send(message) < 0 || flush() < 0) {
         return nullptr;
     }
-    return receive(timeoutMs, sigsel);
+    auto rsp = receive(timeoutMs, sigsel);
+    if (rsp) {
+        auto elapsed = std::chrono::steady_clock::now() - start;
+        latencyHistogram->record(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count());
+    }
+    return rsp;
+}
+
+template<typename IdentifierType>
+void GenericClient<IdentifierType>::setLatencyHistogram(const std::shared_ptr<LinxHistogram> &histogram) {
+    latencyHistogram = histogram;
 }
 
 template<typename IdentifierType>
@@ -76,28 +111,139 @@ bool GenericClient<IdentifierType>::connect(int timeoutMs) {
     static constexpr int pingTimeout = 100;
     Deadline deadline(timeoutMs);
 
-    do {
+    // Announcement of server is pushed by name service, no pings are sent before server starts
+    if (readinessResolver && readinessResolver->resolve(readinessName, deadline.getRemainingTimeMs()).empty()) {
+        LINX_ERROR(CLIENT, "[%s] server %s not announced", getName().c_str(), readinessName.c_str());
+        return false;
+    }
+
+    // Every attempt waits pingTimeout for response, even with timeoutMs 0. Pauses between attempts back off
+    // so that many clients waiting for the same server do not flood it with pings.
+    LinxBackoff backoff(LINX_CONNECT_BACKOFF_MIN, LINX_CONNECT_BACKOFF_MAX);
+    while (true) {
+        Deadline attempt(pingTimeout);
         RawMessage message{IPC_PING_REQ};
-        int len = send(message);
-        if (len >= 0) {
-            auto rsp = receive(pingTimeout, {IPC_PING_RSP});
-            if (rsp != nullptr) {
-                LINX_INFO("[%s] connected", getName().c_str());
-                return true;
-            }
+        if (send(message) >= 0 && receive(pingTimeout, {IPC_PING_RSP}) != nullptr) {
+            LINX_INFO(CLIENT, "[%s] connected", getName().c_str());
+            return true;
         }
-    } while (!deadline.isExpired());
+        // Send and receive errors return immediately, wait for the rest of attempt instead of spinning
+        int rest = attempt.getRemainingTimeMs();
+        if (rest > 0) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(rest));
+        }
+
+        if (deadline.isExpired()) {
+            break;
+        }
+        int pause = backoff.next();
+        int remaining = deadline.getRemainingTimeMs();
+        if (remaining != INFINITE_TIMEOUT) {
+            pause = std::min(pause, remaining);
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(pause));
+    }
 
-    LINX_ERROR("[%s] connection timed out", getName().c_str());
+    LINX_ERROR(CLIENT, "[%s] connection timed out", getName().c_str());
     return false;
 }
 
+template<typename IdentifierType>
+void GenericClient<IdentifierType>::setReadiness(const std::shared_ptr<LinxNameResolver> &resolver,
+                                                 const std::string &serverName) {
+    readinessResolver = resolver;
+    readinessName = serverName;
+}
+
 template<typename IdentifierType>
 bool GenericClient<IdentifierType>::isEqual(const LinxClient &other) const {
     const auto *otherClient = dynamic_cast<const GenericClient<IdentifierType>*>(&other);
     return this->socket == otherClient->socket && this->identifier == otherClient->identifier;
 }
 
+template<typename IdentifierType>
+int GenericClient<IdentifierType>::setBusyPoll(int spinUs, bool kernelBusyPoll) {
+    auto ret = socket->setBusyPoll(spinUs, kernelBusyPoll);
+    if (ret < 0) {
+        LINX_ERROR(CLIENT, "[%s] set busy poll error: %d", getName().c_str(), ret);
+    }
+    return ret;
+}
+
+template<typename IdentifierType>
+int GenericClient<IdentifierType>::setCompression(uint32_t thresholdBytes,
+                                                  const std::shared_ptr<LinxCompressor> &compressor) {
+    auto ret = socket->setCompression(thresholdBytes, compressor);
+    if (ret < 0) {
+        LINX_ERROR(CLIENT, "[%s] set compression error: %d", getName().c_str(), ret);
+    }
+    return ret;
+}
+
+template<typename IdentifierType>
+int GenericClient<IdentifierType>::setChecksum(bool enable) {
+    auto ret = socket->setChecksum(enable);
+    if (ret < 0) {
+        LINX_ERROR(CLIENT, "[%s] set checksum error: %d", getName().c_str(), ret);
+    }
+    return ret;
+}
+
+template<typename IdentifierType>
+int GenericClient<IdentifierType>::setFragmentation(uint32_t maxDatagramSize, int reassemblyTimeoutMs,
+                                                    size_t reassemblyMemoryLimit) {
+    auto ret = socket->setFragmentation(maxDatagramSize, reassemblyTimeoutMs, reassemblyMemoryLimit);
+    if (ret < 0) {
+        LINX_ERROR(CLIENT, "[%s] set fragmentation error: %d", getName().c_str(), ret);
+    }
+    return ret;
+}
+
+template<typename IdentifierType>
+int GenericClient<IdentifierType>::setReliable(bool enable, uint32_t windowSize, int sendTimeoutMs) {
+    auto ret = socket->setReliable(enable, windowSize, sendTimeoutMs);
+    if (ret < 0) {
+        LINX_ERROR(CLIENT, "[%s] set reliable error: %d", getName().c_str(), ret);
+    }
+    return ret;
+}
+
+template<typename IdentifierType>
+int GenericClient<IdentifierType>::setCoalescing(uint32_t maxBatchBytes, int delayUs) {
+    coalescer.reset();
+    if (maxBatchBytes == 0) {
+        return 0;
+    }
+    if (maxBatchBytes <= 2 * sizeof(uint32_t) + LinxBatch::entryHeaderSize) {
+        LINX_ERROR(CLIENT, "[%s] set coalescing error, batch size: %u", getName().c_str(), maxBatchBytes);
+        return -1;
+    }
+    LinxThreadOptions threadOptions;
+    threadOptions.name = "co_" + getName();
+    coalescer = std::make_unique<GenericCoalescer<IdentifierType>>(socket, maxBatchBytes, delayUs, threadOptions);
+    return 0;
+}
+
+template<typename IdentifierType>
+int GenericClient<IdentifierType>::flush() {
+    auto ret = coalescer ? coalescer->flush() : 0;
+    if (ret < 0) {
+        metrics.onSendError();
+        LINX_ERROR_RATELIMITED(CLIENT, "[%s] flush error: %d", getName().c_str(), ret);
+    }
+    return ret;
+}
+
+template<typename IdentifierType>
+LinxMetricsSnapshot GenericClient<IdentifierType>::getMetrics() const {
+    auto snapshot = metrics.snapshot(getName());
+    socket->addMetrics(snapshot);
+    if (coalescer) {
+        coalescer->addMetrics(snapshot);
+    }
+    return snapshot;
+}
+
 template<typename IdentifierType>
 std::string GenericClient<IdentifierType>::getName() const {
     return clientId;
@@ -0,0 +1,290 @@
+#pragma once
+
+#include "GenericClientPool.h"
+#include "GenericClient.tpp"
+#include "Deadline.h"
+#include "LinxTrace.h"
+
+// Socket of single pooled client: sends through shared socket, receives from client queue
+template<typename IdentifierType>
+class GenericClientPool<IdentifierType>::PooledSocket : public GenericSocket<IdentifierType> {
+  public:
+    PooledSocket(const std::shared_ptr<GenericClientPool> &pool, const std::string &key) : pool(pool), key(key) {}
+
+    ~PooledSocket() override {
+        close();
+    }
+
+    int open() override {
+        return 0;
+    }
+
+    void close() override {
+        if (!isClosed) {
+            isClosed = true;
+            pool->release(key, this);
+        }
+    }
+
+    int getFd() const override {
+        return pool->socket->getFd();
+    }
+
+    int getPollFd() const override {
+        return pool->socket->getPollFd();
+    }
+
+    int send(const IMessage &message, const IdentifierType &to) override {
+        return pool->socket->send(message, to);
+    }
+
+    int receive(RawMessagePtr *msg, std::unique_ptr<IIdentifier> *from, int timeout,
+                uint64_t *rxTimestamp = nullptr) override {
+        Received received;
+        int ret = pool->receive(key, &received, timeout);
+        if (ret > 0) {
+            if (rxTimestamp) {
+                *rxTimestamp = received.rxTimestamp;
+            }
+            if (msg) {
+                *msg = std::move(received.message);
+            }
+            if (from) {
+                *from = std::move(received.from);
+            }
+        }
+        return ret;
+    }
+
+    int flush() override {
+        return pool->socket->flush();
+    }
+
+    int setBusyPoll(int spinUs, bool kernelBusyPoll) override {
+        return pool->socket->setBusyPoll(spinUs, kernelBusyPoll);
+    }
+
+    int setTimestamping(bool enable) override {
+        return pool->socket->setTimestamping(enable);
+    }
+
+    int setCompression(uint32_t thresholdBytes, const std::shared_ptr<LinxCompressor> &compressor) override {
+        return pool->socket->setCompression(thresholdBytes, compressor);
+    }
+
+    int setChecksum(bool enable) override {
+        return pool->socket->setChecksum(enable);
+    }
+
+    int setFragmentation(uint32_t maxDatagramSize, int reassemblyTimeoutMs, size_t reassemblyMemoryLimit) override {
+        return pool->socket->setFragmentation(maxDatagramSize, reassemblyTimeoutMs, reassemblyMemoryLimit);
+    }
+
+    int setReliable(bool enable, uint32_t windowSize, int sendTimeoutMs) override {
+        return pool->socket->setReliable(enable, windowSize, sendTimeoutMs);
+    }
+
+    int setSignalFilter(const std::vector<uint32_t> &sigsel) override {
+        return pool->socket->setSignalFilter(sigsel);
+    }
+
+    void addMetrics(LinxMetricsSnapshot &snapshot) const override {
+        pool->socket->addMetrics(snapshot);
+    }
+
+  private:
+    std::shared_ptr<GenericClientPool> pool;
+    std::string key;
+    bool isClosed = false;
+};
+
+template<typename IdentifierType>
+GenericClientPool<IdentifierType>::GenericClientPool(const std::string &name,
+                                                     const std::shared_ptr<GenericSocket<IdentifierType>> &socket,
+                                                     size_t queueSize)
+    : name(name), socket(socket), queueSize(queueSize) {
+}
+
+template<typename IdentifierType>
+GenericClientPool<IdentifierType>::~GenericClientPool() {
+    LINX_INFO(CLIENT, "[%s] Stopping client pool", name.c_str());
+    socket->close();
+}
+
+template<typename IdentifierType>
+std::shared_ptr<typename GenericClientPool<IdentifierType>::Client>
+GenericClientPool<IdentifierType>::createClient(const IdentifierType &identifier) {
+    auto key = identifier.format();
+    std::lock_guard<std::mutex> lock(mutex);
+
+    auto &route = routes[key];
+    if (auto client = route.client.lock()) {
+        return client;
+    }
+    auto pooled = std::make_shared<PooledSocket>(this->shared_from_this(), key);
+    auto client = std::make_shared<Client>(name + "_" + key, pooled, identifier);
+    route.owner = pooled.get();
+    route.client = client;
+    route.queue.clear();
+    return client;
+}
+
+template<typename IdentifierType>
+int GenericClientPool<IdentifierType>::getPollFd() const {
+    return socket->getPollFd();
+}
+
+template<typename IdentifierType>
+int GenericClientPool<IdentifierType>::dispatch(int timeoutMs) {
+    std::unique_lock<std::mutex> lock(mutex);
+    if (isReading) {
+        return 0;
+    }
+
+    // Wait for first message only, then drain messages already received
+    int count = 0;
+    int ret;
+    while ((ret = readLocked(lock, count == 0 ? timeoutMs : IMMEDIATE_TIMEOUT)) > 0) {
+        count++;
+    }
+    handOverLocked();
+    return ret < 0 ? ret : count;
+}
+
+template<typename IdentifierType>
+size_t GenericClientPool<IdentifierType>::getClientCount() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return routes.size();
+}
+
+template<typename IdentifierType>
+LinxMetricsSnapshot GenericClientPool<IdentifierType>::getMetrics() const {
+    auto snapshot = metrics.snapshot(name);
+    socket->addMetrics(snapshot);
+    snapshot.unroutedDrops = unroutedDrops.load(std::memory_order_relaxed);
+
+    std::lock_guard<std::mutex> lock(mutex);
+    for (const auto &[key, route] : routes) {
+        snapshot.queueDepth += route.queue.size();
+    }
+    return snapshot;
+}
+
+template<typename IdentifierType>
+std::string GenericClientPool<IdentifierType>::getName() const {
+    return name;
+}
+
+template<typename IdentifierType>
+int GenericClientPool<IdentifierType>::receive(const std::string &key, Received *received, int timeoutMs) {
+    Deadline deadline(timeoutMs);
+    std::unique_lock<std::mutex> lock(mutex);
+    bool isTimedOut = false;
+
+    while (true) {
+        auto it = routes.find(key);
+        if (it == routes.end()) {
+            return -1;
+        }
+        auto &route = it->second;
+        if (!route.queue.empty()) {
+            *received = std::move(route.queue.front());
+            route.queue.pop_front();
+            handOverLocked();
+            return received->size;
+        }
+        if (isTimedOut) {
+            handOverLocked();
+            return 0;
+        }
+
+        int remaining = deadline.getRemainingTimeMs();
+        if (!isReading) {
+            // Mutex is released while reading, route is looked up again
+            int ret = readLocked(lock, remaining);
+            if (ret < 0) {
+                handOverLocked();
+                return ret;
+            }
+            isTimedOut = ret == 0 && remaining == 0;
+            continue;
+        }
+        if (remaining == 0) {
+            return 0;
+        }
+
+        route.waiters++;
+        if (remaining == INFINITE_TIMEOUT) {
+            route.ready.wait(lock);
+        } else {
+            route.ready.wait_for(lock, std::chrono::milliseconds(remaining));
+        }
+        route.waiters--;
+    }
+}
+
+template<typename IdentifierType>
+int GenericClientPool<IdentifierType>::readLocked(std::unique_lock<std::mutex> &lock, int timeoutMs) {
+    RawMessagePtr message;
+    std::unique_ptr<IIdentifier> from;
+
+    isReading = true;
+    lock.unlock();
+    uint64_t rxTimestamp = 0;
+    int ret = socket->receive(&message, &from, timeoutMs, &rxTimestamp);
+    lock.lock();
+    isReading = false;
+
+    if (ret < 0) {
+        if (ret == LINX_DESERIALIZE_ERROR) {
+            metrics.onDeserializeError();
+        } else {
+            metrics.onReceiveError();
+        }
+        LINX_ERROR_RATELIMITED(CLIENT, "[%s] receive error: %d", name.c_str(), ret);
+        return ret;
+    }
+    if (ret == 0) {
+        return 0;
+    }
+
+    metrics.onReceive(ret);
+    auto it = from ? routes.find(from->format()) : routes.end();
+    if (it == routes.end()) {
+        unroutedDrops.fetch_add(1, std::memory_order_relaxed);
+        LINX_DEBUG(CLIENT, "[%s] no client of sender: %s, reqId: 0x%x", name.c_str(),
+                   from ? from->format().c_str() : "", message->getReqId());
+        return ret;
+    }
+    if (it->second.queue.size() >= queueSize) {
+        metrics.onQueueDrop();
+        LINX_ERROR_RATELIMITED(CLIENT, "[%s] queue of client %s full, reqId: 0x%x dropped", name.c_str(),
+                               it->first.c_str(), message->getReqId());
+        return ret;
+    }
+    it->second.queue.push_back(Received{std::move(message), std::move(from), ret, rxTimestamp});
+    it->second.ready.notify_one();
+    return ret;
+}
+
+template<typename IdentifierType>
+void GenericClientPool<IdentifierType>::handOverLocked() {
+    if (isReading) {
+        return;
+    }
+    for (auto &[key, route] : routes) {
+        if (route.waiters > 0) {
+            route.ready.notify_one();
+            return;
+        }
+    }
+}
+
+template<typename IdentifierType>
+void GenericClientPool<IdentifierType>::release(const std::string &key, const PooledSocket *owner) {
+    std::lock_guard<std::mutex> lock(mutex);
+    auto it = routes.find(key);
+    if (it != routes.end() && it->second.owner == owner) {
+        routes.erase(it);
+    }
+}
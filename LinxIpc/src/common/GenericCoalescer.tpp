@@ -0,0 +1,126 @@
+#pragma once
+
+#include "GenericCoalescer.h"
+#include "LinxBatch.h"
+#include "LinxMessageIds.h"
+#include "LinxTrace.h"
+
+template<typename IdentifierType>
+GenericCoalescer<IdentifierType>::GenericCoalescer(const std::shared_ptr<GenericSocket<IdentifierType>> &socket,
+                                                   uint32_t maxBatchBytes, int delayUs,
+                                                   const LinxThreadOptions &threadOptions)
+    : socket(socket), maxPayloadSize(maxBatchBytes - sizeof(uint32_t)), delay(delayUs) {
+    if (delayUs > 0) {
+        timerThread = std::thread([this, threadOptions]() {
+            if (threadOptions.applyToCurrentThread() < 0) {
+                LINX_WARNING(CLIENT, "Coalescing timer thread options not fully applied");
+            }
+            timerTask();
+        });
+    }
+}
+
+template<typename IdentifierType>
+GenericCoalescer<IdentifierType>::~GenericCoalescer() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        running = false;
+    }
+    wakeup.notify_all();
+    if (timerThread.joinable()) {
+        timerThread.join();
+    }
+    flush();
+}
+
+template<typename IdentifierType>
+int GenericCoalescer<IdentifierType>::send(const IMessage &message, const IdentifierType &to) {
+    uint32_t entrySize = LinxBatch::entryHeaderSize + message.getSize();
+    std::unique_lock<std::mutex> lock(mutex);
+
+    auto it = batches.find(to.format());
+    if (it != batches.end() && it->second.payload.size() + entrySize > maxPayloadSize) {
+        int ret = sendBatch(it->second);
+        batches.erase(it);
+        it = batches.end();
+        if (ret < 0) {
+            return ret;
+        }
+    }
+
+    if (entrySize > maxPayloadSize) {
+        lock.unlock();
+        return socket->send(message, to);
+    }
+
+    if (it == batches.end()) {
+        Batch batch{to, {}, 0, std::chrono::steady_clock::now() + delay};
+        batch.payload.reserve(maxPayloadSize);
+        it = batches.emplace(to.format(), std::move(batch)).first;
+        wakeup.notify_one();
+    }
+
+    if (!LinxBatch::append(it->second.payload, message)) {
+        LINX_ERROR_RATELIMITED(SOCKET, "IPC coalesce serialize error reqId: 0x%x to: %s", message.getReqId(), to.format().c_str());
+        return -2;
+    }
+    it->second.count++;
+    return 0;
+}
+
+template<typename IdentifierType>
+int GenericCoalescer<IdentifierType>::flush() {
+    std::lock_guard<std::mutex> lock(mutex);
+    int result = 0;
+    for (auto &[key, batch] : batches) {
+        if (int ret = sendBatch(batch); ret < 0) {
+            result = ret;
+        }
+    }
+    batches.clear();
+    return result;
+}
+
+template<typename IdentifierType>
+int GenericCoalescer<IdentifierType>::sendBatch(Batch &batch) {
+    uint32_t count = batch.count;
+    int ret = socket->send(RawMessage(IPC_BATCH_MSG, std::move(batch.payload)), batch.to);
+    if (ret < 0) {
+        LINX_ERROR_RATELIMITED(SOCKET, "IPC coalesced send error: %d, messages: %u to: %s", ret, count, batch.to.format().c_str());
+        return ret;
+    }
+    coalescedMessages.fetch_add(count, std::memory_order_relaxed);
+    coalescedBatches.fetch_add(1, std::memory_order_relaxed);
+    return 0;
+}
+
+// Sends containers whose first message waited for delay
+template<typename IdentifierType>
+void GenericCoalescer<IdentifierType>::timerTask() {
+    std::unique_lock<std::mutex> lock(mutex);
+    while (running) {
+        auto now = std::chrono::steady_clock::now();
+        auto next = std::chrono::steady_clock::time_point::max();
+        for (auto it = batches.begin(); it != batches.end();) {
+            if (it->second.deadline <= now) {
+                sendBatch(it->second);
+                it = batches.erase(it);
+            } else {
+                next = std::min(next, it->second.deadline);
+                ++it;
+            }
+        }
+
+        if (next == std::chrono::steady_clock::time_point::max()) {
+            wakeup.wait(lock);
+        } else {
+            wakeup.wait_until(lock, next);
+        }
+    }
+}
+
+template<typename IdentifierType>
+void GenericCoalescer<IdentifierType>::addMetrics(LinxMetricsSnapshot &snapshot) const {
+    snapshot.coalescedMessages += coalescedMessages.load(std::memory_order_relaxed);
+    snapshot.coalescedBatches += coalescedBatches.load(std::memory_order_relaxed);
+}
@@ -13,36 +13,53 @@
 template<typename IdentifierType>
 void GenericServer<IdentifierType>::task() {
 
-    LINX_INFO("[%s] Task started", this->getName().c_str());
+    LINX_INFO(SERVER, "[%s] Task started", this->getName().c_str());
     while (true) {
         RawMessagePtr msg{};
         std::unique_ptr<IIdentifier> from {};
+        uint64_t rxTimestamp = 0;
 
-        int ret = this->socket->receive(&msg, &from, INFINITE_TIMEOUT);
+        int ret = this->socket->receive(&msg, &from, INFINITE_TIMEOUT, &rxTimestamp);
         if (ret == 0) {
-            LINX_INFO("[%s] socket closed, Task stopping", this->getName().c_str());
+            LINX_INFO(SERVER, "[%s] socket closed, Task stopping", this->getName().c_str());
             break;
         }
         if (ret < 0) {
-            LINX_ERROR("[%s] receive error: %d, Task stopping", this->getName().c_str(), ret);
+            if (ret == LINX_DESERIALIZE_ERROR) {
+                this->metrics.onDeserializeError();
+            } else {
+                this->metrics.onReceiveError();
+            }
+            LINX_ERROR(SERVER, "[%s] receive error: %d, Task stopping", this->getName().c_str(), ret);
             break;
         }
 
+        this->metrics.onReceive(ret);
         auto reqId = msg->getReqId();
         if (reqId == IPC_PING_REQ) {
+            this->metrics.onPing();
             RawMessage rsp = RawMessage(IPC_PING_RSP);
             this->send(rsp, *from);
             continue;
         }
+        if (this->isFiltered(reqId)) {
+            this->metrics.onFilterDrop();
+            continue;
+        }
 
         auto container = std::make_unique<LinxReceivedMessage>(LinxReceivedMessage{
             .message = std::move(msg),
             .from = std::move(from),
             .server = this->weak_from_this()
         });
+        if (this->timestamping) {
+            this->stampReceived(*container, rxTimestamp);
+            container->timestamps.queueInsert = LinxMessageTimestamps::now();
+        }
         if (queue->add(std::move(container)) != 0) {
-            LINX_ERROR("[%s] Received reqId: 0x%x from: %s discarded - queue full",
-                      this->getName().c_str(), reqId, container->from->format().c_str());
+            this->metrics.onQueueDrop();
+            LINX_ERROR_RATELIMITED(SERVER, "[%s] Received reqId: 0x%x from: %s discarded - queue full",
+                                   this->getName().c_str(), reqId, container->from->format().c_str());
         }
     }
 }
@@ -68,15 +85,62 @@ bool GenericServer<IdentifierType>::start() {
         return true;
     }
 
-    LINX_INFO("[%s] Starting worker thread", this->getName().c_str());
-    workerThread = std::thread([this]() { this->task(); });
+    LINX_INFO(SERVER, "[%s] Starting worker thread", this->getName().c_str());
+    LinxThreadOptions options = threadOptions;
+    if (options.name.empty()) {
+        options.name = this->getName();
+    }
+
+    this->stopped.store(false);
+    workerThread = std::thread([this, options]() {
+        if (options.applyToCurrentThread() < 0) {
+            LINX_WARNING(SERVER, "[%s] Worker thread options not fully applied", this->getName().c_str());
+        }
+        this->task();
+    });
+    this->announce();
     return true;
 }
 
+template<typename IdentifierType>
+int GenericServer<IdentifierType>::setBusyPoll(int spinUs, bool kernelBusyPoll) {
+    auto ret = GenericSimpleServer<IdentifierType>::setBusyPoll(spinUs, kernelBusyPoll);
+    if (ret < 0) {
+        return ret;
+    }
+    queue->setSpinTime(spinUs);
+    return ret;
+}
+
+template<typename IdentifierType>
+LinxMetricsSnapshot GenericServer<IdentifierType>::getMetrics() const {
+    auto snapshot = GenericSimpleServer<IdentifierType>::getMetrics();
+    snapshot.queueDepth = queue->size();
+    snapshot.queueHighWater = queue->getHighWater();
+    return snapshot;
+}
+
+template<typename IdentifierType>
+void GenericServer<IdentifierType>::setThreadOptions(const LinxThreadOptions &options) {
+    threadOptions = options;
+}
+
+template<typename IdentifierType>
+LinxThreadOptions GenericServer<IdentifierType>::getHelperThreadOptions(const std::string &prefix) const {
+    LinxThreadOptions options = threadOptions;
+    options.name = prefix + (threadOptions.name.empty() ? this->getName() : threadOptions.name);
+    return options;
+}
+
 template<typename IdentifierType>
 void GenericServer<IdentifierType>::stop() {
+    if (this->stopped.exchange(true)) {
+        return;
+    }
+    this->withdraw();
+    this->flush();
     if (workerThread.joinable()) {
-        LINX_INFO("[%s] Stopping worker thread", this->getName().c_str());
+        LINX_INFO(SERVER, "[%s] Stopping worker thread", this->getName().c_str());
         this->socket->close();
         this->queue->stop();
         workerThread.join();
@@ -96,9 +160,32 @@ LinxReceivedMessageSharedPtr GenericServer<IdentifierType>::receive(
 
     auto recvMsg = queue->get(timeoutMs, sigsel, from);
     if (recvMsg != nullptr) {
-        LINX_DEBUG("[%s] Received reqId: 0x%x", this->getName().c_str(), recvMsg->message->getReqId());
+        if (this->timestamping) {
+            recvMsg->timestamps.consumerPickup = LinxMessageTimestamps::now();
+        }
+        LINX_DEBUG(SERVER, "[%s] Received reqId: 0x%x", this->getName().c_str(), recvMsg->message->getReqId());
         return recvMsg;
     }
 
     return recvMsg;
 }
+
+template<typename IdentifierType>
+std::vector<LinxReceivedMessageSharedPtr> GenericServer<IdentifierType>::receiveBatch(
+    size_t maxCount,
+    int timeoutMs,
+    const std::vector<uint32_t> &sigsel,
+    const IIdentifier *from) {
+
+    auto messages = queue->getBatch(maxCount, timeoutMs, sigsel, from);
+    if (this->timestamping && !messages.empty()) {
+        auto pickup = LinxMessageTimestamps::now();
+        for (auto &msg : messages) {
+            msg->timestamps.consumerPickup = pickup;
+        }
+    }
+    LINX_DEBUG(SERVER, "[%s] Received batch of %zu messages", this->getName().c_str(), messages.size());
+
+    return std::vector<LinxReceivedMessageSharedPtr>(std::make_move_iterator(messages.begin()),
+                                                     std::make_move_iterator(messages.end()));
+}
@@ -1,11 +1,14 @@
 #pragma once
 
+#include <algorithm>
 #include <cassert>
 #include "LinxIpc.h"
 #include "LinxMessageIds.h"
 #include "LinxTrace.h"
 #include "LinxMessageFilter.h"
 #include "Deadline.h"
+#include "LinxNameService.h"
+#include "GenericCoalescer.tpp"
 
 template<typename IdentifierType>
 GenericSimpleServer<IdentifierType>::GenericSimpleServer(
@@ -19,22 +22,53 @@ GenericSimpleServer<IdentifierType>::GenericSimpleServer(
 template<typename IdentifierType>
 GenericSimpleServer<IdentifierType>::~GenericSimpleServer() {
     stop();
+    coalescer.reset();
 }
 
 template<typename IdentifierType>
 bool GenericSimpleServer<IdentifierType>::start() {
     // Direct mode server doesn't need to start anything
+    stopped.store(false);
+    announce();
     return true;
 }
 
 template<typename IdentifierType>
 void GenericSimpleServer<IdentifierType>::stop() {
-    // Direct mode server doesn't need to stop anything
+    if (stopped.exchange(true)) {
+        return;
+    }
+    // Direct mode server only sends messages still waiting for coalescing
+    withdraw();
+    flush();
+}
+
+template<typename IdentifierType>
+void GenericSimpleServer<IdentifierType>::setAnnouncement(const std::shared_ptr<LinxNameResolver> &resolver,
+                                                          const std::string &serverName,
+                                                          const std::string &endpoint) {
+    announcementResolver = resolver;
+    announcementName = serverName;
+    announcementEndpoint = endpoint;
+}
+
+template<typename IdentifierType>
+void GenericSimpleServer<IdentifierType>::announce() {
+    if (announcementResolver && announcementResolver->registerName(announcementName, announcementEndpoint) < 0) {
+        LINX_ERROR(SERVER, "[%s] failed to announce %s", getName().c_str(), announcementName.c_str());
+    }
+}
+
+template<typename IdentifierType>
+void GenericSimpleServer<IdentifierType>::withdraw() {
+    if (announcementResolver) {
+        announcementResolver->unregisterName(announcementName);
+    }
 }
 
 template<typename IdentifierType>
 int GenericSimpleServer<IdentifierType>::getPollFd() const {
-    return socket->getFd();
+    return socket->getPollFd();
 }
 
 template<typename IdentifierType>
@@ -43,16 +77,20 @@ int GenericSimpleServer<IdentifierType>::send(const IMessage &message, const IId
     // Downcast to the concrete identifier type
     const auto *typedTo = dynamic_cast<const IdentifierType*>(&to);
     if (typedTo) {
-        LINX_DEBUG("[%s] Sending message to: %s, reqId: 0x%x",
+        LINX_DEBUG(SERVER, "[%s] Sending message to: %s, reqId: 0x%x",
                   getName().c_str(), typedTo->format().c_str(), message.getReqId());
-        auto ret = socket->send(message, *typedTo);
+        auto ret = coalescer ? coalescer->send(message, *typedTo) : socket->send(message, *typedTo);
         if (ret < 0) {
-            LINX_ERROR("[%s] send error: %d", getName().c_str(), ret);
+            metrics.onSendError();
+            LINX_ERROR_RATELIMITED(SERVER, "[%s] send error: %d", getName().c_str(), ret);
+        } else {
+            metrics.onSend(message.getSize());
         }
         return ret;
     }
 
-    LINX_ERROR("[%s] send failed - invalid identifier type", getName().c_str());
+    metrics.onSendError();
+    LINX_ERROR_RATELIMITED(SERVER, "[%s] send failed - invalid identifier type", getName().c_str());
     return -1;
 }
 
@@ -64,6 +102,7 @@ LinxReceivedMessageSharedPtr GenericSimpleServer<IdentifierType>::receive(
 
     RawMessagePtr msg{};
     std::unique_ptr<IIdentifier> from;
+    uint64_t rxTimestamp = 0;
 
     auto predicate = [identifier, &sigsel](const RawMessagePtr &msg, const std::unique_ptr<IIdentifier> &from) {
         return LinxMessageFilter::matchesFrom(from.get(), identifier) &&
@@ -73,36 +112,211 @@ LinxReceivedMessageSharedPtr GenericSimpleServer<IdentifierType>::receive(
     auto deadline = Deadline(timeoutMs);
     do {
         int timeout = deadline.getRemainingTimeMs();
-        int ret = socket->receive(&msg, &from, timeout);
+        int ret = socket->receive(&msg, &from, timeout, &rxTimestamp);
         if (ret == 0) {
-            LINX_DEBUG("[%s] receive timeout", getName().c_str());
+            LINX_DEBUG(SERVER, "[%s] receive timeout", getName().c_str());
             return nullptr;
         }
         if (ret < 0) {
-            LINX_ERROR("[%s] receive error: %d", getName().c_str(), ret);
+            if (ret == LINX_DESERIALIZE_ERROR) {
+                metrics.onDeserializeError();
+            } else {
+                metrics.onReceiveError();
+            }
+            LINX_ERROR_RATELIMITED(SERVER, "[%s] receive error: %d", getName().c_str(), ret);
             return nullptr;
         }
 
+        metrics.onReceive(ret);
         auto reqId = msg->getReqId();
         if (reqId == IPC_PING_REQ) {
+            metrics.onPing();
             RawMessage rsp = RawMessage(IPC_PING_RSP);
             send(rsp, *from);
             continue;
         }
+        if (isFiltered(reqId)) {
+            metrics.onFilterDrop();
+            continue;
+        }
 
         if (predicate(msg, from)) {
-            return std::make_shared<LinxReceivedMessage>(LinxReceivedMessage{
+            auto recvMsg = std::make_shared<LinxReceivedMessage>(LinxReceivedMessage{
                 .message = std::move(msg),
                 .from = std::move(from),
                 .server = this->weak_from_this()
             });
+            if (timestamping) {
+                stampReceived(*recvMsg, rxTimestamp);
+                recvMsg->timestamps.queueInsert = recvMsg->timestamps.socketDequeue;
+                recvMsg->timestamps.consumerPickup = recvMsg->timestamps.socketDequeue;
+            }
+            return recvMsg;
         }
     } while (!deadline.isExpired());
 
-    LINX_ERROR("[%s] receive timed out", getName().c_str());
+    LINX_ERROR_RATELIMITED(SERVER, "[%s] receive timed out", getName().c_str());
     return nullptr;
 }
 
+template<typename IdentifierType>
+std::vector<LinxReceivedMessageSharedPtr> GenericSimpleServer<IdentifierType>::receiveBatch(
+    size_t maxCount,
+    int timeoutMs,
+    const std::vector<uint32_t> &sigsel,
+    const IIdentifier *from) {
+
+    std::vector<LinxReceivedMessageSharedPtr> messages;
+    if (maxCount == 0) {
+        return messages;
+    }
+
+    auto msg = receive(timeoutMs, sigsel, from);
+    while (msg != nullptr) {
+        messages.push_back(std::move(msg));
+        if (messages.size() >= maxCount) {
+            break;
+        }
+        msg = receive(IMMEDIATE_TIMEOUT, sigsel, from);
+    }
+
+    return messages;
+}
+
+template<typename IdentifierType>
+int GenericSimpleServer<IdentifierType>::setTimestamping(bool enable) {
+    auto ret = socket->setTimestamping(enable);
+    if (ret < 0) {
+        LINX_ERROR(SERVER, "[%s] set timestamping error: %d", getName().c_str(), ret);
+        return ret;
+    }
+    timestamping = enable;
+    return 0;
+}
+
+template<typename IdentifierType>
+int GenericSimpleServer<IdentifierType>::setCompression(uint32_t thresholdBytes,
+                                                        const std::shared_ptr<LinxCompressor> &compressor) {
+    auto ret = socket->setCompression(thresholdBytes, compressor);
+    if (ret < 0) {
+        LINX_ERROR(SERVER, "[%s] set compression error: %d", getName().c_str(), ret);
+    }
+    return ret;
+}
+
+template<typename IdentifierType>
+int GenericSimpleServer<IdentifierType>::setChecksum(bool enable) {
+    auto ret = socket->setChecksum(enable);
+    if (ret < 0) {
+        LINX_ERROR(SERVER, "[%s] set checksum error: %d", getName().c_str(), ret);
+    }
+    return ret;
+}
+
+template<typename IdentifierType>
+int GenericSimpleServer<IdentifierType>::setFragmentation(uint32_t maxDatagramSize, int reassemblyTimeoutMs,
+                                                          size_t reassemblyMemoryLimit) {
+    auto ret = socket->setFragmentation(maxDatagramSize, reassemblyTimeoutMs, reassemblyMemoryLimit);
+    if (ret < 0) {
+        LINX_ERROR(SERVER, "[%s] set fragmentation error: %d", getName().c_str(), ret);
+    }
+    return ret;
+}
+
+template<typename IdentifierType>
+int GenericSimpleServer<IdentifierType>::setReliable(bool enable, uint32_t windowSize, int sendTimeoutMs) {
+    auto ret = socket->setReliable(enable, windowSize, sendTimeoutMs);
+    if (ret < 0) {
+        LINX_ERROR(SERVER, "[%s] set reliable error: %d", getName().c_str(), ret);
+    }
+    return ret;
+}
+
+template<typename IdentifierType>
+int GenericSimpleServer<IdentifierType>::setSignalFilter(const std::vector<uint32_t> &sigsel) {
+    std::vector<uint32_t> sorted = sigsel;
+    std::sort(sorted.begin(), sorted.end());
+    {
+        std::lock_guard<std::mutex> lock(signalFilterMutex);
+        signalFilter = std::move(sorted);
+        hasSignalFilter.store(!signalFilter.empty(), std::memory_order_release);
+    }
+
+    // Messages are still filtered in userspace when kernel filter cannot be attached
+    auto ret = socket->setSignalFilter(sigsel);
+    if (ret < 0) {
+        LINX_ERROR(SERVER, "[%s] set signal filter error: %d", getName().c_str(), ret);
+    }
+    return ret;
+}
+
+template<typename IdentifierType>
+bool GenericSimpleServer<IdentifierType>::isFiltered(uint32_t reqId) const {
+    // Internal messages pass, like in kernel filter
+    if (reqId < IPC_SIG_BASE || !hasSignalFilter.load(std::memory_order_acquire)) {
+        return false;
+    }
+    std::lock_guard<std::mutex> lock(signalFilterMutex);
+    return !signalFilter.empty() && !std::binary_search(signalFilter.begin(), signalFilter.end(), reqId);
+}
+
+template<typename IdentifierType>
+int GenericSimpleServer<IdentifierType>::setCoalescing(uint32_t maxBatchBytes, int delayUs) {
+    coalescer.reset();
+    if (maxBatchBytes == 0) {
+        return 0;
+    }
+    if (maxBatchBytes <= 2 * sizeof(uint32_t) + LinxBatch::entryHeaderSize) {
+        LINX_ERROR(SERVER, "[%s] set coalescing error, batch size: %u", getName().c_str(), maxBatchBytes);
+        return -1;
+    }
+    coalescer = std::make_unique<GenericCoalescer<IdentifierType>>(socket, maxBatchBytes, delayUs,
+                                                                   getHelperThreadOptions("co_"));
+    return 0;
+}
+
+template<typename IdentifierType>
+LinxThreadOptions GenericSimpleServer<IdentifierType>::getHelperThreadOptions(const std::string &prefix) const {
+    LinxThreadOptions options;
+    options.name = prefix + getName();
+    return options;
+}
+
+template<typename IdentifierType>
+int GenericSimpleServer<IdentifierType>::flush() {
+    auto ret = coalescer ? coalescer->flush() : 0;
+    if (ret < 0) {
+        metrics.onSendError();
+        LINX_ERROR_RATELIMITED(SERVER, "[%s] flush error: %d", getName().c_str(), ret);
+    }
+    return ret;
+}
+
+template<typename IdentifierType>
+LinxMetricsSnapshot GenericSimpleServer<IdentifierType>::getMetrics() const {
+    auto snapshot = metrics.snapshot(getName());
+    socket->addMetrics(snapshot);
+    if (coalescer) {
+        coalescer->addMetrics(snapshot);
+    }
+    return snapshot;
+}
+
+template<typename IdentifierType>
+void GenericSimpleServer<IdentifierType>::stampReceived(LinxReceivedMessage &msg, uint64_t rxTimestamp) const {
+    msg.timestamps.kernelRx = rxTimestamp;
+    msg.timestamps.socketDequeue = LinxMessageTimestamps::now();
+}
+
+template<typename IdentifierType>
+int GenericSimpleServer<IdentifierType>::setBusyPoll(int spinUs, bool kernelBusyPoll) {
+    auto ret = socket->setBusyPoll(spinUs, kernelBusyPoll);
+    if (ret < 0) {
+        LINX_ERROR(SERVER, "[%s] set busy poll error: %d", getName().c_str(), ret);
+    }
+    return ret;
+}
+
 template<typename IdentifierType>
 std::string GenericSimpleServer<IdentifierType>::getName() const {
     return serverId;
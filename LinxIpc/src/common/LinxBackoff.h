@@ -0,0 +1,23 @@
+#pragma once
+
+#include <algorithm>
+#include <random>
+
+// Exponential backoff with jitter: delay doubles from minMs up to maxMs, each returned delay is drawn
+// from [delay / 2, delay] so that clients started together do not retry in lockstep
+class LinxBackoff {
+  public:
+    LinxBackoff(int minMs, int maxMs) : delay(minMs), maxMs(maxMs) {}
+
+    int next() {
+        static thread_local std::minstd_rand gen(std::random_device{}());
+        std::uniform_int_distribution<int> dis(delay / 2, delay);
+        int jittered = dis(gen);
+        delay = std::min(delay * 2, maxMs);
+        return jittered;
+    }
+
+  private:
+    int delay;
+    const int maxMs;
+};
@@ -0,0 +1,110 @@
+#pragma once
+
+#include <cstring>
+#include <deque>
+#include <memory>
+#include <vector>
+#include <arpa/inet.h>
+#include "RawMessage.h"
+#include "LinxMessageIds.h"
+
+// Container of coalesced messages, reqId IPC_BATCH_MSG with payload of entries:
+//   frame size (4 bytes, network order), serialized message
+namespace LinxBatch {
+
+constexpr uint32_t entryHeaderSize = sizeof(uint32_t);
+
+// Serializes message at end of payload, returns false when serialization failed
+inline bool append(std::vector<uint8_t> &payload, const IMessage &message) {
+    uint32_t frameSize = message.getSize();
+    size_t offset = payload.size();
+    payload.resize(offset + entryHeaderSize + frameSize);
+
+    uint32_t written = message.serialize(payload.data() + offset + entryHeaderSize, frameSize);
+    if (written == 0) {
+        payload.resize(offset);
+        return false;
+    }
+    uint32_t size = htonl(written);
+    memcpy(payload.data() + offset, &size, sizeof(size));
+    payload.resize(offset + entryHeaderSize + written);
+    return true;
+}
+
+// Splits container into messages, returns false on malformed or empty container
+inline bool unpack(const RawMessage &batch, std::deque<RawMessagePtr> *messages) {
+    const uint8_t *data = batch.getPayload();
+    uint32_t size = batch.getPayloadSize();
+    std::deque<RawMessagePtr> unpacked;
+
+    for (uint32_t offset = 0; offset < size;) {
+        uint32_t frameSize;
+        if (size - offset < entryHeaderSize) {
+            return false;
+        }
+        memcpy(&frameSize, data + offset, sizeof(frameSize));
+        frameSize = ntohl(frameSize);
+        offset += entryHeaderSize;
+        if (frameSize > size - offset) {
+            return false;
+        }
+
+        auto message = RawMessage::deserialize(std::vector<uint8_t>(data + offset, data + offset + frameSize));
+        if (message == nullptr || message->getReqId() == IPC_BATCH_MSG) {
+            return false;
+        }
+        unpacked.push_back(std::move(message));
+        offset += frameSize;
+    }
+
+    if (unpacked.empty()) {
+        return false;
+    }
+    *messages = std::move(unpacked);
+    return true;
+}
+
+} // namespace LinxBatch
+
+// Socket side of coalescing: messages of received container are returned one by one with its sender
+// and receive time
+template<typename IdentifierType>
+class LinxUnbatcher {
+  public:
+    bool isEmpty() const {
+        return messages.empty();
+    }
+
+    // Replaces container by its messages, returns false on malformed container
+    bool push(const RawMessage &batch, const IdentifierType &sender, uint64_t rxTimestamp) {
+        if (!LinxBatch::unpack(batch, &messages)) {
+            return false;
+        }
+        this->sender = sender;
+        this->rxTimestamp = rxTimestamp;
+        return true;
+    }
+
+    // Returns serialized size of next message, must not be called when empty
+    int pop(RawMessagePtr *msg, std::unique_ptr<IIdentifier> *from, uint64_t *rxTimestamp) {
+        RawMessagePtr message = std::move(messages.front());
+        messages.pop_front();
+
+        int len = message->getSize();
+        if (from) {
+            *from = std::make_unique<IdentifierType>(sender);
+        }
+        if (rxTimestamp) {
+            *rxTimestamp = this->rxTimestamp;
+        }
+        if (msg) {
+            *msg = std::move(message);
+        }
+        return len;
+    }
+
+  private:
+    std::deque<RawMessagePtr> messages;
+    IdentifierType sender;
+    uint64_t rxTimestamp = 0;
+};
@@ -0,0 +1,179 @@
+#include <algorithm>
+#include <cstring>
+#include "LinxCompression.h"
+
+// Sequence: token (literal length << 4 | match length - minMatch), literal length extension bytes,
+// literals, 2 byte little endian offset, match length extension bytes. Extensions add 255 per byte until
+// byte below 255. Last sequence carries literals only.
+namespace {
+
+constexpr uint32_t minMatch = 4;
+constexpr uint32_t maxOffset = 65535;
+constexpr int hashBits = 12;
+
+uint32_t read32(const uint8_t *p) {
+    uint32_t value;
+    memcpy(&value, p, sizeof(value));
+    return value;
+}
+
+uint32_t hash(uint32_t value) {
+    return (value * 2654435761U) >> (32 - hashBits);
+}
+
+bool writeLength(uint8_t *&out, const uint8_t *outEnd, uint32_t length) {
+    while (length >= 255) {
+        if (out >= outEnd) {
+            return false;
+        }
+        *out++ = 255;
+        length -= 255;
+    }
+    if (out >= outEnd) {
+        return false;
+    }
+    *out++ = (uint8_t)length;
+    return true;
+}
+
+bool readLength(const uint8_t *&in, const uint8_t *inEnd, uint32_t *length) {
+    uint8_t byte;
+    do {
+        if (in >= inEnd) {
+            return false;
+        }
+        byte = *in++;
+        *length += byte;
+    } while (byte == 255);
+    return true;
+}
+
+bool writeSequence(uint8_t *&out, const uint8_t *outEnd, const uint8_t *literals, uint32_t literalLength,
+                   uint32_t offset, uint32_t matchLength) {
+    if (out >= outEnd) {
+        return false;
+    }
+    uint8_t *token = out++;
+    *token = (uint8_t)(std::min<uint32_t>(literalLength, 15) << 4);
+    if (literalLength >= 15 && !writeLength(out, outEnd, literalLength - 15)) {
+        return false;
+    }
+    if ((uint32_t)(outEnd - out) < literalLength) {
+        return false;
+    }
+    memcpy(out, literals, literalLength);
+    out += literalLength;
+
+    if (matchLength == 0) {
+        return true;
+    }
+    if (outEnd - out < 2) {
+        return false;
+    }
+    *out++ = (uint8_t)offset;
+    *out++ = (uint8_t)(offset >> 8);
+    uint32_t extra = matchLength - minMatch;
+    *token |= (uint8_t)std::min<uint32_t>(extra, 15);
+    return extra < 15 || writeLength(out, outEnd, extra - 15);
+}
+
+} // namespace
+
+uint32_t LinxLzCompressor::compress(const uint8_t *src, uint32_t srcSize, uint8_t *dst, uint32_t dstCapacity) const {
+    uint32_t table[1 << hashBits];
+    memset(table, 0, sizeof(table));
+
+    uint8_t *out = dst;
+    const uint8_t *outEnd = dst + dstCapacity;
+    uint32_t anchor = 0;
+    uint32_t pos = 0;
+
+    // Positions are stored +1 so that 0 marks empty slot
+    while (srcSize >= minMatch && pos <= srcSize - minMatch) {
+        uint32_t sequence = read32(src + pos);
+        uint32_t &slot = table[hash(sequence)];
+        uint32_t candidate = slot;
+        slot = pos + 1;
+
+        if (candidate == 0 || pos - (candidate - 1) > maxOffset || read32(src + candidate - 1) != sequence) {
+            pos++;
+            continue;
+        }
+        candidate--;
+
+        uint32_t length = minMatch;
+        while (pos + length < srcSize && src[candidate + length] == src[pos + length]) {
+            length++;
+        }
+        if (!writeSequence(out, outEnd, src + anchor, pos - anchor, pos - candidate, length)) {
+            return 0;
+        }
+        pos += length;
+        anchor = pos;
+    }
+
+    if (!writeSequence(out, outEnd, src + anchor, srcSize - anchor, 0, 0)) {
+        return 0;
+    }
+    return out - dst;
+}
+
+bool LinxLzCompressor::decompress(const uint8_t *src, uint32_t srcSize, uint8_t *dst, uint32_t dstSize) const {
+    const uint8_t *in = src;
+    const uint8_t *inEnd = src + srcSize;
+    uint8_t *out = dst;
+    uint8_t *outEnd = dst + dstSize;
+
+    while (in < inEnd) {
+        uint8_t token = *in++;
+        uint32_t literalLength = token >> 4;
+        if (literalLength == 15 && !readLength(in, inEnd, &literalLength)) {
+            return false;
+        }
+        if ((uint32_t)(inEnd - in) < literalLength || (uint32_t)(outEnd - out) < literalLength) {
+            return false;
+        }
+        memcpy(out, in, literalLength);
+        in += literalLength;
+        out += literalLength;
+
+        if (in == inEnd) {
+            break;
+        }
+        if (inEnd - in < 2) {
+            return false;
+        }
+        uint32_t offset = in[0] | (in[1] << 8);
+        in += 2;
+        uint32_t matchLength = token & 0x0f;
+        if (matchLength == 15 && !readLength(in, inEnd, &matchLength)) {
+            return false;
+        }
+        matchLength += minMatch;
+        if (offset == 0 || offset > (uint32_t)(out - dst) || (uint32_t)(outEnd - out) < matchLength) {
+            return false;
+        }
+
+        // Overlapping match (offset below length) repeats pattern, copied byte by byte
+        const uint8_t *match = out - offset;
+        if (offset >= matchLength) {
+            memcpy(out, match, matchLength);
+        } else {
+            for (uint32_t i = 0; i < matchLength; i++) {
+                out[i] = match[i];
+            }
+        }
+        out += matchLength;
+    }
+    return out == outEnd;
+}
+
+// Every length extension byte adds at most 255 output bytes, other input bytes expand less
+uint64_t LinxLzCompressor::maxDecompressedSize(uint32_t srcSize) const {
+    return (uint64_t)srcSize * 255 + 255;
+}
+
+std::shared_ptr<LinxCompressor> LinxLzCompressor::instance() {
+    static auto compressor = std::make_shared<LinxLzCompressor>();
+    return compressor;
+}
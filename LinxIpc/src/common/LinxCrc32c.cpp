@@ -0,0 +1,150 @@
+#include <array>
+#include <cstring>
+#include "LinxCrc32c.h"
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <nmmintrin.h>
+#define LINX_CRC32C_X86 1
+#elif defined(__aarch64__) && defined(__linux__)
+#include <arm_acle.h>
+#include <sys/auxv.h>
+#include <asm/hwcap.h>
+#define LINX_CRC32C_ARM 1
+#endif
+
+namespace {
+
+// Reflected Castagnoli polynomial
+constexpr uint32_t polynomial = 0x82F63B78;
+
+using Tables = std::array<std::array<uint32_t, 256>, 8>;
+
+// Slicing-by-8: tables[k][b] is CRC of byte b followed by k zero bytes
+constexpr Tables makeTables() {
+    Tables tables{};
+    for (uint32_t i = 0; i < 256; i++) {
+        uint32_t crc = i;
+        for (int bit = 0; bit < 8; bit++) {
+            crc = (crc >> 1) ^ ((crc & 1) ? polynomial : 0);
+        }
+        tables[0][i] = crc;
+    }
+    for (uint32_t i = 0; i < 256; i++) {
+        for (size_t k = 1; k < tables.size(); k++) {
+            tables[k][i] = (tables[k - 1][i] >> 8) ^ tables[0][tables[k - 1][i] & 0xFF];
+        }
+    }
+    return tables;
+}
+
+constexpr Tables tables = makeTables();
+
+// Operates on inverted crc, inversion is done by caller
+uint32_t updateSoftware(const uint8_t *p, size_t size, uint32_t crc) {
+    for (; size >= 8; p += 8, size -= 8) {
+        uint32_t low;
+        uint32_t high;
+        memcpy(&low, p, sizeof(low));
+        memcpy(&high, p + 4, sizeof(high));
+#if __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+        low = __builtin_bswap32(low);
+        high = __builtin_bswap32(high);
+#endif
+        low ^= crc;
+        crc = tables[7][low & 0xFF] ^ tables[6][(low >> 8) & 0xFF] ^ tables[5][(low >> 16) & 0xFF] ^
+              tables[4][low >> 24] ^ tables[3][high & 0xFF] ^ tables[2][(high >> 8) & 0xFF] ^
+              tables[1][(high >> 16) & 0xFF] ^ tables[0][high >> 24];
+    }
+    for (; size > 0; p++, size--) {
+        crc = (crc >> 8) ^ tables[0][(crc ^ *p) & 0xFF];
+    }
+    return crc;
+}
+
+#if defined(LINX_CRC32C_X86)
+
+__attribute__((target("sse4.2"))) uint32_t updateHardware(const uint8_t *p, size_t size, uint32_t crc) {
+#if defined(__x86_64__)
+    uint64_t crc64 = crc;
+    for (; size >= 8; p += 8, size -= 8) {
+        uint64_t value;
+        memcpy(&value, p, sizeof(value));
+        crc64 = _mm_crc32_u64(crc64, value);
+    }
+    crc = static_cast<uint32_t>(crc64);
+#endif
+    for (; size >= 4; p += 4, size -= 4) {
+        uint32_t value;
+        memcpy(&value, p, sizeof(value));
+        crc = _mm_crc32_u32(crc, value);
+    }
+    for (; size > 0; p++, size--) {
+        crc = _mm_crc32_u8(crc, *p);
+    }
+    return crc;
+}
+
+bool hasHardware() {
+    return __builtin_cpu_supports("sse4.2");
+}
+
+#elif defined(LINX_CRC32C_ARM)
+
+#if defined(__clang__)
+__attribute__((target("crc")))
+#else
+__attribute__((target("+crc")))
+#endif
+uint32_t updateHardware(const uint8_t *p, size_t size, uint32_t crc) {
+    for (; size >= 8; p += 8, size -= 8) {
+        uint64_t value;
+        memcpy(&value, p, sizeof(value));
+        crc = __crc32cd(crc, value);
+    }
+    for (; size > 0; p++, size--) {
+        crc = __crc32cb(crc, *p);
+    }
+    return crc;
+}
+
+bool hasHardware() {
+    return (getauxval(AT_HWCAP) & HWCAP_CRC32) != 0;
+}
+
+#else
+
+uint32_t updateHardware(const uint8_t *p, size_t size, uint32_t crc) {
+    return updateSoftware(p, size, crc);
+}
+
+bool hasHardware() {
+    return false;
+}
+
+#endif
+
+using Update = uint32_t (*)(const uint8_t *p, size_t size, uint32_t crc);
+
+// CPU is checked once, on first use
+Update selectedUpdate() {
+    static const Update update = hasHardware() ? updateHardware : updateSoftware;
+    return update;
+}
+
+} // namespace
+
+namespace LinxCrc32c {
+
+uint32_t compute(const void *data, size_t size, uint32_t crc) {
+    return ~selectedUpdate()(static_cast<const uint8_t *>(data), size, ~crc);
+}
+
+uint32_t computeSoftware(const void *data, size_t size, uint32_t crc) {
+    return ~updateSoftware(static_cast<const uint8_t *>(data), size, ~crc);
+}
+
+bool isHardwareAccelerated() {
+    return selectedUpdate() != updateSoftware;
+}
+
+} // namespace LinxCrc32c
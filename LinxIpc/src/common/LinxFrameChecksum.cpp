@@ -0,0 +1,31 @@
+#include <arpa/inet.h>
+#include <cstring>
+#include "LinxFrameChecksum.h"
+#include "LinxCrc32c.h"
+
+uint32_t LinxFrameChecksum::append(uint8_t *frame, uint32_t frameSize) const {
+    uint32_t crc = htonl(LinxCrc32c::compute(frame, frameSize));
+    memcpy(frame + frameSize, &crc, sizeof(crc));
+    return frameSize + trailerSize;
+}
+
+bool LinxFrameChecksum::verify(std::vector<uint8_t> &frame) {
+    uint32_t crc;
+    if (frame.size() < trailerSize) {
+        errors.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+
+    size_t frameSize = frame.size() - trailerSize;
+    memcpy(&crc, frame.data() + frameSize, sizeof(crc));
+    if (ntohl(crc) != LinxCrc32c::compute(frame.data(), frameSize)) {
+        errors.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+    frame.resize(frameSize);
+    return true;
+}
+
+void LinxFrameChecksum::addMetrics(LinxMetricsSnapshot &snapshot) const {
+    snapshot.checksumErrors += errors.load(std::memory_order_relaxed);
+}
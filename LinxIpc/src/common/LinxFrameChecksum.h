@@ -0,0 +1,33 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <vector>
+#include "LinxMetrics.h"
+
+// Socket side of payload integrity check. Frame with checksum:
+//   frame (possibly compressed), CRC32C of frame (4 bytes, network order)
+// Both peers must enable checksum, frames without valid trailer are dropped by receiver
+class LinxFrameChecksum {
+  public:
+    static constexpr uint32_t trailerSize = sizeof(uint32_t);
+
+    void configure(bool enable) {
+        enabled.store(enable, std::memory_order_relaxed);
+    }
+
+    bool isEnabled() const {
+        return enabled.load(std::memory_order_relaxed);
+    }
+
+    // Writes trailer behind frameSize bytes of frame, which must have trailerSize bytes of room.
+    // Returns size of frame with trailer.
+    uint32_t append(uint8_t *frame, uint32_t frameSize) const;
+    // Checks and removes trailer, returns false and counts error when checksum does not match
+    bool verify(std::vector<uint8_t> &frame);
+    void addMetrics(LinxMetricsSnapshot &snapshot) const;
+
+  private:
+    std::atomic<bool> enabled{false};
+    std::atomic<uint64_t> errors{0};
+};
@@ -0,0 +1,67 @@
+#include <arpa/inet.h>
+#include <cstring>
+#include "LinxFrameCompression.h"
+
+void LinxFrameCompression::configure(uint32_t thresholdBytes, const std::shared_ptr<LinxCompressor> &compressor) {
+    std::atomic_store(&this->compressor, compressor ? compressor : LinxLzCompressor::instance());
+    this->threshold.store(thresholdBytes, std::memory_order_release);
+}
+
+bool LinxFrameCompression::compress(const uint8_t *frame, uint32_t frameSize, std::vector<uint8_t> &out) const {
+    uint32_t payloadSize = frameSize - sizeof(uint32_t);
+    uint32_t minPayloadSize = threshold.load(std::memory_order_acquire);
+    if (minPayloadSize == 0 || payloadSize < minPayloadSize || frameSize <= headerSize) {
+        return false;
+    }
+    auto codec = std::atomic_load(&compressor);
+
+    // Compressed frame must be smaller than original one
+    out.resize(frameSize - 1);
+    uint32_t compressedSize = codec->compress(frame + sizeof(uint32_t), payloadSize, out.data() + headerSize,
+                                              frameSize - 1 - headerSize);
+    if (compressedSize == 0) {
+        return false;
+    }
+
+    uint32_t reqId;
+    memcpy(&reqId, frame, sizeof(reqId));
+    reqId |= htonl(LINX_COMPRESSED_FLAG);
+    uint32_t netPayloadSize = htonl(payloadSize);
+    memcpy(out.data(), &reqId, sizeof(reqId));
+    memcpy(out.data() + sizeof(reqId), &netPayloadSize, sizeof(netPayloadSize));
+    out.resize(headerSize + compressedSize);
+    return true;
+}
+
+RawMessagePtr LinxFrameCompression::decode(std::vector<uint8_t> &&frame) const {
+    uint32_t reqId;
+    if (!isEnabled() || frame.size() < sizeof(reqId)) {
+        return RawMessage::deserialize(std::move(frame));
+    }
+
+    memcpy(&reqId, frame.data(), sizeof(reqId));
+    reqId = ntohl(reqId);
+    if ((reqId & LINX_COMPRESSED_FLAG) == 0) {
+        return RawMessage::deserialize(std::move(frame));
+    }
+
+    uint32_t payloadSize;
+    if (frame.size() < headerSize) {
+        return nullptr;
+    }
+    memcpy(&payloadSize, frame.data() + sizeof(reqId), sizeof(payloadSize));
+    payloadSize = ntohl(payloadSize);
+    // Claimed size is checked against what compressed data can expand to, so that small datagram can not force
+    // large allocation
+    auto codec = std::atomic_load(&compressor);
+    if (payloadSize > LINX_MAX_DECOMPRESSED_SIZE || payloadSize > codec->maxDecompressedSize(frame.size() - headerSize)) {
+        return nullptr;
+    }
+
+    // Decompressed directly into payload of returned message
+    std::vector<uint8_t> payload(payloadSize);
+    if (!codec->decompress(frame.data() + headerSize, frame.size() - headerSize, payload.data(), payloadSize)) {
+        return nullptr;
+    }
+    return std::make_unique<RawMessage>(reqId & ~LINX_COMPRESSED_FLAG, std::move(payload));
+}
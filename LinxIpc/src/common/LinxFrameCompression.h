@@ -0,0 +1,34 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include "LinxCompression.h"
+#include "RawMessage.h"
+
+// Socket side of payload compression. Compressed frame:
+//   reqId | LINX_COMPRESSED_FLAG (4 bytes, network order), payload size (4 bytes, network order), compressed payload
+// Frames below threshold, or not getting smaller, are sent unchanged
+class LinxFrameCompression {
+  public:
+    static constexpr uint32_t headerSize = 2 * sizeof(uint32_t);
+
+    // thresholdBytes 0 disables compression, compressor nullptr selects built-in LZ codec.
+    // Can be called while other threads compress and decode, frames in flight may use previous settings.
+    void configure(uint32_t thresholdBytes, const std::shared_ptr<LinxCompressor> &compressor);
+
+    bool isEnabled() const {
+        return threshold.load(std::memory_order_acquire) != 0;
+    }
+
+    // Returns true and fills out when frame (serialized message) should be sent compressed
+    bool compress(const uint8_t *frame, uint32_t frameSize, std::vector<uint8_t> &out) const;
+    // Compressed frames are decoded only when compression is enabled, nullptr on malformed frame
+    RawMessagePtr decode(std::vector<uint8_t> &&frame) const;
+
+  private:
+    // Compressor is stored (std::atomic_store) before threshold enabling it is published
+    std::atomic<uint32_t> threshold{0};
+    std::shared_ptr<LinxCompressor> compressor;
+};
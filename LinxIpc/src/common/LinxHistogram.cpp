@@ -0,0 +1,205 @@
+#include <algorithm>
+#include <cmath>
+#include "LinxHistogram.h"
+
+namespace {
+
+constexpr uint8_t magic[] = {'L', 'X', 'H', '1'};
+
+void putVarint(std::vector<uint8_t> &out, uint64_t value) {
+    while (value >= 0x80) {
+        out.push_back((uint8_t)(value | 0x80));
+        value >>= 7;
+    }
+    out.push_back((uint8_t)value);
+}
+
+bool getVarint(const uint8_t *&data, const uint8_t *end, uint64_t *value) {
+    *value = 0;
+    for (int shift = 0; shift < 64 && data < end; shift += 7) {
+        uint8_t byte = *data++;
+        *value |= (uint64_t)(byte & 0x7f) << shift;
+        if ((byte & 0x80) == 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void atomicMin(std::atomic<uint64_t> &target, uint64_t value) {
+    uint64_t current = target.load(std::memory_order_relaxed);
+    while (value < current && !target.compare_exchange_weak(current, value, std::memory_order_relaxed)) {
+    }
+}
+
+void atomicMax(std::atomic<uint64_t> &target, uint64_t value) {
+    uint64_t current = target.load(std::memory_order_relaxed);
+    while (value > current && !target.compare_exchange_weak(current, value, std::memory_order_relaxed)) {
+    }
+}
+
+} // namespace
+
+size_t LinxHistogram::bucketIndex(uint64_t value) {
+    // Values below 2 * subBucketHalf map 1:1, above that every power of two range is split
+    // into subBucketHalf buckets
+    if (value < 2 * subBucketHalf) {
+        return value;
+    }
+    int shift = 63 - __builtin_clzll(value) - subBucketBits;
+    return shift * subBucketHalf + (value >> shift);
+}
+
+uint64_t LinxHistogram::highestEquivalentValue(size_t index) {
+    if (index < 2 * subBucketHalf) {
+        return index;
+    }
+    int shift = index / subBucketHalf - 1;
+    uint64_t sub = index - shift * subBucketHalf;
+    return (sub << shift) + (1ULL << shift) - 1;
+}
+
+void LinxHistogram::record(uint64_t value) {
+    value = std::min(value, maxValue);
+    counts[bucketIndex(value)].fetch_add(1, std::memory_order_relaxed);
+    totalCount.fetch_add(1, std::memory_order_relaxed);
+    sum.fetch_add(value, std::memory_order_relaxed);
+    atomicMin(minValue, value);
+    atomicMax(maxRecorded, value);
+}
+
+void LinxHistogram::merge(const LinxHistogram &other) {
+    uint64_t merged = 0;
+    for (size_t i = 0; i < bucketCount; i++) {
+        uint64_t count = other.counts[i].load(std::memory_order_relaxed);
+        if (count != 0) {
+            counts[i].fetch_add(count, std::memory_order_relaxed);
+            merged += count;
+        }
+    }
+    if (merged == 0) {
+        return;
+    }
+    totalCount.fetch_add(merged, std::memory_order_relaxed);
+    sum.fetch_add(other.sum.load(std::memory_order_relaxed), std::memory_order_relaxed);
+    atomicMin(minValue, other.minValue.load(std::memory_order_relaxed));
+    atomicMax(maxRecorded, other.maxRecorded.load(std::memory_order_relaxed));
+}
+
+void LinxHistogram::reset() {
+    for (auto &count : counts) {
+        count.store(0, std::memory_order_relaxed);
+    }
+    totalCount.store(0, std::memory_order_relaxed);
+    sum.store(0, std::memory_order_relaxed);
+    minValue.store(UINT64_MAX, std::memory_order_relaxed);
+    maxRecorded.store(0, std::memory_order_relaxed);
+}
+
+uint64_t LinxHistogram::getCount() const {
+    return totalCount.load(std::memory_order_relaxed);
+}
+
+uint64_t LinxHistogram::getMin() const {
+    return getCount() ? minValue.load(std::memory_order_relaxed) : 0;
+}
+
+uint64_t LinxHistogram::getMax() const {
+    return maxRecorded.load(std::memory_order_relaxed);
+}
+
+double LinxHistogram::getMean() const {
+    uint64_t count = getCount();
+    return count ? (double)sum.load(std::memory_order_relaxed) / count : 0.0;
+}
+
+uint64_t LinxHistogram::valueAtPercentile(double percentile) const {
+    uint64_t count = getCount();
+    if (count == 0) {
+        return 0;
+    }
+
+    percentile = std::clamp(percentile, 0.0, 100.0);
+    uint64_t target = std::max<uint64_t>(1, (uint64_t)std::ceil(percentile / 100.0 * count));
+
+    uint64_t seen = 0;
+    for (size_t i = 0; i < bucketCount; i++) {
+        seen += counts[i].load(std::memory_order_relaxed);
+        if (seen >= target) {
+            return std::min(highestEquivalentValue(i), getMax());
+        }
+    }
+    return getMax();
+}
+
+std::vector<uint8_t> LinxHistogram::serialize() const {
+    std::vector<uint8_t> out(std::begin(magic), std::end(magic));
+
+    std::vector<std::pair<size_t, uint64_t>> buckets;
+    uint64_t count = 0;
+    for (size_t i = 0; i < bucketCount; i++) {
+        uint64_t bucket = counts[i].load(std::memory_order_relaxed);
+        if (bucket != 0) {
+            buckets.emplace_back(i, bucket);
+            count += bucket;
+        }
+    }
+
+    // Total is taken from buckets so that serialized form stays consistent during concurrent record()
+    putVarint(out, count);
+    putVarint(out, sum.load(std::memory_order_relaxed));
+    putVarint(out, getMin());
+    putVarint(out, getMax());
+    putVarint(out, buckets.size());
+
+    size_t previous = 0;
+    for (const auto &[index, bucket] : buckets) {
+        putVarint(out, index - previous);
+        putVarint(out, bucket);
+        previous = index;
+    }
+    return out;
+}
+
+std::unique_ptr<LinxHistogram> LinxHistogram::deserialize(const uint8_t *data, size_t size) {
+    if (data == nullptr || size < sizeof(magic) || !std::equal(std::begin(magic), std::end(magic), data)) {
+        return nullptr;
+    }
+
+    const uint8_t *end = data + size;
+    data += sizeof(magic);
+
+    uint64_t count, total, min, max, buckets;
+    if (!getVarint(data, end, &count) || !getVarint(data, end, &total) || !getVarint(data, end, &min) ||
+        !getVarint(data, end, &max) || !getVarint(data, end, &buckets) || buckets > bucketCount) {
+        return nullptr;
+    }
+
+    auto histogram = std::make_unique<LinxHistogram>();
+    uint64_t index = 0;
+    uint64_t seen = 0;
+    for (uint64_t i = 0; i < buckets; i++) {
+        uint64_t delta, bucket;
+        if (!getVarint(data, end, &delta) || !getVarint(data, end, &bucket)) {
+            return nullptr;
+        }
+        index += delta;
+        if ((i > 0 && delta == 0) || index >= bucketCount || bucket == 0) {
+            return nullptr;
+        }
+        histogram->counts[index].store(bucket, std::memory_order_relaxed);
+        seen += bucket;
+    }
+
+    if (data != end || seen != count) {
+        return nullptr;
+    }
+
+    histogram->totalCount.store(count, std::memory_order_relaxed);
+    histogram->sum.store(total, std::memory_order_relaxed);
+    if (count != 0) {
+        histogram->minValue.store(min, std::memory_order_relaxed);
+        histogram->maxRecorded.store(max, std::memory_order_relaxed);
+    }
+    return histogram;
+}
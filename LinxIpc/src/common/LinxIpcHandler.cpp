@@ -1,8 +1,11 @@
+#include <algorithm>
 #include <cassert>
+#include <chrono>
 #include <stdio.h>
 #include "LinxIpc.h"
 #include "LinxTrace.h"
 #include "IIdentifier.h"
+#include "LinxHistogram.h"
 
 // LinxReceivedMessage::sendResponse implementation
 int LinxReceivedMessage::sendResponse(const IMessage &response) const {
@@ -22,26 +25,95 @@ LinxIpcHandler::~LinxIpcHandler() {
 }
 
 LinxIpcHandler& LinxIpcHandler::registerCallback(uint32_t reqId, const LinxIpcCallback &callback, void *data) {
-    IpcContainer container{callback, data};
-    handlers[reqId] = container;
+    auto &container = handlers[reqId];
+    container.callback = callback;
+    container.data = data;
     return *this;
 }
+
+LinxIpcHandler& LinxIpcHandler::setHandlerHistogram(uint32_t reqId, const std::shared_ptr<LinxHistogram> &histogram) {
+    auto it = handlers.find(reqId);
+    if (it == handlers.end()) {
+        LINX_ERROR(HANDLER, "No handler for request ID: 0x%x, histogram not set", reqId);
+        return *this;
+    }
+    it->second.histogram = histogram;
+    return *this;
+}
+
+std::shared_ptr<LinxHistogram> LinxIpcHandler::getHandlerHistogram(uint32_t reqId) const {
+    auto it = handlers.find(reqId);
+    return it != handlers.end() ? it->second.histogram : nullptr;
+}
+
+int LinxIpcHandler::dispatch(const LinxReceivedMessageSharedPtr &msg) {
+    auto reqId = msg->message->getReqId();
+    auto it = handlers.find(reqId);
+    if (it != handlers.end()) {
+        IpcContainer &container = it->second;
+        if (!container.histogram) {
+            return invoke(container, msg);
+        }
+
+        auto start = std::chrono::steady_clock::now();
+        int ret = invoke(container, msg);
+        auto elapsed = std::chrono::steady_clock::now() - start;
+        container.histogram->record(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count());
+        return ret;
+    } else {
+        LINX_ERROR_RATELIMITED(HANDLER, "No handler for request ID: 0x%x", reqId);
+        return 0;
+    }
+}
+
+int LinxIpcHandler::invoke(const IpcContainer &container, const LinxReceivedMessageSharedPtr &msg) {
+    if (msg->timestamps.consumerPickup == 0) {
+        return container.callback(msg, container.data);
+    }
+
+    msg->timestamps.handlerStart = LinxMessageTimestamps::now();
+    int ret = container.callback(msg, container.data);
+    msg->timestamps.handlerDone = LinxMessageTimestamps::now();
+    return ret;
+}
+
 int LinxIpcHandler::handleMessage(int timeoutMs) {
     auto recvMsg = receive(timeoutMs, LINX_ANY_SIG, LINX_ANY_FROM);
     if (recvMsg) {
-        auto reqId = recvMsg->message->getReqId();
-        auto it = handlers.find(reqId);
-        if (it != handlers.end()) {
-            IpcContainer &container = it->second;
-            return container.callback(recvMsg, container.data);
-        } else {
-            LINX_ERROR("No handler for request ID: 0x%x", reqId);
-            return 0;
-        }
+        return dispatch(recvMsg);
     }
     return -1;// Indicate no message handled
 }
 
+size_t LinxIpcHandler::handleMessages(size_t maxCount, int timeBudgetUs) {
+    if (timeBudgetUs == INFINITE_TIMEOUT) {
+        auto messages = receiveBatch(maxCount, IMMEDIATE_TIMEOUT, LINX_ANY_SIG, LINX_ANY_FROM);
+        for (const auto &msg : messages) {
+            dispatch(msg);
+        }
+        return messages.size();
+    }
+
+    // With a time budget messages are taken one by one, so that messages not dispatched when budget runs out
+    // stay in the queue, in order and signaled by getPollFd()
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::microseconds(timeBudgetUs);
+    size_t handled = 0;
+    while (handled < maxCount) {
+        auto msg = receive(IMMEDIATE_TIMEOUT, LINX_ANY_SIG, LINX_ANY_FROM);
+        if (!msg) {
+            break;
+        }
+
+        dispatch(msg);
+        handled++;
+
+        if (std::chrono::steady_clock::now() >= deadline) {
+            break;
+        }
+    }
+    return handled;
+}
+
 bool LinxIpcHandler::start() {
     return server->start();
 }
@@ -60,6 +132,12 @@ LinxReceivedMessageSharedPtr LinxIpcHandler::receive(int timeoutMs,
     return server->receive(timeoutMs, sigsel, from);
 }
 
+std::vector<LinxReceivedMessageSharedPtr> LinxIpcHandler::receiveBatch(size_t maxCount, int timeoutMs,
+                                      const std::vector<uint32_t> &sigsel,
+                                      const IIdentifier *from) {
+    return server->receiveBatch(maxCount, timeoutMs, sigsel, from);
+}
+
 int LinxIpcHandler::send(const IMessage &message, const IIdentifier &to) {
     return server->send(message, to);
 }
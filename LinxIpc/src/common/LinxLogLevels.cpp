@@ -0,0 +1,100 @@
+#include <cstdlib>
+#include <sstream>
+#include "LinxLogLevels.h"
+#include "LinxTrace.h"
+
+namespace {
+
+const char *moduleNames[] = {"queue", "socket", "server", "client", "handler", "general"};
+static_assert(sizeof(moduleNames) / sizeof(moduleNames[0]) == static_cast<int>(LinxLogModule::COUNT));
+
+bool parseLevel(const std::string &text, int *severity) {
+    char *end = nullptr;
+    long value = strtol(text.c_str(), &end, 10);
+    if (text.empty() || *end != '\0' || value < 0 || value > SEVERITY_DEBUG) {
+        return false;
+    }
+    *severity = static_cast<int>(value);
+    return true;
+}
+
+int defaultLevel() {
+    int severity = TRACE_LEVEL;
+    if (const char *envLevel = getenv("LOG_LEVEL")) {
+        parseLevel(envLevel, &severity);
+    }
+    return severity;
+}
+
+} // namespace
+
+std::atomic<int> LinxLogLevels::levels[static_cast<int>(LinxLogModule::COUNT)] = {
+    defaultLevel(), defaultLevel(), defaultLevel(), defaultLevel(), defaultLevel(), defaultLevel(),
+};
+
+namespace {
+
+// Defined after levels so that environment overrides are applied on top of default level
+struct EnvironmentLevels {
+    EnvironmentLevels() {
+        if (const char *envLevels = getenv("LINX_LOG_LEVELS")) {
+            LinxLogLevels::configure(envLevels);
+        }
+    }
+} environmentLevels;
+
+} // namespace
+
+int LinxLogLevels::get(LinxLogModule module) {
+    if (module < LinxLogModule::QUEUE || module >= LinxLogModule::COUNT) {
+        return -1;
+    }
+    return levels[static_cast<int>(module)].load(std::memory_order_relaxed);
+}
+
+int LinxLogLevels::set(LinxLogModule module, int severity) {
+    if (module < LinxLogModule::QUEUE || module >= LinxLogModule::COUNT || severity < 0 || severity > SEVERITY_DEBUG) {
+        return -1;
+    }
+    levels[static_cast<int>(module)].store(severity, std::memory_order_relaxed);
+    return 0;
+}
+
+int LinxLogLevels::setAll(int severity) {
+    if (severity < 0 || severity > SEVERITY_DEBUG) {
+        return -1;
+    }
+    for (auto &level : levels) {
+        level.store(severity, std::memory_order_relaxed);
+    }
+    return 0;
+}
+
+int LinxLogLevels::configure(const std::string &levelsSpec) {
+    int result = 0;
+    std::stringstream stream(levelsSpec);
+
+    for (std::string entry; std::getline(stream, entry, ',');) {
+        size_t separator = entry.find('=');
+        std::string name = separator == std::string::npos ? "all" : entry.substr(0, separator);
+        int severity;
+        if (!parseLevel(separator == std::string::npos ? entry : entry.substr(separator + 1), &severity)) {
+            result = -1;
+            continue;
+        }
+
+        if (name == "all") {
+            setAll(severity);
+            continue;
+        }
+
+        int module = 0;
+        while (module < static_cast<int>(LinxLogModule::COUNT) && name != moduleNames[module]) {
+            module++;
+        }
+        if (set(static_cast<LinxLogModule>(module), severity) != 0) {
+            result = -1;
+        }
+    }
+    return result;
+}
@@ -0,0 +1,138 @@
+#include <cstdio>
+#include <cstdlib>
+#include <sstream>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "LinxMetrics.h"
+#include "LinxTrace.h"
+
+namespace {
+
+struct MetricInfo {
+    const char *name;
+    const char *type;
+    const char *help;
+    uint64_t LinxMetricsSnapshot::*field;
+};
+
+const MetricInfo metricInfos[] = {
+    {"linx_rx_messages_total", "counter", "Messages received", &LinxMetricsSnapshot::rxMessages},
+    {"linx_rx_bytes_total", "counter", "Bytes received", &LinxMetricsSnapshot::rxBytes},
+    {"linx_tx_messages_total", "counter", "Messages sent", &LinxMetricsSnapshot::txMessages},
+    {"linx_tx_bytes_total", "counter", "Bytes sent", &LinxMetricsSnapshot::txBytes},
+    {"linx_send_errors_total", "counter", "Send failures", &LinxMetricsSnapshot::sendErrors},
+    {"linx_receive_errors_total", "counter", "Socket receive failures", &LinxMetricsSnapshot::receiveErrors},
+    {"linx_deserialize_errors_total", "counter", "Received datagrams that could not be deserialized", &LinxMetricsSnapshot::deserializeErrors},
+    {"linx_queue_drops_total", "counter", "Messages dropped on full queue", &LinxMetricsSnapshot::queueDrops},
+    {"linx_pings_total", "counter", "Ping requests answered", &LinxMetricsSnapshot::pings},
+    {"linx_filter_drops_total", "counter", "Messages outside signal filter dropped in userspace", &LinxMetricsSnapshot::filterDrops},
+    {"linx_queue_depth", "gauge", "Current queue depth", &LinxMetricsSnapshot::queueDepth},
+    {"linx_queue_high_water", "gauge", "Highest queue depth seen", &LinxMetricsSnapshot::queueHighWater},
+    {"linx_fragments_sent_total", "counter", "UDP fragments sent", &LinxMetricsSnapshot::fragmentsSent},
+    {"linx_fragments_received_total", "counter", "UDP fragments received", &LinxMetricsSnapshot::fragmentsReceived},
+    {"linx_reassembled_messages_total", "counter", "Messages reassembled from fragments", &LinxMetricsSnapshot::reassembledMessages},
+    {"linx_reassembly_timeouts_total", "counter", "Incomplete messages dropped on timeout", &LinxMetricsSnapshot::reassemblyTimeouts},
+    {"linx_reassembly_drops_total", "counter", "Fragments and incomplete messages dropped", &LinxMetricsSnapshot::reassemblyDrops},
+    {"linx_retransmits_total", "counter", "Reliable datagrams retransmitted", &LinxMetricsSnapshot::retransmits},
+    {"linx_duplicates_received_total", "counter", "Duplicate reliable datagrams discarded", &LinxMetricsSnapshot::duplicatesReceived},
+    {"linx_delivery_failures_total", "counter", "Reliable datagrams never acknowledged", &LinxMetricsSnapshot::deliveryFailures},
+    {"linx_coalesced_messages_total", "counter", "Messages sent inside coalesced containers", &LinxMetricsSnapshot::coalescedMessages},
+    {"linx_coalesced_batches_total", "counter", "Coalesced containers sent", &LinxMetricsSnapshot::coalescedBatches},
+    {"linx_checksum_errors_total", "counter", "Frames dropped on checksum mismatch", &LinxMetricsSnapshot::checksumErrors},
+    {"linx_unsubscribed_drops_total", "counter", "Messages of topics not subscribed dropped", &LinxMetricsSnapshot::unsubscribedDrops},
+    {"linx_unrouted_drops_total", "counter", "Messages from senders without pooled client dropped", &LinxMetricsSnapshot::unroutedDrops},
+};
+
+std::string escapeLabel(const std::string &value) {
+    std::string escaped;
+    escaped.reserve(value.size());
+    for (char c : value) {
+        if (c == '\\' || c == '"') {
+            escaped += '\\';
+            escaped += c;
+        } else if (c == '\n') {
+            escaped += "\\n";
+        } else {
+            escaped += c;
+        }
+    }
+    return escaped;
+}
+
+} // namespace
+
+LinxMetricsSnapshot LinxMetrics::snapshot(const std::string &name) const {
+    LinxMetricsSnapshot snapshot{};
+    snapshot.name = name;
+    snapshot.rxMessages = rxMessages.load(std::memory_order_relaxed);
+    snapshot.rxBytes = rxBytes.load(std::memory_order_relaxed);
+    snapshot.txMessages = txMessages.load(std::memory_order_relaxed);
+    snapshot.txBytes = txBytes.load(std::memory_order_relaxed);
+    snapshot.sendErrors = sendErrors.load(std::memory_order_relaxed);
+    snapshot.receiveErrors = receiveErrors.load(std::memory_order_relaxed);
+    snapshot.deserializeErrors = deserializeErrors.load(std::memory_order_relaxed);
+    snapshot.queueDrops = queueDrops.load(std::memory_order_relaxed);
+    snapshot.pings = pings.load(std::memory_order_relaxed);
+    snapshot.filterDrops = filterDrops.load(std::memory_order_relaxed);
+    return snapshot;
+}
+
+void LinxMetrics::reset() {
+    rxMessages.store(0, std::memory_order_relaxed);
+    rxBytes.store(0, std::memory_order_relaxed);
+    txMessages.store(0, std::memory_order_relaxed);
+    txBytes.store(0, std::memory_order_relaxed);
+    sendErrors.store(0, std::memory_order_relaxed);
+    receiveErrors.store(0, std::memory_order_relaxed);
+    deserializeErrors.store(0, std::memory_order_relaxed);
+    queueDrops.store(0, std::memory_order_relaxed);
+    pings.store(0, std::memory_order_relaxed);
+    filterDrops.store(0, std::memory_order_relaxed);
+}
+
+std::string LinxMetrics::formatPrometheus(const std::vector<LinxMetricsSnapshot> &snapshots) {
+    std::ostringstream out;
+    for (const auto &info : metricInfos) {
+        out << "# HELP " << info.name << " " << info.help << "\n";
+        out << "# TYPE " << info.name << " " << info.type << "\n";
+        for (const auto &snapshot : snapshots) {
+            out << info.name << "{name=\"" << escapeLabel(snapshot.name) << "\"} " << snapshot.*info.field << "\n";
+        }
+    }
+    return out.str();
+}
+
+int LinxMetrics::writePrometheus(const std::string &path, const std::vector<LinxMetricsSnapshot> &snapshots) {
+    // Unique temporary file in the same directory, so that concurrent writers do not overwrite each other's file
+    // and rename() stays atomic
+    std::string tmpPath = path + ".XXXXXX";
+    int fd = mkstemp(tmpPath.data());
+    if (fd < 0) {
+        LINX_ERROR(GENERAL, "Cannot open metrics file: %s", tmpPath.c_str());
+        return -1;
+    }
+    // mkstemp() creates file readable only by owner, scrapers may run as other user
+    fchmod(fd, 0644);
+    FILE *file = fdopen(fd, "w");
+    if (file == nullptr) {
+        LINX_ERROR(GENERAL, "Cannot open metrics file: %s", tmpPath.c_str());
+        close(fd);
+        remove(tmpPath.c_str());
+        return -1;
+    }
+
+    std::string text = formatPrometheus(snapshots);
+    size_t written = fwrite(text.data(), 1, text.size(), file);
+    if (fclose(file) != 0 || written != text.size()) {
+        LINX_ERROR(GENERAL, "Cannot write metrics file: %s", tmpPath.c_str());
+        remove(tmpPath.c_str());
+        return -2;
+    }
+
+    if (rename(tmpPath.c_str(), path.c_str()) != 0) {
+        LINX_ERROR(GENERAL, "Cannot rename metrics file to: %s", path.c_str());
+        remove(tmpPath.c_str());
+        return -3;
+    }
+    return 0;
+}
@@ -0,0 +1,76 @@
+#include <errno.h>
+#include <sys/epoll.h>
+#include <unistd.h>
+#include "LinxPollFd.h"
+#include "LinxTrace.h"
+
+LinxPollFd::~LinxPollFd() {
+    close();
+}
+
+int LinxPollFd::get(int socketFd) {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (epollFd >= 0 || socketFd < 0) {
+        return epollFd;
+    }
+
+    auto eventFd = std::make_unique<LinxEventFd>();
+    int fd = epoll_create1(EPOLL_CLOEXEC);
+    if (fd < 0 || eventFd->getFd() < 0) {
+        LINX_ERROR(SOCKET, "Cannot create poll fd, errno: %d", errno);
+        if (fd >= 0) {
+            ::close(fd);
+        }
+        return -1;
+    }
+
+    for (int watched : {socketFd, eventFd->getFd()}) {
+        struct epoll_event event = {};
+        event.events = EPOLLIN;
+        event.data.fd = watched;
+        if (epoll_ctl(fd, EPOLL_CTL_ADD, watched, &event) < 0) {
+            LINX_ERROR(SOCKET, "Cannot add fd: %d to poll fd, errno: %d", watched, errno);
+            ::close(fd);
+            return -1;
+        }
+    }
+
+    epollFd = fd;
+    backlog = std::move(eventFd);
+    signaled = false;
+    update();
+    return epollFd;
+}
+
+void LinxPollFd::setBacklog(bool pending) {
+    if (this->pending.exchange(pending, std::memory_order_relaxed) == pending) {
+        return;
+    }
+    std::lock_guard<std::mutex> lock(mutex);
+    update();
+}
+
+void LinxPollFd::close() {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (epollFd >= 0) {
+        ::close(epollFd);
+        epollFd = -1;
+    }
+    backlog.reset();
+    pending.store(false, std::memory_order_relaxed);
+    signaled = false;
+}
+
+// Called with mutex locked, eventfd stays signaled as long as backlog is not empty
+void LinxPollFd::update() {
+    if (!backlog) {
+        return;
+    }
+    bool current = pending.load(std::memory_order_relaxed);
+    if (current && !signaled) {
+        backlog->writeEvent();
+    } else if (!current && signaled) {
+        backlog->clearEvents();
+    }
+    signaled = current;
+}
@@ -0,0 +1,29 @@
+#pragma once
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include "LinxEventFd.h"
+
+// Fd for external poller of socket which keeps received messages in user space, so that it is readable
+// while receive() would return without reading socket. Epoll fd watching socket fd and eventfd signaled
+// while backlog is not empty, created on first get() so that sockets without external poller do not pay for it.
+class LinxPollFd {
+  public:
+    ~LinxPollFd();
+
+    // Returns epoll fd, created for socketFd on first call, -1 on error
+    int get(int socketFd);
+    // Called by receiving thread after backlog changed, cheap when state is the same
+    void setBacklog(bool pending);
+    void close();
+
+  private:
+    std::mutex mutex;
+    int epollFd = -1;
+    std::unique_ptr<LinxEventFd> backlog;
+    std::atomic<bool> pending{false};
+    bool signaled = false;
+
+    void update();
+};
@@ -0,0 +1,43 @@
+#include "LinxRateLimiter.h"
+#include "LinxTrace.h"
+
+std::atomic<LinxRateLimitedSite *> LinxRateLimitedSite::sites{nullptr};
+std::atomic<bool> LinxRateLimitedSite::pending{false};
+std::atomic<uint64_t> LinxRateLimitedSite::nextReportNs{0};
+
+LinxRateLimitedSite::LinxRateLimitedSite(int severity, const char *file, int line)
+    : severity(severity), file(file), line(line) {
+    // Sites are function local statics, they are only added and live until exit
+    next = sites.load(std::memory_order_relaxed);
+    while (!sites.compare_exchange_weak(next, this, std::memory_order_release, std::memory_order_relaxed)) {
+    }
+}
+
+void LinxRateLimitedSite::reportPeriodically(uint64_t nowNs) {
+    uint64_t scheduled = nextReportNs.load(std::memory_order_relaxed);
+    if (nowNs < scheduled) {
+        return;
+    }
+
+    // Only one thread reports per interval
+    if (!nextReportNs.compare_exchange_strong(scheduled, nowNs + reportIntervalMs * 1000000ULL,
+                                              std::memory_order_relaxed)) {
+        return;
+    }
+    reportSuppressed();
+}
+
+uint64_t LinxRateLimitedSite::reportSuppressed() {
+    pending.store(false, std::memory_order_relaxed);
+
+    uint64_t reported = 0;
+    for (auto *site = sites.load(std::memory_order_acquire); site != nullptr; site = site->next) {
+        uint64_t suppressed = site->limiter.takeSuppressed();
+        if (suppressed != 0) {
+            trace_log(site->severity, site->file, site->line, "%llu similar messages suppressed",
+                      static_cast<unsigned long long>(suppressed));
+            reported++;
+        }
+    }
+    return reported;
+}
@@ -0,0 +1,96 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
+// Lock-free token bucket (GCRA form): allows burst of records, then one record every interval.
+// Rejected records are counted so that caller can report how many similar records were suppressed.
+class LinxRateLimiter {
+  public:
+    static constexpr uint32_t defaultBurst = 10;
+    static constexpr uint64_t defaultIntervalMs = 1000;
+
+    explicit LinxRateLimiter(uint32_t burst = defaultBurst, uint64_t intervalMs = defaultIntervalMs)
+        : intervalNs(intervalMs * 1000000ULL), toleranceNs(intervalNs * (std::max<uint32_t>(burst, 1) - 1)) {}
+
+    // Returns true when record may be written, suppressed receives number of records rejected since
+    // last allowed one
+    bool allow(uint64_t *suppressed) {
+        auto now = std::chrono::steady_clock::now().time_since_epoch();
+        return allow(std::chrono::duration_cast<std::chrono::nanoseconds>(now).count(), suppressed);
+    }
+
+    bool allow(uint64_t nowNs, uint64_t *suppressed) {
+        // Offset keeps theoretical arrival time above zero for clocks starting near zero
+        nowNs += toleranceNs + intervalNs;
+
+        uint64_t arrival = theoreticalArrival.load(std::memory_order_relaxed);
+        do {
+            if (arrival > nowNs + toleranceNs) {
+                rejected.fetch_add(1, std::memory_order_relaxed);
+                return false;
+            }
+        } while (!theoreticalArrival.compare_exchange_weak(arrival, std::max(arrival, nowNs) + intervalNs,
+                                                           std::memory_order_relaxed));
+
+        *suppressed = rejected.exchange(0, std::memory_order_relaxed);
+        return true;
+    }
+
+    // Returns and clears number of records rejected since last allowed one
+    uint64_t takeSuppressed() {
+        return rejected.exchange(0, std::memory_order_relaxed);
+    }
+
+  private:
+    const uint64_t intervalNs;
+    const uint64_t toleranceNs;
+    std::atomic<uint64_t> theoreticalArrival{0};
+    std::atomic<uint64_t> rejected{0};
+};
+
+// Rate limited trace call site (LINX_TRACE_RATELIMITED). Sites are kept in global list so that records
+// suppressed by a site which is not hit again (overload stopped) are still reported by periodic summary.
+class LinxRateLimitedSite {
+  public:
+    static constexpr uint64_t reportIntervalMs = LinxRateLimiter::defaultIntervalMs;
+
+    LinxRateLimitedSite(int severity, const char *file, int line);
+
+    bool allow(uint64_t *suppressed) {
+        if (limiter.allow(suppressed)) {
+            return true;
+        }
+        if (!pending.load(std::memory_order_relaxed)) {
+            pending.store(true, std::memory_order_relaxed);
+        }
+        return false;
+    }
+
+    // Called by every enabled LINX_* trace, reports suppressed records of all sites at most once per
+    // reportIntervalMs. Costs a single relaxed load while nothing is suppressed.
+    static void reportPeriodically() {
+        if (pending.load(std::memory_order_relaxed)) {
+            auto now = std::chrono::steady_clock::now().time_since_epoch();
+            reportPeriodically(std::chrono::duration_cast<std::chrono::nanoseconds>(now).count());
+        }
+    }
+    static void reportPeriodically(uint64_t nowNs);
+
+    // Writes "N similar messages suppressed" record for every site with suppressed records,
+    // returns number of reported records
+    static uint64_t reportSuppressed();
+
+  private:
+    LinxRateLimiter limiter;
+    const int severity;
+    const char *const file;
+    const int line;
+    LinxRateLimitedSite *next = nullptr;
+
+    static std::atomic<LinxRateLimitedSite *> sites;
+    static std::atomic<bool> pending;
+    static std::atomic<uint64_t> nextReportNs;
+};
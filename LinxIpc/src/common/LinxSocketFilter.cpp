@@ -0,0 +1,87 @@
+#include <algorithm>
+#include <cerrno>
+#include <sys/socket.h>
+#include "LinxIpc.h"
+#include "LinxSocketFilter.h"
+
+namespace {
+
+constexpr uint32_t acceptAll = 0xFFFFFFFF;
+constexpr uint32_t drop = 0;
+
+} // namespace
+
+namespace LinxSocketFilter {
+
+std::vector<Range> merge(std::vector<Range> ranges) {
+    std::sort(ranges.begin(), ranges.end());
+    std::vector<Range> merged;
+    for (const auto &range : ranges) {
+        if (!merged.empty() && range.first <= (uint64_t)merged.back().second + 1) {
+            merged.back().second = std::max(merged.back().second, range.second);
+        } else {
+            merged.push_back(range);
+        }
+    }
+    return merged;
+}
+
+std::vector<sock_filter> build(const std::vector<Range> &ranges, uint32_t payloadOffset, uint32_t flagMask,
+                               uint32_t passFlags) {
+    auto accepted = ranges;
+    accepted.emplace_back(0, IPC_SIG_BASE - 1);
+    accepted = merge(std::move(accepted));
+
+    // Every comparison is followed by its own accept, so that jump offsets stay within 8 bits.
+    // Datagrams shorter than 4 bytes fail the load and are dropped.
+    std::vector<sock_filter> program;
+    program.push_back(BPF_STMT(BPF_LD | BPF_W | BPF_ABS, payloadOffset));
+    if (passFlags != 0) {
+        program.push_back(BPF_JUMP(BPF_JMP | BPF_JSET | BPF_K, passFlags, 0, 1));
+        program.push_back(BPF_STMT(BPF_RET | BPF_K, acceptAll));
+    }
+    if (flagMask != 0) {
+        program.push_back(BPF_STMT(BPF_ALU | BPF_AND | BPF_K, ~flagMask));
+    }
+    for (const auto &[first, last] : accepted) {
+        if (first == last) {
+            program.push_back(BPF_JUMP(BPF_JMP | BPF_JEQ | BPF_K, first, 0, 1));
+        } else {
+            program.push_back(BPF_JUMP(BPF_JMP | BPF_JGE | BPF_K, first, 0, 2));
+            program.push_back(BPF_JUMP(BPF_JMP | BPF_JGT | BPF_K, last, 1, 0));
+        }
+        program.push_back(BPF_STMT(BPF_RET | BPF_K, acceptAll));
+    }
+    program.push_back(BPF_STMT(BPF_RET | BPF_K, drop));
+
+    if (program.size() > BPF_MAXINSNS) {
+        return {};
+    }
+    return program;
+}
+
+std::vector<Range> toRanges(const std::vector<uint32_t> &sigsel) {
+    std::vector<Range> ranges;
+    for (uint32_t reqId : sigsel) {
+        ranges.emplace_back(reqId, reqId);
+    }
+    return merge(std::move(ranges));
+}
+
+int attach(int fd, const std::vector<sock_filter> &program) {
+    if (program.empty()) {
+        int dummy = 0;
+        // Detaching when no filter is attached is not an error
+        if (setsockopt(fd, SOL_SOCKET, SO_DETACH_FILTER, &dummy, sizeof(dummy)) < 0 && errno != ENOENT) {
+            return -1;
+        }
+        return 0;
+    }
+
+    struct sock_fprog fprog{};
+    fprog.len = program.size();
+    fprog.filter = const_cast<sock_filter *>(program.data());
+    return setsockopt(fd, SOL_SOCKET, SO_ATTACH_FILTER, &fprog, sizeof(fprog));
+}
+
+} // namespace LinxSocketFilter
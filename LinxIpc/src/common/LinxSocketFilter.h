@@ -0,0 +1,27 @@
+#pragma once
+
+#include <cstdint>
+#include <utility>
+#include <vector>
+#include <linux/filter.h>
+
+// Classic BPF socket filter dropping datagrams by reqId in kernel, before copy to userspace
+namespace LinxSocketFilter {
+
+using Range = std::pair<uint32_t, uint32_t>;
+
+// Builds program accepting datagrams with reqId (first word of payload at payloadOffset) in one of
+// ranges [first, last] or internal reqIds (below IPC_SIG_BASE). flagMask bits are cleared before comparison, datagrams with
+// any of passFlags bits set are always accepted. Returns empty program when ranges do not fit BPF limits.
+std::vector<sock_filter> build(const std::vector<Range> &ranges, uint32_t payloadOffset, uint32_t flagMask,
+                               uint32_t passFlags);
+
+// Sorted ranges with overlapping and adjacent ones merged
+std::vector<Range> merge(std::vector<Range> ranges);
+// Sorted, merged ranges of single reqIds
+std::vector<Range> toRanges(const std::vector<uint32_t> &sigsel);
+
+// Empty program detaches filter, returns 0 on success, -1 on error (errno set)
+int attach(int fd, const std::vector<sock_filter> &program);
+
+} // namespace LinxSocketFilter
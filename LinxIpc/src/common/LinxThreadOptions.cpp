@@ -0,0 +1,68 @@
+#include <alloca.h>
+#include <cstdint>
+#include <errno.h>
+#include <pthread.h>
+#include <sys/mman.h>
+#include "LinxThreadOptions.h"
+#include "LinxTrace.h"
+
+static constexpr size_t maxThreadNameLength = 15;
+
+// Touch stack pages so the thread does not take page faults in its loop
+__attribute__((noinline)) static void prefaultStack(size_t size) {
+    volatile uint8_t *buffer = static_cast<volatile uint8_t *>(alloca(size));
+    for (size_t i = 0; i < size; i += 4096) {
+        buffer[i] = 0;
+    }
+}
+
+int LinxThreadOptions::applyToCurrentThread() const {
+    int result = 0;
+
+    if (!name.empty()) {
+        std::string threadName = name.substr(0, maxThreadNameLength);
+        if (int rc = pthread_setname_np(pthread_self(), threadName.c_str()); rc != 0) {
+            LINX_ERROR(GENERAL, "Cannot set thread name: %s, error: %d", threadName.c_str(), rc);
+            result = -1;
+        }
+    }
+
+    if (!cpus.empty()) {
+        cpu_set_t cpuset;
+        CPU_ZERO(&cpuset);
+        for (int cpu : cpus) {
+            if (cpu < 0 || cpu >= CPU_SETSIZE) {
+                LINX_ERROR(GENERAL, "Invalid CPU number: %d", cpu);
+                result = -2;
+                continue;
+            }
+            CPU_SET(cpu, &cpuset);
+        }
+        if (int rc = pthread_setaffinity_np(pthread_self(), sizeof(cpuset), &cpuset); rc != 0) {
+            LINX_ERROR(GENERAL, "Cannot set thread affinity, error: %d", rc);
+            result = -2;
+        }
+    }
+
+    if (policy != SCHED_OTHER || priority != 0) {
+        struct sched_param param{};
+        param.sched_priority = priority;
+        if (int rc = pthread_setschedparam(pthread_self(), policy, &param); rc != 0) {
+            LINX_ERROR(GENERAL, "Cannot set thread scheduling policy: %d, priority: %d, error: %d", policy, priority, rc);
+            result = -3;
+        }
+    }
+
+    if (lockMemory) {
+        if (mlockall(MCL_CURRENT | MCL_FUTURE) != 0) {
+            LINX_ERROR(GENERAL, "Cannot lock process memory, errno: %d", errno);
+            result = -4;
+        }
+    }
+
+    if (stackPrefaultSize > 0) {
+        prefaultStack(stackPrefaultSize);
+    }
+
+    return result;
+}
@@ -1,8 +1,62 @@
 #pragma once
 
 #include "trace.h"
+#include "LinxLogLevels.h"
+#include "LinxRateLimiter.h"
 
-#define LINX_ERROR TRACE_ERROR
-#define LINX_WARNING TRACE_WARNING
-#define LINX_INFO TRACE_INFO
-#define LINX_DEBUG TRACE_DEBUG
\ No newline at end of file
+// Runtime level of module (LinxLogModule) is checked before arguments are evaluated,
+// traces above TRACE_LEVEL are not compiled in
+#define LINX_TRACE(module, severity, ...)                                     \
+    do {                                                                      \
+        if (LinxLogLevels::isEnabled(LinxLogModule::module, severity)) {      \
+            LinxRateLimitedSite::reportPeriodically();                        \
+            trace_log(severity, __FILE__, __LINE__, __VA_ARGS__);             \
+        }                                                                     \
+    } while (0)
+
+// Per-callsite token bucket for per-message paths, records rejected by limiter are reported
+// as single summary before next written record of the site, or by periodic summary of any
+// LINX_* trace when the site is not hit again
+#define LINX_TRACE_RATELIMITED(module, severity, ...)                                                       \
+    do {                                                                                                    \
+        if (LinxLogLevels::isEnabled(LinxLogModule::module, severity)) {                                    \
+            static LinxRateLimitedSite linxRateLimitedSite(severity, __FILE__, __LINE__);                   \
+            LinxRateLimitedSite::reportPeriodically();                                                      \
+            uint64_t linxSuppressed = 0;                                                                    \
+            if (linxRateLimitedSite.allow(&linxSuppressed)) {                                               \
+                if (linxSuppressed != 0) {                                                                  \
+                    trace_log(severity, __FILE__, __LINE__, "%llu similar messages suppressed",             \
+                              static_cast<unsigned long long>(linxSuppressed));                             \
+                }                                                                                           \
+                trace_log(severity, __FILE__, __LINE__, __VA_ARGS__);                                       \
+            }                                                                                               \
+        }                                                                                                   \
+    } while (0)
+
+#if TRACE_LEVEL >= SEVERITY_ERROR
+    #define LINX_ERROR(module, ...) LINX_TRACE(module, SEVERITY_ERROR, __VA_ARGS__)
+    #define LINX_ERROR_RATELIMITED(module, ...) LINX_TRACE_RATELIMITED(module, SEVERITY_ERROR, __VA_ARGS__)
+#else
+    #define LINX_ERROR(...)
+    #define LINX_ERROR_RATELIMITED(...)
+#endif
+
+#if TRACE_LEVEL >= SEVERITY_WARNING
+    #define LINX_WARNING(module, ...) LINX_TRACE(module, SEVERITY_WARNING, __VA_ARGS__)
+    #define LINX_WARNING_RATELIMITED(module, ...) LINX_TRACE_RATELIMITED(module, SEVERITY_WARNING, __VA_ARGS__)
+#else
+    #define LINX_WARNING(...)
+    #define LINX_WARNING_RATELIMITED(...)
+#endif
+
+#if TRACE_LEVEL >= SEVERITY_INFO
+    #define LINX_INFO(module, ...) LINX_TRACE(module, SEVERITY_INFO, __VA_ARGS__)
+#else
+    #define LINX_INFO(...)
+#endif
+
+#if TRACE_LEVEL >= SEVERITY_DEBUG
+    #define LINX_DEBUG(module, ...) LINX_TRACE(module, SEVERITY_DEBUG, __VA_ARGS__)
+#else
+    #define LINX_DEBUG(...)
+#endif
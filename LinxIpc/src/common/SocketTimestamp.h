@@ -0,0 +1,50 @@
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <sys/socket.h>
+#include <sys/uio.h>
+
+namespace SocketTimestamp {
+
+inline int enable(int fd, bool enable) {
+    int value = enable ? 1 : 0;
+    return setsockopt(fd, SOL_SOCKET, SO_TIMESTAMPNS, &value, sizeof(value));
+}
+
+// recvfrom() that also returns kernel receive time (SO_TIMESTAMPNS) in ns, 0 when not available
+inline ssize_t recvfrom(int fd, void *buf, size_t len, struct sockaddr *addr, socklen_t *addrlen,
+                        uint64_t *timestampNs) {
+    struct iovec iov = {.iov_base = buf, .iov_len = len};
+    alignas(struct cmsghdr) char control[CMSG_SPACE(sizeof(struct timespec))];
+
+    struct msghdr hdr {};
+    hdr.msg_name = addr;
+    hdr.msg_namelen = addrlen ? *addrlen : 0;
+    hdr.msg_iov = &iov;
+    hdr.msg_iovlen = 1;
+    hdr.msg_control = control;
+    hdr.msg_controllen = sizeof(control);
+
+    ssize_t ret = recvmsg(fd, &hdr, 0);
+    if (ret < 0) {
+        return ret;
+    }
+
+    if (addrlen) {
+        *addrlen = hdr.msg_namelen;
+    }
+
+    *timestampNs = 0;
+    for (struct cmsghdr *cmsg = CMSG_FIRSTHDR(&hdr); cmsg != nullptr; cmsg = CMSG_NXTHDR(&hdr, cmsg)) {
+        if (cmsg->cmsg_level == SOL_SOCKET && cmsg->cmsg_type == SCM_TIMESTAMPNS) {
+            struct timespec ts;
+            memcpy(&ts, CMSG_DATA(cmsg), sizeof(ts));
+            *timestampNs = (uint64_t)ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+            break;
+        }
+    }
+    return ret;
+}
+
+} // namespace SocketTimestamp
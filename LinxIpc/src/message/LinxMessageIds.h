@@ -1,4 +1,10 @@
 #pragma once
 
+// Internal reqIds, whole range below IPC_SIG_BASE is reserved for them and never dropped by signal filters
 #define IPC_PING_REQ 1U
-#define IPC_PING_RSP 2U
\ No newline at end of file
+#define IPC_PING_RSP 2U
+#define IPC_BATCH_MSG 3U
+#define IPC_NAME_REGISTER 4U
+#define IPC_NAME_UNREGISTER 5U
+#define IPC_NAME_QUERY 6U
+#define IPC_NAME_UPDATE 7U
\ No newline at end of file
@@ -6,7 +6,7 @@
 
 LinxEventFd::LinxEventFd() {
     if ((efd = eventfd(0, EFD_SEMAPHORE | EFD_NONBLOCK)) < 0) {
-        LINX_ERROR("Cannot open EventFD");
+        LINX_ERROR(QUEUE, "Cannot open EventFD");
     }
 }
 
@@ -18,13 +18,13 @@ LinxEventFd::~LinxEventFd() {
 
 int LinxEventFd::writeEvent() {
     if (efd < 0) {
-        LINX_ERROR("EventFD not opened");
+        LINX_ERROR(QUEUE, "EventFD not opened");
         return -1;
     }
 
     uint64_t u = 1;
     if (int s = ::write(efd, &u, sizeof(uint64_t)); s != sizeof(uint64_t)) {
-        LINX_ERROR("Write to EventFd failed: %d, errno: %d", s, errno);
+        LINX_ERROR_RATELIMITED(QUEUE, "Write to EventFd failed: %d, errno: %d", s, errno);
         return -2;
     }
 
@@ -33,7 +33,7 @@ int LinxEventFd::writeEvent() {
 
 void LinxEventFd::clearEvents() {
     if (efd < 0) {
-        LINX_ERROR("EventFD not opened");
+        LINX_ERROR(QUEUE, "EventFD not opened");
         return;
     }
 
@@ -44,13 +44,13 @@ void LinxEventFd::clearEvents() {
 
 int LinxEventFd::readEvent() {
     if (efd < 0) {
-        LINX_ERROR("EventFD not opened");
+        LINX_ERROR(QUEUE, "EventFD not opened");
         return -1;
     }
 
     uint64_t u = 0;
     if (int s = ::read(efd, &u, sizeof(uint64_t)); s != sizeof(uint64_t)) {
-        LINX_ERROR("Read from EventFd failed: %d errno: %d", s, errno);
+        LINX_ERROR_RATELIMITED(QUEUE, "Read from EventFd failed: %d errno: %d", s, errno);
         return -2;
     }
 
@@ -1,4 +1,5 @@
 #include <cassert>
+#include "BusyPoll.h"
 #include "LinxEventFd.h"
 #include "LinxIpc.h"
 #include "LinxQueue.h"
@@ -20,8 +21,16 @@ int LinxQueue::add(LinxReceivedMessagePtr &&msg) {
 
     int result = -1;
     if (queue.size() < (std::size_t)max_size) {
+        // eventfd is signalled as long as queue is not empty
+        if (queue.empty()) {
+            efd->writeEvent();
+        }
         queue.push_back(std::move(msg));
-        efd->writeEvent();
+        generation.fetch_add(1, std::memory_order_release);
+        updateDepth();
+        if ((int)queue.size() > highWater.load(std::memory_order_relaxed)) {
+            highWater.store(queue.size(), std::memory_order_relaxed);
+        }
         result = 0;
     }
 
@@ -34,6 +43,7 @@ void LinxQueue::stop() {
     std::lock_guard<std::mutex> lock(m_mutex);
     stopped = true;
     queue.clear();
+    updateDepth();
     efd->clearEvents();
     m_cv.notify_all();
 }
@@ -41,19 +51,95 @@ void LinxQueue::stop() {
 void LinxQueue::clear() {
     std::lock_guard<std::mutex> lock(m_mutex);
     queue.clear();
+    updateDepth();
     efd->clearEvents();
 }
 
+void LinxQueue::setSpinTime(int spinUs) {
+    this->spinUs = spinUs;
+}
+
+template<typename Predicate>
+bool LinxQueue::spinWait(Predicate predicate, std::chrono::steady_clock::time_point start, int timeoutMs) {
+    // Mutex is taken only when producer added something since last check
+    uint64_t seen = generation.load(std::memory_order_acquire) - 1;
+    auto deadline = BusyPoll::spinDeadline(start, timeoutMs, spinUs);
+    do {
+        if (uint64_t current = generation.load(std::memory_order_acquire); current != seen) {
+            seen = current;
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if (predicate()) {
+                return true;
+            }
+        }
+        BusyPoll::cpuRelax();
+    } while (std::chrono::steady_clock::now() < deadline);
+    return false;
+}
+
 LinxReceivedMessagePtr LinxQueue::get(int timeoutMs, const std::vector<uint32_t> &sigsel, const IIdentifier *from) {
     if (timeoutMs == IMMEDIATE_TIMEOUT) {
         return getMessage(sigsel, from);
-    } else if (timeoutMs == INFINITE_TIMEOUT) {
+    }
+
+    if (spinUs > 0) {
+        auto start = std::chrono::steady_clock::now();
+        LinxReceivedMessagePtr msg = nullptr;
+        if (spinWait([this, &sigsel, &from, &msg]() {
+            msg = findMessage(sigsel, from);
+            return msg != nullptr || stopped;
+        }, start, timeoutMs)) {
+            return msg;
+        }
+        timeoutMs = BusyPoll::remainingMs(timeoutMs, start);
+    }
+
+    if (timeoutMs == INFINITE_TIMEOUT) {
         return waitForMessage(sigsel, from);
     } else {
         return waitForMessage(timeoutMs, sigsel, from);
     }
 }
 
+std::vector<LinxReceivedMessagePtr> LinxQueue::getBatch(size_t maxCount, int timeoutMs,
+                                                       const std::vector<uint32_t> &sigsel,
+                                                       const IIdentifier *from) {
+    std::vector<LinxReceivedMessagePtr> messages;
+    if (maxCount == 0) {
+        return messages;
+    }
+
+    std::unique_lock<std::mutex> lock(m_mutex);
+
+    auto predicate = [this, maxCount, &sigsel, &from, &messages]() {
+        findMessages(maxCount, sigsel, from, messages);
+        return !messages.empty() || stopped;
+    };
+
+    if (timeoutMs == IMMEDIATE_TIMEOUT) {
+        predicate();
+        return messages;
+    }
+
+    if (spinUs > 0) {
+        auto start = std::chrono::steady_clock::now();
+        lock.unlock();
+        if (spinWait(predicate, start, timeoutMs)) {
+            return messages;
+        }
+        timeoutMs = BusyPoll::remainingMs(timeoutMs, start);
+        lock.lock();
+    }
+
+    if (timeoutMs == INFINITE_TIMEOUT) {
+        m_cv.wait(lock, predicate);
+    } else {
+        m_cv.wait_for(lock, std::chrono::milliseconds(timeoutMs), predicate);
+    }
+
+    return messages;
+}
+
 LinxReceivedMessagePtr LinxQueue::getMessage(const std::vector<uint32_t> &sigsel,
                                            const IIdentifier *from) {
     std::lock_guard<std::mutex> lock(m_mutex);
@@ -98,15 +184,48 @@ LinxReceivedMessagePtr LinxQueue::findMessage(const std::vector<uint32_t> &sigse
     if (auto it = std::find_if(queue.begin(), queue.end(), predicate); it != queue.end()) {
         auto msg = std::move(*it);
         queue.erase(it);
-        efd->readEvent();
+        updateDepth();
+        if (queue.empty()) {
+            efd->readEvent();
+        }
         return msg;
     }
 
     return nullptr;
 }
 
+void LinxQueue::findMessages(size_t maxCount, const std::vector<uint32_t> &sigsel, const IIdentifier *from,
+                             std::vector<LinxReceivedMessagePtr> &messages) {
+
+    auto it = queue.begin();
+    while (it != queue.end() && messages.size() < maxCount) {
+        if (LinxMessageFilter::matchesFrom((*it)->from.get(), from) &&
+            LinxMessageFilter::matchesSignalSelector(*(*it)->message, sigsel)) {
+            messages.push_back(std::move(*it));
+            it = queue.erase(it);
+        } else {
+            ++it;
+        }
+    }
+
+    if (!messages.empty()) {
+        updateDepth();
+    }
+    if (!messages.empty() && queue.empty()) {
+        efd->readEvent();
+    }
+}
+
+void LinxQueue::updateDepth() {
+    depth.store(queue.size(), std::memory_order_relaxed);
+}
+
 int LinxQueue::size() const {
-    return queue.size();
+    return depth.load(std::memory_order_relaxed);
+}
+
+int LinxQueue::getHighWater() const {
+    return highWater.load(std::memory_order_relaxed);
 }
 
 int LinxQueue::getFd() const {
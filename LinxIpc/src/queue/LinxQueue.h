@@ -1,5 +1,7 @@
 #pragma once
 
+#include <atomic>
+#include <chrono>
 #include <condition_variable>
 #include <list>
 #include <mutex>
@@ -14,12 +16,18 @@ class LinxQueue {
     virtual ~LinxQueue();
     virtual int add(LinxReceivedMessagePtr &&msg);
     virtual int size() const;
+    // Highest number of messages held in queue since creation
+    virtual int getHighWater() const;
     virtual int getFd() const;
     virtual void clear();
     virtual void stop();
+    // Consumer spins for spinUs checking for new messages before blocking on condition variable
+    virtual void setSpinTime(int spinUs);
 
     virtual LinxReceivedMessagePtr get(int timeoutMs, const std::vector<uint32_t> &sigsel,
                                    const IIdentifier *from);
+    virtual std::vector<LinxReceivedMessagePtr> getBatch(size_t maxCount, int timeoutMs,
+                                   const std::vector<uint32_t> &sigsel, const IIdentifier *from);
 
    private:
     bool stopped = false;
@@ -28,8 +36,20 @@ class LinxQueue {
     std::mutex m_mutex;
     std::condition_variable m_cv;
     std::list<LinxReceivedMessagePtr> queue;
+    int spinUs = 0;
+    std::atomic<uint64_t> generation{0};
+    std::atomic<int> highWater{0};
+    // Number of queued messages, updated under m_mutex and read without it by size()
+    std::atomic<int> depth{0};
+
+    template<typename Predicate>
+    bool spinWait(Predicate predicate, std::chrono::steady_clock::time_point start, int timeoutMs);
 
     LinxReceivedMessagePtr findMessage(const std::vector<uint32_t> &sigsel, const IIdentifier *from);
+    // Called with m_mutex held after queue is changed
+    void updateDepth();
+    void findMessages(size_t maxCount, const std::vector<uint32_t> &sigsel, const IIdentifier *from,
+                      std::vector<LinxReceivedMessagePtr> &messages);
     LinxReceivedMessagePtr waitForMessage(int timeoutMs, const std::vector<uint32_t> &sigsel, const IIdentifier *from);
     LinxReceivedMessagePtr waitForMessage(const std::vector<uint32_t> &sigsel, const IIdentifier *from);
     LinxReceivedMessagePtr getMessage(const std::vector<uint32_t> &sigsel, const IIdentifier *from);
@@ -1,12 +1,15 @@
+#include <algorithm>
 #include <sstream>
 #include <random>
 #include "UdpSocket.h"
+#include "LinxNameService.h"
 #include "LinxEventFd.h"
 #include "LinxQueue.h"
 #include "LinxTrace.h"
 #include "GenericSimpleServer.tpp"
 #include "GenericServer.tpp"
 #include "GenericClient.tpp"
+#include "GenericClientPool.tpp"
 
 namespace UdpFactory {
 
@@ -15,16 +18,16 @@ std::shared_ptr<UdpSimpleServer> createSimpleServer(uint16_t port) {
 
     auto socket = std::make_shared<UdpSocket>();
     if (socket->open() < 0) {
-        LINX_ERROR("Failed to open UDP socket for server on port: %d", port);
+        LINX_ERROR(SOCKET, "Failed to open UDP socket for server on port: %d", port);
         return nullptr;
     }
     if (socket->bind(port) < 0) {
-        LINX_ERROR("Failed to bind UDP socket for server on port: %d", port);
+        LINX_ERROR(SOCKET, "Failed to bind UDP socket for server on port: %d", port);
         return nullptr;
     }
 
     std::string serverId = ip + ":" + std::to_string(port);
-    LINX_INFO("Created UDP server: %s(%d), socket: %s:%d", serverId.c_str(), socket->getFd(), ip.c_str(), port);
+    LINX_INFO(SOCKET, "Created UDP server: %s(%d), socket: %s:%d", serverId.c_str(), socket->getFd(), ip.c_str(), port);
     return std::make_shared<UdpSimpleServer>(serverId, socket);
 }
 
@@ -33,11 +36,11 @@ std::shared_ptr<UdpServer> createServer(uint16_t port, size_t queueSize) {
 
     auto socket = std::make_shared<UdpSocket>();
     if (socket->open() < 0) {
-        LINX_ERROR("Failed to open UDP socket for server on port: %d", port);
+        LINX_ERROR(SOCKET, "Failed to open UDP socket for server on port: %d", port);
         return nullptr;
     }
     if (socket->bind(port) < 0) {
-        LINX_ERROR("Failed to bind UDP socket for server on port: %d", port);
+        LINX_ERROR(SOCKET, "Failed to bind UDP socket for server on port: %d", port);
         return nullptr;
     }
 
@@ -45,28 +48,68 @@ std::shared_ptr<UdpServer> createServer(uint16_t port, size_t queueSize) {
     auto efd = std::make_unique<LinxEventFd>();
     auto queue = std::make_unique<LinxQueue>(std::move(efd), queueSize);
 
-    LINX_INFO("Created UDP worker server: %s(%d), socket: %s:%d", serverId.c_str(), socket->getFd(), ip.c_str(), port);
+    LINX_INFO(SOCKET, "Created UDP worker server: %s(%d), socket: %s:%d", serverId.c_str(), socket->getFd(), ip.c_str(), port);
     return std::make_shared<UdpServer>(serverId, socket, std::move(queue));
 }
 
+std::vector<std::shared_ptr<UdpServer>> createShardedServer(uint16_t port, size_t workers, size_t queueSize) {
+    std::string ip = "0.0.0.0";
+    std::vector<std::shared_ptr<UdpServer>> servers;
+
+    for (size_t i = 0; i < workers; i++) {
+        auto socket = std::make_shared<UdpSocket>();
+        if (socket->open() < 0) {
+            LINX_ERROR(SOCKET, "Failed to open UDP socket for server on port: %d", port);
+            return {};
+        }
+        if (socket->setReusePort(true) < 0) {
+            LINX_ERROR(SOCKET, "Failed to set port reuse for UDP socket on port: %d", port);
+            return {};
+        }
+        if (socket->bind(port) < 0) {
+            LINX_ERROR(SOCKET, "Failed to bind UDP socket for server on port: %d", port);
+            return {};
+        }
+
+        // All shards have to share port assigned by OS to the first one
+        if (port == 0) {
+            int localPort = socket->getLocalPort();
+            if (localPort <= 0) {
+                LINX_ERROR(SOCKET, "Failed to get local port of UDP socket");
+                return {};
+            }
+            port = localPort;
+        }
+
+        std::string serverId = ip + ":" + std::to_string(port) + "#" + std::to_string(i);
+        auto efd = std::make_unique<LinxEventFd>();
+        auto queue = std::make_unique<LinxQueue>(std::move(efd), queueSize);
+
+        LINX_INFO(SOCKET, "Created UDP sharded server: %s(%d), socket: %s:%d", serverId.c_str(), socket->getFd(), ip.c_str(), port);
+        servers.push_back(std::make_shared<UdpServer>(serverId, socket, std::move(queue)));
+    }
+
+    return servers;
+}
+
 std::shared_ptr<UdpServer> createMulticastServer(const std::string &multicastIp, uint16_t port, size_t queueSize) {
 
     if (!isMulticastIp(multicastIp)) {
-        LINX_ERROR("IP address is not multicast: %s", multicastIp.c_str());
+        LINX_ERROR(SOCKET, "IP address is not multicast: %s", multicastIp.c_str());
         return nullptr;
     }
 
     auto socket = std::make_shared<UdpSocket>();
     if (socket->open() < 0) {
-        LINX_ERROR("Failed to open UDP socket for server on port: %d", port);
+        LINX_ERROR(SOCKET, "Failed to open UDP socket for server on port: %d", port);
         return nullptr;
     }
     if (socket->bind(port, multicastIp) < 0) {
-        LINX_ERROR("Failed to bind UDP socket for server on port: %d", port);
+        LINX_ERROR(SOCKET, "Failed to bind UDP socket for server on port: %d", port);
         return nullptr;
     }
     if (socket->joinMulticastGroup(multicastIp) < 0) {
-        LINX_ERROR("Failed to join multicast group: %s", multicastIp.c_str());
+        LINX_ERROR(SOCKET, "Failed to join multicast group: %s", multicastIp.c_str());
         return nullptr;
     }
 
@@ -74,26 +117,106 @@ std::shared_ptr<UdpServer> createMulticastServer(const std::string &multicastIp,
     auto efd = std::make_unique<LinxEventFd>();
     auto queue = std::make_unique<LinxQueue>(std::move(efd), queueSize);
 
-    LINX_INFO("Created UDP worker server: %s(%d), socket: %s:%d", serverId.c_str(), socket->getFd(), multicastIp.c_str(), port);
+    LINX_INFO(SOCKET, "Created UDP worker server: %s(%d), socket: %s:%d", serverId.c_str(), socket->getFd(), multicastIp.c_str(), port);
+    return std::make_shared<UdpServer>(serverId, socket, std::move(queue));
+}
+
+std::shared_ptr<UdpServer> createSubscriber(const std::vector<LinxTopic> &topics, uint16_t port, size_t queueSize) {
+
+    if (topics.empty()) {
+        LINX_ERROR(SOCKET, "Subscriber without topics on port: %d", port);
+        return nullptr;
+    }
+    for (const auto &topic : topics) {
+        if (!isMulticastIp(topic.group)) {
+            LINX_ERROR(SOCKET, "IP address is not multicast: %s", topic.group.c_str());
+            return nullptr;
+        }
+    }
+
+    auto socket = std::make_shared<UdpSocket>();
+    if (socket->open() < 0) {
+        LINX_ERROR(SOCKET, "Failed to open UDP socket for subscriber on port: %d", port);
+        return nullptr;
+    }
+    if (socket->setReusePort(true) < 0) {
+        LINX_ERROR(SOCKET, "Failed to set port reuse for UDP socket on port: %d", port);
+        return nullptr;
+    }
+    if (socket->bind(port) < 0) {
+        LINX_ERROR(SOCKET, "Failed to bind UDP socket for subscriber on port: %d", port);
+        return nullptr;
+    }
+    if (socket->setSubscription(topics) < 0) {
+        LINX_ERROR(SOCKET, "Failed to set subscription for UDP socket on port: %d", port);
+        return nullptr;
+    }
+
+    // Each group is joined once, groups of topics not subscribed are filtered by kernel
+    std::vector<std::string> groups;
+    for (const auto &topic : topics) {
+        if (std::find(groups.begin(), groups.end(), topic.group) != groups.end()) {
+            continue;
+        }
+        if (socket->joinMulticastGroup(topic.group) < 0) {
+            LINX_ERROR(SOCKET, "Failed to join multicast group: %s", topic.group.c_str());
+            return nullptr;
+        }
+        groups.push_back(topic.group);
+    }
+
+    std::string serverId = "subscriber_" + groups.front() + ":" + std::to_string(port);
+    auto efd = std::make_unique<LinxEventFd>();
+    auto queue = std::make_unique<LinxQueue>(std::move(efd), queueSize);
+
+    LINX_INFO(SOCKET, "Created UDP subscriber: %s(%d), topics: %zu, groups: %zu", serverId.c_str(), socket->getFd(),
+              topics.size(), groups.size());
     return std::make_shared<UdpServer>(serverId, socket, std::move(queue));
 }
 
+std::shared_ptr<UdpPublisher> createPublisher(const std::vector<LinxTopic> &topics, uint16_t port) {
+
+    for (const auto &topic : topics) {
+        if (!isMulticastIp(topic.group) || topic.firstReqId > topic.lastReqId) {
+            LINX_ERROR(SOCKET, "Invalid topic: 0x%x-0x%x, group: %s", topic.firstReqId, topic.lastReqId, topic.group.c_str());
+            return nullptr;
+        }
+    }
+
+    auto socket = std::make_shared<UdpSocket>();
+    if (socket->open() < 0) {
+        LINX_ERROR(SOCKET, "Failed to open UDP socket for publisher on port: %d", port);
+        return nullptr;
+    }
+    if (socket->setMulticastTtl(1) < 0) {
+        LINX_ERROR(SOCKET, "Failed to set multicast TTL for publisher on port: %d", port);
+        return nullptr;
+    }
+
+    static std::mt19937 gen(std::random_device{}());
+    std::uniform_int_distribution<> dis(0, 65535);
+    std::string publisherId = "publisher_" + std::to_string(dis(gen)) + ":" + std::to_string(port);
+
+    LINX_INFO(SOCKET, "Created UDP publisher: %s(%d), topics: %zu", publisherId.c_str(), socket->getFd(), topics.size());
+    return std::make_shared<UdpPublisher>(publisherId, socket, topics, port);
+}
+
 std::shared_ptr<UdpClient> createClient(const std::string &ip, uint16_t port) {
 
     auto socket = std::make_shared<UdpSocket>();
     if (socket->open() < 0) {
-        LINX_ERROR("Failed to open UDP socket for client: %s:%d", ip.c_str(), port);
+        LINX_ERROR(SOCKET, "Failed to open UDP socket for client: %s:%d", ip.c_str(), port);
         return nullptr;
     }
     if (isMulticastIp(ip)) {
         if (socket->setMulticastTtl(1) < 0) {
-            LINX_ERROR("Failed to set multicast TTL for: %s", ip.c_str());
+            LINX_ERROR(SOCKET, "Failed to set multicast TTL for: %s", ip.c_str());
             return nullptr;
         }
     }
     if (isBroadcastIp(ip)) {
         if (socket->setBroadcast(true) < 0) {
-            LINX_ERROR("Failed to set broadcast for: %s", ip.c_str());
+            LINX_ERROR(SOCKET, "Failed to set broadcast for: %s", ip.c_str());
             return nullptr;
         }
     }
@@ -102,10 +225,42 @@ std::shared_ptr<UdpClient> createClient(const std::string &ip, uint16_t port) {
     std::uniform_int_distribution<> dis(0, 65535);
     std::string clientId = "client_" + std::to_string(dis(gen)) + "_" + ip + ":" + std::to_string(port);
 
-    LINX_INFO("Created UDP client: %s(%d) -> server socket: %s:%d", clientId.c_str(), socket->getFd(), ip.c_str(), port);
+    LINX_INFO(SOCKET, "Created UDP client: %s(%d) -> server socket: %s:%d", clientId.c_str(), socket->getFd(), ip.c_str(), port);
     return std::make_shared<UdpClient>(clientId, socket, PortInfo(ip, port));
 }
 
+std::shared_ptr<UdpClientPool> createClientPool(size_t queueSize) {
+    auto socket = std::make_shared<UdpSocket>();
+    if (socket->open() < 0) {
+        LINX_ERROR(SOCKET, "Failed to open UDP socket for client pool");
+        return nullptr;
+    }
+
+    static std::mt19937 gen(std::random_device{}());
+    std::uniform_int_distribution<> dis(0, 65535);
+    std::string poolId = "client_pool_" + std::to_string(dis(gen));
+
+    LINX_INFO(SOCKET, "Created UDP client pool: %s(%d)", poolId.c_str(), socket->getFd());
+    return std::make_shared<UdpClientPool>(poolId, socket, queueSize);
+}
+
+std::shared_ptr<UdpClient> resolveClient(LinxNameResolver &resolver, const std::string &serviceName, int timeoutMs) {
+    auto endpoint = resolver.resolve(serviceName, timeoutMs);
+    auto separator = endpoint.rfind(':');
+    if (endpoint.empty() || separator == std::string::npos) {
+        LINX_ERROR(SOCKET, "Failed to resolve UDP server: %s, endpoint: %s", serviceName.c_str(), endpoint.c_str());
+        return nullptr;
+    }
+
+    char *end = nullptr;
+    unsigned long port = strtoul(endpoint.c_str() + separator + 1, &end, 10);
+    if (separator + 1 == endpoint.size() || *end != '\0' || port == 0 || port > UINT16_MAX) {
+        LINX_ERROR(SOCKET, "Invalid UDP endpoint of server: %s, endpoint: %s", serviceName.c_str(), endpoint.c_str());
+        return nullptr;
+    }
+    return createClient(endpoint.substr(0, separator), static_cast<uint16_t>(port));
+}
+
 bool isBroadcastIp(const std::string &ip) {
     return ip == "255.255.255.255";
 }
@@ -120,3 +275,8 @@ bool isMulticastIp(const std::string &ip) {
 }
 
 } // namespace UdpFactory
+
+template class GenericSimpleServer<PortInfo>;
+template class GenericServer<PortInfo>;
+template class GenericClient<PortInfo>;
+template class GenericClientPool<PortInfo>;
@@ -0,0 +1,115 @@
+#include <algorithm>
+#include <arpa/inet.h>
+#include <cstring>
+#include "UdpFragmentation.h"
+#include "UdpLinx.h"
+#include "LinxCompression.h"
+
+void UdpReassembler::configure(int timeoutMs, size_t memoryLimit) {
+    std::lock_guard<std::mutex> lock(mutex);
+    this->timeoutMs = timeoutMs;
+    this->memoryLimit = memoryLimit;
+}
+
+bool UdpReassembler::add(uint64_t sender, const uint8_t *datagram, size_t size, uint64_t nowMs,
+                         std::vector<uint8_t> *frame) {
+    fragmentsReceived.fetch_add(1, std::memory_order_relaxed);
+
+    UdpFragmentHeader header;
+    if (size <= sizeof(header)) {
+        reassemblyDrops.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+    memcpy(&header, datagram, sizeof(header));
+    uint32_t messageId = ntohl(header.messageId);
+    uint32_t frameSize = ntohl(header.frameSize);
+    uint32_t offset = ntohl(header.offset);
+    uint32_t fragmentSize = ntohl(header.fragmentSize);
+    const uint8_t *data = datagram + sizeof(header);
+    size_t dataSize = size - sizeof(header);
+
+    if (fragmentSize == 0 || frameSize == 0 || frameSize > LINX_MAX_DECOMPRESSED_SIZE || offset >= frameSize ||
+        offset % fragmentSize != 0 || dataSize != std::min<size_t>(fragmentSize, frameSize - offset)) {
+        reassemblyDrops.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+
+    std::lock_guard<std::mutex> lock(mutex);
+    expire(nowMs);
+
+    Key key{sender, messageId};
+    auto it = entries.find(key);
+    if (it == entries.end()) {
+        if (!reserve(frameSize)) {
+            reassemblyDrops.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+        uint32_t count = (frameSize + fragmentSize - 1) / fragmentSize;
+        it = entries.emplace(key, Entry{std::vector<uint8_t>(frameSize), std::vector<bool>(count), frameSize,
+                                        fragmentSize, count, nowMs}).first;
+    } else if (it->second.frameSize != frameSize || it->second.fragmentSize != fragmentSize) {
+        reassemblyDrops.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+
+    auto &entry = it->second;
+    uint32_t index = offset / fragmentSize;
+    if (entry.received[index]) {
+        return false;
+    }
+    entry.received[index] = true;
+    memcpy(entry.frame.data() + offset, data, dataSize);
+    if (--entry.missing > 0) {
+        return false;
+    }
+
+    *frame = std::move(entry.frame);
+    erase(it);
+    reassembledMessages.fetch_add(1, std::memory_order_relaxed);
+    return true;
+}
+
+void UdpReassembler::expire(uint64_t nowMs) {
+    for (auto it = entries.begin(); it != entries.end();) {
+        if (nowMs - it->second.createdMs >= (uint64_t)timeoutMs) {
+            reassemblyTimeouts.fetch_add(1, std::memory_order_relaxed);
+            auto next = std::next(it);
+            erase(it);
+            it = next;
+        } else {
+            ++it;
+        }
+    }
+}
+
+bool UdpReassembler::reserve(size_t size) {
+    if (size > memoryLimit) {
+        return false;
+    }
+    while (memoryUsed + size > memoryLimit) {
+        auto oldest = std::min_element(entries.begin(), entries.end(), [](const auto &a, const auto &b) {
+            return a.second.createdMs < b.second.createdMs;
+        });
+        reassemblyDrops.fetch_add(1, std::memory_order_relaxed);
+        erase(oldest);
+    }
+    memoryUsed += size;
+    return true;
+}
+
+void UdpReassembler::erase(std::map<Key, Entry>::iterator it) {
+    memoryUsed -= it->second.frameSize;
+    entries.erase(it);
+}
+
+size_t UdpReassembler::getPendingCount() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return entries.size();
+}
+
+void UdpReassembler::addMetrics(LinxMetricsSnapshot &snapshot) const {
+    snapshot.fragmentsReceived += fragmentsReceived.load(std::memory_order_relaxed);
+    snapshot.reassembledMessages += reassembledMessages.load(std::memory_order_relaxed);
+    snapshot.reassemblyTimeouts += reassemblyTimeouts.load(std::memory_order_relaxed);
+    snapshot.reassemblyDrops += reassemblyDrops.load(std::memory_order_relaxed);
+}
@@ -0,0 +1,58 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <vector>
+#include "LinxIpc.h"
+#include "LinxMetrics.h"
+
+// Header of every fragment datagram, fields in network order, followed by fragment data.
+// Fragment data are consecutive slices of serialized (and possibly compressed) message frame.
+struct UdpFragmentHeader {
+    uint32_t reqId;         // reqId of message | LINX_FRAGMENT_FLAG
+    uint32_t messageId;     // per sender counter
+    uint32_t frameSize;     // size of reassembled frame
+    uint32_t offset;        // offset of fragment data in frame
+    uint32_t fragmentSize;  // data size of every fragment except last one
+};
+
+// Collects fragments per sender and message, incomplete messages are dropped after timeout
+// or when memory limit would be exceeded (oldest first)
+class UdpReassembler {
+  public:
+    void configure(int timeoutMs, size_t memoryLimit);
+
+    // Returns true and fills frame when fragment completed the message
+    bool add(uint64_t sender, const uint8_t *datagram, size_t size, uint64_t nowMs, std::vector<uint8_t> *frame);
+
+    size_t getPendingCount() const;
+    void addMetrics(LinxMetricsSnapshot &snapshot) const;
+
+  private:
+    struct Entry {
+        std::vector<uint8_t> frame;
+        std::vector<bool> received;
+        uint32_t frameSize;
+        uint32_t fragmentSize;
+        uint32_t missing;
+        uint64_t createdMs;
+    };
+    using Key = std::pair<uint64_t, uint32_t>;
+
+    int timeoutMs = LINX_DEFAULT_REASSEMBLY_TIMEOUT;
+    size_t memoryLimit = LINX_DEFAULT_REASSEMBLY_MEMORY;
+    size_t memoryUsed = 0;
+    std::map<Key, Entry> entries;
+    mutable std::mutex mutex;
+
+    std::atomic<uint64_t> fragmentsReceived{0};
+    std::atomic<uint64_t> reassembledMessages{0};
+    std::atomic<uint64_t> reassemblyTimeouts{0};
+    std::atomic<uint64_t> reassemblyDrops{0};
+
+    void expire(uint64_t nowMs);
+    bool reserve(size_t size);
+    void erase(std::map<Key, Entry>::iterator it);
+};
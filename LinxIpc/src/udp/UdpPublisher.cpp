@@ -0,0 +1,54 @@
+#include "UdpLinx.h"
+#include "LinxTrace.h"
+
+UdpPublisher::UdpPublisher(const std::string &name, const std::shared_ptr<UdpProtocol::Socket> &socket,
+                           const std::vector<LinxTopic> &topics, uint16_t port)
+    : name(name), socket(socket) {
+    for (const auto &topic : topics) {
+        routes.push_back({topic.firstReqId, topic.lastReqId, PortInfo(topic.group, port)});
+    }
+}
+
+UdpPublisher::~UdpPublisher() {
+    socket->close();
+}
+
+int UdpPublisher::publish(const IMessage &message) {
+    uint32_t reqId = message.getReqId();
+    std::vector<const PortInfo *> sent;
+
+    for (const auto &route : routes) {
+        if (reqId < route.firstReqId || reqId > route.lastReqId) {
+            continue;
+        }
+        // Topics sharing group get single copy, subscribers filter by reqId
+        bool isSent = false;
+        for (const auto *to : sent) {
+            isSent = isSent || to->ip == route.to.ip;
+        }
+        if (isSent) {
+            continue;
+        }
+
+        auto ret = socket->send(message, route.to);
+        if (ret < 0) {
+            metrics.onSendError();
+            LINX_ERROR_RATELIMITED(CLIENT, "[%s] publish reqId: 0x%x to: %s error: %d", name.c_str(), reqId,
+                                   route.to.format().c_str(), ret);
+            return ret;
+        }
+        metrics.onSend(message.getSize());
+        sent.push_back(&route.to);
+    }
+    return sent.size();
+}
+
+LinxMetricsSnapshot UdpPublisher::getMetrics() const {
+    auto snapshot = metrics.snapshot(name);
+    socket->addMetrics(snapshot);
+    return snapshot;
+}
+
+std::string UdpPublisher::getName() const {
+    return name;
+}
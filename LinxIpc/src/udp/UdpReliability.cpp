@@ -0,0 +1,417 @@
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstring>
+#include <random>
+#include <arpa/inet.h>
+#include "UdpReliability.h"
+#include "UdpLinx.h"
+#include "Deadline.h"
+#include "LinxThreadOptions.h"
+#include "LinxTrace.h"
+
+namespace {
+
+// Sequence numbers wrap around, a is before b when it is less than half of sequence space behind
+bool isBefore(uint32_t a, uint32_t b) {
+    return static_cast<int32_t>(a - b) < 0;
+}
+
+uint32_t randomSession() {
+    std::random_device device;
+    return device();
+}
+
+// Granularity of waiting for window while other thread processes ACKs
+constexpr int windowPollMs = 5;
+
+} // namespace
+
+UdpReliability::UdpReliability(Transmit transmit, Drive drive)
+    : transmit(std::move(transmit)), drive(std::move(drive)), session(randomSession()) {}
+
+UdpReliability::~UdpReliability() {
+    stopTimer();
+}
+
+void UdpReliability::configure(bool enable, uint32_t windowSize, int sendTimeoutMs) {
+    std::lock_guard<std::mutex> lock(mutex);
+    this->windowSize = std::max<uint32_t>(windowSize, 1);
+    this->sendTimeoutMs = sendTimeoutMs;
+    enabled.store(enable, std::memory_order_relaxed);
+}
+
+bool UdpReliability::isEnabled() const {
+    return enabled.load(std::memory_order_relaxed);
+}
+
+bool UdpReliability::isReliable(const std::vector<uint8_t> &datagram) {
+    uint32_t reqId;
+    if (datagram.size() < sizeof(reqId)) {
+        return false;
+    }
+    memcpy(&reqId, datagram.data(), sizeof(reqId));
+    return (ntohl(reqId) & LINX_RELIABLE_FLAG) != 0;
+}
+
+int UdpReliability::send(const struct iovec *iov, int iovCount, const sockaddr_in &addr) {
+    std::unique_lock<std::mutex> lock(mutex);
+    SendState &state = senders[key(addr)];
+    state.addr = addr;
+
+    // Incoming ACKs are processed by this thread when nobody else receives from socket
+    Deadline deadline(sendTimeoutMs);
+    while (state.unacked.size() >= windowSize) {
+        int remainingMs = deadline.getRemainingTimeMs();
+        if (remainingMs == 0) {
+            return -2;
+        }
+        int waitMs = remainingMs == INFINITE_TIMEOUT ? windowPollMs : std::min(remainingMs, windowPollMs);
+        lock.unlock();
+        bool drove = drive(waitMs) >= 0;
+        lock.lock();
+        if (!drove && state.unacked.size() >= windowSize) {
+            acked.wait_for(lock, std::chrono::milliseconds(waitMs));
+        }
+    }
+
+    UdpReliableHeader header{};
+    header.reqId = htonl(LINX_RELIABLE_FLAG);
+    if (iovCount > 0 && iov[0].iov_len >= sizeof(uint32_t)) {
+        uint32_t reqId;
+        memcpy(&reqId, iov[0].iov_base, sizeof(reqId));
+        header.reqId |= reqId;
+    }
+    header.type = dataType;
+    header.session = htonl(session);
+    uint32_t sequence = state.nextSequence++;
+    header.sequence = htonl(sequence);
+    header.lowest = htonl(lowestUnacked(state, sequence));
+
+    // Datagram is copied once, the copy is kept for retransmission until acknowledged
+    Pending pending{};
+    pending.datagram.assign((uint8_t *)&header, (uint8_t *)&header + sizeof(header));
+    for (int i = 0; i < iovCount; i++) {
+        const uint8_t *data = static_cast<const uint8_t *>(iov[i].iov_base);
+        pending.datagram.insert(pending.datagram.end(), data, data + iov[i].iov_len);
+    }
+
+    struct iovec datagramIov = {pending.datagram.data(), pending.datagram.size()};
+    if (transmit(&datagramIov, 1, addr) < 0) {
+        return -1;
+    }
+
+    pending.sentNs = nowNs();
+    pending.dueNs = pending.sentNs + state.rtoNs;
+    if (pending.dueNs < timerWakeNs) {
+        timerWakeup.notify_one();
+    }
+    state.unacked.emplace(sequence, std::move(pending));
+    return 0;
+}
+
+bool UdpReliability::onReceive(std::vector<uint8_t> &datagram, const sockaddr_in &from) {
+    UdpReliableHeader header;
+    if (datagram.size() < sizeof(header)) {
+        LINX_ERROR_RATELIMITED(SOCKET, "IPC recv reliable datagram too short: %zu", datagram.size());
+        return false;
+    }
+    memcpy(&header, datagram.data(), sizeof(header));
+
+    if (header.type == ackType) {
+        onAck(datagram, header, from);
+        return false;
+    }
+    if (header.type != dataType || !onData(header, from)) {
+        return false;
+    }
+
+    datagram.erase(datagram.begin(), datagram.begin() + sizeof(header));
+    return true;
+}
+
+void UdpReliability::onAck(const std::vector<uint8_t> &datagram, const UdpReliableHeader &header,
+                           const sockaddr_in &from) {
+    if (ntohl(header.session) != session ||
+        datagram.size() < sizeof(header) + header.sackCount * sizeof(UdpSackBlock)) {
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(mutex);
+    auto it = senders.find(key(from));
+    if (it == senders.end()) {
+        return;
+    }
+
+    SendState &state = it->second;
+    uint32_t cumulative = ntohl(header.sequence);
+    std::vector<UdpSackBlock> blocks(header.sackCount);
+    memcpy(blocks.data(), datagram.data() + sizeof(header), blocks.size() * sizeof(UdpSackBlock));
+
+    uint64_t now = nowNs();
+    for (auto pending = state.unacked.begin(); pending != state.unacked.end();) {
+        uint32_t sequence = pending->first;
+        bool isAcked = isBefore(sequence, cumulative);
+        for (size_t i = 0; i < blocks.size() && !isAcked; i++) {
+            isAcked = !isBefore(sequence, ntohl(blocks[i].start)) && isBefore(sequence, ntohl(blocks[i].end));
+        }
+        if (!isAcked) {
+            ++pending;
+            continue;
+        }
+
+        // Karn's algorithm: retransmitted datagrams give ambiguous RTT samples
+        if (pending->second.retransmits == 0) {
+            updateRto(state, now - pending->second.sentNs);
+        }
+        pending = state.unacked.erase(pending);
+    }
+    acked.notify_all();
+}
+
+bool UdpReliability::onData(const UdpReliableHeader &header, const sockaddr_in &from) {
+    uint32_t sequence = ntohl(header.sequence);
+    uint32_t lowest = ntohl(header.lowest);
+    if (isBefore(sequence, lowest)) {
+        LINX_ERROR_RATELIMITED(SOCKET, "IPC recv reliable sequence: %u below sender lowest: %u", sequence, lowest);
+        return false;
+    }
+
+    std::lock_guard<std::mutex> lock(mutex);
+    ReceiveState &state = receivers[key(from)];
+
+    // New peer, restarted sender (new session) or restarted receiver: window starts at lowest sequence
+    // sender still retransmits, sequences below were delivered before
+    uint32_t senderSession = ntohl(header.session);
+    if (!state.started || state.session != senderSession) {
+        state = ReceiveState{};
+        state.started = true;
+        state.session = senderSession;
+        state.cumulative = lowest;
+    }
+
+    // Sequences below lowest were acknowledged or given up by sender after last retransmission,
+    // window must move past them or it would stall on the gap
+    if (isBefore(state.cumulative, lowest)) {
+        for (auto it = state.received.begin(); it != state.received.end();) {
+            it = isBefore(*it, lowest) ? state.received.erase(it) : std::next(it);
+        }
+        state.cumulative = lowest;
+        while (state.received.erase(state.cumulative) != 0) {
+            state.cumulative++;
+        }
+    }
+
+    if (sequence - state.cumulative >= maxReorder && !isBefore(sequence, state.cumulative)) {
+        LINX_ERROR_RATELIMITED(SOCKET, "IPC recv reliable sequence: %u out of window: %u", sequence, state.cumulative);
+        return false;
+    }
+
+    bool isDuplicate = isBefore(sequence, state.cumulative) || !state.received.insert(sequence).second;
+    if (!isDuplicate) {
+        while (state.received.erase(state.cumulative) != 0) {
+            state.cumulative++;
+        }
+    }
+
+    // Duplicates are acknowledged again, previous ACK might have been lost
+    sendAck(state, senderSession, from);
+    if (isDuplicate) {
+        duplicates.fetch_add(1, std::memory_order_relaxed);
+    }
+    return !isDuplicate;
+}
+
+void UdpReliability::sendAck(const ReceiveState &state, uint32_t ackedSession, const sockaddr_in &to) {
+    std::vector<UdpSackBlock> blocks;
+    for (auto it = state.received.begin(); it != state.received.end() && blocks.size() < maxSackBlocks;) {
+        uint32_t start = *it;
+        uint32_t end = start + 1;
+        while (++it != state.received.end() && *it == end) {
+            end++;
+        }
+        blocks.push_back({htonl(start), htonl(end)});
+    }
+
+    UdpReliableHeader header{};
+    header.reqId = htonl(LINX_RELIABLE_FLAG);
+    header.type = ackType;
+    header.sackCount = blocks.size();
+    header.session = htonl(ackedSession);
+    header.sequence = htonl(state.cumulative);
+
+    struct iovec iov[2] = {
+        {&header, sizeof(header)},
+        {blocks.data(), blocks.size() * sizeof(UdpSackBlock)},
+    };
+    if (transmit(iov, 2, to) < 0) {
+        LINX_ERROR_RATELIMITED(SOCKET, "IPC send reliable ACK error, errno: %d", errno);
+    }
+}
+
+int UdpReliability::retransmit() {
+    return retransmit(nowNs());
+}
+
+int UdpReliability::retransmit(uint64_t now) {
+    std::lock_guard<std::mutex> lock(mutex);
+    uint64_t nextDueNs = UINT64_MAX;
+    bool dropped = false;
+
+    for (auto &[peer, state] : senders) {
+        // Given up datagrams are dropped first, so that retransmissions carry up to date lowest sequence
+        for (auto it = state.unacked.begin(); it != state.unacked.end();) {
+            Pending &pending = it->second;
+            if (pending.dueNs > now || pending.retransmits < maxRetransmits) {
+                ++it;
+                continue;
+            }
+            LINX_ERROR_RATELIMITED(SOCKET, "IPC reliable delivery failed after %d retransmissions, sequence: %u",
+                                   pending.retransmits, it->first);
+            deliveryFailures.fetch_add(1, std::memory_order_relaxed);
+            it = state.unacked.erase(it);
+            dropped = true;
+        }
+        uint32_t lowest = htonl(lowestUnacked(state, state.nextSequence));
+
+        for (auto it = state.unacked.begin(); it != state.unacked.end();) {
+            Pending &pending = it->second;
+            if (pending.dueNs > now) {
+                nextDueNs = std::min(nextDueNs, pending.dueNs);
+                ++it;
+                continue;
+            }
+
+            memcpy(pending.datagram.data() + offsetof(UdpReliableHeader, lowest), &lowest, sizeof(lowest));
+            struct iovec iov = {pending.datagram.data(), pending.datagram.size()};
+            if (transmit(&iov, 1, state.addr) < 0) {
+                LINX_ERROR_RATELIMITED(SOCKET, "IPC reliable retransmission error, errno: %d", errno);
+            }
+            retransmits.fetch_add(1, std::memory_order_relaxed);
+            pending.retransmits++;
+
+            // Exponential backoff of timeout for every retransmission of the same datagram
+            pending.dueNs = now + std::min(state.rtoNs << pending.retransmits, maxRtoNs);
+            nextDueNs = std::min(nextDueNs, pending.dueNs);
+            ++it;
+        }
+    }
+
+    if (dropped) {
+        acked.notify_all();
+    }
+    if (nextDueNs == UINT64_MAX) {
+        return INFINITE_TIMEOUT;
+    }
+    // Rounded up so that caller does not wake up before datagram is due
+    return static_cast<int>((nextDueNs - now + 999999) / 1000000);
+}
+
+void UdpReliability::startTimer() {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (timerRunning) {
+        return;
+    }
+    timerRunning = true;
+    timer = std::thread(&UdpReliability::runTimer, this);
+}
+
+void UdpReliability::stopTimer() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        timerRunning = false;
+    }
+    timerWakeup.notify_one();
+    if (timer.joinable()) {
+        timer.join();
+    }
+}
+
+void UdpReliability::runTimer() {
+    LinxThreadOptions threadOptions;
+    threadOptions.name = "linx_retransmit";
+    threadOptions.applyToCurrentThread();
+
+    std::unique_lock<std::mutex> lock(mutex);
+    while (timerRunning) {
+        uint64_t dueNs = nextDueNs();
+        uint64_t now = nowNs();
+        if (dueNs > now) {
+            // Woken up by send() when new datagram is due earlier, or by stopTimer()
+            timerWakeNs = dueNs;
+            if (dueNs == UINT64_MAX) {
+                timerWakeup.wait(lock);
+            } else {
+                timerWakeup.wait_for(lock, std::chrono::nanoseconds(dueNs - now));
+            }
+            timerWakeNs = UINT64_MAX;
+            continue;
+        }
+
+        // ACKs waiting in socket are processed first, so that acknowledged datagrams are not retransmitted.
+        // drive() returns -1 when other thread receives, that thread processes ACKs itself.
+        lock.unlock();
+        for (int i = 0; i < maxTimerReads && drive(IMMEDIATE_TIMEOUT) > 0; i++) {
+        }
+        retransmit();
+        lock.lock();
+    }
+}
+
+// Called with mutex locked
+uint64_t UdpReliability::nextDueNs() const {
+    uint64_t dueNs = UINT64_MAX;
+    for (const auto &[peer, state] : senders) {
+        for (const auto &[sequence, pending] : state.unacked) {
+            dueNs = std::min(dueNs, pending.dueNs);
+        }
+    }
+    return dueNs;
+}
+
+// Lowest of unacknowledged sequences and sequence, in sequence number order (with wrap around)
+uint32_t UdpReliability::lowestUnacked(const SendState &state, uint32_t sequence) {
+    uint32_t lowest = sequence;
+    for (const auto &[unacked, pending] : state.unacked) {
+        if (isBefore(unacked, lowest)) {
+            lowest = unacked;
+        }
+    }
+    return lowest;
+}
+
+void UdpReliability::updateRto(SendState &state, uint64_t sampleNs) {
+    if (state.srttNs == 0) {
+        state.srttNs = sampleNs;
+        state.rttvarNs = sampleNs / 2;
+    } else {
+        uint64_t delta = state.srttNs > sampleNs ? state.srttNs - sampleNs : sampleNs - state.srttNs;
+        state.rttvarNs = (3 * state.rttvarNs + delta) / 4;
+        state.srttNs = (7 * state.srttNs + sampleNs) / 8;
+    }
+    state.rtoNs = std::clamp(state.srttNs + 4 * state.rttvarNs, minRtoNs, maxRtoNs);
+}
+
+size_t UdpReliability::getUnackedCount() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    size_t count = 0;
+    for (const auto &[peer, state] : senders) {
+        count += state.unacked.size();
+    }
+    return count;
+}
+
+void UdpReliability::addMetrics(LinxMetricsSnapshot &snapshot) const {
+    snapshot.retransmits += retransmits.load(std::memory_order_relaxed);
+    snapshot.duplicatesReceived += duplicates.load(std::memory_order_relaxed);
+    snapshot.deliveryFailures += deliveryFailures.load(std::memory_order_relaxed);
+}
+
+uint64_t UdpReliability::key(const sockaddr_in &addr) {
+    return ((uint64_t)addr.sin_addr.s_addr << 16) | addr.sin_port;
+}
+
+uint64_t UdpReliability::nowNs() {
+    auto now = std::chrono::steady_clock::now().time_since_epoch();
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(now).count();
+}
@@ -0,0 +1,141 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <set>
+#include <thread>
+#include <vector>
+#include <netinet/in.h>
+#include <sys/uio.h>
+#include "LinxIpc.h"
+#include "LinxMetrics.h"
+
+// Header of every reliable datagram, fields in network order, followed by original datagram (data)
+// or by sackCount UdpSackBlock entries (ACK)
+struct UdpReliableHeader {
+    uint32_t reqId;         // reqId of original datagram | LINX_RELIABLE_FLAG, LINX_RELIABLE_FLAG only for ACK
+    uint8_t type;           // UdpReliability::dataType or UdpReliability::ackType
+    uint8_t sackCount;      // ACK: number of selective ACK blocks
+    uint16_t reserved;
+    uint32_t session;       // random per sending socket, receiver resets its state when it changes
+    uint32_t sequence;      // data: per peer sequence number, ACK: all sequences below are received
+    uint32_t lowest;        // data: lowest sequence sender still retransmits, all sequences below are
+                            // acknowledged or given up, receiver moves its window up to it
+};
+
+// Range [start, end) of sequences received above cumulative ACK
+struct UdpSackBlock {
+    uint32_t start;
+    uint32_t end;
+};
+
+// Per peer sequence numbers, cumulative and selective ACKs, retransmission with RTT based timeout
+// (RFC 6298) and bounded send window. Datagrams are delivered once but not reordered.
+class UdpReliability {
+  public:
+    // Sends datagram to peer without reliability
+    using Transmit = std::function<ssize_t(const struct iovec *iov, int iovCount, const sockaddr_in &addr)>;
+    // Processes incoming datagrams for up to timeoutMs, returns number of datagrams read or -1 when other
+    // thread is receiving
+    using Drive = std::function<int(int timeoutMs)>;
+
+    static constexpr uint8_t dataType = 1;
+    static constexpr uint8_t ackType = 2;
+    static constexpr size_t maxSackBlocks = 16;
+    static constexpr int maxRetransmits = 8;
+    static constexpr uint64_t initialRtoNs = 100000000ULL;
+    static constexpr uint64_t minRtoNs = 5000000ULL;
+    static constexpr uint64_t maxRtoNs = 2000000000ULL;
+
+    UdpReliability(Transmit transmit, Drive drive);
+    ~UdpReliability();
+
+    void configure(bool enable, uint32_t windowSize, int sendTimeoutMs);
+    bool isEnabled() const;
+
+    // Sends datagram gathered from iov with reliable header, waits while peer window is full.
+    // Returns 0 on success, -1 on transmit error (errno set), -2 when window stayed full until timeout.
+    int send(const struct iovec *iov, int iovCount, const sockaddr_in &addr);
+
+    // Handles received reliable datagram: ACK is consumed, data is acknowledged and its header removed.
+    // Returns true when datagram must be delivered (first copy of data).
+    bool onReceive(std::vector<uint8_t> &datagram, const sockaddr_in &from);
+
+    // Retransmits datagrams with expired timeout, returns ms to next retransmission or INFINITE_TIMEOUT
+    int retransmit();
+    int retransmit(uint64_t nowNs);
+
+    // Background thread retransmitting at due time, so that datagrams of peer which only sends are
+    // retransmitted without traffic. Reads ACKs through drive before retransmitting.
+    void startTimer();
+    void stopTimer();
+
+    size_t getUnackedCount() const;
+    void addMetrics(LinxMetricsSnapshot &snapshot) const;
+
+    static bool isReliable(const std::vector<uint8_t> &datagram);
+
+  private:
+    struct Pending {
+        std::vector<uint8_t> datagram;
+        uint64_t sentNs;
+        uint64_t dueNs;
+        int retransmits;
+    };
+    struct SendState {
+        sockaddr_in addr;
+        uint32_t nextSequence = 0;
+        std::map<uint32_t, Pending> unacked;
+        uint64_t srttNs = 0;
+        uint64_t rttvarNs = 0;
+        uint64_t rtoNs = initialRtoNs;
+    };
+    struct ReceiveState {
+        bool started = false;
+        uint32_t session = 0;
+        uint32_t cumulative = 0;
+        std::set<uint32_t> received;
+    };
+
+    // Out of order sequences further than this from cumulative ACK are ignored
+    static constexpr uint32_t maxReorder = 65536;
+    // Datagrams read by timer before retransmitting, bounds time spent on ACKs under load
+    static constexpr int maxTimerReads = 64;
+
+    Transmit transmit;
+    Drive drive;
+    std::atomic<bool> enabled{false};
+    uint32_t windowSize = LINX_DEFAULT_RELIABLE_WINDOW;
+    int sendTimeoutMs = LINX_DEFAULT_RELIABLE_SEND_TIMEOUT;
+    const uint32_t session;
+
+    std::map<uint64_t, SendState> senders;
+    std::map<uint64_t, ReceiveState> receivers;
+    mutable std::mutex mutex;
+    std::condition_variable acked;
+
+    std::thread timer;
+    bool timerRunning = false;
+    uint64_t timerWakeNs = UINT64_MAX;
+    std::condition_variable timerWakeup;
+
+    std::atomic<uint64_t> retransmits{0};
+    std::atomic<uint64_t> duplicates{0};
+    std::atomic<uint64_t> deliveryFailures{0};
+
+    void onAck(const std::vector<uint8_t> &datagram, const UdpReliableHeader &header, const sockaddr_in &from);
+    bool onData(const UdpReliableHeader &header, const sockaddr_in &from);
+    void sendAck(const ReceiveState &state, uint32_t ackedSession, const sockaddr_in &to);
+    void updateRto(SendState &state, uint64_t sampleNs);
+    void runTimer();
+    uint64_t nextDueNs() const;
+
+    static uint32_t lowestUnacked(const SendState &state, uint32_t sequence);
+
+    static uint64_t key(const sockaddr_in &addr);
+    static uint64_t nowNs();
+};
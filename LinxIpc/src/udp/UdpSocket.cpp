@@ -1,13 +1,37 @@
+#include <algorithm>
+#include <climits>
+#include <chrono>
 #include <poll.h>
+#include <netinet/udp.h>
 #include <sys/ioctl.h>
 #include <unistd.h>
 #include <arpa/inet.h>
 #include "UdpSocket.h"
+#include "BusyPoll.h"
+#include "SocketTimestamp.h"
+#include "Deadline.h"
+#include "LinxSocketFilter.h"
 #include "LinxIpc.h"
 #include "LinxTrace.h"
 
 
-UdpSocket::UdpSocket() {
+namespace {
+
+// Returned by readDatagram() when socket was closed, never returned to caller of receive()
+constexpr int socketClosed = INT_MIN;
+
+int minTimeout(int timeoutMs, int otherMs) {
+    if (timeoutMs == INFINITE_TIMEOUT) {
+        return otherMs;
+    }
+    return otherMs == INFINITE_TIMEOUT ? timeoutMs : std::min(timeoutMs, otherMs);
+}
+
+} // namespace
+
+UdpSocket::UdpSocket()
+    : reliability([this](const struct iovec *iov, int iovCount, const sockaddr_in &addr) { return transmit(iov, iovCount, addr); },
+                  [this](int timeoutMs) { return driveReceive(timeoutMs); }) {
 }
 
 UdpSocket::~UdpSocket() {
@@ -18,117 +42,428 @@ int UdpSocket::getFd() const {
     return fd;
 }
 
-int UdpSocket::receive(RawMessagePtr *msg, std::unique_ptr<IIdentifier> *from, int timeoutMs) {
+int UdpSocket::getPollFd() const {
+    return pollFd.get(fd);
+}
+
+int UdpSocket::receive(RawMessagePtr *msg, std::unique_ptr<IIdentifier> *from, int timeoutMs, uint64_t *rxTimestamp) {
 
     if (this->fd < 0) {
-        LINX_ERROR("IPC recv on wrong IPC socket");
+        LINX_ERROR_RATELIMITED(SOCKET, "IPC recv on wrong IPC socket");
         return -1;
     }
 
-    struct pollfd fds[1];
-    fds[0].fd = this->fd;
-    fds[0].events = POLLIN;
+    Deadline deadline(timeoutMs);
+    std::lock_guard<std::mutex> lock(readMutex);
+    int ret = receiveSubscribed(msg, from, rxTimestamp, deadline);
+    updateBacklog();
+    return ret;
+}
 
-    int pollrc = poll(fds, 1, timeoutMs);
-    if (pollrc < 0) {
-        if (errno == EBADF) {
-            LINX_DEBUG("IPC recv socket closed IPC socket");
-            return 0;
-        } else {
-            LINX_ERROR("IPC recv error IPC socket, errno: %d", errno);
-            return -2;
+int UdpSocket::receiveSubscribed(RawMessagePtr *msg, std::unique_ptr<IIdentifier> *from, uint64_t *rxTimestamp,
+                                 const Deadline &deadline) {
+    // Messages of topics not subscribed are skipped, also those unpacked from containers or reliable datagrams
+    while (true) {
+        RawMessagePtr ipc;
+        std::unique_ptr<IIdentifier> sender;
+        std::unique_ptr<IIdentifier> *senderPtr = from ? &sender : nullptr;
+        uint64_t timestamp = 0;
+        int len = unbatcher.isEmpty() ? receiveMessage(&ipc, senderPtr, &timestamp, deadline)
+                                      : unbatcher.pop(&ipc, senderPtr, &timestamp);
+        if (len <= 0) {
+            return len;
         }
-    } else if (pollrc == 0) {
-        LINX_DEBUG("IPC recv timeout IPC socket");
-        return 0;
+        if (!isSubscribed(ipc->getReqId())) {
+            unsubscribedDrops.fetch_add(1, std::memory_order_relaxed);
+            continue;
+        }
+
+        if (from) {
+            *from = std::move(sender);
+        }
+        if (msg) {
+            *msg = std::move(ipc);
+        }
+        if (rxTimestamp) {
+            *rxTimestamp = timestamp;
+        }
+        return len;
     }
+}
 
-    int bytes_available = 0;
-    ioctl(this->fd, FIONREAD, &bytes_available);
-    std::vector<uint8_t> buffer(bytes_available);
+// Returns size of received frame, 0 on timeout or negative value on error
+int UdpSocket::receiveMessage(RawMessagePtr *msg, std::unique_ptr<IIdentifier> *from, uint64_t *rxTimestamp,
+                              const Deadline &deadline) {
+    Datagram datagram;
 
-    sockaddr_in client_address;
-    socklen_t address_length = sizeof(sockaddr_in);
-    memset(&client_address, 0, address_length);
+    // Fragments are collected until message is complete or timeout expires
+    while (true) {
+        int ret = nextDatagram(&datagram, deadline);
+        if (ret <= 0) {
+            return ret;
+        }
 
-    ssize_t len = recvfrom(this->fd, buffer.data(), bytes_available, 0,
-                    (struct sockaddr *)&client_address, &address_length);
-    if (len < 0) {
-        if (errno == EBADF) {
-            LINX_DEBUG("IPC recv socket closed IPC socket");
-            return 0;
-        } else {
-            LINX_ERROR("IPC recv error IPC socket, errno: %d", errno);
-            return -4;
+        if (!isFragment(datagram.data)) {
+            break;
+        }
+        uint64_t sender = ((uint64_t)datagram.address.sin_addr.s_addr << 16) | datagram.address.sin_port;
+        std::vector<uint8_t> frame;
+        if (reassembler.add(sender, datagram.data.data(), datagram.data.size(), nowMs(), &frame)) {
+            datagram.data = std::move(frame);
+            break;
         }
-    }
-    if (len != bytes_available) {
-        LINX_ERROR("IPC recv wrong size: %d for IPC socket", len);
-        return -5;
     }
 
-    auto ipc = RawMessage::deserialize(std::move(buffer));
+    int len = datagram.data.size();
+    *rxTimestamp = datagram.rxTimestamp;
+    if (checksum.isEnabled() && !checksum.verify(datagram.data)) {
+        LINX_ERROR_RATELIMITED(SOCKET, "IPC recv checksum mismatch from IPC socket: %s:%d",
+                               inet_ntoa(datagram.address.sin_addr), ntohs(datagram.address.sin_port));
+        return -7;
+    }
+    auto ipc = compression.decode(std::move(datagram.data));
     if (ipc == nullptr) {
-        LINX_ERROR("IPC recv deserialize failed for IPC socket");
-        return -6;
+        LINX_ERROR_RATELIMITED(SOCKET, "IPC recv deserialize failed for IPC socket");
+        return LINX_DESERIALIZE_ERROR;
+    }
+
+    PortInfo sender(inet_ntoa(datagram.address.sin_addr), ntohs(datagram.address.sin_port));
+    if (ipc->getReqId() == IPC_BATCH_MSG) {
+        if (!unbatcher.push(*ipc, sender, datagram.rxTimestamp)) {
+            LINX_ERROR_RATELIMITED(SOCKET, "IPC recv malformed batch from IPC socket: %s", sender.format().c_str());
+            return LINX_DESERIALIZE_ERROR;
+        }
+        return unbatcher.pop(msg, from, rxTimestamp);
     }
 
     if (from) {
-        *from = std::make_unique<PortInfo>(
-            inet_ntoa(client_address.sin_addr),
-            ntohs(client_address.sin_port)
-        );
+        *from = std::make_unique<PortInfo>(sender);
     }
+    *msg = std::move(ipc);
+    return len;
+}
+
+// Returns 1 when datagram to deliver was read, 0 on timeout or closed socket, negative value on error.
+// Reliability ACKs and duplicates are consumed, poll wakes up for due retransmissions.
+int UdpSocket::nextDatagram(Datagram *datagram, const Deadline &deadline) {
+    while (true) {
+        if (!pendingDatagrams.empty()) {
+            *datagram = std::move(pendingDatagrams.front());
+            pendingDatagrams.pop_front();
+            return 1;
+        }
+
+        int waitMs = deadline.getRemainingTimeMs();
+        if (reliability.isEnabled()) {
+            waitMs = minTimeout(waitMs, reliability.retransmit());
+        }
 
-    if (msg) {
-        *msg = std::move(ipc);
+        int ret = readDatagram(datagram, waitMs);
+        if (ret == socketClosed) {
+            return 0;
+        }
+        if (ret < 0) {
+            return ret;
+        }
+        if (ret == 0) {
+            if (deadline.getRemainingTimeMs() == 0) {
+                LINX_DEBUG(SOCKET, "IPC recv timeout IPC socket");
+                return 0;
+            }
+            continue;
+        }
+
+        if (reliability.isEnabled() && UdpReliability::isReliable(datagram->data) &&
+            !reliability.onReceive(datagram->data, datagram->address)) {
+            continue;
+        }
+        return 1;
     }
+}
 
-    return len;
+// Returns 1 when datagram was read, 0 on timeout, socketClosed or negative value on error
+int UdpSocket::readDatagram(Datagram *datagram, int timeoutMs) {
+    struct pollfd fds[1];
+    fds[0].fd = this->fd;
+    fds[0].events = POLLIN;
+
+    if (this->fd < 0) {
+        return socketClosed;
+    }
+
+    while (true) {
+        int pollrc = BusyPoll::poll(fds, 1, timeoutMs, spinUs.load(std::memory_order_relaxed));
+        if (pollrc < 0) {
+            if (errno == EBADF) {
+                LINX_DEBUG(SOCKET, "IPC recv socket closed IPC socket");
+                return socketClosed;
+            } else {
+                LINX_ERROR_RATELIMITED(SOCKET, "IPC recv error IPC socket, errno: %d", errno);
+                return -2;
+            }
+        } else if (pollrc == 0) {
+            return 0;
+        }
+
+        // Datagram is read into buffer reused while datagrams are dropped by subscription filter
+        int bytes_available = 0;
+        ioctl(this->fd, FIONREAD, &bytes_available);
+        rxBuffer.resize(bytes_available);
+        datagram->rxTimestamp = 0;
+
+        socklen_t address_length = sizeof(sockaddr_in);
+        memset(&datagram->address, 0, address_length);
+
+        ssize_t len = timestamping.load(std::memory_order_relaxed)
+            ? SocketTimestamp::recvfrom(this->fd, rxBuffer.data(), bytes_available,
+                        (struct sockaddr *)&datagram->address, &address_length, &datagram->rxTimestamp)
+            : recvfrom(this->fd, rxBuffer.data(), bytes_available, 0,
+                        (struct sockaddr *)&datagram->address, &address_length);
+        if (len < 0) {
+            if (errno == EBADF) {
+                LINX_DEBUG(SOCKET, "IPC recv socket closed IPC socket");
+                return socketClosed;
+            } else {
+                LINX_ERROR_RATELIMITED(SOCKET, "IPC recv error IPC socket, errno: %d", errno);
+                return -4;
+            }
+        }
+        if (len != bytes_available) {
+            LINX_ERROR_RATELIMITED(SOCKET, "IPC recv wrong size: %d for IPC socket", len);
+            return -5;
+        }
+
+        if (!isSubscribedDatagram(rxBuffer)) {
+            unsubscribedDrops.fetch_add(1, std::memory_order_relaxed);
+            timeoutMs = IMMEDIATE_TIMEOUT;
+            continue;
+        }
+        datagram->data.swap(rxBuffer);
+        return 1;
+    }
+}
+
+// Called by send() waiting for free window slot and by retransmission timer, reads socket only when
+// no other thread receives. Returns number of datagrams read or -1 when other thread receives.
+int UdpSocket::driveReceive(int timeoutMs) {
+    std::unique_lock<std::mutex> lock(readMutex, std::try_to_lock);
+    if (!lock.owns_lock()) {
+        return -1;
+    }
+
+    Datagram datagram;
+    if (readDatagram(&datagram, minTimeout(timeoutMs, reliability.retransmit())) != 1) {
+        return 0;
+    }
+    if (!UdpReliability::isReliable(datagram.data) || reliability.onReceive(datagram.data, datagram.address)) {
+        pendingDatagrams.push_back(std::move(datagram));
+        updateBacklog();
+    }
+    return 1;
+}
+
+// Called with readMutex locked
+void UdpSocket::updateBacklog() {
+    pollFd.setBacklog(!pendingDatagrams.empty() || !unbatcher.isEmpty());
 }
 
 int UdpSocket::send(const IMessage &message, const PortInfo &to) {
     if (this->fd < 0) {
-        LINX_ERROR("IPC send on wrong IPC socket: %s:%d", to.ip.c_str(), to.port);
+        LINX_ERROR_RATELIMITED(SOCKET, "IPC send on wrong IPC socket: %s:%d", to.ip.c_str(), to.port);
         return -1;
     }
 
+    // Frame is serialized into buffer reused by calling thread (socket is shared by sending threads),
+    // only messages which need fragmentation get a buffer of their own
+    static thread_local std::vector<uint8_t> threadBuffer;
+    std::vector<uint8_t> largeBuffer;
     uint32_t sendSize = message.getSize();
-    uint8_t buffer[sendSize];
-    uint32_t result = message.serialize(buffer, sendSize);
+    uint32_t bufferSize = sendSize + LinxFrameChecksum::trailerSize;
+    std::vector<uint8_t> &buffer = bufferSize <= maxUdpDatagramSize ? threadBuffer : largeBuffer;
+    buffer.resize(bufferSize);
+    uint32_t result = message.serialize(buffer.data(), sendSize);
 
     if (result == 0) {
-        LINX_ERROR("IPC send serialize error IPC socket: %s:%d, actual: %d, size: %d", to.ip.c_str(), to.port, result, sendSize);
+        LINX_ERROR_RATELIMITED(SOCKET, "IPC send serialize error IPC socket: %s:%d, actual: %d, size: %d", to.ip.c_str(), to.port, result, sendSize);
         return -2;
     }
 
+    // Read once, so that fragmentation decision and fragment size agree when option changes
+    uint32_t datagramSize = maxDatagramSize.load(std::memory_order_relaxed);
+    uint32_t reservedFlags = (compression.isEnabled() ? LINX_COMPRESSED_FLAG : 0) |
+                             (datagramSize != 0 ? LINX_FRAGMENT_FLAG : 0) |
+                             (reliability.isEnabled() ? LINX_RELIABLE_FLAG : 0);
+    if (message.getReqId() & reservedFlags) {
+        LINX_ERROR_RATELIMITED(SOCKET, "IPC send reserved reqId: 0x%x IPC socket: %s:%d", message.getReqId(), to.ip.c_str(), to.port);
+        return -6;
+    }
+
+    uint8_t *frame = buffer.data();
+    std::vector<uint8_t> compressed;
+    if (compression.compress(buffer.data(), result, compressed)) {
+        result = compressed.size();
+        compressed.resize(result + LinxFrameChecksum::trailerSize);
+        frame = compressed.data();
+    }
+    if (checksum.isEnabled()) {
+        result = checksum.append(frame, result);
+    }
+
     sockaddr_in addr{};
     addr.sin_family = AF_INET;
     addr.sin_port = htons(to.port);
     if (inet_pton(AF_INET, to.ip.c_str(), &addr.sin_addr) != 1) {
-        LINX_ERROR("IPC send invalid IP address IPC socket: %s:%d", to.ip.c_str(), to.port);
+        LINX_ERROR_RATELIMITED(SOCKET, "IPC send invalid IP address IPC socket: %s:%d", to.ip.c_str(), to.port);
         return -3;
     }
 
-    ssize_t len = sendto(this->fd, buffer, result, 0, (struct sockaddr *)&addr, sizeof(addr));
+    // ACKs come from group members, not from group address the datagram was sent to, so reliable
+    // datagrams to groups would never be acknowledged
+    uint32_t destination = ntohl(addr.sin_addr.s_addr);
+    if (reliability.isEnabled() && (IN_MULTICAST(destination) || destination == INADDR_BROADCAST)) {
+        LINX_ERROR_RATELIMITED(SOCKET, "IPC send reliable to multicast or broadcast IPC socket: %s:%d", to.ip.c_str(), to.port);
+        return -8;
+    }
 
+    uint32_t reliableSize = reliability.isEnabled() ? sizeof(UdpReliableHeader) : 0;
+    if (datagramSize != 0 && result + reliableSize > datagramSize) {
+        return sendFragments(frame, result, datagramSize, addr, to);
+    }
+
+    struct iovec iov = {frame, result};
+    return sendDatagram(&iov, 1, addr, to);
+}
+
+int UdpSocket::sendDatagram(const struct iovec *iov, int iovCount, const sockaddr_in &addr, const PortInfo &to) {
+    if (reliability.isEnabled()) {
+        int ret = reliability.send(iov, iovCount, addr);
+        if (ret == -2) {
+            LINX_ERROR_RATELIMITED(SOCKET, "IPC send window full IPC socket: %s:%d", to.ip.c_str(), to.port);
+            return -7;
+        }
+        if (ret < 0) {
+            LINX_ERROR_RATELIMITED(SOCKET, "IPC send error IPC socket: %s:%d, errno: %d", to.ip.c_str(), to.port, errno);
+            return -4;
+        }
+        return 0;
+    }
+
+    size_t size = 0;
+    for (int i = 0; i < iovCount; i++) {
+        size += iov[i].iov_len;
+    }
+
+    ssize_t len = transmit(iov, iovCount, addr);
     if (len < 0) {
-        LINX_ERROR("IPC send error IPC socket: %s:%d(0x%x), errno: %d", to.ip.c_str(), to.port, message.getReqId(), errno);
+        LINX_ERROR_RATELIMITED(SOCKET, "IPC send error IPC socket: %s:%d, errno: %d", to.ip.c_str(), to.port, errno);
         return -4;
     }
 
-    if ((uint32_t)len != result) {
-        LINX_ERROR("IPC send wrong size: %d for IPC socket: %s:%d", len, to.ip.c_str(), to.port);
+    if ((size_t)len != size) {
+        LINX_ERROR_RATELIMITED(SOCKET, "IPC send wrong size: %d for IPC socket: %s:%d", len, to.ip.c_str(), to.port);
         return -5;
     }
 
     return 0;
 }
 
+ssize_t UdpSocket::transmit(const struct iovec *iov, int iovCount, const sockaddr_in &addr) {
+    struct msghdr msg{};
+    msg.msg_name = const_cast<sockaddr_in *>(&addr);
+    msg.msg_namelen = sizeof(addr);
+    msg.msg_iov = const_cast<struct iovec *>(iov);
+    msg.msg_iovlen = iovCount;
+    return sendmsg(this->fd, &msg, 0);
+}
+
+int UdpSocket::sendFragments(const uint8_t *frame, uint32_t frameSize, uint32_t datagramSize, const sockaddr_in &addr,
+                             const PortInfo &to) {
+    uint32_t reliableSize = reliability.isEnabled() ? sizeof(UdpReliableHeader) : 0;
+    uint32_t fragmentSize = datagramSize - sizeof(UdpFragmentHeader) - reliableSize;
+    uint32_t reqId;
+    memcpy(&reqId, frame, sizeof(reqId));
+
+    UdpFragmentHeader header{};
+    header.reqId = reqId | htonl(LINX_FRAGMENT_FLAG);
+    header.messageId = htonl(nextMessageId.fetch_add(1, std::memory_order_relaxed));
+    header.frameSize = htonl(frameSize);
+    header.fragmentSize = htonl(fragmentSize);
+
+    // Header and slice of frame are gathered by kernel, frame is not copied
+    for (uint32_t offset = 0; offset < frameSize; offset += fragmentSize) {
+        uint32_t dataSize = std::min(fragmentSize, frameSize - offset);
+        header.offset = htonl(offset);
+
+        struct iovec iov[2] = {
+            {&header, sizeof(header)},
+            {const_cast<uint8_t *>(frame + offset), dataSize},
+        };
+        if (int ret = sendDatagram(iov, 2, addr, to); ret < 0) {
+            return ret;
+        }
+        fragmentsSent.fetch_add(1, std::memory_order_relaxed);
+    }
+    return 0;
+}
+
+bool UdpSocket::isSubscribed(uint32_t reqId) const {
+    // Sockets without subscription skip shared pointer load
+    if (!subscribed.load(std::memory_order_acquire)) {
+        return true;
+    }
+    auto ranges = std::atomic_load(&subscription);
+    return !ranges || isSubscribed(*ranges, reqId);
+}
+
+bool UdpSocket::isSubscribed(const std::vector<LinxSocketFilter::Range> &ranges, uint32_t reqId) {
+    if (reqId < IPC_SIG_BASE) {
+        return true;
+    }
+    auto it = std::upper_bound(ranges.begin(), ranges.end(), reqId,
+                               [](uint32_t id, const LinxSocketFilter::Range &range) { return id < range.first; });
+    return it != ranges.begin() && reqId <= std::prev(it)->second;
+}
+
+// Checks reqId in first word of datagram, with flag bits of enabled features masked
+bool UdpSocket::isSubscribedDatagram(const std::vector<uint8_t> &datagram) const {
+    uint32_t reqId;
+    if (!subscribed.load(std::memory_order_acquire)) {
+        return true;
+    }
+    auto ranges = std::atomic_load(&subscription);
+    if (!ranges || datagram.size() < sizeof(reqId)) {
+        return true;
+    }
+    memcpy(&reqId, datagram.data(), sizeof(reqId));
+    reqId = ntohl(reqId);
+
+    // Reliable datagrams have to be acknowledged, their messages are filtered after decoding
+    if (reliability.isEnabled() && (reqId & LINX_RELIABLE_FLAG)) {
+        return true;
+    }
+    uint32_t flags = (compression.isEnabled() ? LINX_COMPRESSED_FLAG : 0) |
+                     (maxDatagramSize.load(std::memory_order_relaxed) != 0 ? LINX_FRAGMENT_FLAG : 0);
+    return isSubscribed(*ranges, reqId & ~flags);
+}
+
+bool UdpSocket::isFragment(const std::vector<uint8_t> &datagram) const {
+    uint32_t reqId;
+    if (maxDatagramSize.load(std::memory_order_relaxed) == 0 || datagram.size() < sizeof(reqId)) {
+        return false;
+    }
+    memcpy(&reqId, datagram.data(), sizeof(reqId));
+    return (ntohl(reqId) & LINX_FRAGMENT_FLAG) != 0;
+}
+
+uint64_t UdpSocket::nowMs() {
+    auto now = std::chrono::steady_clock::now().time_since_epoch();
+    return std::chrono::duration_cast<std::chrono::milliseconds>(now).count();
+}
+
 int UdpSocket::flush() {
 
     if (this->fd < 0) {
-        LINX_ERROR("IPC flush on wrong IPC socket");
+        LINX_ERROR(SOCKET, "IPC flush on wrong IPC socket");
         return -1;
     }
 
@@ -148,25 +483,32 @@ int UdpSocket::flush() {
 }
 
 void UdpSocket::close() {
+    // Timer reads and writes socket, it is stopped before socket is closed
+    reliability.stopTimer();
     if (this->fd >= 0) {
         ::shutdown(this->fd, SHUT_RDWR);
         ::close(this->fd);
         this->fd = -1;
     }
+    pollFd.close();
 }
 
 int UdpSocket::open() {
     if (this->fd >= 0) {
-        LINX_ERROR("IPC open on already opened IPC socket");
+        LINX_ERROR(SOCKET, "IPC open on already opened IPC socket");
         return -1;
     }
 
     if ((this->fd = socket(AF_INET, SOCK_DGRAM, 0)) < 0) {
         this->fd = -1;
-        LINX_ERROR("Cannot open IPC socket");
+        LINX_ERROR(SOCKET, "Cannot open IPC socket");
         return -1;
     }
 
+    // Reopened after close(), which stopped retransmission timer
+    if (reliability.isEnabled()) {
+        reliability.startTimer();
+    }
     return 0;
 }
 
@@ -185,11 +527,11 @@ int UdpSocket::bind(uint16_t port, const std::string &multicastIp) {
 int UdpSocket::joinMulticastGroup(const std::string &multicastIp) {
 
     if (this->fd < 0) {
-        LINX_ERROR("IPC joinMulticastGroup on wrong IPC socket");
+        LINX_ERROR(SOCKET, "IPC joinMulticastGroup on wrong IPC socket");
         return -1;
     }
 
-    LINX_INFO("Setting up multicast membership for IPC socket: %s", multicastIp.c_str());
+    LINX_INFO(SOCKET, "Setting up multicast membership for IPC socket: %s", multicastIp.c_str());
     struct ip_mreq mreq{};
     mreq.imr_interface.s_addr = INADDR_ANY;
     inet_aton(multicastIp.c_str(), &mreq.imr_multiaddr);
@@ -200,11 +542,11 @@ int UdpSocket::joinMulticastGroup(const std::string &multicastIp) {
 int UdpSocket::setBroadcast(bool enable) {
 
     if (this->fd < 0) {
-        LINX_ERROR("IPC setBroadcast on wrong IPC socket");
+        LINX_ERROR(SOCKET, "IPC setBroadcast on wrong IPC socket");
         return -1;
     }
 
-    LINX_INFO("Setting up broadcast for IPC socket");
+    LINX_INFO(SOCKET, "Setting up broadcast for IPC socket");
     int enable_val = enable ? 1 : 0;
     return setsockopt(fd, SOL_SOCKET, SO_BROADCAST, &enable_val, sizeof(enable_val));
 }
@@ -212,14 +554,213 @@ int UdpSocket::setBroadcast(bool enable) {
 int UdpSocket::setMulticastTtl(int ttl) {
 
     if (this->fd < 0) {
-        LINX_ERROR("IPC setMulticastTtl on wrong IPC socket");
+        LINX_ERROR(SOCKET, "IPC setMulticastTtl on wrong IPC socket");
         return -1;
     }
 
     int loop = 1;
 
-    LINX_INFO("Setting up multicast for IPC socket");
+    LINX_INFO(SOCKET, "Setting up multicast for IPC socket");
     auto result1 = setsockopt(fd, IPPROTO_IP, IP_MULTICAST_TTL, &ttl, sizeof(ttl));
     auto result2 = setsockopt(fd, IPPROTO_IP, IP_MULTICAST_LOOP, &loop, sizeof(loop));
     return result1 < 0 ? result1 : result2;
 }
+
+int UdpSocket::setReusePort(bool enable) {
+
+    if (this->fd < 0) {
+        LINX_ERROR(SOCKET, "IPC setReusePort on wrong IPC socket");
+        return -1;
+    }
+
+    LINX_INFO(SOCKET, "Setting up port reuse for IPC socket");
+    int enable_val = enable ? 1 : 0;
+    return setsockopt(fd, SOL_SOCKET, SO_REUSEPORT, &enable_val, sizeof(enable_val));
+}
+
+int UdpSocket::setBusyPoll(int spinUs, bool kernelBusyPoll) {
+
+    if (this->fd < 0) {
+        LINX_ERROR(SOCKET, "IPC setBusyPoll on wrong IPC socket");
+        return -1;
+    }
+
+    LINX_INFO(SOCKET, "Setting up busy poll: %d us for IPC socket", spinUs);
+    this->spinUs.store(spinUs, std::memory_order_relaxed);
+    if (kernelBusyPoll) {
+        return setsockopt(fd, SOL_SOCKET, SO_BUSY_POLL, &spinUs, sizeof(spinUs));
+    }
+    return 0;
+}
+
+int UdpSocket::setTimestamping(bool enable) {
+    if (this->fd < 0) {
+        LINX_ERROR(SOCKET, "IPC setTimestamping on wrong IPC socket");
+        return -1;
+    }
+
+    if (SocketTimestamp::enable(this->fd, enable) < 0) {
+        LINX_ERROR(SOCKET, "IPC setTimestamping error IPC socket, errno: %d", errno);
+        return -2;
+    }
+
+    this->timestamping.store(enable, std::memory_order_relaxed);
+    return 0;
+}
+
+int UdpSocket::setCompression(uint32_t thresholdBytes, const std::shared_ptr<LinxCompressor> &compressor) {
+    LINX_INFO(SOCKET, "Setting up compression threshold: %u for IPC socket", thresholdBytes);
+    std::lock_guard<std::mutex> lock(configMutex);
+    compression.configure(thresholdBytes, compressor);
+    return applySocketFilter();
+}
+
+int UdpSocket::setChecksum(bool enable) {
+    LINX_INFO(SOCKET, "Setting up checksum: %d for IPC socket", enable);
+    checksum.configure(enable);
+    return 0;
+}
+
+int UdpSocket::setFragmentation(uint32_t maxDatagramSize, int reassemblyTimeoutMs, size_t reassemblyMemoryLimit) {
+    uint32_t minDatagramSize = sizeof(UdpFragmentHeader) + sizeof(UdpReliableHeader);
+    if (maxDatagramSize != 0 && (maxDatagramSize <= minDatagramSize || maxDatagramSize > maxUdpDatagramSize)) {
+        LINX_ERROR(SOCKET, "IPC setFragmentation invalid datagram size: %u", maxDatagramSize);
+        return -1;
+    }
+
+    LINX_INFO(SOCKET, "Setting up fragmentation datagram size: %u for IPC socket", maxDatagramSize);
+    std::lock_guard<std::mutex> lock(configMutex);
+    this->maxDatagramSize.store(maxDatagramSize, std::memory_order_relaxed);
+    reassembler.configure(reassemblyTimeoutMs, reassemblyMemoryLimit);
+    return applySocketFilter();
+}
+
+int UdpSocket::setReliable(bool enable, uint32_t windowSize, int sendTimeoutMs) {
+    LINX_INFO(SOCKET, "Setting up reliable mode: %d, window: %u for IPC socket", enable, windowSize);
+    std::lock_guard<std::mutex> lock(configMutex);
+    reliability.configure(enable, windowSize, sendTimeoutMs);
+    if (enable) {
+        reliability.startTimer();
+    } else {
+        reliability.stopTimer();
+    }
+    return applySocketFilter();
+}
+
+int UdpSocket::setSubscription(const std::vector<LinxTopic> &topics) {
+    std::vector<LinxSocketFilter::Range> ranges;
+    for (const auto &topic : topics) {
+        if (topic.firstReqId > topic.lastReqId) {
+            LINX_ERROR(SOCKET, "IPC setSubscription invalid reqId range: 0x%x-0x%x", topic.firstReqId, topic.lastReqId);
+            return -1;
+        }
+        ranges.emplace_back(topic.firstReqId, topic.lastReqId);
+    }
+
+    // Sorted and merged, so that lookup is binary search over disjoint ranges
+    auto merged = LinxSocketFilter::merge(std::move(ranges));
+
+    // Socket option, userspace ranges and kernel filter are changed together, receiving thread keeps
+    // reading without lock and sees either old or new ranges
+    std::lock_guard<std::mutex> lock(configMutex);
+
+    // Socket bound to any address receives only groups it joined, not groups joined by other sockets
+    int all = merged.empty() ? 1 : 0;
+    if (this->fd >= 0 && setsockopt(fd, IPPROTO_IP, IP_MULTICAST_ALL, &all, sizeof(all)) < 0) {
+        LINX_ERROR(SOCKET, "IPC setSubscription error IPC socket, errno: %d", errno);
+        return -2;
+    }
+
+    LINX_INFO(SOCKET, "Setting up subscription of %zu reqId ranges for IPC socket", merged.size());
+    std::shared_ptr<const std::vector<LinxSocketFilter::Range>> updated;
+    if (!merged.empty()) {
+        updated = std::make_shared<const std::vector<LinxSocketFilter::Range>>(std::move(merged));
+    }
+    std::atomic_store(&subscription, updated);
+    subscribed.store(updated != nullptr, std::memory_order_release);
+    return applySocketFilter();
+}
+
+int UdpSocket::setSignalFilter(const std::vector<uint32_t> &sigsel) {
+    if (this->fd < 0) {
+        LINX_ERROR(SOCKET, "IPC setSignalFilter on wrong IPC socket");
+        return -1;
+    }
+
+    LINX_INFO(SOCKET, "Setting up signal filter of %zu reqIds for IPC socket", sigsel.size());
+    std::lock_guard<std::mutex> lock(configMutex);
+    signalFilter = LinxSocketFilter::toRanges(sigsel);
+    return applySocketFilter();
+}
+
+// Kernel filter accepts reqIds of signal filter which are also subscribed, reqId flags of enabled features
+// are masked and reliable datagrams always pass, so that they are acknowledged
+int UdpSocket::applySocketFilter() {
+    auto topics = std::atomic_load(&subscription);
+    if (this->fd < 0 || (signalFilter.empty() && !topics)) {
+        return detachSocketFilter();
+    }
+
+    std::vector<LinxSocketFilter::Range> ranges = signalFilter.empty() ? *topics : signalFilter;
+    if (!signalFilter.empty() && topics) {
+        // Both sorted and merged, keep only their intersection
+        ranges.clear();
+        for (const auto &wanted : signalFilter) {
+            for (const auto &topic : *topics) {
+                uint32_t first = std::max(wanted.first, topic.first);
+                uint32_t last = std::min(wanted.second, topic.second);
+                if (first <= last) {
+                    ranges.emplace_back(first, last);
+                }
+            }
+        }
+    }
+
+    uint32_t flagMask = (compression.isEnabled() ? LINX_COMPRESSED_FLAG : 0) |
+                        (maxDatagramSize.load(std::memory_order_relaxed) != 0 ? LINX_FRAGMENT_FLAG : 0);
+    uint32_t passFlags = reliability.isEnabled() ? LINX_RELIABLE_FLAG : 0;
+    auto program = LinxSocketFilter::build(ranges, sizeof(struct udphdr), flagMask, passFlags);
+    if (program.empty()) {
+        LINX_ERROR(SOCKET, "IPC socket filter too large, reqId ranges: %zu", ranges.size());
+        detachSocketFilter();
+        return -3;
+    }
+    if (LinxSocketFilter::attach(this->fd, program) < 0) {
+        LINX_ERROR(SOCKET, "IPC attach socket filter error IPC socket, errno: %d", errno);
+        return -2;
+    }
+    socketFilterAttached = true;
+    return 0;
+}
+
+int UdpSocket::detachSocketFilter() {
+    if (this->fd < 0 || !socketFilterAttached) {
+        return 0;
+    }
+    socketFilterAttached = false;
+    return LinxSocketFilter::attach(this->fd, {});
+}
+
+void UdpSocket::addMetrics(LinxMetricsSnapshot &snapshot) const {
+    snapshot.unsubscribedDrops += unsubscribedDrops.load(std::memory_order_relaxed);
+    snapshot.fragmentsSent += fragmentsSent.load(std::memory_order_relaxed);
+    reassembler.addMetrics(snapshot);
+    reliability.addMetrics(snapshot);
+    checksum.addMetrics(snapshot);
+}
+
+int UdpSocket::getLocalPort() const {
+
+    if (this->fd < 0) {
+        LINX_ERROR(SOCKET, "IPC getLocalPort on wrong IPC socket");
+        return -1;
+    }
+
+    sockaddr_in addr{};
+    socklen_t address_length = sizeof(addr);
+    if (getsockname(fd, (struct sockaddr *)&addr, &address_length) < 0) {
+        LINX_ERROR(SOCKET, "IPC getsockname failed, errno: %d", errno);
+        return -2;
+    }
+    return ntohs(addr.sin_port);
+}
@@ -1,10 +1,22 @@
 #pragma once
 
+#include <deque>
+#include <memory>
+#include <mutex>
 #include <sys/socket.h>
 #include <sys/un.h>
 #include "LinxIpc.h"
 #include "GenericSocket.h"
 #include "UdpLinx.h"
+#include "LinxFrameCompression.h"
+#include "LinxFrameChecksum.h"
+#include "UdpFragmentation.h"
+#include "UdpReliability.h"
+#include "LinxBatch.h"
+#include "LinxSocketFilter.h"
+#include "LinxPollFd.h"
+
+class Deadline;
 
 class UdpSocket : public GenericSocket<PortInfo> {
   public:
@@ -12,11 +24,24 @@ class UdpSocket : public GenericSocket<PortInfo> {
     virtual ~UdpSocket();
 
     virtual int getFd() const;
+    virtual int getPollFd() const;
 
     virtual int send(const IMessage &message, const Identifier &to);
-    virtual int receive(RawMessagePtr *msg, std::unique_ptr<IIdentifier> *from, int timeout);
+    virtual int receive(RawMessagePtr *msg, std::unique_ptr<IIdentifier> *from, int timeout,
+                        uint64_t *rxTimestamp = nullptr);
 
     virtual int flush();
+    virtual int setBusyPoll(int spinUs, bool kernelBusyPoll);
+    virtual int setTimestamping(bool enable);
+    virtual int setCompression(uint32_t thresholdBytes, const std::shared_ptr<LinxCompressor> &compressor);
+    virtual int setChecksum(bool enable);
+    virtual int setFragmentation(uint32_t maxDatagramSize, int reassemblyTimeoutMs, size_t reassemblyMemoryLimit);
+    virtual int setReliable(bool enable, uint32_t windowSize, int sendTimeoutMs);
+    // Deliver only messages with reqId of topics (and internal messages) and only from joined multicast groups,
+    // empty topics deliver everything
+    int setSubscription(const std::vector<LinxTopic> &topics);
+    virtual int setSignalFilter(const std::vector<uint32_t> &sigsel);
+    virtual void addMetrics(LinxMetricsSnapshot &snapshot) const;
     virtual void close();
 
     virtual int open();
@@ -24,7 +49,69 @@ class UdpSocket : public GenericSocket<PortInfo> {
     virtual int joinMulticastGroup(const std::string &multicastIp);
     virtual int setBroadcast(bool enable);
     virtual int setMulticastTtl(int ttl);
+    virtual int setReusePort(bool enable);
+    virtual int getLocalPort() const;
 
   protected:
+    struct Datagram {
+        std::vector<uint8_t> data;
+        sockaddr_in address;
+        uint64_t rxTimestamp;
+    };
+
     int fd = -1;
+    // Options below are read by sending and receiving threads without lock, setters may run concurrently
+    std::atomic<int> spinUs{0};
+    std::atomic<bool> timestamping{false};
+    LinxFrameCompression compression;
+    LinxFrameChecksum checksum;
+    std::atomic<uint32_t> maxDatagramSize{0};
+    std::atomic<uint32_t> nextMessageId{0};
+    std::atomic<uint64_t> fragmentsSent{0};
+    UdpReassembler reassembler;
+    UdpReliability reliability;
+    // Held by thread reading from socket, datagrams read by send() waiting for ACKs are queued for receive()
+    std::mutex readMutex;
+    std::deque<Datagram> pendingDatagrams;
+    // Readable also while pendingDatagrams or unbatcher is not empty, socket fd alone is not
+    mutable LinxPollFd pollFd;
+    LinxUnbatcher<PortInfo> unbatcher;
+    // Sorted disjoint reqId ranges of subscribed topics, swapped atomically (std::atomic_load/atomic_store)
+    // so that receiving thread never blocks setSubscription(), nullptr when not subscribed
+    std::shared_ptr<const std::vector<LinxSocketFilter::Range>> subscription;
+    std::atomic<bool> subscribed{false};
+    // Serializes setters with kernel filter rebuild, never held by sending or receiving thread
+    std::mutex configMutex;
+    // Read buffer reused for datagrams dropped by subscription
+    std::vector<uint8_t> rxBuffer;
+    // Single reqId ranges of setSignalFilter(), applied only by kernel filter, guarded by configMutex
+    std::vector<std::pair<uint32_t, uint32_t>> signalFilter;
+    bool socketFilterAttached = false;
+    std::atomic<uint64_t> unsubscribedDrops{0};
+
+    // IPv4 limit: 65535 - IP header - UDP header
+    static constexpr uint32_t maxUdpDatagramSize = 65507;
+
+    // Every datagram leaves through transmit(), overridden by tests to simulate lossy network
+    virtual ssize_t transmit(const struct iovec *iov, int iovCount, const sockaddr_in &addr);
+
+    int sendDatagram(const struct iovec *iov, int iovCount, const sockaddr_in &addr, const PortInfo &to);
+    int sendFragments(const uint8_t *frame, uint32_t frameSize, uint32_t datagramSize, const sockaddr_in &addr,
+                      const PortInfo &to);
+    int receiveSubscribed(RawMessagePtr *msg, std::unique_ptr<IIdentifier> *from, uint64_t *rxTimestamp,
+                          const Deadline &deadline);
+    int receiveMessage(RawMessagePtr *msg, std::unique_ptr<IIdentifier> *from, uint64_t *rxTimestamp,
+                       const Deadline &deadline);
+    int nextDatagram(Datagram *datagram, const Deadline &deadline);
+    int readDatagram(Datagram *datagram, int timeoutMs);
+    int driveReceive(int timeoutMs);
+    void updateBacklog();
+    bool isFragment(const std::vector<uint8_t> &datagram) const;
+    bool isSubscribed(uint32_t reqId) const;
+    static bool isSubscribed(const std::vector<LinxSocketFilter::Range> &ranges, uint32_t reqId);
+    // Called with configMutex held
+    int applySocketFilter();
+    int detachSocketFilter();
+    bool isSubscribedDatagram(const std::vector<uint8_t> &datagram) const;
+    static uint64_t nowMs();
 };
\ No newline at end of file
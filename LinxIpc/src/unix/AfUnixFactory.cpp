@@ -1,36 +1,38 @@
 #include <sstream>
 #include <random>
 #include "AfUnixSocket.h"
+#include "LinxNameService.h"
 #include "LinxEventFd.h"
 #include "LinxQueue.h"
 #include "GenericSimpleServer.tpp"
 #include "GenericServer.tpp"
 #include "GenericClient.tpp"
+#include "GenericClientPool.tpp"
 
 namespace AfUnixFactory {
 
 std::shared_ptr<AfUnixSimpleServer> createSimpleServer(const std::string &socketName) {
     auto socket = std::make_shared<AfUnixSocket>(socketName);
     if (socket->open() < 0) {
-        LINX_ERROR("Failed to open AF_UNIX socket for server: %s", socketName.c_str());
+        LINX_ERROR(SOCKET, "Failed to open AF_UNIX socket for server: %s", socketName.c_str());
         return nullptr;
     }
 
-    LINX_INFO("Created AF_UNIX server: %s(%d), socket: %s", socketName.c_str(), socket->getFd(), socketName.c_str());
+    LINX_INFO(SOCKET, "Created AF_UNIX server: %s(%d), socket: %s", socketName.c_str(), socket->getFd(), socketName.c_str());
     return std::make_shared<AfUnixSimpleServer>(socketName, socket);
 }
 
 std::shared_ptr<AfUnixServer> createServer(const std::string &socketName, size_t queueSize) {
     auto socket = std::make_shared<AfUnixSocket>(socketName);
     if (socket->open() < 0) {
-        LINX_ERROR("Failed to open AF_UNIX socket for server: %s", socketName.c_str());
+        LINX_ERROR(SOCKET, "Failed to open AF_UNIX socket for server: %s", socketName.c_str());
         return nullptr;
     }
 
     auto efd = std::make_unique<LinxEventFd>();
     auto queue = std::make_unique<LinxQueue>(std::move(efd), queueSize);
 
-    LINX_INFO("Created AF_UNIX worker server: %s(%d), socket: %s", socketName.c_str(), socket->getFd(), socketName.c_str());
+    LINX_INFO(SOCKET, "Created AF_UNIX worker server: %s(%d), socket: %s", socketName.c_str(), socket->getFd(), socketName.c_str());
     return std::make_shared<AfUnixServer>(socketName, socket, std::move(queue));
 }
 
@@ -41,12 +43,41 @@ std::shared_ptr<AfUnixClient> createClient(const std::string &serverSocket) {
 
     auto socket = std::make_shared<AfUnixSocket>(clientId);
     if (socket->open() < 0) {
-        LINX_ERROR("Failed to open AF_UNIX socket for client: %s", clientId.c_str());
+        LINX_ERROR(SOCKET, "Failed to open AF_UNIX socket for client: %s", clientId.c_str());
         return nullptr;
     }
 
-    LINX_INFO("Created AF_UNIX client: %s(%d) -> server socket: %s", clientId.c_str(), socket->getFd(), serverSocket.c_str());
+    LINX_INFO(SOCKET, "Created AF_UNIX client: %s(%d) -> server socket: %s", clientId.c_str(), socket->getFd(), serverSocket.c_str());
     return std::make_shared<AfUnixClient>(clientId, socket, UnixInfo(serverSocket));
 }
 
+std::shared_ptr<AfUnixClientPool> createClientPool(size_t queueSize) {
+    static std::mt19937 gen(std::random_device{}());
+    std::uniform_int_distribution<> dis(0, 65535);
+    std::string poolId = "client_pool_" + std::to_string(dis(gen));
+
+    auto socket = std::make_shared<AfUnixSocket>(poolId);
+    if (socket->open() < 0) {
+        LINX_ERROR(SOCKET, "Failed to open AF_UNIX socket for client pool: %s", poolId.c_str());
+        return nullptr;
+    }
+
+    LINX_INFO(SOCKET, "Created AF_UNIX client pool: %s(%d)", poolId.c_str(), socket->getFd());
+    return std::make_shared<AfUnixClientPool>(poolId, socket, queueSize);
+}
+
+std::shared_ptr<AfUnixClient> resolveClient(LinxNameResolver &resolver, const std::string &serviceName, int timeoutMs) {
+    auto endpoint = resolver.resolve(serviceName, timeoutMs);
+    if (endpoint.empty()) {
+        LINX_ERROR(SOCKET, "Failed to resolve AF_UNIX server: %s", serviceName.c_str());
+        return nullptr;
+    }
+    return createClient(endpoint);
+}
+
 } // namespace AfUnixFactory
+
+template class GenericSimpleServer<UnixInfo>;
+template class GenericServer<UnixInfo>;
+template class GenericClient<UnixInfo>;
+template class GenericClientPool<UnixInfo>;
@@ -2,8 +2,11 @@
 #include <sys/ioctl.h>
 #include <unistd.h>
 #include "AfUnixSocket.h"
+#include "BusyPoll.h"
+#include "SocketTimestamp.h"
 #include "LinxIpc.h"
 #include "LinxTrace.h"
+#include "LinxSocketFilter.h"
 
 AfUnixSocket::AfUnixSocket(const std::string &socketName) {
     this->socketName = socketName;
@@ -15,13 +18,13 @@ AfUnixSocket::~AfUnixSocket() {
 
 int AfUnixSocket::open() {
     if (this->fd >= 0) {
-        LINX_INFO("IPC socket already connected for IPC");
+        LINX_INFO(SOCKET, "IPC socket already connected for IPC");
         return -1;
     }
 
     if ((this->fd = socket(AF_UNIX, SOCK_DGRAM, 0)) < 0) {
         this->fd = -1;
-        LINX_ERROR("Cannot open IPC socket");
+        LINX_ERROR(SOCKET, "Cannot open IPC socket");
         return -1;
     }
 
@@ -30,7 +33,7 @@ int AfUnixSocket::open() {
     if (bind(this->fd, (const struct sockaddr *)&this->address, address_length) < 0) {
         ::close(this->fd);
         this->fd = -1;
-        LINX_ERROR("Cannot bind IPC socket");
+        LINX_ERROR(SOCKET, "Cannot bind IPC socket");
         return -1;
     }
 
@@ -43,30 +46,40 @@ void AfUnixSocket::close() {
         ::close(this->fd);
         this->fd = -1;
     }
+    pollFd.close();
 }
 
-int AfUnixSocket::receive(RawMessagePtr *msg, std::unique_ptr<IIdentifier> *from, int timeoutMs) {
+int AfUnixSocket::receive(RawMessagePtr *msg, std::unique_ptr<IIdentifier> *from, int timeoutMs,
+                          uint64_t *rxTimestamp) {
 
     if (this->fd < 0) {
-        LINX_ERROR("IPC recv on wrong IPC socket");
+        LINX_ERROR_RATELIMITED(SOCKET, "IPC recv on wrong IPC socket");
         return -1;
     }
 
+    int ret = unbatcher.isEmpty() ? receiveDatagram(msg, from, rxTimestamp, timeoutMs)
+                                  : unbatcher.pop(msg, from, rxTimestamp);
+    pollFd.setBacklog(!unbatcher.isEmpty());
+    return ret;
+}
+
+int AfUnixSocket::receiveDatagram(RawMessagePtr *msg, std::unique_ptr<IIdentifier> *from, uint64_t *rxTimestamp,
+                                  int timeoutMs) {
     struct pollfd fds[1];
     fds[0].fd = this->fd;
     fds[0].events = POLLIN;
 
-    int pollrc = poll(fds, 1, timeoutMs);
+    int pollrc = BusyPoll::poll(fds, 1, timeoutMs, spinUs.load(std::memory_order_relaxed));
     if (pollrc < 0) {
         if (errno == EBADF) {
-            LINX_DEBUG("IPC recv socket closed IPC socket");
+            LINX_DEBUG(SOCKET, "IPC recv socket closed IPC socket");
             return 0;
         } else {
-            LINX_ERROR("IPC recv error IPC socket, errno: %d", errno);
+            LINX_ERROR_RATELIMITED(SOCKET, "IPC recv error IPC socket, errno: %d", errno);
             return -2;
         }
     } else if (pollrc == 0) {
-        LINX_DEBUG("IPC recv timeout IPC socket");
+        LINX_DEBUG(SOCKET, "IPC recv timeout IPC socket");
         return 0;
     }
 
@@ -78,26 +91,43 @@ int AfUnixSocket::receive(RawMessagePtr *msg, std::unique_ptr<IIdentifier> *from
     socklen_t address_length = sizeof(struct sockaddr_un);
     memset(&client_address, 0, address_length);
 
-    ssize_t len = recvfrom(this->fd, buffer.data(), bytes_available, 0,
+    uint64_t timestamp = 0;
+    ssize_t len = timestamping.load(std::memory_order_relaxed)
+        ? SocketTimestamp::recvfrom(this->fd, buffer.data(), bytes_available,
+                        (struct sockaddr *)&client_address, &address_length, &timestamp)
+        : recvfrom(this->fd, buffer.data(), bytes_available, 0,
                         (struct sockaddr *)&client_address, &address_length);
     if (len < 0) {
         if (errno == EBADF) {
-            LINX_DEBUG("IPC recv socket closed IPC socket");
+            LINX_DEBUG(SOCKET, "IPC recv socket closed IPC socket");
             return 0;
         } else {
-            LINX_ERROR("IPC recv error IPC socket, errno: %d", errno);
+            LINX_ERROR_RATELIMITED(SOCKET, "IPC recv error IPC socket, errno: %d", errno);
             return -4;
         }
     }
     if (len != bytes_available) {
-        LINX_ERROR("IPC recv wrong size: %d for IPC socket", len);
+        LINX_ERROR_RATELIMITED(SOCKET, "IPC recv wrong size: %d for IPC socket", len);
         return -5;
     }
 
-    auto ipc = RawMessage::deserialize(std::move(buffer));
+    if (checksum.isEnabled() && !checksum.verify(buffer)) {
+        LINX_ERROR_RATELIMITED(SOCKET, "IPC recv checksum mismatch from IPC socket: %s", &client_address.sun_path[1]);
+        return -7;
+    }
+
+    auto ipc = compression.decode(std::move(buffer));
     if (ipc == nullptr) {
-        LINX_ERROR("IPC recv deserialize failed for IPC socket");
-        return -6;
+        LINX_ERROR_RATELIMITED(SOCKET, "IPC recv deserialize failed for IPC socket");
+        return LINX_DESERIALIZE_ERROR;
+    }
+
+    if (ipc->getReqId() == IPC_BATCH_MSG) {
+        if (!unbatcher.push(*ipc, UnixInfo(&client_address.sun_path[1]), timestamp)) {
+            LINX_ERROR_RATELIMITED(SOCKET, "IPC recv malformed batch from IPC socket: %s", &client_address.sun_path[1]);
+            return LINX_DESERIALIZE_ERROR;
+        }
+        return unbatcher.pop(msg, from, rxTimestamp);
     }
 
     if (from) {
@@ -107,6 +137,9 @@ int AfUnixSocket::receive(RawMessagePtr *msg, std::unique_ptr<IIdentifier> *from
     if (msg) {
         *msg = std::move(ipc);
     }
+    if (rxTimestamp) {
+        *rxTimestamp = timestamp;
+    }
 
     return len;
 }
@@ -114,31 +147,54 @@ int AfUnixSocket::receive(RawMessagePtr *msg, std::unique_ptr<IIdentifier> *from
 int AfUnixSocket::send(const IMessage &message, const UnixInfo &to) {
 
     if (this->fd < 0) {
-        LINX_ERROR("IPC send on wrong IPC socket");
+        LINX_ERROR_RATELIMITED(SOCKET, "IPC send on wrong IPC socket");
         return -1;
     }
 
+    // Frame is serialized into buffer reused by calling thread (socket is shared by sending threads),
+    // unusually large messages get a buffer of their own
+    static thread_local std::vector<uint8_t> threadBuffer;
+    std::vector<uint8_t> largeBuffer;
     uint32_t sendSize = message.getSize();
-    uint8_t buffer[sendSize];
-    uint32_t result = message.serialize(buffer, sendSize);
+    uint32_t bufferSize = sendSize + LinxFrameChecksum::trailerSize;
+    std::vector<uint8_t> &buffer = bufferSize <= maxReusedBufferSize ? threadBuffer : largeBuffer;
+    buffer.resize(bufferSize);
+    uint32_t result = message.serialize(buffer.data(), sendSize);
 
     if (result == 0) {
-        LINX_ERROR("IPC send serialize error IPC socket, actual: %d, size: %d", result, sendSize);
+        LINX_ERROR_RATELIMITED(SOCKET, "IPC send serialize error IPC socket, actual: %d, size: %d", result, sendSize);
         return -2;
     }
 
+    uint8_t *frame = buffer.data();
+    std::vector<uint8_t> compressed;
+    if (compression.isEnabled()) {
+        if (message.getReqId() & LINX_COMPRESSED_FLAG) {
+            LINX_ERROR_RATELIMITED(SOCKET, "IPC send reserved reqId: 0x%x IPC socket", message.getReqId());
+            return -5;
+        }
+        if (compression.compress(buffer.data(), result, compressed)) {
+            result = compressed.size();
+            compressed.resize(result + LinxFrameChecksum::trailerSize);
+            frame = compressed.data();
+        }
+    }
+    if (checksum.isEnabled()) {
+        result = checksum.append(frame, result);
+    }
+
     struct sockaddr_un address {};
     socklen_t address_length = createAddress(&address, to.getValue());
 
-    ssize_t len = sendto(this->fd, buffer, result, 0, (struct sockaddr *)&address, address_length);
+    ssize_t len = sendto(this->fd, frame, result, 0, (struct sockaddr *)&address, address_length);
 
     if (len < 0) {
-        LINX_ERROR("IPC send error IPC socket, errno: %d", errno);
+        LINX_ERROR_RATELIMITED(SOCKET, "IPC send error IPC socket, errno: %d", errno);
         return -3;
     }
 
     if ((uint32_t)len != result) {
-        LINX_ERROR("IPC send wrong size: %d for IPC socket", len);
+        LINX_ERROR_RATELIMITED(SOCKET, "IPC send wrong size: %d for IPC socket", len);
         return -4;
     }
 
@@ -154,7 +210,7 @@ socklen_t AfUnixSocket::createAddress(struct sockaddr_un *address, const std::st
 
 int AfUnixSocket::flush() {
     if (this->fd < 0) {
-        LINX_ERROR("IPC flush on wrong IPC socket");
+        LINX_ERROR(SOCKET, "IPC flush on wrong IPC socket");
         return -1;
     }
 
@@ -173,6 +229,113 @@ int AfUnixSocket::flush() {
     return bytes_available;
 }
 
+int AfUnixSocket::setBusyPoll(int spinUs, bool kernelBusyPoll) {
+    if (this->fd < 0) {
+        LINX_ERROR(SOCKET, "IPC setBusyPoll on wrong IPC socket");
+        return -1;
+    }
+
+    // SO_BUSY_POLL applies to network devices only, AF_UNIX relies on userspace spinning
+    LINX_INFO(SOCKET, "Setting up busy poll: %d us for IPC socket", spinUs);
+    this->spinUs.store(spinUs, std::memory_order_relaxed);
+    return 0;
+}
+
+int AfUnixSocket::setTimestamping(bool enable) {
+    if (this->fd < 0) {
+        LINX_ERROR(SOCKET, "IPC setTimestamping on wrong IPC socket");
+        return -1;
+    }
+
+    if (SocketTimestamp::enable(this->fd, enable) < 0) {
+        LINX_ERROR(SOCKET, "IPC setTimestamping error IPC socket, errno: %d", errno);
+        return -2;
+    }
+
+    this->timestamping.store(enable, std::memory_order_relaxed);
+    return 0;
+}
+
+int AfUnixSocket::setCompression(uint32_t thresholdBytes, const std::shared_ptr<LinxCompressor> &compressor) {
+    LINX_INFO(SOCKET, "Setting up compression threshold: %u for IPC socket", thresholdBytes);
+    std::lock_guard<std::mutex> lock(configMutex);
+    compression.configure(thresholdBytes, compressor);
+    return applySocketFilter();
+}
+
+int AfUnixSocket::setChecksum(bool enable) {
+    LINX_INFO(SOCKET, "Setting up checksum: %d for IPC socket", enable);
+    checksum.configure(enable);
+    return 0;
+}
+
+// AF_UNIX datagrams are not limited by MTU
+int AfUnixSocket::setFragmentation(uint32_t maxDatagramSize, int, size_t) {
+    if (maxDatagramSize != 0) {
+        LINX_ERROR(SOCKET, "IPC setFragmentation not supported by AF_UNIX socket");
+        return -1;
+    }
+    return 0;
+}
+
+// AF_UNIX datagrams are not lost
+int AfUnixSocket::setReliable(bool enable, uint32_t, int) {
+    if (enable) {
+        LINX_ERROR(SOCKET, "IPC setReliable not supported by AF_UNIX socket");
+        return -1;
+    }
+    return 0;
+}
+
+int AfUnixSocket::setSignalFilter(const std::vector<uint32_t> &sigsel) {
+    if (this->fd < 0) {
+        LINX_ERROR(SOCKET, "IPC setSignalFilter on wrong IPC socket");
+        return -1;
+    }
+
+    LINX_INFO(SOCKET, "Setting up signal filter of %zu reqIds for IPC socket", sigsel.size());
+    std::lock_guard<std::mutex> lock(configMutex);
+    signalFilter = sigsel;
+    return applySocketFilter();
+}
+
+// AF_UNIX filter sees datagram payload from offset 0, compressed flag is masked when compression is enabled
+int AfUnixSocket::applySocketFilter() {
+    if (this->fd < 0 || signalFilter.empty()) {
+        return detachSocketFilter();
+    }
+
+    auto ranges = LinxSocketFilter::toRanges(signalFilter);
+    auto program = LinxSocketFilter::build(ranges, 0, compression.isEnabled() ? LINX_COMPRESSED_FLAG : 0, 0);
+    if (program.empty()) {
+        LINX_ERROR(SOCKET, "IPC socket filter too large, reqId ranges: %zu", ranges.size());
+        detachSocketFilter();
+        return -3;
+    }
+    if (LinxSocketFilter::attach(this->fd, program) < 0) {
+        LINX_ERROR(SOCKET, "IPC attach socket filter error IPC socket, errno: %d", errno);
+        return -2;
+    }
+    socketFilterAttached = true;
+    return 0;
+}
+
+int AfUnixSocket::detachSocketFilter() {
+    if (this->fd < 0 || !socketFilterAttached) {
+        return 0;
+    }
+    socketFilterAttached = false;
+    return LinxSocketFilter::attach(this->fd, {});
+}
+
+void AfUnixSocket::addMetrics(LinxMetricsSnapshot &snapshot) const {
+    checksum.addMetrics(snapshot);
+}
+
 int AfUnixSocket::getFd() const {
     return fd;
 }
+
+int AfUnixSocket::getPollFd() const {
+    return pollFd.get(fd);
+}
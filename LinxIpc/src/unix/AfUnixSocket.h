@@ -1,10 +1,16 @@
 #pragma once
 
+#include <atomic>
+#include <mutex>
 #include <sys/socket.h>
 #include <sys/un.h>
 #include "LinxIpc.h"
 #include "GenericSocket.h"
 #include "UnixLinx.h"
+#include "LinxFrameCompression.h"
+#include "LinxFrameChecksum.h"
+#include "LinxBatch.h"
+#include "LinxPollFd.h"
 
 class AfUnixSocket : public GenericSocket<UnixInfo> {
   public:
@@ -12,18 +18,50 @@ class AfUnixSocket : public GenericSocket<UnixInfo> {
     virtual ~AfUnixSocket();
 
     virtual int getFd() const;
+    virtual int getPollFd() const;
 
     virtual int send(const IMessage &message, const Identifier &to);
-    virtual int receive(RawMessagePtr *msg, std::unique_ptr<IIdentifier> *from, int timeoutMs);
+    virtual int receive(RawMessagePtr *msg, std::unique_ptr<IIdentifier> *from, int timeoutMs,
+                        uint64_t *rxTimestamp = nullptr);
 
     virtual int flush();
+    virtual int setBusyPoll(int spinUs, bool kernelBusyPoll);
+    virtual int setTimestamping(bool enable);
+    virtual int setCompression(uint32_t thresholdBytes, const std::shared_ptr<LinxCompressor> &compressor);
+    virtual int setChecksum(bool enable);
+    virtual int setFragmentation(uint32_t maxDatagramSize, int reassemblyTimeoutMs, size_t reassemblyMemoryLimit);
+    virtual int setReliable(bool enable, uint32_t windowSize, int sendTimeoutMs);
+    virtual int setSignalFilter(const std::vector<uint32_t> &sigsel);
+    virtual void addMetrics(LinxMetricsSnapshot &snapshot) const;
     virtual int open();
     virtual void close();
 
   protected:
     int fd = -1;
+    // Options below are read by sending and receiving threads without lock, setters may run concurrently
+    std::atomic<int> spinUs{0};
+    std::atomic<bool> timestamping{false};
+    LinxFrameCompression compression;
+    LinxFrameChecksum checksum;
+    LinxUnbatcher<UnixInfo> unbatcher;
+    // Readable also while unbatcher is not empty, socket fd alone is not
+    mutable LinxPollFd pollFd;
+    // Serializes setters with kernel filter rebuild, never held by sending or receiving thread
+    std::mutex configMutex;
+    // Guarded by configMutex
+    std::vector<uint32_t> signalFilter;
+    bool socketFilterAttached = false;
     struct sockaddr_un address {};
     std::string socketName;
 
+    // Largest send buffer kept for reuse by sending thread
+    static constexpr uint32_t maxReusedBufferSize = 65536;
+
+    int receiveDatagram(RawMessagePtr *msg, std::unique_ptr<IIdentifier> *from, uint64_t *rxTimestamp,
+                        int timeoutMs);
+
+    // Called with configMutex held
+    int applySocketFilter();
+    int detachSocketFilter();
     socklen_t createAddress(struct sockaddr_un *address, const std::string &socketName);
 };
@@ -0,0 +1,56 @@
+#pragma once
+
+#include <cstring>
+#include <string>
+#include <vector>
+#include <arpa/inet.h>
+#include "RawMessage.h"
+
+// Name service message payload: generation (4 bytes, network order, 0 in requests), name, '\0', endpoint
+namespace LinxNameRecord {
+
+constexpr size_t maxNameSize = 255;
+
+struct Record {
+    std::string name;
+    std::string endpoint;
+    uint32_t generation = 0;
+};
+
+inline bool isValid(const std::string &value, bool allowEmpty) {
+    return (allowEmpty || !value.empty()) && value.size() <= maxNameSize && value.find('\0') == std::string::npos;
+}
+
+inline RawMessage encode(uint32_t reqId, const Record &record) {
+    std::vector<uint8_t> payload(sizeof(uint32_t) + record.name.size() + 1 + record.endpoint.size());
+    uint32_t generation = htonl(record.generation);
+    memcpy(payload.data(), &generation, sizeof(generation));
+    memcpy(payload.data() + sizeof(uint32_t), record.name.data(), record.name.size());
+    memcpy(payload.data() + sizeof(uint32_t) + record.name.size() + 1, record.endpoint.data(), record.endpoint.size());
+    return RawMessage(reqId, std::move(payload));
+}
+
+// Returns false on malformed payload
+inline bool decode(const RawMessage &message, Record *record) {
+    const uint8_t *data = message.getPayload();
+    uint32_t size = message.getPayloadSize();
+    if (size <= sizeof(uint32_t)) {
+        return false;
+    }
+
+    const char *text = reinterpret_cast<const char *>(data + sizeof(uint32_t));
+    size_t textSize = size - sizeof(uint32_t);
+    const char *separator = static_cast<const char *>(memchr(text, '\0', textSize));
+    if (separator == nullptr) {
+        return false;
+    }
+
+    uint32_t generation;
+    memcpy(&generation, data, sizeof(generation));
+    record->generation = ntohl(generation);
+    record->name.assign(text, separator);
+    record->endpoint.assign(separator + 1, text + textSize);
+    return isValid(record->name, false) && isValid(record->endpoint, true);
+}
+
+} // namespace LinxNameRecord
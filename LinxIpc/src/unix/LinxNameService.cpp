@@ -0,0 +1,363 @@
+#include <random>
+#include "LinxNameService.h"
+#include "AfUnixSocket.h"
+#include "LinxNameRecord.h"
+#include "LinxMessageIds.h"
+#include "Deadline.h"
+#include "LinxThreadOptions.h"
+#include "LinxTrace.h"
+
+namespace {
+
+// Leases are checked and unanswered requests are resent at least this often
+constexpr int pollTimeout = 100;
+
+} // namespace
+
+std::unique_ptr<LinxNameService> LinxNameService::create(const std::string &socketName, int leaseMs) {
+    if (leaseMs <= 0) {
+        LINX_ERROR(SERVER, "Invalid name service lease: %d", leaseMs);
+        return nullptr;
+    }
+    auto server = AfUnixFactory::createSimpleServer(socketName);
+    if (server == nullptr) {
+        return nullptr;
+    }
+    return std::unique_ptr<LinxNameService>(new LinxNameService(server, leaseMs));
+}
+
+LinxNameService::LinxNameService(const std::shared_ptr<AfUnixSimpleServer> &server, int leaseMs)
+    : server(server), lease(leaseMs), nextGeneration(std::random_device{}() | 1) {
+}
+
+LinxNameService::~LinxNameService() {
+    stop();
+}
+
+bool LinxNameService::start() {
+    if (running.exchange(true)) {
+        return true;
+    }
+    LinxThreadOptions threadOptions;
+    threadOptions.name = "ns_" + server->getName();
+    thread = std::thread([this, threadOptions]() {
+        threadOptions.applyToCurrentThread();
+        task();
+    });
+    LINX_INFO(SERVER, "[%s] name service started", server->getName().c_str());
+    return true;
+}
+
+void LinxNameService::stop() {
+    if (!running.exchange(false)) {
+        return;
+    }
+    if (thread.joinable()) {
+        thread.join();
+    }
+    LINX_INFO(SERVER, "[%s] name service stopped", server->getName().c_str());
+}
+
+size_t LinxNameService::getRegisteredCount() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return entries.size();
+}
+
+void LinxNameService::task() {
+    while (running) {
+        auto msg = server->receive(pollTimeout);
+        if (msg != nullptr) {
+            handle(*msg);
+        }
+        expire();
+    }
+}
+
+void LinxNameService::handle(const LinxReceivedMessage &msg) {
+    LinxNameRecord::Record record;
+    auto reqId = msg.message->getReqId();
+    const auto *from = dynamic_cast<const UnixInfo *>(msg.from.get());
+    if (from == nullptr || !LinxNameRecord::decode(*msg.message, &record)) {
+        LINX_ERROR_RATELIMITED(SERVER, "[%s] malformed name service request reqId: 0x%x",
+                               server->getName().c_str(), reqId);
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(mutex);
+    switch (reqId) {
+    case IPC_NAME_REGISTER: {
+        if (record.endpoint.empty()) {
+            return;
+        }
+        // Refresh of registration taken over by another resolver (e.g. restarted server) is ignored
+        auto it = entries.find(record.name);
+        if (it != entries.end() && record.generation != 0 && it->second.owner != from->getValue()) {
+            sendUpdate(record.name, *from);
+            break;
+        }
+        // Anything but refresh or resend of the same registration is new one
+        bool isNew = it == entries.end() || it->second.owner != from->getValue() ||
+                     it->second.endpoint != record.endpoint ||
+                     (record.generation != 0 && record.generation != it->second.generation);
+        auto &entry = entries[record.name];
+        entry.expiry = std::chrono::steady_clock::now() + lease;
+        if (isNew) {
+            entry.endpoint = record.endpoint;
+            entry.owner = from->getValue();
+            entry.generation = nextGeneration++;
+            LINX_INFO(SERVER, "[%s] registered: %s -> %s", server->getName().c_str(), record.name.c_str(),
+                      record.endpoint.c_str());
+            notify(record.name);
+        }
+        sendUpdate(record.name, *from);
+        break;
+    }
+    case IPC_NAME_UNREGISTER: {
+        // Late unregistration of previous owner must not remove registration of restarted server
+        auto it = entries.find(record.name);
+        if (it != entries.end() && it->second.owner == from->getValue()) {
+            entries.erase(it);
+            LINX_INFO(SERVER, "[%s] unregistered: %s", server->getName().c_str(), record.name.c_str());
+            notify(record.name);
+        }
+        break;
+    }
+    case IPC_NAME_QUERY:
+        watchers[record.name].insert(from->getValue());
+        sendUpdate(record.name, *from);
+        break;
+    default:
+        LINX_ERROR_RATELIMITED(SERVER, "[%s] unknown name service request reqId: 0x%x",
+                               server->getName().c_str(), reqId);
+        break;
+    }
+}
+
+void LinxNameService::expire() {
+    std::lock_guard<std::mutex> lock(mutex);
+    auto now = std::chrono::steady_clock::now();
+    for (auto it = entries.begin(); it != entries.end();) {
+        if (it->second.expiry > now) {
+            ++it;
+            continue;
+        }
+        std::string name = it->first;
+        it = entries.erase(it);
+        LINX_INFO(SERVER, "[%s] registration expired: %s", server->getName().c_str(), name.c_str());
+        notify(name);
+    }
+}
+
+void LinxNameService::notify(const std::string &name) {
+    auto it = watchers.find(name);
+    if (it == watchers.end()) {
+        return;
+    }
+    for (auto watcher = it->second.begin(); watcher != it->second.end();) {
+        if (sendUpdate(name, UnixInfo(*watcher)) < 0) {
+            watcher = it->second.erase(watcher);
+        } else {
+            ++watcher;
+        }
+    }
+    if (it->second.empty()) {
+        watchers.erase(it);
+    }
+}
+
+int LinxNameService::sendUpdate(const std::string &name, const UnixInfo &to) {
+    LinxNameRecord::Record record{name, "", 0};
+    auto it = entries.find(name);
+    if (it != entries.end()) {
+        record.endpoint = it->second.endpoint;
+        record.generation = it->second.generation;
+    }
+    return server->send(LinxNameRecord::encode(IPC_NAME_UPDATE, record), to);
+}
+
+std::shared_ptr<LinxNameResolver> LinxNameResolver::create(const std::string &serviceName, int refreshMs) {
+    if (refreshMs <= 0) {
+        LINX_ERROR(CLIENT, "Invalid name resolver refresh interval: %d", refreshMs);
+        return nullptr;
+    }
+
+    static std::mt19937 gen(std::random_device{}());
+    std::uniform_int_distribution<> dis(0, 65535);
+    std::string resolverId = "resolver_" + std::to_string(dis(gen)) + "_" + serviceName;
+
+    auto socket = std::make_shared<AfUnixSocket>(resolverId);
+    if (socket->open() < 0) {
+        LINX_ERROR(CLIENT, "Failed to open AF_UNIX socket for name resolver: %s", resolverId.c_str());
+        return nullptr;
+    }
+    return std::shared_ptr<LinxNameResolver>(new LinxNameResolver(socket, serviceName, refreshMs));
+}
+
+LinxNameResolver::LinxNameResolver(const std::shared_ptr<AfUnixSocket> &socket, const std::string &serviceName,
+                                   int refreshMs)
+    : socket(socket), service(serviceName), refreshInterval(refreshMs) {
+    LinxThreadOptions threadOptions;
+    threadOptions.name = "nr_" + serviceName;
+    thread = std::thread([this, threadOptions]() {
+        threadOptions.applyToCurrentThread();
+        task();
+    });
+}
+
+LinxNameResolver::~LinxNameResolver() {
+    running = false;
+    if (thread.joinable()) {
+        thread.join();
+    }
+    for (const auto &[name, registration] : registrations) {
+        sendRecord(IPC_NAME_UNREGISTER, name, "");
+    }
+    socket->close();
+}
+
+int LinxNameResolver::registerName(const std::string &name, const std::string &endpoint) {
+    if (!LinxNameRecord::isValid(name, false) || !LinxNameRecord::isValid(endpoint, false)) {
+        LINX_ERROR(CLIENT, "Invalid name registration: %s -> %s", name.c_str(), endpoint.c_str());
+        return -1;
+    }
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        registrations[name] = Registration{endpoint, 0};
+    }
+    // Resent by resolver thread until name service confirms it
+    sendRecord(IPC_NAME_REGISTER, name, endpoint);
+    return 0;
+}
+
+int LinxNameResolver::unregisterName(const std::string &name) {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (registrations.erase(name) == 0) {
+            return -1;
+        }
+    }
+    sendRecord(IPC_NAME_UNREGISTER, name, "");
+    return 0;
+}
+
+std::string LinxNameResolver::resolve(const std::string &name, int timeoutMs) {
+    if (!LinxNameRecord::isValid(name, false)) {
+        LINX_ERROR(CLIENT, "Invalid name: %s", name.c_str());
+        return "";
+    }
+
+    Deadline deadline(timeoutMs);
+    std::unique_lock<std::mutex> lock(mutex);
+    if (cache.find(name) == cache.end()) {
+        cache.emplace(name, Resolved{"", 0, false});
+        lock.unlock();
+        // Resent by resolver thread until name service answers, then name is watched
+        sendRecord(IPC_NAME_QUERY, name, "");
+        lock.lock();
+    }
+
+    auto isResolved = [this, &name]() { return !cache[name].endpoint.empty(); };
+    if (timeoutMs == INFINITE_TIMEOUT) {
+        changed.wait(lock, isResolved);
+    } else {
+        changed.wait_for(lock, std::chrono::milliseconds(deadline.getRemainingTimeMs()), isResolved);
+    }
+
+    if (!isResolved()) {
+        LINX_ERROR(CLIENT, "[%s] resolve %s timed out", service.getValue().c_str(), name.c_str());
+    }
+    return cache[name].endpoint;
+}
+
+void LinxNameResolver::setListener(const Listener &listener) {
+    std::lock_guard<std::mutex> lock(mutex);
+    this->listener = listener;
+}
+
+void LinxNameResolver::task() {
+    auto now = std::chrono::steady_clock::now();
+    auto nextRetry = now + std::chrono::milliseconds(pollTimeout);
+    auto nextRefresh = now + refreshInterval;
+
+    while (running) {
+        RawMessagePtr msg;
+        std::unique_ptr<IIdentifier> from;
+        int ret = socket->receive(&msg, &from, pollTimeout);
+        if (ret > 0 && msg->getReqId() == IPC_NAME_UPDATE && from && *from == service) {
+            handleUpdate(*msg);
+        }
+
+        now = std::chrono::steady_clock::now();
+        if (now >= nextRefresh) {
+            sendPending(true);
+            nextRefresh = now + refreshInterval;
+            nextRetry = now + std::chrono::milliseconds(pollTimeout);
+        } else if (now >= nextRetry) {
+            sendPending(false);
+            nextRetry = now + std::chrono::milliseconds(pollTimeout);
+        }
+    }
+}
+
+void LinxNameResolver::handleUpdate(const RawMessage &msg) {
+    LinxNameRecord::Record record;
+    if (!LinxNameRecord::decode(msg, &record)) {
+        LINX_ERROR_RATELIMITED(CLIENT, "[%s] malformed name service update", service.getValue().c_str());
+        return;
+    }
+
+    Listener notify;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        auto registration = registrations.find(record.name);
+        if (registration != registrations.end() && registration->second.endpoint == record.endpoint) {
+            registration->second.generation = record.generation;
+        }
+
+        auto it = cache.find(record.name);
+        if (it == cache.end()) {
+            return;
+        }
+        it->second.isAnswered = true;
+        if (it->second.endpoint == record.endpoint && it->second.generation == record.generation) {
+            return;
+        }
+        it->second.endpoint = record.endpoint;
+        it->second.generation = record.generation;
+        notify = listener;
+    }
+
+    LINX_INFO(CLIENT, "[%s] resolved: %s -> %s", service.getValue().c_str(), record.name.c_str(),
+              record.endpoint.c_str());
+    changed.notify_all();
+    if (notify) {
+        notify(record.name, record.endpoint);
+    }
+}
+
+void LinxNameResolver::sendPending(bool refresh) {
+    std::vector<std::pair<uint32_t, LinxNameRecord::Record>> pending;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        for (const auto &[name, registration] : registrations) {
+            if (refresh || registration.generation == 0) {
+                pending.push_back({IPC_NAME_REGISTER, {name, registration.endpoint, registration.generation}});
+            }
+        }
+        // Refreshed queries let restarted name service learn watchers again
+        for (const auto &[name, resolved] : cache) {
+            if (refresh || !resolved.isAnswered) {
+                pending.push_back({IPC_NAME_QUERY, {name, "", 0}});
+            }
+        }
+    }
+
+    for (const auto &[reqId, record] : pending) {
+        sendRecord(reqId, record.name, record.endpoint, record.generation);
+    }
+}
+
+int LinxNameResolver::sendRecord(uint32_t reqId, const std::string &name, const std::string &endpoint,
+                                 uint32_t generation) {
+    return socket->send(LinxNameRecord::encode(reqId, {name, endpoint, generation}), service);
+}
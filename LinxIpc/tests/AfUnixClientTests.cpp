@@ -16,7 +16,7 @@ class AfUnixClientTests : public testing::Test {
     void SetUp() override {
         socket = std::make_unique<NiceMock<AfUnixSocketMock>>();
         socketPtr = socket.get();
-        ON_CALL(*socketPtr, receive(_, _, _)).WillByDefault(Return(-1));
+        ON_CALL(*socketPtr, receive(_, _, _, _)).WillByDefault(Return(-1));
         ON_CALL(*socketPtr, send(_, _)).WillByDefault(Return(0));
     }
 };
@@ -47,15 +47,15 @@ TEST_F(AfUnixClientTests, receive_CallSocketReceive) {
     auto client = AfUnixClient("test_instance", std::move(socket), UnixInfo("TEST"));
     std::initializer_list<uint32_t> sigsel = {2, 3};
 
-    EXPECT_CALL(*socketPtr, receive(_, _, _));
+    EXPECT_CALL(*socketPtr, receive(_, _, _, _));
     client.receive(1000, sigsel);
 }
 
 TEST_F(AfUnixClientTests, receive_ReturnSocketReceivedMsg) {
     auto client = AfUnixClient("test_instance", std::move(socket), UnixInfo("TEST"));
 
-    EXPECT_CALL(*socketPtr, receive(_, _, _)).WillOnce(Invoke(
-        [](RawMessagePtr* msg, std::unique_ptr<IIdentifier>* from, int) {
+    EXPECT_CALL(*socketPtr, receive(_, _, _, _)).WillOnce(Invoke(
+        [](RawMessagePtr* msg, std::unique_ptr<IIdentifier>* from, int, uint64_t *) {
             *msg = std::make_unique<RawMessage>(2);
             *from = std::make_unique<UnixInfo>("TEST");
             return 4;
@@ -69,8 +69,8 @@ TEST_F(AfUnixClientTests, receive_ReturnSocketReceivedMsg) {
 TEST_F(AfUnixClientTests, receive_ReturnNullWhenFromDifferentService) {
     auto client = AfUnixClient("test_instance", std::move(socket), UnixInfo("TEST"));
 
-    EXPECT_CALL(*socketPtr, receive(_, _, _)).WillRepeatedly(Invoke(
-        [](RawMessagePtr* msg, std::unique_ptr<IIdentifier>* from, int) {
+    EXPECT_CALL(*socketPtr, receive(_, _, _, _)).WillRepeatedly(Invoke(
+        [](RawMessagePtr* msg, std::unique_ptr<IIdentifier>* from, int, uint64_t *) {
             std::this_thread::sleep_for(std::chrono::milliseconds(100));
             *msg = std::make_unique<RawMessage>(2);
             *from = std::make_unique<UnixInfo>("TEST2");
@@ -83,8 +83,8 @@ TEST_F(AfUnixClientTests, receive_ReturnNullWhenFromDifferentService) {
 TEST_F(AfUnixClientTests, receive_ReturnNullWhenSignalNotInSigsel) {
     auto client = AfUnixClient("test_instance", std::move(socket), UnixInfo("TEST"));
 
-    EXPECT_CALL(*socketPtr, receive(_, _, _)).WillRepeatedly(Invoke(
-        [](RawMessagePtr* msg, std::unique_ptr<IIdentifier>* from, int) {
+    EXPECT_CALL(*socketPtr, receive(_, _, _, _)).WillRepeatedly(Invoke(
+        [](RawMessagePtr* msg, std::unique_ptr<IIdentifier>* from, int, uint64_t *) {
             std::this_thread::sleep_for(std::chrono::milliseconds(100));
             *msg = std::make_unique<RawMessage>(10);
             *from = std::make_unique<UnixInfo>("TEST");
@@ -97,7 +97,7 @@ TEST_F(AfUnixClientTests, receive_ReturnNullWhenSignalNotInSigsel) {
 TEST_F(AfUnixClientTests, receive_ReturnNullWhenSocketReturnError) {
     auto client = AfUnixClient("test_instance", std::move(socket), UnixInfo("TEST"));
     auto sigsel = std::initializer_list<uint32_t>{4};
-    EXPECT_CALL(*socketPtr, receive(_, _, _)).WillOnce(Return(-1));
+    EXPECT_CALL(*socketPtr, receive(_, _, _, _)).WillOnce(Return(-1));
 
     ASSERT_EQ(client.receive(10000, sigsel), nullptr);
 }
@@ -105,7 +105,7 @@ TEST_F(AfUnixClientTests, receive_ReturnNullWhenSocketReturnError) {
 TEST_F(AfUnixClientTests, receive_ReturnNullWhenSocketTimeout) {
     auto client = AfUnixClient("test_instance", std::move(socket), UnixInfo("TEST"));
     auto sigsel = std::initializer_list<uint32_t>{4};
-    EXPECT_CALL(*socketPtr, receive(_, _, _)).WillOnce(Return(0));
+    EXPECT_CALL(*socketPtr, receive(_, _, _, _)).WillOnce(Return(0));
 
     ASSERT_EQ(client.receive(10000, sigsel), nullptr);
 }
@@ -113,8 +113,8 @@ TEST_F(AfUnixClientTests, receive_ReturnNullWhenSocketTimeout) {
 TEST_F(AfUnixClientTests, receive_ReturnMsgWhenSignalMatchAny) {
     auto client = AfUnixClient("test_instance", std::move(socket), UnixInfo("TEST"));
 
-    EXPECT_CALL(*socketPtr, receive(_, _, _)).WillOnce(Invoke(
-        [](RawMessagePtr* msg, std::unique_ptr<IIdentifier>* from, int) {
+    EXPECT_CALL(*socketPtr, receive(_, _, _, _)).WillOnce(Invoke(
+        [](RawMessagePtr* msg, std::unique_ptr<IIdentifier>* from, int, uint64_t *) {
             *msg = std::make_unique<RawMessage>(10);
             *from = std::make_unique<UnixInfo>("TEST");
             return 4;
@@ -138,8 +138,8 @@ TEST_F(AfUnixClientTests, sendReceive_ReturnCallserverSendAndReceive) {
     auto msg = RawMessage(10);
 
     EXPECT_CALL(*socketPtr, send(Ref(msg), _)).WillOnce(Return(0));
-    EXPECT_CALL(*socketPtr, receive(_, _, _)).WillRepeatedly(Invoke(
-        [](RawMessagePtr* msg, std::unique_ptr<IIdentifier>* from, int) {
+    EXPECT_CALL(*socketPtr, receive(_, _, _, _)).WillRepeatedly(Invoke(
+        [](RawMessagePtr* msg, std::unique_ptr<IIdentifier>* from, int, uint64_t *) {
             *msg = std::make_unique<RawMessage>(12);
             *from = std::make_unique<UnixInfo>("TEST");
             return 4;
@@ -166,8 +166,8 @@ TEST_F(AfUnixClientTests, connect_SendHuntReq) {
 TEST_F(AfUnixClientTests, connect_ReturnTrueWhenRspReceived) {
     auto client = AfUnixClient("test_instance", std::move(socket), UnixInfo("TEST"));
 
-    EXPECT_CALL(*socketPtr, receive(_, _, _)).WillOnce(Invoke(
-        [](RawMessagePtr* msg, std::unique_ptr<IIdentifier>* from, int) {
+    EXPECT_CALL(*socketPtr, receive(_, _, _, _)).WillOnce(Invoke(
+        [](RawMessagePtr* msg, std::unique_ptr<IIdentifier>* from, int, uint64_t *) {
             *msg = std::make_unique<RawMessage>(IPC_PING_RSP);
             *from = std::make_unique<UnixInfo>("TEST");
             return 4;
@@ -182,8 +182,8 @@ TEST_F(AfUnixClientTests, connect_NotCallReceiveWhenSendFail) {
     EXPECT_CALL(*socketPtr, send(_, _))
         .WillOnce(Return(-1))
         .WillOnce(Return(2));
-    EXPECT_CALL(*socketPtr, receive(_, _, _)).WillOnce(Invoke(
-        [](RawMessagePtr* msg, std::unique_ptr<IIdentifier>* from, int) {
+    EXPECT_CALL(*socketPtr, receive(_, _, _, _)).WillOnce(Invoke(
+        [](RawMessagePtr* msg, std::unique_ptr<IIdentifier>* from, int, uint64_t *) {
             *msg = std::make_unique<RawMessage>(IPC_PING_RSP);
             *from = std::make_unique<UnixInfo>("TEST");
             return 4;
@@ -197,15 +197,15 @@ TEST_F(AfUnixClientTests, connect_SendAgainWhenNoReponseReceived) {
     auto client = AfUnixClient("test_instance", std::move(socket), UnixInfo("TEST"));
 
     EXPECT_CALL(*socketPtr, send(signalMatcher(IPC_PING_REQ), _)).Times(2);
-    EXPECT_CALL(*socketPtr, receive(_, _, _))
+    EXPECT_CALL(*socketPtr, receive(_, _, _, _))
         .WillOnce(Invoke(
-            [](RawMessagePtr*, std::unique_ptr<IIdentifier>*, int) {
+            [](RawMessagePtr*, std::unique_ptr<IIdentifier>*, int, uint64_t *) {
                 std::this_thread::sleep_for(std::chrono::milliseconds(100));
                 return -1;
             }
         ))
         .WillOnce(Invoke(
-            [](RawMessagePtr* msg, std::unique_ptr<IIdentifier>* from, int) {
+            [](RawMessagePtr* msg, std::unique_ptr<IIdentifier>* from, int, uint64_t *) {
                 *msg = std::make_unique<RawMessage>(IPC_PING_RSP);
                 *from = std::make_unique<UnixInfo>("TEST");
                 return 4;
@@ -218,7 +218,7 @@ TEST_F(AfUnixClientTests, connect_SendAgainWhenNoReponseReceived) {
 TEST_F(AfUnixClientTests, connect_ReturnFalseWhenTimeOutTimeout) {
     auto client = AfUnixClient("test_instance", std::move(socket), UnixInfo("TEST"));
 
-    EXPECT_CALL(*socketPtr, receive(_, _, _)).WillRepeatedly(DoAll(
+    EXPECT_CALL(*socketPtr, receive(_, _, _, _)).WillRepeatedly(DoAll(
         InvokeWithoutArgs([]() { std::this_thread::sleep_for(std::chrono::milliseconds(100)); }),
         Return(-1)
     ));
@@ -230,7 +230,7 @@ TEST_F(AfUnixClientTests, testConnectDuration) {
     static constexpr int time = 1000;
     static constexpr int margin = 110;
 
-    ON_CALL(*socketPtr, receive(_, _, _)).WillByDefault(DoAll(
+    ON_CALL(*socketPtr, receive(_, _, _, _)).WillByDefault(DoAll(
         InvokeWithoutArgs([]() { std::this_thread::sleep_for(std::chrono::milliseconds(50)); }),
         Return(-1)
     ));
@@ -246,24 +246,53 @@ TEST_F(AfUnixClientTests, testConnectDuration) {
     ASSERT_LE(duration.count(), time+margin) << "Connection should not take more than " << time+margin << " ms";
 }
 
+TEST_F(AfUnixClientTests, connect_BacksOffWhenSendFails) {
+    auto client = AfUnixClient("test_instance", std::move(socket), UnixInfo("TEST"));
+
+    int attempts = 0;
+    EXPECT_CALL(*socketPtr, send(signalMatcher(IPC_PING_REQ), _)).WillRepeatedly(InvokeWithoutArgs([&attempts]() {
+        attempts++;
+        return -1;
+    }));
+    ASSERT_FALSE(client.connect(300));
+    // Attempts wait 100 ms each, separated by pauses of up to 10 and 20 ms, instead of retrying immediately
+    EXPECT_GE(attempts, 2);
+    EXPECT_LE(attempts, 3);
+}
+
+TEST_F(AfUnixClientTests, connect_ZeroTimeoutWaitsForPingResponse) {
+    auto client = AfUnixClient("test_instance", std::move(socket), UnixInfo("TEST"));
+
+    EXPECT_CALL(*socketPtr, receive(_, _, _, _))
+        .WillOnce(Invoke(
+            [](RawMessagePtr* msg, std::unique_ptr<IIdentifier>* from, int timeoutMs, uint64_t *) {
+                EXPECT_GE(timeoutMs, 90);
+                *msg = std::make_unique<RawMessage>(IPC_PING_RSP);
+                *from = std::make_unique<UnixInfo>("TEST");
+                return 4;
+            }
+        ));
+    ASSERT_TRUE(client.connect(IMMEDIATE_TIMEOUT));
+}
+
 TEST_F(AfUnixClientTests, receive_LoopsContinueUntilCorrectMessageReceived) {
     auto client = AfUnixClient("test_instance", std::move(socket), UnixInfo("TEST"));
 
     // First call returns wrong signal (5 instead of 2 or 3)
     // Second call returns wrong service name
     // Third call returns correct message
-    EXPECT_CALL(*socketPtr, receive(_, _, _))
-        .WillOnce(Invoke([](RawMessagePtr* msg, std::unique_ptr<IIdentifier>* from, int) {
+    EXPECT_CALL(*socketPtr, receive(_, _, _, _))
+        .WillOnce(Invoke([](RawMessagePtr* msg, std::unique_ptr<IIdentifier>* from, int, uint64_t *) {
             *msg = std::make_unique<RawMessage>(5);  // Wrong signal
             *from = std::make_unique<UnixInfo>("TEST");
             return 4;
         }))
-        .WillOnce(Invoke([](RawMessagePtr* msg, std::unique_ptr<IIdentifier>* from, int) {
+        .WillOnce(Invoke([](RawMessagePtr* msg, std::unique_ptr<IIdentifier>* from, int, uint64_t *) {
             *msg = std::make_unique<RawMessage>(2);  // Right signal
             *from = std::make_unique<UnixInfo>("WRONG_SERVICE");  // Wrong service name
             return 4;
         }))
-        .WillOnce(Invoke([](RawMessagePtr* msg, std::unique_ptr<IIdentifier>* from, int) {
+        .WillOnce(Invoke([](RawMessagePtr* msg, std::unique_ptr<IIdentifier>* from, int, uint64_t *) {
             *msg = std::make_unique<RawMessage>(3);  // Right signal
             *from = std::make_unique<UnixInfo>("TEST");  // Right service name
             return 4;
@@ -303,3 +332,44 @@ TEST_F(AfUnixClientTests, isEqual_ReturnsFalseWhenDifferentServiceName) {
 
     ASSERT_FALSE(client1.isEqual(client2));
 }
+
+TEST_F(AfUnixClientTests, getMetrics_CountSentAndReceivedMessages) {
+    auto client = AfUnixClient("test_instance", std::move(socket), UnixInfo("TEST"));
+
+    EXPECT_CALL(*socketPtr, send(_, _)).WillOnce(Return(0)).WillOnce(Return(-1));
+    EXPECT_CALL(*socketPtr, receive(_, _, _, _)).WillOnce(Invoke(
+        [](RawMessagePtr* msg, std::unique_ptr<IIdentifier>* from, int, uint64_t *) {
+            *msg = std::make_unique<RawMessage>(2);
+            *from = std::make_unique<UnixInfo>("TEST");
+            return 16;
+        }));
+
+    client.send(RawMessage(10));
+    client.send(RawMessage(10));
+    client.receive(1000, LINX_ANY_SIG);
+
+    auto metrics = client.getMetrics();
+    ASSERT_EQ(metrics.name, "test_instance");
+    ASSERT_EQ(metrics.txMessages, 1U);
+    ASSERT_EQ(metrics.sendErrors, 1U);
+    ASSERT_EQ(metrics.rxMessages, 1U);
+    ASSERT_EQ(metrics.rxBytes, 16U);
+}
+
+TEST_F(AfUnixClientTests, sendReceive_RecordRoundTripInHistogram) {
+    auto client = AfUnixClient("test_instance", std::move(socket), UnixInfo("TEST"));
+    auto histogram = std::make_shared<LinxHistogram>();
+    client.setLatencyHistogram(histogram);
+
+    EXPECT_CALL(*socketPtr, receive(_, _, _, _))
+        .WillOnce(Invoke([](RawMessagePtr* msg, std::unique_ptr<IIdentifier>* from, int, uint64_t *) {
+            *msg = std::make_unique<RawMessage>(2);
+            *from = std::make_unique<UnixInfo>("TEST");
+            return 16;
+        }))
+        .WillOnce(Return(0));
+
+    ASSERT_NE(client.sendReceive(RawMessage(10), 1000, {2}), nullptr);
+    ASSERT_EQ(client.sendReceive(RawMessage(10), 1000, {2}), nullptr);
+    ASSERT_EQ(histogram->getCount(), 1U);
+}
@@ -19,7 +19,7 @@ class AfUnixEndpointTests : public testing::Test {
         socket = std::make_shared<NiceMock<AfUnixSocketMock>>();
         socketPtr = socket.get();
         ON_CALL(*socketPtr, open()).WillByDefault(Return(true));
-        ON_CALL(*socketPtr, receive(_, _, _)).WillByDefault(Return(-1));
+        ON_CALL(*socketPtr, receive(_, _, _, _)).WillByDefault(Return(-1));
         ON_CALL(*socketPtr, send(_, _)).WillByDefault(Return(0));
 
         queue = std::make_unique<NiceMock<LinxQueueMock>>();
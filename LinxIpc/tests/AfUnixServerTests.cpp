@@ -1,5 +1,8 @@
+#include <atomic>
+#include <thread>
 #include "gtest/gtest.h"
 #include "UnixLinx.h"
+#include "UdpLinx.h"
 #include "AfUnixSocketMock.h"
 #include "LinxIpc.h"
 #include "LinxMessageIds.h"
@@ -23,13 +26,13 @@ class AfUnixServerTests : public testing::Test {
     void SetUp() {
         socket = std::make_shared<NiceMock<AfUnixSocketMock>>();
         socketPtr = socket.get();
-        ON_CALL(*socketPtr, receive(_, _, _)).WillByDefault(Return(-1));
+        ON_CALL(*socketPtr, receive(_, _, _, _)).WillByDefault(Return(-1));
 
         queue = std::make_unique<NiceMock<LinxQueueMock>>();
         queuePtr = queue.get();
         ON_CALL(*queuePtr, get(_, _, _)).WillByDefault(Return(ByMove(LinxReceivedMessagePtr(nullptr))));
         ON_CALL(*queuePtr, getFd()).WillByDefault(Return(1));
-        ON_CALL(*socketPtr, getFd()).WillByDefault(Return(2));
+        ON_CALL(*socketPtr, getPollFd()).WillByDefault(Return(2));
     }
 };
 
@@ -40,7 +43,7 @@ TEST_F(AfUnixServerTests, getPollFdReturnQueueGetFdResult) {
     server.stop();
 }
 
-TEST_F(AfUnixServerTests, getPollFdReturnSocketGetFdResult) {
+TEST_F(AfUnixServerTests, getPollFdReturnSocketGetPollFdResult) {
     auto server = AfUnixSimpleServer("TEST", socket);
     ASSERT_EQ(server.getPollFd(), 2);
 }
@@ -90,8 +93,8 @@ TEST_F(AfUnixServerTests, receive_WithoutStart_UsesSocketDirectly) {
     auto from = std::make_unique<UnixInfo>("CLIENT");
 
     // Without starting, receive should call socket directly, not queue
-    EXPECT_CALL(*socketPtr, receive(_, _, _))
-        .WillOnce(Invoke([&](RawMessagePtr *msgOut, std::unique_ptr<IIdentifier> *fromOut, int) {
+    EXPECT_CALL(*socketPtr, receive(_, _, _, _))
+        .WillOnce(Invoke([&](RawMessagePtr *msgOut, std::unique_ptr<IIdentifier> *fromOut, int, uint64_t *) {
             *msgOut = std::move(msg);
             *fromOut = std::move(from);
             return 1;
@@ -117,14 +120,14 @@ TEST_F(AfUnixServerTests, receive_WithoutStart_FiltersMessages) {
     auto from2 = std::make_unique<UnixInfo>("CLIENT2");
 
     int callCount = 0;
-    EXPECT_CALL(*socketPtr, receive(_, _, _))
-        .WillOnce(Invoke([&](RawMessagePtr *msgOut, std::unique_ptr<IIdentifier> *fromOut, int) {
+    EXPECT_CALL(*socketPtr, receive(_, _, _, _))
+        .WillOnce(Invoke([&](RawMessagePtr *msgOut, std::unique_ptr<IIdentifier> *fromOut, int, uint64_t *) {
             callCount++;
             *msgOut = std::move(msg1);
             *fromOut = std::move(from1);
             return 1;
         }))
-        .WillOnce(Invoke([&](RawMessagePtr *msgOut, std::unique_ptr<IIdentifier> *fromOut, int) {
+        .WillOnce(Invoke([&](RawMessagePtr *msgOut, std::unique_ptr<IIdentifier> *fromOut, int, uint64_t *) {
             callCount++;
             *msgOut = std::move(msg2);
             *fromOut = std::move(from2);
@@ -142,7 +145,7 @@ TEST_F(AfUnixServerTests, receive_WithoutStart_HandlesTimeout) {
     auto sigsel = std::initializer_list<uint32_t>{100};
 
     // Socket returns timeout (0)
-    EXPECT_CALL(*socketPtr, receive(_, _, _)).WillOnce(Return(0));
+    EXPECT_CALL(*socketPtr, receive(_, _, _, _)).WillOnce(Return(0));
 
     auto result = server->receive(10000, sigsel);
     ASSERT_EQ(result, nullptr);
@@ -159,14 +162,14 @@ TEST_F(AfUnixServerTests, receive_WithoutStart_HandlesPingRequest) {
     auto from2 = std::make_unique<UnixInfo>("CLIENT2");
 
     int callCount = 0;
-    EXPECT_CALL(*socketPtr, receive(_, _, _))
-        .WillOnce(Invoke([&](RawMessagePtr *msgOut, std::unique_ptr<IIdentifier> *fromOut, int) {
+    EXPECT_CALL(*socketPtr, receive(_, _, _, _))
+        .WillOnce(Invoke([&](RawMessagePtr *msgOut, std::unique_ptr<IIdentifier> *fromOut, int, uint64_t *) {
             callCount++;
             *msgOut = std::move(pingMsg);
             *fromOut = std::move(from1);
             return 1;
         }))
-        .WillOnce(Invoke([&](RawMessagePtr *msgOut, std::unique_ptr<IIdentifier> *fromOut, int) {
+        .WillOnce(Invoke([&](RawMessagePtr *msgOut, std::unique_ptr<IIdentifier> *fromOut, int, uint64_t *) {
             callCount++;
             *msgOut = std::move(normalMsg);
             *fromOut = std::move(from2);
@@ -211,6 +214,251 @@ TEST_F(AfUnixServerTests, endpoint_receiveMsg) {
     server->stop();
 }
 
+TEST_F(AfUnixServerTests, receiveBatch_callQueueGetBatch) {
+    auto server = std::make_shared<AfUnixServer>("TEST", socket, std::move(queue));
+    auto sigsel = std::initializer_list<uint32_t>{4};
+
+    EXPECT_CALL(*queuePtr, getBatch(16, 1000, SigselMatcher(sigsel), nullptr)).WillOnce(Invoke(
+        [](size_t, int, const std::vector<uint32_t>&, const IIdentifier*) {
+            std::vector<LinxReceivedMessagePtr> messages;
+            messages.push_back(std::make_unique<LinxReceivedMessage>(LinxReceivedMessage{
+                .message = std::make_unique<RawMessage>(4),
+                .from = std::make_unique<UnixInfo>("TEST")
+            }));
+            return messages;
+        }
+    ));
+
+    auto result = server->receiveBatch(16, 1000, sigsel);
+    ASSERT_EQ(result.size(), 1);
+    ASSERT_EQ(result[0]->message->getReqId(), 4U);
+}
+
+TEST_F(AfUnixServerTests, receiveBatch_WithoutStart_DrainsSocketUntilEmpty) {
+    auto server = std::make_shared<AfUnixSimpleServer>("TEST", socket);
+
+    EXPECT_CALL(*socketPtr, receive(_, _, Gt(0), _))
+        .WillOnce(Invoke([](RawMessagePtr *msgOut, std::unique_ptr<IIdentifier> *fromOut, int, uint64_t *) {
+            *msgOut = std::make_unique<RawMessage>(100);
+            *fromOut = std::make_unique<UnixInfo>("CLIENT1");
+            return 4;
+        }));
+    EXPECT_CALL(*socketPtr, receive(_, _, IMMEDIATE_TIMEOUT, _))
+        .WillOnce(Invoke([](RawMessagePtr *msgOut, std::unique_ptr<IIdentifier> *fromOut, int, uint64_t *) {
+            *msgOut = std::make_unique<RawMessage>(101);
+            *fromOut = std::make_unique<UnixInfo>("CLIENT2");
+            return 4;
+        }))
+        .WillOnce(Return(0));
+
+    auto result = server->receiveBatch(10, 1000);
+    ASSERT_EQ(result.size(), 2);
+    ASSERT_EQ(result[0]->message->getReqId(), 100U);
+    ASSERT_EQ(result[1]->message->getReqId(), 101U);
+}
+
+TEST_F(AfUnixServerTests, receiveBatch_WithoutStart_StopsAtMaxCount) {
+    auto server = std::make_shared<AfUnixSimpleServer>("TEST", socket);
+
+    EXPECT_CALL(*socketPtr, receive(_, _, _, _))
+        .Times(2)
+        .WillRepeatedly(Invoke([](RawMessagePtr *msgOut, std::unique_ptr<IIdentifier> *fromOut, int, uint64_t *) {
+            *msgOut = std::make_unique<RawMessage>(100);
+            *fromOut = std::make_unique<UnixInfo>("CLIENT1");
+            return 4;
+        }));
+
+    auto result = server->receiveBatch(2, 1000);
+    ASSERT_EQ(result.size(), 2);
+}
+
+TEST_F(AfUnixServerTests, setBusyPoll_SetsQueueAndSocketSpin) {
+    auto server = std::make_shared<AfUnixServer>("TEST", socket, std::move(queue));
+
+    EXPECT_CALL(*queuePtr, setSpinTime(50));
+    EXPECT_CALL(*socketPtr, setBusyPoll(50, false)).WillOnce(Return(0));
+    ASSERT_EQ(server->setBusyPoll(50), 0);
+}
+
+TEST_F(AfUnixServerTests, setBusyPoll_KeepQueueSpinWhenSocketFails) {
+    auto server = std::make_shared<AfUnixServer>("TEST", socket, std::move(queue));
+
+    EXPECT_CALL(*queuePtr, setSpinTime(_)).Times(0);
+    EXPECT_CALL(*socketPtr, setBusyPoll(50, true)).WillOnce(Return(-1));
+    ASSERT_EQ(server->setBusyPoll(50, true), -1);
+}
+
+TEST_F(AfUnixServerTests, setBusyPoll_WithoutStart_ReturnSocketError) {
+    auto server = std::make_shared<AfUnixSimpleServer>("TEST", socket);
+
+    EXPECT_CALL(*socketPtr, setBusyPoll(50, true)).WillOnce(Return(-1));
+    ASSERT_EQ(server->setBusyPoll(50, true), -1);
+}
+
+TEST_F(AfUnixServerTests, setTimestamping_EnablesSocketTimestamping) {
+    auto server = std::make_shared<AfUnixSimpleServer>("TEST", socket);
+
+    EXPECT_CALL(*socketPtr, setTimestamping(true)).WillOnce(Return(0));
+    ASSERT_EQ(server->setTimestamping(true), 0);
+}
+
+TEST_F(AfUnixServerTests, setTimestamping_ReturnSocketError) {
+    auto server = std::make_shared<AfUnixSimpleServer>("TEST", socket);
+
+    EXPECT_CALL(*socketPtr, setTimestamping(true)).WillOnce(Return(-2));
+    ASSERT_EQ(server->setTimestamping(true), -2);
+}
+
+TEST_F(AfUnixServerTests, receive_WithoutStart_NoTimestampsWhenDisabled) {
+    auto server = std::make_shared<AfUnixSimpleServer>("TEST", socket);
+
+    EXPECT_CALL(*socketPtr, receive(_, _, _, _))
+        .WillOnce(Invoke([&](RawMessagePtr *msgOut, std::unique_ptr<IIdentifier> *fromOut, int, uint64_t *) {
+            *msgOut = std::make_unique<RawMessage>(100);
+            *fromOut = std::make_unique<UnixInfo>("CLIENT");
+            return 1;
+        }));
+
+    auto result = server->receive(10000);
+    ASSERT_NE(result, nullptr);
+    ASSERT_EQ(result->timestamps.socketDequeue, 0U);
+    ASSERT_EQ(result->timestamps.consumerPickup, 0U);
+}
+
+TEST_F(AfUnixServerTests, receive_WithoutStart_StampsMessageWhenEnabled) {
+    auto server = std::make_shared<AfUnixSimpleServer>("TEST", socket);
+    ON_CALL(*socketPtr, setTimestamping(true)).WillByDefault(Return(0));
+    ASSERT_EQ(server->setTimestamping(true), 0);
+
+    uint64_t kernelRx = LinxMessageTimestamps::now();
+    EXPECT_CALL(*socketPtr, receive(_, _, _, _))
+        .WillOnce(Invoke([&](RawMessagePtr *msgOut, std::unique_ptr<IIdentifier> *fromOut, int,
+                             uint64_t *rxTimestamp) {
+            *msgOut = std::make_unique<RawMessage>(100);
+            *fromOut = std::make_unique<UnixInfo>("CLIENT");
+            *rxTimestamp = kernelRx;
+            return 1;
+        }));
+
+    auto result = server->receive(10000);
+    ASSERT_NE(result, nullptr);
+    ASSERT_EQ(result->timestamps.kernelRx, kernelRx);
+    ASSERT_GE(result->timestamps.socketDequeue, kernelRx);
+    ASSERT_EQ(result->timestamps.consumerPickup, result->timestamps.socketDequeue);
+    ASSERT_GE(result->timestamps.socketWaitNs(), 0);
+    ASSERT_EQ(result->timestamps.queueWaitNs(), 0);
+    ASSERT_EQ(result->timestamps.handlerNs(), -1);
+}
+
+TEST_F(AfUnixServerTests, receive_StampsConsumerPickupWhenEnabled) {
+    auto server = std::make_shared<AfUnixServer>("TEST", socket, std::move(queue));
+    ON_CALL(*socketPtr, setTimestamping(true)).WillByDefault(Return(0));
+    ASSERT_EQ(server->setTimestamping(true), 0);
+
+    auto msg = std::make_unique<LinxReceivedMessage>();
+    msg->message = std::make_unique<RawMessage>(100);
+    msg->timestamps.queueInsert = LinxMessageTimestamps::now();
+    EXPECT_CALL(*queuePtr, get(_, _, _)).WillOnce(Return(ByMove(std::move(msg))));
+
+    auto result = server->receive(10000);
+    ASSERT_NE(result, nullptr);
+    ASSERT_GE(result->timestamps.queueWaitNs(), 0);
+}
+
+TEST_F(AfUnixServerTests, getMetrics_CountReceivedMessagesAndPings) {
+    auto server = std::make_shared<AfUnixSimpleServer>("TEST", socket);
+
+    EXPECT_CALL(*socketPtr, receive(_, _, _, _))
+        .WillOnce(Invoke([&](RawMessagePtr *msgOut, std::unique_ptr<IIdentifier> *fromOut, int, uint64_t *) {
+            *msgOut = std::make_unique<RawMessage>(IPC_PING_REQ);
+            *fromOut = std::make_unique<UnixInfo>("CLIENT");
+            return 8;
+        }))
+        .WillOnce(Invoke([&](RawMessagePtr *msgOut, std::unique_ptr<IIdentifier> *fromOut, int, uint64_t *) {
+            *msgOut = std::make_unique<RawMessage>(100);
+            *fromOut = std::make_unique<UnixInfo>("CLIENT");
+            return 12;
+        }))
+        .WillOnce(Return(-4));
+    EXPECT_CALL(*socketPtr, send(_, _)).WillOnce(Return(0));
+
+    ASSERT_NE(server->receive(10000), nullptr);
+    ASSERT_EQ(server->receive(10000), nullptr);
+
+    auto metrics = server->getMetrics();
+    ASSERT_EQ(metrics.name, "TEST");
+    ASSERT_EQ(metrics.rxMessages, 2U);
+    ASSERT_EQ(metrics.rxBytes, 20U);
+    ASSERT_EQ(metrics.pings, 1U);
+    ASSERT_EQ(metrics.txMessages, 1U);
+    ASSERT_EQ(metrics.receiveErrors, 1U);
+    ASSERT_EQ(metrics.deserializeErrors, 0U);
+}
+
+TEST_F(AfUnixServerTests, getMetrics_CountDeserializeErrorsSeparately) {
+    auto server = std::make_shared<AfUnixSimpleServer>("TEST", socket);
+
+    EXPECT_CALL(*socketPtr, receive(_, _, _, _))
+        .WillOnce(Return(LINX_DESERIALIZE_ERROR));
+
+    ASSERT_EQ(server->receive(10000), nullptr);
+
+    auto metrics = server->getMetrics();
+    ASSERT_EQ(metrics.deserializeErrors, 1U);
+    ASSERT_EQ(metrics.receiveErrors, 0U);
+}
+
+TEST_F(AfUnixServerTests, getMetrics_CountSendErrors) {
+    auto server = std::make_shared<AfUnixSimpleServer>("TEST", socket);
+
+    EXPECT_CALL(*socketPtr, send(_, _)).WillOnce(Return(-3)).WillOnce(Return(0));
+    server->send(RawMessage(10), UnixInfo("CLIENT"));
+    server->send(RawMessage(10), UnixInfo("CLIENT"));
+    server->send(RawMessage(10), PortInfo("127.0.0.1", 1000));
+
+    auto metrics = server->getMetrics();
+    ASSERT_EQ(metrics.sendErrors, 2U);
+    ASSERT_EQ(metrics.txMessages, 1U);
+    ASSERT_EQ(metrics.txBytes, RawMessage(10).getSize());
+}
+
+TEST_F(AfUnixServerTests, getMetrics_ReportQueueDepthAndHighWater) {
+    auto server = std::make_shared<AfUnixServer>("TEST", socket, std::move(queue));
+
+    EXPECT_CALL(*queuePtr, size()).WillOnce(Return(3));
+    EXPECT_CALL(*queuePtr, getHighWater()).WillOnce(Return(9));
+
+    auto metrics = server->getMetrics();
+    ASSERT_EQ(metrics.queueDepth, 3U);
+    ASSERT_EQ(metrics.queueHighWater, 9U);
+}
+
+TEST_F(AfUnixServerTests, getMetrics_CountQueueDrops) {
+    auto server = std::make_shared<AfUnixServer>("TEST", socket, std::move(queue));
+
+    std::atomic<int> calls{0};
+    ON_CALL(*socketPtr, receive(_, _, _, _))
+        .WillByDefault(Invoke([&](RawMessagePtr *msgOut, std::unique_ptr<IIdentifier> *fromOut, int, uint64_t *) {
+            if (calls++ < 2) {
+                *msgOut = std::make_unique<RawMessage>(100);
+                *fromOut = std::make_unique<UnixInfo>("CLIENT");
+                return 8;
+            }
+            return 0;
+        }));
+    EXPECT_CALL(*queuePtr, add(_)).WillOnce(Return(0)).WillOnce(Return(-1));
+
+    server->start();
+    while (calls < 3) {
+        std::this_thread::yield();
+    }
+    server->stop();
+
+    auto metrics = server->getMetrics();
+    ASSERT_EQ(metrics.rxMessages, 2U);
+    ASSERT_EQ(metrics.queueDrops, 1U);
+}
+
 TEST_F(AfUnixServerTests, stop_DoNothingWhenNotStarted) {
     auto server = AfUnixServer("TEST", socket, std::move(queue));
     server.stop();
@@ -239,8 +487,8 @@ TEST_F(AfUnixServerTests, task_ReceivesMessageAndAddsToQueue) {
     auto server = std::make_shared<AfUnixServer>("TEST", socket, std::move(queue));
 
     // Simulate socket receiving a message
-    EXPECT_CALL(*socketPtr, receive(_, _, _))
-        .WillOnce(Invoke([](RawMessagePtr *msg, std::unique_ptr<IIdentifier> *from, int) {
+    EXPECT_CALL(*socketPtr, receive(_, _, _, _))
+        .WillOnce(Invoke([](RawMessagePtr *msg, std::unique_ptr<IIdentifier> *from, int, uint64_t *) {
             *msg = std::make_unique<RawMessage>(42);
             *from = std::make_unique<UnixInfo>("CLIENT1");
             return 4;
@@ -260,8 +508,8 @@ TEST_F(AfUnixServerTests, task_HandlesPingRequest) {
     auto server = std::make_shared<AfUnixServer>("TEST", socket, std::move(queue));
 
     // Simulate socket receiving a ping request
-    EXPECT_CALL(*socketPtr, receive(_, _, _))
-        .WillOnce(Invoke([](RawMessagePtr *msg, std::unique_ptr<IIdentifier> *from, int) {
+    EXPECT_CALL(*socketPtr, receive(_, _, _, _))
+        .WillOnce(Invoke([](RawMessagePtr *msg, std::unique_ptr<IIdentifier> *from, int, uint64_t *) {
             *msg = std::make_unique<RawMessage>(IPC_PING_REQ);
             *from = std::make_unique<UnixInfo>("CLIENT1");
             return 4;
@@ -285,8 +533,8 @@ TEST_F(AfUnixServerTests, task_DiscardsMessageWhenQueueFull) {
     auto server = std::make_shared<AfUnixServer>("TEST", socket, std::move(queue));
 
     // Simulate socket receiving a message
-    EXPECT_CALL(*socketPtr, receive(_, _, _))
-        .WillOnce(Invoke([](RawMessagePtr *msg, std::unique_ptr<IIdentifier> *from, int) {
+    EXPECT_CALL(*socketPtr, receive(_, _, _, _))
+        .WillOnce(Invoke([](RawMessagePtr *msg, std::unique_ptr<IIdentifier> *from, int, uint64_t *) {
             *msg = std::make_unique<RawMessage>(42);
             *from = std::make_unique<UnixInfo>("CLIENT1");
             return 4;
@@ -308,7 +556,7 @@ TEST_F(AfUnixServerTests, task_HandlesSocketClose) {
     auto server = std::make_shared<AfUnixServer>("TEST", socket, std::move(queue));
 
     // Simulate socket timing out
-    EXPECT_CALL(*socketPtr, receive(_, _, _))
+    EXPECT_CALL(*socketPtr, receive(_, _, _, _))
         .Times(1)
         .WillRepeatedly(testing::Return(0));
 
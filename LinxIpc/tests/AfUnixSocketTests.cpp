@@ -2,6 +2,7 @@
 #include "gmock/gmock.h"
 #include "AfUnixSocket.h"
 #include "RawMessage.h"
+#include "LinxBatch.h"
 #include "SystemMock.h"
 #include <sys/socket.h>
 #include <sys/un.h>
@@ -101,6 +102,131 @@ TEST_F(AfUnixSocketTests, receive_ReturnsZeroOnTimeout) {
     socket.close();
 }
 
+// Test busy poll
+TEST_F(AfUnixSocketTests, setBusyPoll_FailsOnInvalidSocket) {
+    AfUnixSocket socket("test_socket_12345");
+    EXPECT_EQ(socket.setBusyPoll(50, false), -1);
+}
+
+TEST_F(AfUnixSocketTests, receive_WithBusyPoll_ReceivesMessage) {
+    AfUnixSocket receiver("test_socket_12345");
+    AfUnixSocket sender("test_socket_67890");
+    receiver.open();
+    sender.open();
+    EXPECT_EQ(receiver.setBusyPoll(1000, true), 0);
+
+    ASSERT_EQ(sender.send(RawMessage(7), UnixInfo("test_socket_12345")), 0);
+
+    RawMessagePtr msg;
+    std::unique_ptr<IIdentifier> from;
+    EXPECT_GT(receiver.receive(&msg, &from, 100), 0);
+    ASSERT_NE(msg, nullptr);
+    EXPECT_EQ(msg->getReqId(), 7U);
+}
+
+TEST_F(AfUnixSocketTests, receive_WithBusyPoll_ReturnsZeroOnTimeout) {
+    AfUnixSocket socket("test_socket_12345");
+    socket.open();
+    socket.setBusyPoll(100, false);
+
+    RawMessagePtr msg;
+    std::unique_ptr<IIdentifier> from;
+    EXPECT_EQ(socket.receive(&msg, &from, 10), 0);
+}
+
+// Test kernel receive timestamps
+TEST_F(AfUnixSocketTests, setTimestamping_FailsOnInvalidSocket) {
+    AfUnixSocket socket("test_socket_12345");
+    EXPECT_EQ(socket.setTimestamping(true), -1);
+}
+
+TEST_F(AfUnixSocketTests, receive_WithTimestamping_RecordsKernelTime) {
+    AfUnixSocket receiver("test_socket_12345");
+    AfUnixSocket sender("test_socket_67890");
+    receiver.open();
+    sender.open();
+    ASSERT_EQ(receiver.setTimestamping(true), 0);
+
+    uint64_t before = LinxMessageTimestamps::now();
+    ASSERT_EQ(sender.send(RawMessage(7), UnixInfo("test_socket_12345")), 0);
+
+    RawMessagePtr msg;
+    std::unique_ptr<IIdentifier> from;
+    uint64_t rxTimestamp = 0;
+    EXPECT_GT(receiver.receive(&msg, &from, 100, &rxTimestamp), 0);
+    uint64_t after = LinxMessageTimestamps::now();
+
+    ASSERT_NE(msg, nullptr);
+    EXPECT_EQ(msg->getReqId(), 7U);
+    EXPECT_GE(rxTimestamp, before);
+    EXPECT_LE(rxTimestamp, after);
+    ASSERT_NE(from, nullptr);
+    EXPECT_TRUE(*from == UnixInfo("test_socket_67890"));
+}
+
+TEST_F(AfUnixSocketTests, receive_UnpackCoalescedMessages) {
+    AfUnixSocket receiver("test_socket_12345");
+    AfUnixSocket sender("test_socket_67890");
+    receiver.open();
+    sender.open();
+
+    std::vector<uint8_t> batch;
+    ASSERT_TRUE(LinxBatch::append(batch, RawMessage(7, {1, 2})));
+    ASSERT_TRUE(LinxBatch::append(batch, RawMessage(8)));
+    ASSERT_EQ(sender.send(RawMessage(IPC_BATCH_MSG, std::move(batch)), UnixInfo("test_socket_12345")), 0);
+
+    RawMessagePtr msg;
+    std::unique_ptr<IIdentifier> from;
+    EXPECT_EQ(receiver.receive(&msg, &from, 100), (int)RawMessage(7, {1, 2}).getSize());
+    EXPECT_EQ(msg->getReqId(), 7U);
+    EXPECT_TRUE(*from == UnixInfo("test_socket_67890"));
+    EXPECT_GT(receiver.receive(&msg, &from, 0), 0);
+    EXPECT_EQ(msg->getReqId(), 8U);
+    EXPECT_TRUE(*from == UnixInfo("test_socket_67890"));
+    EXPECT_EQ(receiver.receive(&msg, &from, 0), 0);
+}
+
+TEST_F(AfUnixSocketTests, receive_WithChecksum_DropsMessageWithoutValidTrailer) {
+    AfUnixSocket receiver("test_socket_12345");
+    AfUnixSocket sender("test_socket_67890");
+    receiver.open();
+    sender.open();
+    ASSERT_EQ(receiver.setChecksum(true), 0);
+    ASSERT_EQ(sender.setChecksum(true), 0);
+
+    RawMessagePtr msg;
+    ASSERT_EQ(sender.send(RawMessage(7, {1, 2, 3, 4}), UnixInfo("test_socket_12345")), 0);
+    EXPECT_EQ(receiver.receive(&msg, nullptr, 100), (int)(RawMessage(7, {1, 2, 3, 4}).getSize() + sizeof(uint32_t)));
+    ASSERT_NE(msg, nullptr);
+    EXPECT_EQ(msg->getReqId(), 7U);
+    EXPECT_EQ(msg->getPayloadSize(), 4U);
+
+    sender.setChecksum(false);
+    msg.reset();
+    ASSERT_EQ(sender.send(RawMessage(7, {1, 2, 3, 4}), UnixInfo("test_socket_12345")), 0);
+    EXPECT_EQ(receiver.receive(&msg, nullptr, 100), -7);
+    EXPECT_EQ(msg, nullptr);
+
+    LinxMetricsSnapshot snapshot;
+    receiver.addMetrics(snapshot);
+    EXPECT_EQ(snapshot.checksumErrors, 1u);
+}
+
+TEST_F(AfUnixSocketTests, receive_WithoutTimestamping_NoKernelTime) {
+    AfUnixSocket receiver("test_socket_12345");
+    AfUnixSocket sender("test_socket_67890");
+    receiver.open();
+    sender.open();
+
+    ASSERT_EQ(sender.send(RawMessage(7), UnixInfo("test_socket_12345")), 0);
+
+    RawMessagePtr msg;
+    std::unique_ptr<IIdentifier> from;
+    uint64_t rxTimestamp = 1;
+    EXPECT_GT(receiver.receive(&msg, &from, 100, &rxTimestamp), 0);
+    EXPECT_EQ(rxTimestamp, 0U);
+}
+
 // Test flush on valid socket
 TEST_F(AfUnixSocketTests, flush_ReturnsZeroWhenNoData) {
     AfUnixSocket socket("test_socket_12345");
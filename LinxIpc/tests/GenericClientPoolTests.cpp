@@ -0,0 +1,151 @@
+#include "gtest/gtest.h"
+#include <future>
+#include <poll.h>
+#include "AfUnixSocket.h"
+#include "UdpLinx.h"
+#include "RawMessage.h"
+
+using namespace ::testing;
+
+namespace {
+
+constexpr uint32_t REQUEST = IPC_SIG_BASE + 1;
+constexpr uint32_t RESPONSE_A = IPC_SIG_BASE + 2;
+constexpr uint32_t RESPONSE_B = IPC_SIG_BASE + 3;
+
+// Answers single request with reqId to its sender
+void respond(AfUnixSocket &server, uint32_t reqId) {
+    RawMessagePtr msg;
+    std::unique_ptr<IIdentifier> from;
+    ASSERT_GT(server.receive(&msg, &from, 1000), 0);
+    ASSERT_NE(from, nullptr);
+    ASSERT_EQ(server.send(RawMessage(reqId), *dynamic_cast<UnixInfo *>(from.get())), 0);
+}
+
+uint32_t receiveReqId(const std::shared_ptr<AfUnixClient> &client, int timeoutMs = 100) {
+    auto msg = client->receive(timeoutMs, LINX_ANY_SIG);
+    return msg ? msg->getReqId() : 0;
+}
+
+} // namespace
+
+class GenericClientPoolTests : public testing::Test {
+  protected:
+    void SetUp() override {
+        ASSERT_EQ(serverA.open(), 0);
+        ASSERT_EQ(serverB.open(), 0);
+        pool = AfUnixFactory::createClientPool(2);
+        ASSERT_NE(pool, nullptr);
+        clientA = pool->createClient(UnixInfo("test_pool_server_a"));
+        clientB = pool->createClient(UnixInfo("test_pool_server_b"));
+    }
+
+    AfUnixSocket serverA{"test_pool_server_a"};
+    AfUnixSocket serverB{"test_pool_server_b"};
+    std::shared_ptr<AfUnixClientPool> pool;
+    std::shared_ptr<AfUnixClient> clientA;
+    std::shared_ptr<AfUnixClient> clientB;
+};
+
+TEST_F(GenericClientPoolTests, receive_RoutesMessagesBySender) {
+    ASSERT_EQ(clientA->send(RawMessage(REQUEST)), 0);
+    ASSERT_EQ(clientB->send(RawMessage(REQUEST)), 0);
+    respond(serverA, RESPONSE_A);
+    respond(serverB, RESPONSE_B);
+
+    // Message of clientA is read first and kept for it
+    EXPECT_EQ(receiveReqId(clientB), RESPONSE_B);
+    EXPECT_EQ(receiveReqId(clientA), RESPONSE_A);
+    EXPECT_EQ(receiveReqId(clientA, 0), 0u);
+    EXPECT_EQ(receiveReqId(clientB, 0), 0u);
+}
+
+TEST_F(GenericClientPoolTests, receive_BlockedClientsReceiveConcurrently) {
+    auto receivedA = std::async(std::launch::async, [this]() { return receiveReqId(clientA, 1000); });
+    auto receivedB = std::async(std::launch::async, [this]() { return receiveReqId(clientB, 1000); });
+
+    ASSERT_EQ(clientA->send(RawMessage(REQUEST)), 0);
+    ASSERT_EQ(clientB->send(RawMessage(REQUEST)), 0);
+    respond(serverB, RESPONSE_B);
+    respond(serverA, RESPONSE_A);
+
+    EXPECT_EQ(receivedA.get(), RESPONSE_A);
+    EXPECT_EQ(receivedB.get(), RESPONSE_B);
+}
+
+TEST_F(GenericClientPoolTests, connect_SucceedsForEveryClient) {
+    auto server = AfUnixFactory::createServer("test_pool_server_c", 10);
+    ASSERT_NE(server, nullptr);
+    ASSERT_TRUE(server->start());
+
+    auto client = pool->createClient(UnixInfo("test_pool_server_c"));
+    EXPECT_TRUE(client->connect(1000));
+    EXPECT_EQ(pool->getMetrics().rxMessages, 1u);
+}
+
+TEST_F(GenericClientPoolTests, createClient_ReturnsExistingClientOfIdentifier) {
+    EXPECT_EQ(pool->createClient(UnixInfo("test_pool_server_a")), clientA);
+    EXPECT_EQ(pool->getClientCount(), 2u);
+
+    clientB.reset();
+    EXPECT_EQ(pool->getClientCount(), 1u);
+    clientB = pool->createClient(UnixInfo("test_pool_server_b"));
+    EXPECT_EQ(pool->getClientCount(), 2u);
+}
+
+TEST_F(GenericClientPoolTests, dispatch_RoutesMessagesForExternalPoller) {
+    ASSERT_EQ(clientA->send(RawMessage(REQUEST)), 0);
+    ASSERT_EQ(clientB->send(RawMessage(REQUEST)), 0);
+    respond(serverA, RESPONSE_A);
+    respond(serverB, RESPONSE_B);
+
+    struct pollfd pfd = {pool->getPollFd(), POLLIN, 0};
+    ASSERT_EQ(poll(&pfd, 1, 1000), 1);
+    EXPECT_EQ(pool->dispatch(), 2);
+    EXPECT_EQ(pool->dispatch(), 0);
+
+    EXPECT_EQ(receiveReqId(clientA, 0), RESPONSE_A);
+    EXPECT_EQ(receiveReqId(clientB, 0), RESPONSE_B);
+    EXPECT_EQ(pool->getMetrics().queueDepth, 0u);
+}
+
+TEST_F(GenericClientPoolTests, dispatch_DropsMessagesOfUnknownSenderAndOnFullQueue) {
+    AfUnixSocket stranger("test_pool_stranger");
+    ASSERT_EQ(stranger.open(), 0);
+    ASSERT_EQ(clientA->send(RawMessage(REQUEST)), 0);
+    respond(serverA, RESPONSE_A);
+    auto poolAddress = [this]() {
+        RawMessagePtr msg;
+        std::unique_ptr<IIdentifier> from;
+        EXPECT_EQ(clientA->send(RawMessage(REQUEST)), 0);
+        EXPECT_GT(serverA.receive(&msg, &from, 1000), 0);
+        return *dynamic_cast<UnixInfo *>(from.get());
+    }();
+
+    ASSERT_EQ(stranger.send(RawMessage(RESPONSE_B), poolAddress), 0);
+    ASSERT_EQ(serverA.send(RawMessage(RESPONSE_A), poolAddress), 0);
+    ASSERT_EQ(serverA.send(RawMessage(RESPONSE_A), poolAddress), 0);
+    EXPECT_EQ(pool->dispatch(100), 4);
+
+    auto metrics = pool->getMetrics();
+    EXPECT_EQ(metrics.unroutedDrops, 1u);
+    EXPECT_EQ(metrics.queueDrops, 1u);
+    EXPECT_EQ(metrics.queueDepth, 2u);
+}
+
+TEST(UdpClientPoolTests, connect_SucceedsThroughSharedSocket) {
+    auto serverA = UdpFactory::createServer(12380, 10);
+    auto serverB = UdpFactory::createServer(12381, 10);
+    ASSERT_NE(serverA, nullptr);
+    ASSERT_NE(serverB, nullptr);
+    ASSERT_TRUE(serverA->start());
+    ASSERT_TRUE(serverB->start());
+
+    auto pool = UdpFactory::createClientPool();
+    ASSERT_NE(pool, nullptr);
+    auto clientA = pool->createClient(PortInfo("127.0.0.1", 12380));
+    auto clientB = pool->createClient(PortInfo("127.0.0.1", 12381));
+    EXPECT_TRUE(clientA->connect(1000));
+    EXPECT_TRUE(clientB->connect(1000));
+    EXPECT_EQ(pool->getMetrics().unroutedDrops, 0u);
+}
@@ -0,0 +1,191 @@
+#include <thread>
+#include <poll.h>
+#include <sys/ioctl.h>
+#include "gtest/gtest.h"
+#include "UdpLinx.h"
+#include "UdpSocket.h"
+#include "UnixLinx.h"
+#include "LinxBatch.h"
+
+using namespace ::testing;
+
+class GenericCoalescerTests : public testing::Test {
+  protected:
+    std::shared_ptr<UdpSocket> receiver = std::make_shared<UdpSocket>();
+    std::shared_ptr<UdpSocket> sender = std::make_shared<UdpSocket>();
+    std::unique_ptr<UdpClient> client;
+
+    void SetUp() override {
+        receiver->open();
+        receiver->bind(0);
+        sender->open();
+        client = std::make_unique<UdpClient>("client", sender, PortInfo("127.0.0.1", receiver->getLocalPort()));
+    }
+
+    int available() {
+        int bytes = 0;
+        ioctl(receiver->getFd(), FIONREAD, &bytes);
+        return bytes;
+    }
+
+    std::vector<uint32_t> receiveAll(int timeoutMs = 100) {
+        std::vector<uint32_t> reqIds;
+        RawMessagePtr msg;
+        while (receiver->receive(&msg, nullptr, timeoutMs) > 0) {
+            reqIds.push_back(msg->getReqId());
+            timeoutMs = 0;
+        }
+        return reqIds;
+    }
+};
+
+TEST(LinxBatchTests, unpack_ReturnAppendedMessages) {
+    std::vector<uint8_t> payload;
+    ASSERT_TRUE(LinxBatch::append(payload, RawMessage(7, {1, 2, 3})));
+    ASSERT_TRUE(LinxBatch::append(payload, RawMessage(8)));
+
+    std::deque<RawMessagePtr> messages;
+    ASSERT_TRUE(LinxBatch::unpack(RawMessage(IPC_BATCH_MSG, payload), &messages));
+    ASSERT_EQ(messages.size(), 2u);
+    EXPECT_EQ(messages[0]->getReqId(), 7u);
+    EXPECT_EQ(messages[0]->getPayloadSize(), 3u);
+    EXPECT_EQ(messages[1]->getReqId(), 8u);
+}
+
+TEST(LinxBatchTests, unpack_RejectMalformedContainer) {
+    std::vector<uint8_t> payload;
+    ASSERT_TRUE(LinxBatch::append(payload, RawMessage(7, {1, 2, 3})));
+    std::deque<RawMessagePtr> messages;
+
+    auto truncated = payload;
+    truncated.pop_back();
+    EXPECT_FALSE(LinxBatch::unpack(RawMessage(IPC_BATCH_MSG, truncated), &messages));
+    EXPECT_FALSE(LinxBatch::unpack(RawMessage(IPC_BATCH_MSG), &messages));
+
+    std::vector<uint8_t> nested;
+    ASSERT_TRUE(LinxBatch::append(nested, RawMessage(IPC_BATCH_MSG, payload)));
+    EXPECT_FALSE(LinxBatch::unpack(RawMessage(IPC_BATCH_MSG, nested), &messages));
+    EXPECT_TRUE(messages.empty());
+}
+
+TEST_F(GenericCoalescerTests, send_PackMessagesUntilFlush) {
+    ASSERT_EQ(client->setCoalescing(LINX_DEFAULT_DATAGRAM_SIZE, 1000000), 0);
+
+    for (uint32_t i = 0; i < 10; i++) {
+        ASSERT_EQ(client->send(RawMessage(IPC_SIG_BASE + i, {1, 2, 3, 4})), 0);
+    }
+    EXPECT_EQ(available(), 0);
+
+    ASSERT_EQ(client->flush(), 0);
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    EXPECT_GT(available(), 0);
+
+    RawMessagePtr msg;
+    std::unique_ptr<IIdentifier> from;
+    ASSERT_GT(receiver->receive(&msg, &from, 100), 0);
+    EXPECT_EQ(msg->getReqId(), IPC_SIG_BASE);
+    EXPECT_EQ(from->format(), "127.0.0.1:" + std::to_string(sender->getLocalPort()));
+    EXPECT_EQ(available(), 0);
+
+    auto reqIds = receiveAll(0);
+    ASSERT_EQ(reqIds.size(), 9u);
+    for (uint32_t i = 0; i < reqIds.size(); i++) {
+        EXPECT_EQ(reqIds[i], IPC_SIG_BASE + i + 1);
+    }
+
+    auto metrics = client->getMetrics();
+    EXPECT_EQ(metrics.coalescedMessages, 10u);
+    EXPECT_EQ(metrics.coalescedBatches, 1u);
+    EXPECT_EQ(metrics.txMessages, 10u);
+}
+
+TEST_F(GenericCoalescerTests, send_FlushWhenContainerIsFull) {
+    // Container payload holds two entries of 4 + 12 bytes
+    ASSERT_EQ(client->setCoalescing(sizeof(uint32_t) + 2 * 16, 1000000), 0);
+
+    for (uint32_t i = 0; i < 5; i++) {
+        ASSERT_EQ(client->send(RawMessage(i + 10, {1, 2, 3, 4, 5, 6, 7, 8})), 0);
+    }
+    EXPECT_EQ(client->getMetrics().coalescedBatches, 2u);
+    EXPECT_EQ(receiveAll(), (std::vector<uint32_t>{10, 11, 12, 13}));
+
+    ASSERT_EQ(client->flush(), 0);
+    EXPECT_EQ(receiveAll(), (std::vector<uint32_t>{14}));
+}
+
+TEST_F(GenericCoalescerTests, send_FlushAfterDelay) {
+    ASSERT_EQ(client->setCoalescing(LINX_DEFAULT_DATAGRAM_SIZE, 2000), 0);
+
+    ASSERT_EQ(client->send(RawMessage(10)), 0);
+    RawMessagePtr msg;
+    ASSERT_GT(receiver->receive(&msg, nullptr, 500), 0);
+    EXPECT_EQ(msg->getReqId(), 10u);
+}
+
+TEST_F(GenericCoalescerTests, send_LargeMessageSentDirectlyAfterPending) {
+    ASSERT_EQ(client->setCoalescing(64, 1000000), 0);
+
+    ASSERT_EQ(client->send(RawMessage(10)), 0);
+    ASSERT_EQ(client->send(RawMessage(11, std::vector<uint8_t>(200))), 0);
+    EXPECT_EQ(receiveAll(), (std::vector<uint32_t>{10, 11}));
+    EXPECT_EQ(client->getMetrics().coalescedMessages, 1u);
+}
+
+TEST_F(GenericCoalescerTests, setCoalescing_RejectTooSmallContainer) {
+    EXPECT_EQ(client->setCoalescing(12, 100), -1);
+    EXPECT_EQ(client->setCoalescing(0), 0);
+    EXPECT_EQ(client->send(RawMessage(10)), 0);
+    EXPECT_EQ(receiveAll(), (std::vector<uint32_t>{10}));
+}
+
+TEST_F(GenericCoalescerTests, getPollFd_ReadableUntilContainerIsUnpacked) {
+    struct pollfd pfd = {receiver->getPollFd(), POLLIN, 0};
+    ASSERT_EQ(client->setCoalescing(LINX_DEFAULT_DATAGRAM_SIZE, 1000000), 0);
+    ASSERT_EQ(client->send(RawMessage(10)), 0);
+    ASSERT_EQ(client->send(RawMessage(11)), 0);
+    ASSERT_EQ(client->flush(), 0);
+
+    ASSERT_EQ(poll(&pfd, 1, 100), 1);
+    RawMessagePtr msg;
+    ASSERT_GT(receiver->receive(&msg, nullptr, IMMEDIATE_TIMEOUT), 0);
+    EXPECT_EQ(available(), 0);
+    EXPECT_EQ(poll(&pfd, 1, 0), 1);
+
+    ASSERT_GT(receiver->receive(&msg, nullptr, IMMEDIATE_TIMEOUT), 0);
+    EXPECT_EQ(msg->getReqId(), 11u);
+    EXPECT_EQ(poll(&pfd, 1, 0), 0);
+}
+
+TEST_F(GenericCoalescerTests, getPollFd_ReadableUntilUnixContainerIsUnpacked) {
+    auto server = AfUnixFactory::createSimpleServer("CoalescePollSrv");
+    auto unixClient = AfUnixFactory::createClient("CoalescePollSrv");
+    ASSERT_NE(server, nullptr);
+    ASSERT_NE(unixClient, nullptr);
+    struct pollfd pfd = {server->getPollFd(), POLLIN, 0};
+    ASSERT_EQ(unixClient->setCoalescing(LINX_DEFAULT_DATAGRAM_SIZE, 1000000), 0);
+    ASSERT_EQ(unixClient->send(RawMessage(IPC_SIG_BASE)), 0);
+    ASSERT_EQ(unixClient->send(RawMessage(IPC_SIG_BASE + 1)), 0);
+    ASSERT_EQ(unixClient->flush(), 0);
+
+    ASSERT_EQ(poll(&pfd, 1, 100), 1);
+    ASSERT_NE(server->receive(IMMEDIATE_TIMEOUT), nullptr);
+    EXPECT_EQ(poll(&pfd, 1, 0), 1);
+    ASSERT_NE(server->receive(IMMEDIATE_TIMEOUT), nullptr);
+    EXPECT_EQ(poll(&pfd, 1, 0), 0);
+}
+
+TEST_F(GenericCoalescerTests, receive_ReturnContainerTimestampWithEveryMessage) {
+    ASSERT_EQ(receiver->setTimestamping(true), 0);
+    ASSERT_EQ(client->setCoalescing(LINX_DEFAULT_DATAGRAM_SIZE, 1000000), 0);
+    ASSERT_EQ(client->send(RawMessage(10)), 0);
+    ASSERT_EQ(client->send(RawMessage(11)), 0);
+    ASSERT_EQ(client->flush(), 0);
+
+    RawMessagePtr msg;
+    uint64_t first = 0;
+    uint64_t second = 0;
+    ASSERT_GT(receiver->receive(&msg, nullptr, 100, &first), 0);
+    ASSERT_GT(receiver->receive(&msg, nullptr, IMMEDIATE_TIMEOUT, &second), 0);
+    EXPECT_NE(first, 0u);
+    EXPECT_EQ(second, first);
+}
@@ -0,0 +1,205 @@
+#include "gtest/gtest.h"
+#include "LinxCompression.h"
+#include "LinxFrameCompression.h"
+#include <arpa/inet.h>
+#include <random>
+
+using namespace ::testing;
+
+namespace {
+
+std::vector<uint8_t> compressibleData(size_t size) {
+    std::string text;
+    while (text.size() < size) {
+        text += "{\"level\":\"info\",\"module\":\"server\",\"seq\":" + std::to_string(text.size()) + "}\n";
+    }
+    return std::vector<uint8_t>(text.begin(), text.begin() + size);
+}
+
+std::vector<uint8_t> randomData(size_t size) {
+    std::mt19937 generator(42);
+    std::vector<uint8_t> data(size);
+    for (auto &byte : data) {
+        byte = (uint8_t)generator();
+    }
+    return data;
+}
+
+std::vector<uint8_t> frameOf(const RawMessage &msg) {
+    std::vector<uint8_t> frame(msg.getSize());
+    msg.serialize(frame.data(), frame.size());
+    return frame;
+}
+
+} // namespace
+
+class LinxCompressionTests : public testing::TestWithParam<size_t> {};
+
+TEST_P(LinxCompressionTests, lz_RoundTripCompressibleData) {
+    LinxLzCompressor compressor;
+    auto data = compressibleData(GetParam());
+    std::vector<uint8_t> compressed(data.size() + 64);
+
+    uint32_t size = compressor.compress(data.data(), data.size(), compressed.data(), compressed.size());
+    ASSERT_GT(size, 0u);
+
+    std::vector<uint8_t> result(data.size());
+    ASSERT_TRUE(compressor.decompress(compressed.data(), size, result.data(), result.size()));
+    ASSERT_EQ(result, data);
+}
+
+INSTANTIATE_TEST_SUITE_P(Sizes, LinxCompressionTests, Values(1, 4, 15, 100, 4096, 70000));
+
+TEST(LinxLzCompressorTests, compress_ReduceRepetitiveData) {
+    LinxLzCompressor compressor;
+    auto data = compressibleData(16 * 1024);
+    std::vector<uint8_t> compressed(data.size());
+
+    uint32_t size = compressor.compress(data.data(), data.size(), compressed.data(), compressed.size());
+    ASSERT_GT(size, 0u);
+    ASSERT_LT(size, data.size() / 3);
+}
+
+TEST(LinxLzCompressorTests, compress_OverlappingMatch) {
+    LinxLzCompressor compressor;
+    std::vector<uint8_t> data(1000, 'a');
+    std::vector<uint8_t> compressed(data.size());
+
+    uint32_t size = compressor.compress(data.data(), data.size(), compressed.data(), compressed.size());
+    ASSERT_GT(size, 0u);
+    ASSERT_LT(size, 16u);
+
+    std::vector<uint8_t> result(data.size());
+    ASSERT_TRUE(compressor.decompress(compressed.data(), size, result.data(), result.size()));
+    ASSERT_EQ(result, data);
+}
+
+TEST(LinxLzCompressorTests, compress_ReturnZeroWhenOutputDoesNotFit) {
+    LinxLzCompressor compressor;
+    auto data = randomData(4096);
+    std::vector<uint8_t> compressed(data.size() - 1);
+
+    ASSERT_EQ(compressor.compress(data.data(), data.size(), compressed.data(), compressed.size()), 0u);
+}
+
+TEST(LinxLzCompressorTests, decompress_RejectMalformedInput) {
+    LinxLzCompressor compressor;
+    auto data = compressibleData(4096);
+    std::vector<uint8_t> compressed(data.size());
+    uint32_t size = compressor.compress(data.data(), data.size(), compressed.data(), compressed.size());
+    std::vector<uint8_t> result(data.size());
+
+    ASSERT_FALSE(compressor.decompress(compressed.data(), size / 2, result.data(), result.size()));
+    ASSERT_FALSE(compressor.decompress(compressed.data(), size, result.data(), result.size() - 1));
+    ASSERT_FALSE(compressor.decompress(compressed.data(), size, result.data(), result.size() + 1));
+
+    // Match referring before start of output
+    uint8_t invalidOffset[] = {0x10, 'a', 0x05, 0x00};
+    ASSERT_FALSE(compressor.decompress(invalidOffset, sizeof(invalidOffset), result.data(), 5));
+}
+
+TEST(LinxFrameCompressionTests, compress_SkipFramesBelowThreshold) {
+    LinxFrameCompression compression;
+    compression.configure(1024, nullptr);
+    std::vector<uint8_t> out;
+
+    ASSERT_FALSE(compression.compress(frameOf(RawMessage(1, compressibleData(1023))).data(), 1027, out));
+}
+
+TEST(LinxFrameCompressionTests, compress_SkipIncompressibleFrames) {
+    LinxFrameCompression compression;
+    compression.configure(16, nullptr);
+    auto frame = frameOf(RawMessage(1, randomData(2048)));
+    std::vector<uint8_t> out;
+
+    ASSERT_FALSE(compression.compress(frame.data(), frame.size(), out));
+}
+
+TEST(LinxFrameCompressionTests, decode_RestoreCompressedFrame) {
+    LinxFrameCompression compression;
+    compression.configure(16, nullptr);
+    auto payload = compressibleData(8192);
+    auto frame = frameOf(RawMessage(0x1234, payload));
+    std::vector<uint8_t> out;
+
+    ASSERT_TRUE(compression.compress(frame.data(), frame.size(), out));
+    ASSERT_LT(out.size(), frame.size());
+    uint32_t reqId;
+    memcpy(&reqId, out.data(), sizeof(reqId));
+    ASSERT_EQ(ntohl(reqId), 0x1234 | LINX_COMPRESSED_FLAG);
+
+    auto msg = compression.decode(std::move(out));
+    ASSERT_NE(msg, nullptr);
+    ASSERT_EQ(msg->getReqId(), 0x1234u);
+    ASSERT_EQ(std::vector<uint8_t>(msg->getPayload(), msg->getPayload() + msg->getPayloadSize()), payload);
+}
+
+TEST(LinxFrameCompressionTests, decode_PassUncompressedFrame) {
+    LinxFrameCompression compression;
+    compression.configure(16, nullptr);
+
+    auto msg = compression.decode(frameOf(RawMessage(5, {1, 2, 3})));
+    ASSERT_NE(msg, nullptr);
+    ASSERT_EQ(msg->getReqId(), 5u);
+    ASSERT_EQ(msg->getPayloadSize(), 3u);
+}
+
+TEST(LinxFrameCompressionTests, decode_DisabledCompressionKeepsFlaggedReqId) {
+    LinxFrameCompression compression;
+
+    auto msg = compression.decode(frameOf(RawMessage(LINX_COMPRESSED_FLAG | 5, {1, 2, 3})));
+    ASSERT_NE(msg, nullptr);
+    ASSERT_EQ(msg->getReqId(), LINX_COMPRESSED_FLAG | 5);
+}
+
+TEST(LinxFrameCompressionTests, decode_RejectMalformedFrames) {
+    LinxFrameCompression compression;
+    compression.configure(16, nullptr);
+
+    uint32_t header[] = {htonl(LINX_COMPRESSED_FLAG | 5), htonl(LINX_MAX_DECOMPRESSED_SIZE + 1)};
+    std::vector<uint8_t> tooLarge((uint8_t *)header, (uint8_t *)header + sizeof(header));
+    tooLarge.push_back(0);
+    ASSERT_EQ(compression.decode(std::move(tooLarge)), nullptr);
+
+    std::vector<uint8_t> truncated((uint8_t *)header, (uint8_t *)header + sizeof(uint32_t) + 2);
+    ASSERT_EQ(compression.decode(std::move(truncated)), nullptr);
+
+    header[1] = htonl(100);
+    std::vector<uint8_t> corrupted((uint8_t *)header, (uint8_t *)header + sizeof(header));
+    corrupted.insert(corrupted.end(), {0xF0, 0xFF});
+    ASSERT_EQ(compression.decode(std::move(corrupted)), nullptr);
+}
+
+TEST(LinxFrameCompressionTests, decode_RejectSizeCompressedDataCannotExpandTo) {
+    class BoundedCompressor : public LinxCompressor {
+      public:
+        mutable int decompressCalls = 0;
+        uint32_t compress(const uint8_t *, uint32_t, uint8_t *, uint32_t) const override { return 0; }
+        bool decompress(const uint8_t *, uint32_t, uint8_t *, uint32_t) const override {
+            decompressCalls++;
+            return false;
+        }
+        uint64_t maxDecompressedSize(uint32_t srcSize) const override { return srcSize * 2; }
+    };
+    auto compressor = std::make_shared<BoundedCompressor>();
+    LinxFrameCompression compression;
+    compression.configure(16, compressor);
+
+    uint32_t header[] = {htonl(LINX_COMPRESSED_FLAG | 5), htonl(9)};
+    std::vector<uint8_t> frame((uint8_t *)header, (uint8_t *)header + sizeof(header));
+    frame.insert(frame.end(), {1, 2, 3, 4});
+    ASSERT_EQ(compression.decode(std::move(frame)), nullptr);
+    EXPECT_EQ(compressor->decompressCalls, 0);
+}
+
+TEST(LinxLzCompressorTests, maxDecompressedSize_BoundsHighlyCompressibleData) {
+    LinxLzCompressor compressor;
+    std::vector<uint8_t> data(1024 * 1024, 0);
+    std::vector<uint8_t> compressed(data.size());
+
+    uint32_t size = compressor.compress(data.data(), data.size(), compressed.data(), compressed.size());
+    ASSERT_GT(size, 0u);
+    EXPECT_LE(data.size(), compressor.maxDecompressedSize(size));
+    // Small datagram can not claim maximum payload
+    EXPECT_LT(compressor.maxDecompressedSize(4), LINX_MAX_DECOMPRESSED_SIZE);
+}
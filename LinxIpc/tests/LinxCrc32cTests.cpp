@@ -0,0 +1,89 @@
+#include "gtest/gtest.h"
+#include "LinxCrc32c.h"
+#include "LinxFrameChecksum.h"
+#include <random>
+#include <string>
+
+using namespace ::testing;
+
+namespace {
+
+std::vector<uint8_t> randomData(size_t size) {
+    std::mt19937 generator(7);
+    std::vector<uint8_t> data(size);
+    for (auto &byte : data) {
+        byte = (uint8_t)generator();
+    }
+    return data;
+}
+
+} // namespace
+
+TEST(LinxCrc32cTests, compute_MatchesKnownVectors) {
+    const std::string check = "123456789";
+    std::vector<uint8_t> zeros(32, 0);
+    std::vector<uint8_t> ones(32, 0xFF);
+
+    EXPECT_EQ(LinxCrc32c::compute(nullptr, 0), 0u);
+    EXPECT_EQ(LinxCrc32c::compute(check.data(), check.size()), 0xE3069283u);
+    // RFC 3720 (iSCSI) test patterns
+    EXPECT_EQ(LinxCrc32c::compute(zeros.data(), zeros.size()), 0x8A9136AAu);
+    EXPECT_EQ(LinxCrc32c::compute(ones.data(), ones.size()), 0x62A8AB43u);
+    EXPECT_EQ(LinxCrc32c::computeSoftware(check.data(), check.size()), 0xE3069283u);
+}
+
+TEST(LinxCrc32cTests, compute_SameAsSoftwareForAllSizesAndAlignments) {
+    auto data = randomData(4096 + 8);
+
+    for (size_t offset = 0; offset < 8; offset++) {
+        for (size_t size : {0, 1, 3, 7, 8, 9, 15, 16, 63, 64, 65, 1000, 4096}) {
+            EXPECT_EQ(LinxCrc32c::compute(data.data() + offset, size),
+                      LinxCrc32c::computeSoftware(data.data() + offset, size))
+                << "offset: " << offset << ", size: " << size;
+        }
+    }
+}
+
+TEST(LinxCrc32cTests, compute_ContinuesPreviousChecksum) {
+    auto data = randomData(1000);
+
+    uint32_t crc = LinxCrc32c::compute(data.data(), 333);
+    crc = LinxCrc32c::compute(data.data() + 333, data.size() - 333, crc);
+    EXPECT_EQ(crc, LinxCrc32c::compute(data.data(), data.size()));
+}
+
+TEST(LinxFrameChecksumTests, verify_RemovesValidTrailer) {
+    LinxFrameChecksum checksum;
+    checksum.configure(true);
+    auto frame = randomData(100);
+    auto original = frame;
+
+    frame.resize(frame.size() + LinxFrameChecksum::trailerSize);
+    ASSERT_EQ(checksum.append(frame.data(), original.size()), frame.size());
+    ASSERT_TRUE(checksum.verify(frame));
+    EXPECT_EQ(frame, original);
+
+    LinxMetricsSnapshot snapshot;
+    checksum.addMetrics(snapshot);
+    EXPECT_EQ(snapshot.checksumErrors, 0u);
+}
+
+TEST(LinxFrameChecksumTests, verify_DetectsCorruptionAndCountsErrors) {
+    LinxFrameChecksum checksum;
+    checksum.configure(true);
+    auto frame = randomData(100 + LinxFrameChecksum::trailerSize);
+    checksum.append(frame.data(), 100);
+
+    for (size_t i = 0; i < frame.size(); i += 13) {
+        auto corrupted = frame;
+        corrupted[i] ^= 0x01;
+        EXPECT_FALSE(checksum.verify(corrupted)) << "byte: " << i;
+        EXPECT_EQ(corrupted.size(), frame.size());
+    }
+    std::vector<uint8_t> tooShort(LinxFrameChecksum::trailerSize - 1);
+    EXPECT_FALSE(checksum.verify(tooShort));
+
+    LinxMetricsSnapshot snapshot;
+    checksum.addMetrics(snapshot);
+    EXPECT_EQ(snapshot.checksumErrors, (frame.size() + 12) / 13 + 1);
+}
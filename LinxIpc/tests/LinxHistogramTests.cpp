@@ -0,0 +1,166 @@
+#include <thread>
+#include "gtest/gtest.h"
+#include "LinxHistogram.h"
+
+using namespace ::testing;
+
+class LinxHistogramTests : public testing::Test {
+};
+
+TEST_F(LinxHistogramTests, emptyHistogramReturnZero) {
+    LinxHistogram histogram;
+
+    ASSERT_EQ(histogram.getCount(), 0U);
+    ASSERT_EQ(histogram.getMin(), 0U);
+    ASSERT_EQ(histogram.getMax(), 0U);
+    ASSERT_EQ(histogram.getMean(), 0.0);
+    ASSERT_EQ(histogram.valueAtPercentile(99.0), 0U);
+}
+
+TEST_F(LinxHistogramTests, record_SmallValuesAreExact) {
+    LinxHistogram histogram;
+    for (uint64_t value = 1; value <= 100; value++) {
+        histogram.record(value);
+    }
+
+    ASSERT_EQ(histogram.getCount(), 100U);
+    ASSERT_EQ(histogram.getMin(), 1U);
+    ASSERT_EQ(histogram.getMax(), 100U);
+    ASSERT_DOUBLE_EQ(histogram.getMean(), 50.5);
+    ASSERT_EQ(histogram.valueAtPercentile(50.0), 50U);
+    ASSERT_EQ(histogram.valueAtPercentile(99.0), 99U);
+    ASSERT_EQ(histogram.valueAtPercentile(100.0), 100U);
+    ASSERT_EQ(histogram.valueAtPercentile(0.0), 1U);
+}
+
+TEST_F(LinxHistogramTests, valueAtPercentile_RelativeErrorBelowOnePercent) {
+    LinxHistogram histogram;
+    for (uint64_t value = 1; value <= 1000000; value++) {
+        histogram.record(value * 1000);
+    }
+
+    for (double percentile : {50.0, 90.0, 99.0, 99.9, 99.99}) {
+        double expected = percentile / 100.0 * 1000000 * 1000;
+        double actual = histogram.valueAtPercentile(percentile);
+        EXPECT_NEAR(actual, expected, expected * 0.01) << "percentile: " << percentile;
+    }
+}
+
+TEST_F(LinxHistogramTests, record_ClampValuesAboveMaximum) {
+    LinxHistogram histogram;
+    histogram.record(UINT64_MAX);
+
+    ASSERT_EQ(histogram.getCount(), 1U);
+    ASSERT_EQ(histogram.getMax(), LinxHistogram::maxValue);
+    ASSERT_EQ(histogram.valueAtPercentile(100.0), LinxHistogram::maxValue);
+}
+
+TEST_F(LinxHistogramTests, record_FromMultipleThreads) {
+    LinxHistogram histogram;
+    std::vector<std::thread> threads;
+    for (int i = 0; i < 4; i++) {
+        threads.emplace_back([&histogram, i]() {
+            for (uint64_t value = 0; value < 10000; value++) {
+                histogram.record(value + i * 10000);
+            }
+        });
+    }
+    for (auto &thread : threads) {
+        thread.join();
+    }
+
+    ASSERT_EQ(histogram.getCount(), 40000U);
+    ASSERT_EQ(histogram.getMin(), 0U);
+    ASSERT_EQ(histogram.getMax(), 39999U);
+}
+
+TEST_F(LinxHistogramTests, merge_CombineHistograms) {
+    LinxHistogram first;
+    LinxHistogram second;
+    for (uint64_t value = 1; value <= 50; value++) {
+        first.record(value);
+        second.record(value + 50);
+    }
+
+    first.merge(second);
+
+    ASSERT_EQ(first.getCount(), 100U);
+    ASSERT_EQ(first.getMin(), 1U);
+    ASSERT_EQ(first.getMax(), 100U);
+    ASSERT_EQ(first.valueAtPercentile(50.0), 50U);
+    ASSERT_EQ(second.getCount(), 50U);
+}
+
+TEST_F(LinxHistogramTests, merge_EmptyHistogramDoNothing) {
+    LinxHistogram first;
+    LinxHistogram second;
+    first.record(10);
+
+    first.merge(second);
+
+    ASSERT_EQ(first.getCount(), 1U);
+    ASSERT_EQ(first.getMin(), 10U);
+}
+
+TEST_F(LinxHistogramTests, reset_ClearHistogram) {
+    LinxHistogram histogram;
+    histogram.record(10);
+    histogram.reset();
+
+    ASSERT_EQ(histogram.getCount(), 0U);
+    ASSERT_EQ(histogram.getMax(), 0U);
+    histogram.record(20);
+    ASSERT_EQ(histogram.getMin(), 20U);
+}
+
+TEST_F(LinxHistogramTests, serialize_RoundTrip) {
+    LinxHistogram histogram;
+    for (uint64_t value = 0; value < 100000; value += 7) {
+        histogram.record(value * value);
+    }
+
+    auto data = histogram.serialize();
+    auto restored = LinxHistogram::deserialize(data.data(), data.size());
+
+    ASSERT_NE(restored, nullptr);
+    ASSERT_EQ(restored->getCount(), histogram.getCount());
+    ASSERT_EQ(restored->getMin(), histogram.getMin());
+    ASSERT_EQ(restored->getMax(), histogram.getMax());
+    ASSERT_DOUBLE_EQ(restored->getMean(), histogram.getMean());
+    for (double percentile : {1.0, 50.0, 99.0, 99.9}) {
+        ASSERT_EQ(restored->valueAtPercentile(percentile), histogram.valueAtPercentile(percentile));
+    }
+}
+
+TEST_F(LinxHistogramTests, serialize_EmptyHistogramRoundTrip) {
+    LinxHistogram histogram;
+
+    auto data = histogram.serialize();
+    auto restored = LinxHistogram::deserialize(data.data(), data.size());
+
+    ASSERT_NE(restored, nullptr);
+    ASSERT_EQ(restored->getCount(), 0U);
+}
+
+TEST_F(LinxHistogramTests, deserialize_ReturnNullOnMalformedInput) {
+    LinxHistogram histogram;
+    histogram.record(10);
+    histogram.record(1000);
+    auto data = histogram.serialize();
+
+    ASSERT_EQ(LinxHistogram::deserialize(nullptr, 0), nullptr);
+    ASSERT_EQ(LinxHistogram::deserialize(data.data(), 3), nullptr);
+    ASSERT_EQ(LinxHistogram::deserialize(data.data(), data.size() - 1), nullptr);
+
+    auto badMagic = data;
+    badMagic[0] = 'X';
+    ASSERT_EQ(LinxHistogram::deserialize(badMagic.data(), badMagic.size()), nullptr);
+
+    auto trailing = data;
+    trailing.push_back(0);
+    ASSERT_EQ(LinxHistogram::deserialize(trailing.data(), trailing.size()), nullptr);
+
+    auto badCount = data;
+    badCount[4] = 3;
+    ASSERT_EQ(LinxHistogram::deserialize(badCount.data(), badCount.size()), nullptr);
+}
@@ -1,6 +1,7 @@
-
+#include <thread>
 #include "gtest/gtest.h"
 #include "LinxIpc.h"
+#include "LinxHistogram.h"
 #include "LinxServerMock.h"
 #include "IIdentifier.h"
 #include "UnixLinx.h"
@@ -56,6 +57,154 @@ TEST_F(LinxIpcHandlerTests, handleMessage_ReturnCallbackResult) {
     ASSERT_EQ(handler.handleMessage(10000), 5);
 }
 
+TEST_F(LinxIpcHandlerTests, handleMessage_StampsHandlerTimeWhenTimestampsEnabled) {
+    auto server = std::make_shared<NiceMock<LinxServerMock>>();
+    auto handler = LinxIpcHandler(server);
+    handler.registerCallback(10, [](const LinxReceivedMessageSharedPtr &msg, void *data) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(2));
+        return 0;
+    }, nullptr);
+
+    auto msg = std::make_shared<LinxReceivedMessage>();
+    msg->message = std::make_unique<RawMessage>(10);
+    msg->timestamps.consumerPickup = LinxMessageTimestamps::now();
+
+    EXPECT_CALL(*server, receive(_, _, _)).WillOnce(Return(msg));
+    ASSERT_EQ(handler.handleMessage(10000), 0);
+    ASSERT_GE(msg->timestamps.handlerNs(), 2000000);
+    ASSERT_GE(msg->timestamps.handlerStart, msg->timestamps.consumerPickup);
+}
+
+TEST_F(LinxIpcHandlerTests, handleMessage_NoHandlerTimeWhenTimestampsDisabled) {
+    auto server = std::make_shared<NiceMock<LinxServerMock>>();
+    auto handler = LinxIpcHandler(server);
+    handler.registerCallback(10, [](const LinxReceivedMessageSharedPtr &msg, void *data) { return 0; }, nullptr);
+
+    auto msg = std::make_shared<LinxReceivedMessage>();
+    msg->message = std::make_unique<RawMessage>(10);
+
+    EXPECT_CALL(*server, receive(_, _, _)).WillOnce(Return(msg));
+    ASSERT_EQ(handler.handleMessage(10000), 0);
+    ASSERT_EQ(msg->timestamps.handlerDone, 0U);
+    ASSERT_EQ(msg->timestamps.handlerNs(), -1);
+}
+
+TEST_F(LinxIpcHandlerTests, handleMessage_RecordHandlerTimeInHistogram) {
+    auto server = std::make_shared<NiceMock<LinxServerMock>>();
+    auto handler = LinxIpcHandler(server);
+    auto histogram = std::make_shared<LinxHistogram>();
+    handler.registerCallback(10, [](const LinxReceivedMessageSharedPtr &msg, void *data) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(2));
+        return 3;
+    }, nullptr).setHandlerHistogram(10, histogram);
+
+    auto msg = std::make_shared<LinxReceivedMessage>();
+    msg->message = std::make_unique<RawMessage>(10);
+
+    EXPECT_CALL(*server, receive(_, _, _)).WillOnce(Return(msg));
+    ASSERT_EQ(handler.handleMessage(10000), 3);
+    ASSERT_EQ(histogram->getCount(), 1U);
+    ASSERT_GE(histogram->getMin(), 2000000U);
+    ASSERT_EQ(handler.getHandlerHistogram(10), histogram);
+}
+
+TEST_F(LinxIpcHandlerTests, registerCallback_KeepHistogramWhenCallbackReplaced) {
+    auto server = std::make_shared<NiceMock<LinxServerMock>>();
+    auto handler = LinxIpcHandler(server);
+    auto histogram = std::make_shared<LinxHistogram>();
+    handler.registerCallback(10, [](const LinxReceivedMessageSharedPtr &msg, void *data) { return 0; })
+           .setHandlerHistogram(10, histogram)
+           .registerCallback(10, [](const LinxReceivedMessageSharedPtr &msg, void *data) { return 1; });
+
+    ASSERT_EQ(handler.getHandlerHistogram(10), histogram);
+}
+
+TEST_F(LinxIpcHandlerTests, setHandlerHistogram_IgnoreNotRegisteredRequest) {
+    auto server = std::make_shared<NiceMock<LinxServerMock>>();
+    auto handler = LinxIpcHandler(server);
+
+    handler.setHandlerHistogram(10, std::make_shared<LinxHistogram>());
+    ASSERT_EQ(handler.getHandlerHistogram(10), nullptr);
+}
+
+TEST_F(LinxIpcHandlerTests, timestamps_BreakdownStages) {
+    LinxMessageTimestamps ts;
+    ASSERT_EQ(ts.socketWaitNs(), -1);
+    ASSERT_EQ(ts.totalNs(), -1);
+
+    ts.kernelRx = 1000;
+    ts.socketDequeue = 1500;
+    ts.queueInsert = 1600;
+    ts.consumerPickup = 2600;
+    ASSERT_EQ(ts.socketWaitNs(), 500);
+    ASSERT_EQ(ts.queueWaitNs(), 1000);
+    ASSERT_EQ(ts.totalNs(), 1600);
+
+    ts.handlerStart = 3000;
+    ts.handlerDone = 3200;
+    ASSERT_EQ(ts.handlerNs(), 200);
+    ASSERT_EQ(ts.totalNs(), 2200);
+}
+
+TEST_F(LinxIpcHandlerTests, handleMessages_DispatchAllMessagesFromBatch) {
+    MockFunction<LinxIpcCallback> mockCallback;
+
+    auto server = std::make_shared<NiceMock<LinxServerMock>>();
+    auto handler = LinxIpcHandler(server);
+    handler.registerCallback(10, mockCallback.AsStdFunction(), nullptr);
+
+    std::vector<LinxReceivedMessageSharedPtr> batch;
+    for (int i = 0; i < 3; i++) {
+        auto msg = std::make_shared<LinxReceivedMessage>();
+        msg->message = std::make_unique<RawMessage>(10);
+        batch.push_back(msg);
+    }
+
+    EXPECT_CALL(*server, receiveBatch(5, IMMEDIATE_TIMEOUT, _, _)).WillOnce(Return(batch));
+    EXPECT_CALL(mockCallback, Call(_, nullptr)).Times(3).WillRepeatedly(Return(0));
+    ASSERT_EQ(handler.handleMessages(5), 3u);
+}
+
+TEST_F(LinxIpcHandlerTests, handleMessages_ReturnZeroWhenNoMessages) {
+    auto server = std::make_shared<NiceMock<LinxServerMock>>();
+    auto handler = LinxIpcHandler(server);
+
+    EXPECT_CALL(*server, receive(IMMEDIATE_TIMEOUT, _, _)).WillOnce(Return(nullptr));
+    ASSERT_EQ(handler.handleMessages(5, 1000), 0u);
+}
+
+TEST_F(LinxIpcHandlerTests, handleMessages_StopWhenTimeBudgetUsed) {
+    auto server = std::make_shared<NiceMock<LinxServerMock>>();
+    auto handler = LinxIpcHandler(server);
+    handler.registerCallback(10, [](const LinxReceivedMessageSharedPtr &msg, void *data) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        return 0;
+    });
+
+    // Budget is exceeded after first message, following messages are not taken from the queue
+    EXPECT_CALL(*server, receiveBatch(_, _, _, _)).Times(0);
+    EXPECT_CALL(*server, receive(IMMEDIATE_TIMEOUT, _, _)).WillOnce(InvokeWithoutArgs([]() {
+        auto msg = std::make_shared<LinxReceivedMessage>();
+        msg->message = std::make_unique<RawMessage>(10);
+        return msg;
+    }));
+    ASSERT_EQ(handler.handleMessages(1000, 100), 1u);
+}
+
+TEST_F(LinxIpcHandlerTests, receiveBatch) {
+    auto server = std::make_shared<NiceMock<LinxServerMock>>();
+    auto handler = LinxIpcHandler(server);
+
+    auto msg = std::make_shared<LinxReceivedMessage>();
+    msg->message = std::make_unique<RawMessage>(10);
+
+    EXPECT_CALL(*server, receiveBatch(8, 1000, _, _))
+        .WillOnce(Return(std::vector<LinxReceivedMessageSharedPtr>{msg}));
+    auto result = handler.receiveBatch(8, 1000);
+    ASSERT_EQ(result.size(), 1);
+    ASSERT_EQ(result[0], msg);
+}
+
 TEST_F(LinxIpcHandlerTests, startStop) {
     MockFunction<LinxIpcCallback> mockCallback;
 
@@ -1,3 +1,4 @@
+#include <poll.h>
 #include <thread>
 #include "gtest/gtest.h"
 #include "UnixLinx.h"
@@ -115,6 +116,85 @@ TEST_F(LinxIpcIntegrationTests, testHandleMessageUdp) {
     ASSERT_LE(duration.count(), 10) << "Get should not take more than " << 10 <<" ms";
 }
 
+TEST_F(LinxIpcIntegrationTests, testHandleMessageUdpReliable) {
+
+    std::atomic<bool> running{true};
+    std::thread handlerThread([&]() {
+        auto server = UdpFactory::createServer(12347, 10);
+        server->setReliable(true);
+        auto handler = LinxIpcHandler(server);
+        handler.registerCallback(IPC_SIG1_REQ, [&handler](const LinxReceivedMessageSharedPtr &msg, void *data) {
+            RawMessage rsp(IPC_SIG1_RSP, {1, 2});
+            handler.send(rsp, *msg->from);
+            return 0;
+        }, nullptr);
+
+        ASSERT_TRUE(handler.start());
+        while (running) {
+            handler.handleMessage(100);
+        }
+        handler.stop();
+    });
+
+    // Ensure thread is always joined, even if test fails
+    auto threadGuard = [&]() {
+        running = false;
+        if (handlerThread.joinable()) {
+            handlerThread.join();
+        }
+    };
+    std::shared_ptr<void> guard(nullptr, [&](void*) { threadGuard(); });
+
+    auto client = UdpFactory::createClient("127.0.0.1", 12347);
+    ASSERT_EQ(client->setReliable(true), 0);
+    ASSERT_TRUE(client->connect(1000));
+
+    // Ping sent before server started is retransmitted as well, its late response is skipped by sigsel
+    for (int i = 0; i < 100; i++) {
+        auto rsp = client->sendReceive(RawMessage(IPC_SIG1_REQ, {1, 2}), 1000, {IPC_SIG1_RSP});
+        ASSERT_NE(rsp, nullptr);
+        ASSERT_EQ(rsp->getReqId(), IPC_SIG1_RSP);
+    }
+
+    auto metrics = client->getMetrics();
+    EXPECT_EQ(metrics.deliveryFailures, 0u);
+}
+
+TEST_F(LinxIpcIntegrationTests, handleMessages_PollFdReadableWhenBudgetRunsOut) {
+    auto server = AfUnixFactory::createServer("TestService", 10);
+    auto handler = LinxIpcHandler(server);
+    std::vector<uint32_t> handled;
+    handler.registerCallback(IPC_SIG1_REQ, [&handled](const LinxReceivedMessageSharedPtr &msg, void *data) {
+        handled.push_back(msg->message->getReqId());
+        std::this_thread::sleep_for(std::chrono::milliseconds(2));
+        return 0;
+    }, nullptr)
+    .registerCallback(IPC_SIG2_REQ, [&handled](const LinxReceivedMessageSharedPtr &msg, void *data) {
+        handled.push_back(msg->message->getReqId());
+        return 0;
+    }, nullptr);
+    ASSERT_TRUE(handler.start());
+
+    auto client = AfUnixFactory::createClient("TestService");
+    ASSERT_EQ(client->send(RawMessage(IPC_SIG1_REQ)), 0);
+    ASSERT_EQ(client->send(RawMessage(IPC_SIG2_REQ)), 0);
+
+    struct pollfd pfd = {handler.getPollFd(), POLLIN, 0};
+    ASSERT_EQ(poll(&pfd, 1, 1000), 1);
+    while (server->getMetrics().queueDepth < 2) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    ASSERT_EQ(handler.handleMessages(10, 100), 1u);
+
+    // Message left by budget is still signaled and received in order
+    EXPECT_EQ(poll(&pfd, 1, 0), 1);
+    auto msg = handler.receive(IMMEDIATE_TIMEOUT);
+    ASSERT_NE(msg, nullptr);
+    EXPECT_EQ(msg->message->getReqId(), IPC_SIG2_REQ);
+    EXPECT_EQ(handled, std::vector<uint32_t>{IPC_SIG1_REQ});
+    handler.stop();
+}
+
 TEST_F(LinxIpcIntegrationTests, testConnectTwoServers) {
 
     std::atomic<bool> running{true};
@@ -193,3 +273,31 @@ TEST_F(LinxIpcIntegrationTests, TestFailToConnectToNonExistingServer) {
     auto rsp = client->connect(100);
     ASSERT_FALSE(rsp);
 }
+
+TEST_F(LinxIpcIntegrationTests, testTimestampsRecordedForEachStage) {
+
+    auto server = AfUnixFactory::createServer("TestService", 10);
+    ASSERT_EQ(server->setTimestamping(true), 0);
+    ASSERT_TRUE(server->start());
+
+    auto client = AfUnixFactory::createClient("TestService");
+    ASSERT_TRUE(client->connect(1000));
+    ASSERT_GE(client->send(RawMessage(IPC_SIG1_REQ)), 0);
+
+    auto handler = LinxIpcHandler(server);
+    LinxMessageTimestamps timestamps{};
+    handler.registerCallback(IPC_SIG1_REQ, [&timestamps](const LinxReceivedMessageSharedPtr &msg, void *data) {
+        timestamps = msg->timestamps;
+        return 0;
+    }, nullptr);
+    ASSERT_EQ(handler.handleMessage(1000), 0);
+
+    EXPECT_NE(timestamps.kernelRx, 0U);
+    EXPECT_LE(timestamps.kernelRx, timestamps.socketDequeue);
+    EXPECT_LE(timestamps.socketDequeue, timestamps.queueInsert);
+    EXPECT_LE(timestamps.queueInsert, timestamps.consumerPickup);
+    EXPECT_GE(timestamps.socketWaitNs(), 0);
+    EXPECT_GE(timestamps.queueWaitNs(), 0);
+
+    server->stop();
+}
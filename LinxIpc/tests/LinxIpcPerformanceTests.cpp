@@ -7,6 +7,9 @@
 #include <sys/utsname.h>
 #include "gtest/gtest.h"
 #include "UnixLinx.h"
+#include "UdpLinx.h"
+#include "LinxHistogram.h"
+#include "trace.h"
 
 using namespace ::testing;
 using namespace std::chrono;
@@ -199,6 +202,9 @@ TEST_F(LinxIpcPerformanceTests, Latency_SingleMessage) {
         client->sendReceive(msg, 1000, {PERF_SIG_RSP});
     }
 
+    auto histogram = std::make_shared<LinxHistogram>();
+    client->setLatencyHistogram(histogram);
+
     // Measure minimum latency over 100 samples
     auto minLatency = duration<double, std::milli>::max();
     auto maxLatency = duration<double, std::milli>::min();
@@ -231,6 +237,9 @@ TEST_F(LinxIpcPerformanceTests, Latency_SingleMessage) {
     std::cout << std::left << std::setw(labelWidth) << "Min latency:" << minLatency.count() << " ms\n";
     std::cout << std::left << std::setw(labelWidth) << "Max latency:" << maxLatency.count() << " ms\n";
     std::cout << std::left << std::setw(labelWidth) << "Avg latency:" << avgLatency << " ms\n";
+    std::cout << std::left << std::setw(labelWidth) << "p50 latency:" << histogram->valueAtPercentile(50.0) / 1e6 << " ms\n";
+    std::cout << std::left << std::setw(labelWidth) << "p99 latency:" << histogram->valueAtPercentile(99.0) / 1e6 << " ms\n";
+    std::cout << std::left << std::setw(labelWidth) << "p99.9 latency:" << histogram->valueAtPercentile(99.9) / 1e6 << " ms\n";
     std::cout << "=======================\n";
 
     EXPECT_LT(avgLatency, 10.0) << "Average latency should be < 10 ms";
@@ -376,3 +385,175 @@ TEST_F(LinxIpcPerformanceTests, Concurrency_MultipleClients) {
     EXPECT_EQ(totalMessages, expectedMessages);
     EXPECT_GT(messagesPerSecond, 500) << "Concurrent throughput should be > 500 msg/s";
 }
+
+TEST_F(LinxIpcPerformanceTests, Scaling_UdpShardedServers) {
+    const int numClients = 8;
+    const int messagesPerClient = 1000;
+    const uint16_t basePort = 23450;
+
+    std::cout << "\n=== UDP Sharded Server Scaling ===\n";
+    std::cout << std::left << std::setw(labelWidth) << "Workers:" << "Throughput\n";
+
+    for (size_t workers : {1, 2, 4, 8}) {
+        std::atomic<bool> running{true};
+        std::atomic<int> totalMessages{0};
+
+        uint16_t port = basePort + workers;
+        auto servers = UdpFactory::createShardedServer(port, workers, 1000);
+        ASSERT_EQ(servers.size(), workers);
+
+        std::vector<std::thread> workerThreads;
+        for (auto &server : servers) {
+            workerThreads.emplace_back([&, server]() {
+                auto handler = LinxIpcHandler(server);
+                handler.registerCallback(PERF_SIG_REQ,
+                    [&](const LinxReceivedMessageSharedPtr &msg, void *data) {
+                        totalMessages++;
+                        RawMessage rsp(PERF_SIG_RSP);
+                        handler.send(rsp, *msg->from);
+                        return 0;
+                    }, nullptr);
+
+                handler.start();
+                while (running) {
+                    handler.handleMessage(10);
+                }
+                handler.stop();
+            });
+        }
+
+        std::this_thread::sleep_for(milliseconds(100));
+
+        std::vector<std::thread> clientThreads;
+        auto start = high_resolution_clock::now();
+
+        for (int c = 0; c < numClients; c++) {
+            clientThreads.emplace_back([port]() {
+                auto client = UdpFactory::createClient("127.0.0.1", port);
+                ASSERT_TRUE(client->connect(5000));
+
+                for (int i = 0; i < messagesPerClient; i++) {
+                    RawMessage msg(PERF_SIG_REQ);
+                    auto rsp = client->sendReceive(msg, 2000, {PERF_SIG_RSP});
+                    ASSERT_NE(rsp, nullptr);
+                }
+            });
+        }
+
+        for (auto &thread : clientThreads) {
+            thread.join();
+        }
+
+        auto end = high_resolution_clock::now();
+        auto duration = duration_cast<milliseconds>(end - start).count();
+
+        running = false;
+        for (auto &thread : workerThreads) {
+            thread.join();
+        }
+
+        double messagesPerSecond = (numClients * messagesPerClient * 1000.0) / std::max<long>(duration, 1);
+        std::cout << std::left << std::setw(labelWidth) << workers << messagesPerSecond << " msg/s\n";
+
+        EXPECT_EQ(totalMessages, numClients * messagesPerClient);
+    }
+
+    std::cout << "==================================\n";
+}
+
+TEST_F(LinxIpcPerformanceTests, Latency_BusyPollSpinCost) {
+    const int samples = 500;
+
+    std::cout << "\n=== Busy Poll Spin Cost ===\n";
+    std::cout << std::left << std::setw(labelWidth) << "Spin [us]:"
+              << std::setw(labelWidth) << "Avg latency [us]" << "CPU per msg [us]\n";
+
+    for (int spinUs : {0, 10, 50, 200}) {
+        std::atomic<bool> running{true};
+        std::string serverName = "BusyPollServer" + std::to_string(spinUs);
+
+        auto server = AfUnixFactory::createServer(serverName);
+        server->setBusyPoll(spinUs);
+
+        std::thread serverThread([&]() {
+            auto handler = LinxIpcHandler(server);
+            handler.registerCallback(PERF_SIG_REQ,
+                [&](const LinxReceivedMessageSharedPtr &msg, void *data) {
+                    RawMessage rsp(PERF_SIG_RSP);
+                    handler.send(rsp, *msg->from);
+                    return 0;
+                }, nullptr);
+
+            handler.start();
+            while (running) {
+                handler.handleMessage(100);
+            }
+            handler.stop();
+        });
+
+        std::this_thread::sleep_for(milliseconds(100));
+
+        auto client = AfUnixFactory::createClient(serverName);
+        ASSERT_TRUE(client->connect(5000));
+        client->setBusyPoll(spinUs);
+
+        for (int i = 0; i < 10; i++) {
+            RawMessage msg(PERF_SIG_REQ);
+            client->sendReceive(msg, 1000, {PERF_SIG_RSP});
+        }
+
+        timespec cpuStart{}, cpuEnd{};
+        clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &cpuStart);
+        auto start = high_resolution_clock::now();
+
+        for (int i = 0; i < samples; i++) {
+            RawMessage msg(PERF_SIG_REQ);
+            auto rsp = client->sendReceive(msg, 1000, {PERF_SIG_RSP});
+            ASSERT_NE(rsp, nullptr);
+        }
+
+        auto end = high_resolution_clock::now();
+        clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &cpuEnd);
+
+        running = false;
+        serverThread.join();
+
+        double avgLatency = duration<double, std::micro>(end - start).count() / samples;
+        double cpuUs = (cpuEnd.tv_sec - cpuStart.tv_sec) * 1e6 + (cpuEnd.tv_nsec - cpuStart.tv_nsec) / 1e3;
+        std::cout << std::left << std::setw(labelWidth) << spinUs
+                  << std::setw(labelWidth) << avgLatency << cpuUs / samples << "\n";
+    }
+
+    std::cout << "===========================\n";
+}
+
+TEST_F(LinxIpcPerformanceTests, Latency_TraceCallerCost) {
+    const int samples = 2000;
+    std::string path = "/tmp/linx_trace_perf_" + std::to_string(getpid()) + ".log";
+
+    auto measure = [&]() {
+        auto start = high_resolution_clock::now();
+        for (int i = 0; i < samples; i++) {
+            trace_error(__FILE__, __LINE__, "[%s] Received reqId: 0x%x from: %s discarded - queue full",
+                        "perf_server", i, "perf_client");
+        }
+        return duration<double, std::nano>(high_resolution_clock::now() - start).count() / samples;
+    };
+
+    double syncNs = measure();
+    ASSERT_EQ(trace_start_async(path.c_str()), 0);
+    double asyncNs = measure();
+    trace_stop_async();
+    unlink(path.c_str());
+    ASSERT_EQ(trace_start_binary(path.c_str(), 0), 0);
+    double binaryNs = measure();
+    trace_stop_binary();
+    unlink(path.c_str());
+
+    std::cout << "\n=== Trace Caller Cost ===\n";
+    std::cout << std::left << std::setw(labelWidth) << "Synchronous:" << syncNs << " ns/call\n";
+    std::cout << std::left << std::setw(labelWidth) << "Asynchronous:" << asyncNs << " ns/call\n";
+    std::cout << std::left << std::setw(labelWidth) << "Binary:" << binaryNs << " ns/call\n";
+    std::cout << std::left << std::setw(labelWidth) << "Dropped:" << trace_dropped() << "\n";
+    std::cout << "=========================\n";
+}
@@ -0,0 +1,87 @@
+#include "gtest/gtest.h"
+#include "LinxLogLevels.h"
+#include "LinxTrace.h"
+
+using namespace ::testing;
+
+class LinxLogLevelsTests : public testing::Test {
+  protected:
+    int savedLevels[static_cast<int>(LinxLogModule::COUNT)];
+
+    void SetUp() override {
+        for (int i = 0; i < static_cast<int>(LinxLogModule::COUNT); i++) {
+            savedLevels[i] = LinxLogLevels::get(static_cast<LinxLogModule>(i));
+        }
+    }
+
+    void TearDown() override {
+        for (int i = 0; i < static_cast<int>(LinxLogModule::COUNT); i++) {
+            LinxLogLevels::set(static_cast<LinxLogModule>(i), savedLevels[i]);
+        }
+    }
+};
+
+TEST_F(LinxLogLevelsTests, set_ChangeLevelOfSingleModule) {
+    LinxLogLevels::setAll(SEVERITY_ERROR);
+    ASSERT_EQ(LinxLogLevels::set(LinxLogModule::SERVER, SEVERITY_DEBUG), 0);
+
+    ASSERT_EQ(LinxLogLevels::get(LinxLogModule::SERVER), SEVERITY_DEBUG);
+    ASSERT_EQ(LinxLogLevels::get(LinxLogModule::CLIENT), SEVERITY_ERROR);
+    ASSERT_TRUE(LinxLogLevels::isEnabled(LinxLogModule::SERVER, SEVERITY_DEBUG));
+    ASSERT_FALSE(LinxLogLevels::isEnabled(LinxLogModule::CLIENT, SEVERITY_WARNING));
+    ASSERT_TRUE(LinxLogLevels::isEnabled(LinxLogModule::CLIENT, SEVERITY_ERROR));
+}
+
+TEST_F(LinxLogLevelsTests, set_ReturnErrorOnInvalidArguments) {
+    ASSERT_EQ(LinxLogLevels::set(LinxLogModule::COUNT, SEVERITY_DEBUG), -1);
+    ASSERT_EQ(LinxLogLevels::set(LinxLogModule::QUEUE, SEVERITY_DEBUG + 1), -1);
+    ASSERT_EQ(LinxLogLevels::set(LinxLogModule::QUEUE, -1), -1);
+    ASSERT_EQ(LinxLogLevels::setAll(SEVERITY_DEBUG + 1), -1);
+    ASSERT_EQ(LinxLogLevels::get(LinxLogModule::COUNT), -1);
+}
+
+TEST_F(LinxLogLevelsTests, set_ZeroDisablesModule) {
+    ASSERT_EQ(LinxLogLevels::set(LinxLogModule::SOCKET, 0), 0);
+    ASSERT_FALSE(LinxLogLevels::isEnabled(LinxLogModule::SOCKET, SEVERITY_ERROR));
+}
+
+TEST_F(LinxLogLevelsTests, configure_ApplyModuleList) {
+    ASSERT_EQ(LinxLogLevels::configure("all=1,server=4,queue=2"), 0);
+
+    ASSERT_EQ(LinxLogLevels::get(LinxLogModule::SERVER), SEVERITY_DEBUG);
+    ASSERT_EQ(LinxLogLevels::get(LinxLogModule::QUEUE), SEVERITY_WARNING);
+    ASSERT_EQ(LinxLogLevels::get(LinxLogModule::HANDLER), SEVERITY_ERROR);
+}
+
+TEST_F(LinxLogLevelsTests, configure_SingleLevelAppliesToAllModules) {
+    ASSERT_EQ(LinxLogLevels::configure("3"), 0);
+
+    for (int i = 0; i < static_cast<int>(LinxLogModule::COUNT); i++) {
+        ASSERT_EQ(LinxLogLevels::get(static_cast<LinxLogModule>(i)), SEVERITY_INFO);
+    }
+}
+
+TEST_F(LinxLogLevelsTests, configure_ApplyValidEntriesAndReturnErrorOnInvalid) {
+    LinxLogLevels::setAll(SEVERITY_ERROR);
+    ASSERT_EQ(LinxLogLevels::configure("client=4,unknown=2,socket=9,handler=x"), -1);
+
+    ASSERT_EQ(LinxLogLevels::get(LinxLogModule::CLIENT), SEVERITY_DEBUG);
+    ASSERT_EQ(LinxLogLevels::get(LinxLogModule::SOCKET), SEVERITY_ERROR);
+    ASSERT_EQ(LinxLogLevels::get(LinxLogModule::HANDLER), SEVERITY_ERROR);
+}
+
+TEST_F(LinxLogLevelsTests, trace_ArgumentsNotEvaluatedWhenModuleDisabled) {
+    int evaluated = 0;
+    [[maybe_unused]] auto argument = [&]() {
+        evaluated++;
+        return 0;
+    };
+
+    LinxLogLevels::set(LinxLogModule::CLIENT, 0);
+    LINX_ERROR(CLIENT, "value: %d", argument());
+    ASSERT_EQ(evaluated, 0);
+
+    LinxLogLevels::set(LinxLogModule::CLIENT, SEVERITY_ERROR);
+    LINX_ERROR(CLIENT, "value: %d", argument());
+    ASSERT_EQ(evaluated, TRACE_LEVEL >= SEVERITY_ERROR ? 1 : 0);
+}
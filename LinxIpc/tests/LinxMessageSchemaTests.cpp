@@ -0,0 +1,135 @@
+#include "gtest/gtest.h"
+#include "LinxIpc.h"
+#include <arpa/inet.h>
+
+using namespace ::testing;
+
+namespace {
+
+struct PackedData {
+    uint32_t id;
+    float values[4];
+};
+
+struct MixedData {
+    uint8_t flag;
+    uint32_t id;
+    std::array<uint16_t, 3> samples;
+    double ratio;
+};
+
+enum class Mode : uint16_t { IDLE = 1, ACTIVE = 0x0102 };
+
+struct ReorderedData {
+    uint32_t first;
+    Mode mode;
+    uint16_t second;
+};
+
+} // namespace
+
+template<>
+struct LinxMessageSchema<PackedData> : LinxSchemaFields<&PackedData::id, &PackedData::values> {};
+
+template<>
+struct LinxMessageSchema<MixedData> : LinxSchemaFields<&MixedData::flag, &MixedData::id, &MixedData::samples, &MixedData::ratio> {
+    static constexpr LinxByteOrder byteOrder = LinxByteOrder::BIG;
+};
+
+template<>
+struct LinxMessageSchema<ReorderedData> : LinxSchemaFields<&ReorderedData::second, &ReorderedData::mode, &ReorderedData::first> {};
+
+static_assert(LinxSchemaCodec<PackedData>::size == 20);
+static_assert(LinxSchemaCodec<MixedData>::size == 1 + 4 + 6 + 8);
+static_assert(LinxSchemaCodec<ReorderedData>::size == 8);
+
+TEST(LinxMessageSchemaTests, serialize_PackedLittleEndianLayoutIsMemcpy) {
+    PackedData data = {7, {1.0f, 2.0f, 3.0f, 4.0f}};
+    uint8_t buffer[LinxSchemaCodec<PackedData>::size];
+
+    ASSERT_EQ(LinxSchemaCodec<PackedData>::serialize(data, buffer, sizeof(buffer)), sizeof(buffer));
+    ASSERT_EQ(LinxSchemaCodec<PackedData>::isMemcpyLayout(), __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__);
+    ASSERT_EQ(buffer[0], 7);
+    ASSERT_EQ(buffer[1], 0);
+}
+
+TEST(LinxMessageSchemaTests, serialize_WriteFieldsWithoutPaddingInBigEndian) {
+    MixedData data = {0xAA, 0x11223344, {0x0102, 0x0304, 0x0506}, 0.5};
+    uint8_t buffer[LinxSchemaCodec<MixedData>::size];
+
+    ASSERT_EQ(LinxSchemaCodec<MixedData>::serialize(data, buffer, sizeof(buffer)), sizeof(buffer));
+    ASSERT_FALSE(LinxSchemaCodec<MixedData>::isMemcpyLayout());
+
+    uint8_t expectedHead[] = {0xAA, 0x11, 0x22, 0x33, 0x44, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06};
+    ASSERT_EQ(memcmp(buffer, expectedHead, sizeof(expectedHead)), 0);
+    uint8_t expectedRatio[] = {0x3F, 0xE0, 0, 0, 0, 0, 0, 0};
+    ASSERT_EQ(memcmp(buffer + sizeof(expectedHead), expectedRatio, sizeof(expectedRatio)), 0);
+}
+
+TEST(LinxMessageSchemaTests, serialize_FollowSchemaOrder) {
+    ReorderedData data = {0x01020304, Mode::ACTIVE, 0x0506};
+    uint8_t buffer[LinxSchemaCodec<ReorderedData>::size];
+
+    ASSERT_EQ(LinxSchemaCodec<ReorderedData>::serialize(data, buffer, sizeof(buffer)), sizeof(buffer));
+    ASSERT_FALSE(LinxSchemaCodec<ReorderedData>::isMemcpyLayout());
+
+    uint8_t expected[] = {0x06, 0x05, 0x02, 0x01, 0x04, 0x03, 0x02, 0x01};
+    ASSERT_EQ(memcmp(buffer, expected, sizeof(expected)), 0);
+}
+
+TEST(LinxMessageSchemaTests, serialize_FailOnTooSmallBuffer) {
+    MixedData data = {};
+    uint8_t buffer[LinxSchemaCodec<MixedData>::size - 1];
+
+    ASSERT_EQ(LinxSchemaCodec<MixedData>::serialize(data, buffer, sizeof(buffer)), 0u);
+    ASSERT_FALSE(LinxSchemaCodec<MixedData>::deserialize(buffer, sizeof(buffer), data));
+}
+
+TEST(LinxMessageSchemaTests, deserialize_RestoreSerializedData) {
+    MixedData data = {1, 0xDEADBEEF, {7, 8, 9}, -2.25};
+    uint8_t buffer[LinxSchemaCodec<MixedData>::size];
+    LinxSchemaCodec<MixedData>::serialize(data, buffer, sizeof(buffer));
+
+    MixedData result = {};
+    ASSERT_TRUE(LinxSchemaCodec<MixedData>::deserialize(buffer, sizeof(buffer), result));
+    ASSERT_EQ(result.flag, 1);
+    ASSERT_EQ(result.id, 0xDEADBEEF);
+    ASSERT_EQ(result.samples, data.samples);
+    ASSERT_EQ(result.ratio, -2.25);
+}
+
+TEST(LinxMessageSchemaTests, schemaMessage_RoundTripThroughRawMessage) {
+    LinxSchemaMessage<ReorderedData> msg(0x20, {10, Mode::IDLE, 20});
+    std::vector<uint8_t> buffer(msg.getSize());
+    ASSERT_EQ(msg.serialize(buffer.data(), buffer.size()), buffer.size());
+
+    auto raw = RawMessage::deserialize(std::move(buffer));
+    auto result = LinxSchemaMessage<ReorderedData>::fromRawMessage(*raw);
+
+    ASSERT_NE(result, nullptr);
+    ASSERT_EQ(result->getReqId(), 0x20u);
+    ASSERT_EQ(result->getPayload()->first, 10u);
+    ASSERT_EQ(result->getPayload()->mode, Mode::IDLE);
+    ASSERT_EQ(result->getPayload()->second, 20);
+}
+
+TEST(LinxMessageSchemaTests, schemaMessage_FailOnShortPayload) {
+    RawMessage raw(0x20, LinxSchemaCodec<ReorderedData>::size - 1);
+
+    ASSERT_EQ(LinxSchemaMessage<ReorderedData>::fromRawMessage(raw), nullptr);
+}
+
+TEST(LinxMessageSchemaTests, myMessage_ValueSentInNetworkOrder) {
+    MyMessage msg(5, 0x01020304, 1.5f);
+    std::vector<uint8_t> buffer(msg.getSize());
+    ASSERT_EQ(msg.serialize(buffer.data(), buffer.size()), buffer.size());
+
+    uint32_t value;
+    memcpy(&value, buffer.data() + sizeof(uint32_t), sizeof(value));
+    ASSERT_EQ(ntohl(value), 0x01020304u);
+
+    auto result = MyMessage::fromRawMessage(*RawMessage::deserialize(std::move(buffer)));
+    ASSERT_NE(result, nullptr);
+    ASSERT_EQ(result->getValue(), 0x01020304);
+    ASSERT_EQ(result->getTemperature(), 1.5f);
+}
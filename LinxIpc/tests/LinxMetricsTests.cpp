@@ -0,0 +1,170 @@
+#include <dirent.h>
+#include <fstream>
+#include <sstream>
+#include <thread>
+#include <unistd.h>
+#include "gtest/gtest.h"
+#include "LinxMetrics.h"
+
+using namespace ::testing;
+
+class LinxMetricsTests : public testing::Test {
+};
+
+namespace {
+
+size_t countFiles(const std::string &dir) {
+    size_t count = 0;
+    DIR *d = opendir(dir.c_str());
+    while (auto *entry = readdir(d)) {
+        if (entry->d_name[0] != '.') {
+            count++;
+        }
+    }
+    closedir(d);
+    return count;
+}
+
+} // namespace
+
+TEST_F(LinxMetricsTests, snapshot_ReturnZeroCountersInitially) {
+    LinxMetrics metrics;
+    auto snapshot = metrics.snapshot("server");
+
+    ASSERT_EQ(snapshot.name, "server");
+    ASSERT_EQ(snapshot.rxMessages, 0U);
+    ASSERT_EQ(snapshot.txMessages, 0U);
+    ASSERT_EQ(snapshot.queueDrops, 0U);
+}
+
+TEST_F(LinxMetricsTests, snapshot_ReturnUpdatedCounters) {
+    LinxMetrics metrics;
+    metrics.onReceive(100);
+    metrics.onReceive(50);
+    metrics.onSend(10);
+    metrics.onSendError();
+    metrics.onReceiveError();
+    metrics.onDeserializeError();
+    metrics.onQueueDrop();
+    metrics.onPing();
+
+    auto snapshot = metrics.snapshot("server");
+    ASSERT_EQ(snapshot.rxMessages, 2U);
+    ASSERT_EQ(snapshot.rxBytes, 150U);
+    ASSERT_EQ(snapshot.txMessages, 1U);
+    ASSERT_EQ(snapshot.txBytes, 10U);
+    ASSERT_EQ(snapshot.sendErrors, 1U);
+    ASSERT_EQ(snapshot.receiveErrors, 1U);
+    ASSERT_EQ(snapshot.deserializeErrors, 1U);
+    ASSERT_EQ(snapshot.queueDrops, 1U);
+    ASSERT_EQ(snapshot.pings, 1U);
+}
+
+TEST_F(LinxMetricsTests, reset_ClearCounters) {
+    LinxMetrics metrics;
+    metrics.onReceive(100);
+    metrics.onQueueDrop();
+    metrics.reset();
+
+    auto snapshot = metrics.snapshot("server");
+    ASSERT_EQ(snapshot.rxMessages, 0U);
+    ASSERT_EQ(snapshot.rxBytes, 0U);
+    ASSERT_EQ(snapshot.queueDrops, 0U);
+}
+
+TEST_F(LinxMetricsTests, onReceive_CountFromMultipleThreads) {
+    LinxMetrics metrics;
+    std::vector<std::thread> threads;
+    for (int i = 0; i < 4; i++) {
+        threads.emplace_back([&metrics]() {
+            for (int j = 0; j < 10000; j++) {
+                metrics.onReceive(1);
+                metrics.onSend(2);
+            }
+        });
+    }
+    for (auto &thread : threads) {
+        thread.join();
+    }
+
+    auto snapshot = metrics.snapshot("server");
+    ASSERT_EQ(snapshot.rxMessages, 40000U);
+    ASSERT_EQ(snapshot.txBytes, 80000U);
+}
+
+TEST_F(LinxMetricsTests, formatPrometheus_ContainsSamplesForAllSnapshots) {
+    LinxMetricsSnapshot server{.name = "server", .rxMessages = 5, .queueDrops = 2, .queueHighWater = 7};
+    LinxMetricsSnapshot client{.name = "client", .txMessages = 3};
+
+    auto text = LinxMetrics::formatPrometheus({server, client});
+
+    EXPECT_NE(text.find("# TYPE linx_rx_messages_total counter\n"), std::string::npos);
+    EXPECT_NE(text.find("linx_rx_messages_total{name=\"server\"} 5\n"), std::string::npos);
+    EXPECT_NE(text.find("linx_rx_messages_total{name=\"client\"} 0\n"), std::string::npos);
+    EXPECT_NE(text.find("linx_tx_messages_total{name=\"client\"} 3\n"), std::string::npos);
+    EXPECT_NE(text.find("linx_queue_drops_total{name=\"server\"} 2\n"), std::string::npos);
+    EXPECT_NE(text.find("# TYPE linx_queue_high_water gauge\n"), std::string::npos);
+    EXPECT_NE(text.find("linx_queue_high_water{name=\"server\"} 7\n"), std::string::npos);
+}
+
+TEST_F(LinxMetricsTests, formatPrometheus_EscapeLabelValue) {
+    LinxMetricsSnapshot server{.name = "a\"b\\c"};
+
+    auto text = LinxMetrics::formatPrometheus({server});
+    EXPECT_NE(text.find("{name=\"a\\\"b\\\\c\"}"), std::string::npos);
+}
+
+TEST_F(LinxMetricsTests, writePrometheus_WriteFile) {
+    char dir[] = "/tmp/linx_metrics_test_XXXXXX";
+    ASSERT_NE(mkdtemp(dir), nullptr);
+    std::string path = std::string(dir) + "/metrics.prom";
+    LinxMetricsSnapshot server{.name = "server", .rxMessages = 5};
+
+    ASSERT_EQ(LinxMetrics::writePrometheus(path, {server}), 0);
+
+    std::ifstream file(path);
+    std::stringstream content;
+    content << file.rdbuf();
+    EXPECT_EQ(content.str(), LinxMetrics::formatPrometheus({server}));
+    // Temporary file was renamed
+    EXPECT_EQ(countFiles(dir), 1u);
+    unlink(path.c_str());
+    rmdir(dir);
+}
+
+TEST_F(LinxMetricsTests, writePrometheus_ConcurrentWritersToSamePath) {
+    char dir[] = "/tmp/linx_metrics_test_XXXXXX";
+    ASSERT_NE(mkdtemp(dir), nullptr);
+    std::string path = std::string(dir) + "/metrics.prom";
+
+    std::vector<std::thread> writers;
+    for (uint64_t i = 0; i < 4; i++) {
+        writers.emplace_back([&path, i]() {
+            LinxMetricsSnapshot server{.name = "server", .rxMessages = i};
+            for (int n = 0; n < 50; n++) {
+                EXPECT_EQ(LinxMetrics::writePrometheus(path, {server}), 0);
+            }
+        });
+    }
+    for (auto &writer : writers) {
+        writer.join();
+    }
+
+    // File is complete output of one of writers, no temporary file is left behind
+    std::ifstream file(path);
+    std::stringstream content;
+    content << file.rdbuf();
+    bool complete = false;
+    for (uint64_t i = 0; i < 4; i++) {
+        LinxMetricsSnapshot server{.name = "server", .rxMessages = i};
+        complete |= content.str() == LinxMetrics::formatPrometheus({server});
+    }
+    EXPECT_TRUE(complete);
+    EXPECT_EQ(countFiles(dir), 1u);
+    unlink(path.c_str());
+    rmdir(dir);
+}
+
+TEST_F(LinxMetricsTests, writePrometheus_ReturnErrorWhenDirectoryDoesNotExist) {
+    ASSERT_EQ(LinxMetrics::writePrometheus("/nonexistent_dir/metrics.prom", {}), -1);
+}
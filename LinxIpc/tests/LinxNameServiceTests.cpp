@@ -0,0 +1,248 @@
+#include "gtest/gtest.h"
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <future>
+#include <thread>
+#include "LinxNameService.h"
+#include "AfUnixSocket.h"
+#include "LinxNameRecord.h"
+#include "LinxMessageIds.h"
+#include "UdpLinx.h"
+
+using namespace ::testing;
+
+namespace {
+
+const std::string SERVICE = "test_name_service";
+constexpr int REFRESH_MS = 50;
+constexpr int LEASE_MS = 200;
+
+// Collects listener notifications of resolver thread
+class UpdateLog {
+  public:
+    LinxNameResolver::Listener listener() {
+        return [this](const std::string &name, const std::string &endpoint) {
+            std::lock_guard<std::mutex> lock(mutex);
+            updates.push_back(name + "=" + endpoint);
+            changed.notify_all();
+        };
+    }
+
+    bool waitFor(const std::string &update, size_t count = 1, int timeoutMs = 1000) {
+        std::unique_lock<std::mutex> lock(mutex);
+        return changed.wait_for(lock, std::chrono::milliseconds(timeoutMs), [&]() {
+            return static_cast<size_t>(std::count(updates.begin(), updates.end(), update)) >= count;
+        });
+    }
+
+    size_t count(const std::string &update) {
+        std::lock_guard<std::mutex> lock(mutex);
+        return std::count(updates.begin(), updates.end(), update);
+    }
+
+  private:
+    std::mutex mutex;
+    std::condition_variable changed;
+    std::vector<std::string> updates;
+};
+
+} // namespace
+
+class LinxNameServiceTests : public testing::Test {
+  protected:
+    void SetUp() override {
+        service = LinxNameService::create(SERVICE, LEASE_MS);
+        ASSERT_NE(service, nullptr);
+        ASSERT_TRUE(service->start());
+    }
+
+    std::unique_ptr<LinxNameService> service;
+};
+
+TEST_F(LinxNameServiceTests, create_FailsWhenNameServiceAlreadyRuns) {
+    EXPECT_EQ(LinxNameService::create(SERVICE), nullptr);
+}
+
+TEST_F(LinxNameServiceTests, resolve_ReturnsRegisteredEndpoint) {
+    auto server = LinxNameResolver::create(SERVICE, REFRESH_MS);
+    auto client = LinxNameResolver::create(SERVICE, REFRESH_MS);
+    ASSERT_EQ(server->registerName("Service", "service_socket"), 0);
+
+    EXPECT_EQ(client->resolve("Service", 1000), "service_socket");
+    EXPECT_EQ(service->getRegisteredCount(), 1u);
+}
+
+TEST_F(LinxNameServiceTests, resolve_WaitsForRegistrationPushedByNameService) {
+    auto server = LinxNameResolver::create(SERVICE, 1000);
+    auto client = LinxNameResolver::create(SERVICE, 1000);
+
+    auto start = std::chrono::steady_clock::now();
+    auto resolved = std::async(std::launch::async, [&client]() { return client->resolve("Service", 2000); });
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    ASSERT_EQ(server->registerName("Service", "service_socket"), 0);
+
+    EXPECT_EQ(resolved.get(), "service_socket");
+    // Delivered by push, long before refresh interval
+    EXPECT_LT(std::chrono::steady_clock::now() - start, std::chrono::milliseconds(500));
+}
+
+TEST_F(LinxNameServiceTests, resolve_ReturnsEmptyOnTimeout) {
+    auto client = LinxNameResolver::create(SERVICE, REFRESH_MS);
+    EXPECT_EQ(client->resolve("Unknown", 50), "");
+    EXPECT_EQ(client->resolve("", 50), "");
+}
+
+TEST_F(LinxNameServiceTests, resolve_ReturnsCachedEndpointWithoutNameService) {
+    auto server = LinxNameResolver::create(SERVICE, REFRESH_MS);
+    auto client = LinxNameResolver::create(SERVICE, REFRESH_MS);
+    ASSERT_EQ(server->registerName("Service", "service_socket"), 0);
+    ASSERT_EQ(client->resolve("Service", 1000), "service_socket");
+
+    service.reset();
+    EXPECT_EQ(client->resolve("Service", 0), "service_socket");
+}
+
+TEST_F(LinxNameServiceTests, listener_NotifiedOnServerRestartAndUnregister) {
+    UpdateLog log;
+    auto client = LinxNameResolver::create(SERVICE, REFRESH_MS);
+    client->setListener(log.listener());
+
+    auto server = LinxNameResolver::create(SERVICE, REFRESH_MS);
+    ASSERT_EQ(server->registerName("Service", "service_socket"), 0);
+    ASSERT_EQ(client->resolve("Service", 1000), "service_socket");
+    EXPECT_TRUE(log.waitFor("Service=service_socket"));
+
+    // Restarted server registers the same endpoint again
+    server.reset();
+    EXPECT_TRUE(log.waitFor("Service="));
+    server = LinxNameResolver::create(SERVICE, REFRESH_MS);
+    ASSERT_EQ(server->registerName("Service", "service_socket"), 0);
+    ASSERT_TRUE(log.waitFor("Service=service_socket", 2));
+    std::this_thread::sleep_for(std::chrono::milliseconds(3 * REFRESH_MS));
+    EXPECT_EQ(log.count("Service=service_socket"), 2u);
+
+    EXPECT_EQ(server->unregisterName("Service"), 0);
+    EXPECT_EQ(server->unregisterName("Service"), -1);
+    EXPECT_TRUE(log.waitFor("Service=", 2));
+}
+
+TEST_F(LinxNameServiceTests, unregisterName_KeepsRegistrationOfNewOwner) {
+    auto previous = LinxNameResolver::create(SERVICE, REFRESH_MS);
+    auto restarted = LinxNameResolver::create(SERVICE, REFRESH_MS);
+    auto client = LinxNameResolver::create(SERVICE, REFRESH_MS);
+    ASSERT_EQ(previous->registerName("Service", "previous_socket"), 0);
+    ASSERT_EQ(client->resolve("Service", 1000), "previous_socket");
+    ASSERT_EQ(restarted->registerName("Service", "restarted_socket"), 0);
+    std::this_thread::sleep_for(std::chrono::milliseconds(3 * REFRESH_MS));
+
+    EXPECT_EQ(previous->unregisterName("Service"), 0);
+    previous.reset();
+    std::this_thread::sleep_for(std::chrono::milliseconds(3 * REFRESH_MS));
+    EXPECT_EQ(client->resolve("Service", 0), "restarted_socket");
+    EXPECT_EQ(service->getRegisteredCount(), 1u);
+}
+
+TEST_F(LinxNameServiceTests, registration_ExpiresWhenNotRefreshed) {
+    UpdateLog log;
+    auto client = LinxNameResolver::create(SERVICE, REFRESH_MS);
+    client->setListener(log.listener());
+
+    // Registration of process that died without unregistering
+    AfUnixSocket crashed("test_crashed_server");
+    ASSERT_EQ(crashed.open(), 0);
+    ASSERT_EQ(crashed.send(LinxNameRecord::encode(IPC_NAME_REGISTER, {"Service", "crashed_socket", 0}),
+                           UnixInfo(SERVICE)), 0);
+
+    EXPECT_EQ(client->resolve("Service", 1000), "crashed_socket");
+    EXPECT_TRUE(log.waitFor("Service=", 1, 2 * LEASE_MS + 200));
+    EXPECT_EQ(service->getRegisteredCount(), 0u);
+}
+
+TEST_F(LinxNameServiceTests, registration_RegisteredWhenNameServiceStartsLater) {
+    service.reset();
+    auto server = LinxNameResolver::create(SERVICE, 1000);
+    auto client = LinxNameResolver::create(SERVICE, 1000);
+    ASSERT_EQ(server->registerName("Service", "service_socket"), 0);
+    EXPECT_EQ(client->resolve("Service", 50), "");
+
+    service = LinxNameService::create(SERVICE, LEASE_MS);
+    ASSERT_NE(service, nullptr);
+    ASSERT_TRUE(service->start());
+    EXPECT_EQ(client->resolve("Service", 500), "service_socket");
+}
+
+TEST_F(LinxNameServiceTests, registerName_FailsOnInvalidName) {
+    auto server = LinxNameResolver::create(SERVICE, REFRESH_MS);
+    EXPECT_EQ(server->registerName("", "service_socket"), -1);
+    EXPECT_EQ(server->registerName("Service", ""), -1);
+    EXPECT_EQ(server->registerName("Service", std::string(300, 'a')), -1);
+}
+
+TEST_F(LinxNameServiceTests, resolveClient_ConnectsToRegisteredServer) {
+    auto server = AfUnixFactory::createServer("test_resolved_server", 10);
+    ASSERT_NE(server, nullptr);
+    ASSERT_TRUE(server->start());
+    auto serverResolver = LinxNameResolver::create(SERVICE, REFRESH_MS);
+    ASSERT_EQ(serverResolver->registerName("ResolvedService", "test_resolved_server"), 0);
+
+    auto resolver = LinxNameResolver::create(SERVICE, REFRESH_MS);
+    auto client = AfUnixFactory::resolveClient(*resolver, "ResolvedService", 1000);
+    ASSERT_NE(client, nullptr);
+    EXPECT_TRUE(client->connect(1000));
+    EXPECT_EQ(AfUnixFactory::resolveClient(*resolver, "MissingService", 50), nullptr);
+}
+
+TEST_F(LinxNameServiceTests, connect_CompletesWhenServerAnnouncesStart) {
+    auto server = AfUnixFactory::createServer("test_announced_server", 10);
+    ASSERT_NE(server, nullptr);
+    server->setAnnouncement(LinxNameResolver::create(SERVICE, REFRESH_MS), "AnnouncedService",
+                            "test_announced_server");
+
+    UpdateLog log;
+    auto resolver = LinxNameResolver::create(SERVICE, 1000);
+    resolver->setListener(log.listener());
+    auto client = AfUnixFactory::createClient("test_announced_server");
+    client->setReadiness(resolver, "AnnouncedService");
+    auto connected = std::async(std::launch::async, [&client]() { return client->connect(2000); });
+    std::this_thread::sleep_for(std::chrono::milliseconds(200));
+
+    auto start = std::chrono::steady_clock::now();
+    ASSERT_TRUE(server->start());
+    EXPECT_TRUE(connected.get());
+    EXPECT_LT(std::chrono::steady_clock::now() - start, std::chrono::milliseconds(100));
+    // Client did not ping server before it was announced
+    EXPECT_EQ(server->getMetrics().pings, 1u);
+
+    server->stop();
+    EXPECT_TRUE(log.waitFor("AnnouncedService="));
+    EXPECT_FALSE(client->connect(50));
+}
+
+TEST_F(LinxNameServiceTests, stop_WithdrawsAnnouncementOnce) {
+    auto announcer = LinxNameResolver::create(SERVICE, REFRESH_MS);
+    auto server = AfUnixFactory::createServer("test_announced_server", 10);
+    ASSERT_NE(server, nullptr);
+    server->setAnnouncement(announcer, "AnnouncedService", "test_announced_server");
+    ASSERT_TRUE(server->start());
+    server->stop();
+
+    // Name registered again after stop() is not withdrawn by destructor of stopped server
+    ASSERT_EQ(announcer->registerName("AnnouncedService", "test_next_server"), 0);
+    server.reset();
+
+    auto resolver = LinxNameResolver::create(SERVICE, 1000);
+    EXPECT_EQ(resolver->resolve("AnnouncedService", 500), "test_next_server");
+}
+
+TEST_F(LinxNameServiceTests, resolveClient_ParsesUdpEndpoint) {
+    auto serverResolver = LinxNameResolver::create(SERVICE, REFRESH_MS);
+    ASSERT_EQ(serverResolver->registerName("UdpService", "127.0.0.1:12370"), 0);
+    ASSERT_EQ(serverResolver->registerName("BadUdpService", "127.0.0.1"), 0);
+    ASSERT_EQ(serverResolver->registerName("BadPortService", "127.0.0.1:70000"), 0);
+
+    auto resolver = LinxNameResolver::create(SERVICE, REFRESH_MS);
+    EXPECT_NE(UdpFactory::resolveClient(*resolver, "UdpService", 1000), nullptr);
+    EXPECT_EQ(UdpFactory::resolveClient(*resolver, "BadUdpService", 1000), nullptr);
+    EXPECT_EQ(UdpFactory::resolveClient(*resolver, "BadPortService", 1000), nullptr);
+}
@@ -5,6 +5,8 @@
 #include "LinxEventFdMock.h"
 #include "LinxIpc.h"
 #include "LinxQueue.h"
+#include "BusyPoll.h"
+#include <unistd.h>
 
 using namespace ::testing;
 
@@ -351,6 +353,174 @@ TEST_F(LinxQueueTests, get_Timeout_ReturnMsgWhenSignalNrInQueue) {
     ASSERT_EQ(msg->message->getReqId(), 2);
 }
 
+TEST_F(LinxQueueTests, getBatch_Immediate_ReturnMatchingMessagesUpToMaxCount) {
+    auto queue = LinxQueue(std::move(efdMock), 5);
+
+    queue.add(createMsgFromClient("from1", 1));
+    queue.add(createMsgFromClient("from2", 2));
+    queue.add(createMsgFromClient("from3", 3));
+    queue.add(createMsgFromClient("from4", 2));
+    queue.add(createMsgFromClient("from5", 2));
+
+    auto messages = queue.getBatch(2, IMMEDIATE_TIMEOUT, {2}, nullptr);
+    ASSERT_EQ(messages.size(), 2);
+    ASSERT_TRUE(*messages[0]->from == UnixInfo("from2"));
+    ASSERT_TRUE(*messages[1]->from == UnixInfo("from4"));
+    ASSERT_EQ(queue.size(), 3);
+}
+
+TEST_F(LinxQueueTests, getBatch_Immediate_ReturnEmptyWhenNoSignalNrInQueue) {
+    auto queue = LinxQueue(std::move(efdMock), 2);
+
+    queue.add(createMsgFromClient("from1", 1));
+
+    ASSERT_TRUE(queue.getBatch(10, IMMEDIATE_TIMEOUT, {3, 4}, nullptr).empty());
+    ASSERT_EQ(queue.size(), 1);
+}
+
+TEST_F(LinxQueueTests, getBatch_ReturnEmptyWhenMaxCountIsZero) {
+    auto queue = LinxQueue(std::move(efdMock), 2);
+
+    queue.add(createMsgFromClient("from1", 1));
+
+    ASSERT_TRUE(queue.getBatch(0, INFINITE_TIMEOUT, LINX_ANY_SIG, nullptr).empty());
+    ASSERT_EQ(queue.size(), 1);
+}
+
+TEST_F(LinxQueueTests, getBatch_Timeout_ReturnEmptyWhenWaitTimedOut) {
+    auto queue = LinxQueue(std::move(efdMock), 2);
+    ASSERT_TRUE(queue.getBatch(10, 100, LINX_ANY_SIG, nullptr).empty());
+}
+
+TEST_F(LinxQueueTests, getBatch_Infinite_WaitForFirstMessage) {
+    auto queue = LinxQueue(std::move(efdMock), 5);
+
+    std::thread producer([&queue, this]() {
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        queue.add(createMsgFromClient("from1", 1));
+    });
+
+    auto messages = queue.getBatch(10, INFINITE_TIMEOUT, LINX_ANY_SIG, nullptr);
+    producer.join();
+    ASSERT_EQ(messages.size(), 1);
+    ASSERT_EQ(messages[0]->message->getReqId(), 1);
+}
+
+TEST_F(LinxQueueTests, eventFd_SignalledOnceWhileQueueNotEmpty) {
+    EXPECT_CALL(*efdPtr, writeEvent()).Times(1);
+    EXPECT_CALL(*efdPtr, readEvent()).Times(1);
+
+    auto queue = LinxQueue(std::move(efdMock), 5);
+
+    queue.add(createMsgFromClient("from1", 1));
+    queue.add(createMsgFromClient("from2", 2));
+    queue.add(createMsgFromClient("from3", 3));
+
+    ASSERT_NE(queue.get(IMMEDIATE_TIMEOUT, {1}, nullptr), nullptr);
+    ASSERT_EQ(queue.getBatch(5, IMMEDIATE_TIMEOUT, LINX_ANY_SIG, nullptr).size(), 2);
+}
+
+TEST_F(LinxQueueTests, get_Spin_ReturnMessageAddedWhileSpinning) {
+    auto queue = LinxQueue(std::move(efdMock), 5);
+    queue.setSpinTime(200000);
+
+    std::thread producer([&queue, this]() {
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        queue.add(createMsgFromClient("from1", 1));
+        queue.add(createMsgFromClient("from2", 2));
+    });
+
+    auto msg = queue.get(1000, {2}, nullptr);
+    producer.join();
+    ASSERT_NE(msg, nullptr);
+    ASSERT_EQ(msg->message->getReqId(), 2);
+    ASSERT_EQ(queue.size(), 1);
+}
+
+TEST_F(LinxQueueTests, get_Spin_FallBackToBlockingWaitWhenSpinExpired) {
+    auto queue = LinxQueue(std::move(efdMock), 5);
+    queue.setSpinTime(100);
+
+    std::thread producer([&queue, this]() {
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        queue.add(createMsgFromClient("from1", 1));
+    });
+
+    auto msg = queue.get(INFINITE_TIMEOUT, LINX_ANY_SIG, nullptr);
+    producer.join();
+    ASSERT_NE(msg, nullptr);
+}
+
+TEST_F(LinxQueueTests, getBatch_Spin_ReturnMessagesAddedWhileSpinning) {
+    auto queue = LinxQueue(std::move(efdMock), 5);
+    queue.setSpinTime(200000);
+
+    std::thread producer([&queue, this]() {
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        queue.add(createMsgFromClient("from1", 1));
+    });
+
+    auto messages = queue.getBatch(5, 1000, LINX_ANY_SIG, nullptr);
+    producer.join();
+    ASSERT_EQ(messages.size(), 1);
+}
+
+TEST_F(LinxQueueTests, get_Spin_ReturnNullWhenStopped) {
+    auto queue = LinxQueue(std::move(efdMock), 5);
+    queue.setSpinTime(200000);
+    queue.stop();
+
+    ASSERT_EQ(queue.get(1000, LINX_ANY_SIG, nullptr), nullptr);
+}
+
+TEST_F(LinxQueueTests, get_Spin_SpinTimeCountsTowardsTimeout) {
+    auto queue = LinxQueue(std::move(efdMock), 5);
+    queue.setSpinTime(200000);
+
+    auto start = std::chrono::steady_clock::now();
+    ASSERT_EQ(queue.get(50, LINX_ANY_SIG, nullptr), nullptr);
+    ASSERT_TRUE(queue.getBatch(5, 50, LINX_ANY_SIG, nullptr).empty());
+    EXPECT_LT(std::chrono::steady_clock::now() - start, std::chrono::milliseconds(150));
+}
+
+TEST(BusyPollTests, poll_SpinTimeCountsTowardsTimeout) {
+    int fds[2];
+    ASSERT_EQ(pipe(fds), 0);
+    struct pollfd pfd = {fds[0], POLLIN, 0};
+
+    auto start = std::chrono::steady_clock::now();
+    EXPECT_EQ(BusyPoll::poll(&pfd, 1, 50, 30000), 0);
+    auto elapsed = std::chrono::steady_clock::now() - start;
+    EXPECT_GE(elapsed, std::chrono::milliseconds(49));
+    EXPECT_LT(elapsed, std::chrono::milliseconds(75));
+    close(fds[0]);
+    close(fds[1]);
+}
+
+TEST_F(LinxQueueTests, getHighWater_ReturnMaximumQueueSize) {
+    auto queue = LinxQueue(std::move(efdMock), 5);
+    ASSERT_EQ(queue.getHighWater(), 0);
+
+    queue.add(createMsgFromClient("from1", 1));
+    queue.add(createMsgFromClient("from2", 2));
+    queue.add(createMsgFromClient("from3", 3));
+    queue.get(IMMEDIATE_TIMEOUT, LINX_ANY_SIG, nullptr);
+    queue.get(IMMEDIATE_TIMEOUT, LINX_ANY_SIG, nullptr);
+    queue.add(createMsgFromClient("from4", 4));
+
+    ASSERT_EQ(queue.size(), 2);
+    ASSERT_EQ(queue.getHighWater(), 3);
+}
+
+TEST_F(LinxQueueTests, getHighWater_NotExceedMaximumSize) {
+    auto queue = LinxQueue(std::move(efdMock), 2);
+    for (int i = 0; i < 4; i++) {
+        queue.add(createMsgFromClient("from", i));
+    }
+
+    ASSERT_EQ(queue.getHighWater(), 2);
+}
+
 TEST_F(LinxQueueTests, getFdReturnefdFd) {
     auto queue = LinxQueue(std::move(efdMock), 2);
     ASSERT_EQ(queue.getFd(), 1);
@@ -0,0 +1,112 @@
+#include "gtest/gtest.h"
+#include "LinxRateLimiter.h"
+#include "LinxTrace.h"
+
+using namespace ::testing;
+
+static constexpr uint64_t msToNs(uint64_t ms) {
+    return ms * 1000000ULL;
+}
+
+TEST(LinxRateLimiterTests, allow_AcceptBurstThenReject) {
+    LinxRateLimiter limiter(3, 1000);
+    uint64_t suppressed = 0;
+
+    ASSERT_TRUE(limiter.allow(0, &suppressed));
+    ASSERT_TRUE(limiter.allow(0, &suppressed));
+    ASSERT_TRUE(limiter.allow(0, &suppressed));
+    ASSERT_FALSE(limiter.allow(0, &suppressed));
+    ASSERT_FALSE(limiter.allow(msToNs(999), &suppressed));
+}
+
+TEST(LinxRateLimiterTests, allow_AcceptOneRecordPerInterval) {
+    LinxRateLimiter limiter(1, 100);
+    uint64_t suppressed = 0;
+
+    ASSERT_TRUE(limiter.allow(0, &suppressed));
+    ASSERT_FALSE(limiter.allow(msToNs(50), &suppressed));
+    ASSERT_TRUE(limiter.allow(msToNs(100), &suppressed));
+    ASSERT_FALSE(limiter.allow(msToNs(150), &suppressed));
+    ASSERT_TRUE(limiter.allow(msToNs(250), &suppressed));
+}
+
+TEST(LinxRateLimiterTests, allow_ReportSuppressedCountOnNextAcceptedRecord) {
+    LinxRateLimiter limiter(1, 100);
+    uint64_t suppressed = 99;
+
+    ASSERT_TRUE(limiter.allow(0, &suppressed));
+    ASSERT_EQ(suppressed, 0u);
+
+    for (int i = 0; i < 5; i++) {
+        ASSERT_FALSE(limiter.allow(msToNs(10), &suppressed));
+    }
+
+    ASSERT_TRUE(limiter.allow(msToNs(100), &suppressed));
+    ASSERT_EQ(suppressed, 5u);
+
+    ASSERT_TRUE(limiter.allow(msToNs(200), &suppressed));
+    ASSERT_EQ(suppressed, 0u);
+}
+
+TEST(LinxRateLimiterTests, allow_BurstRefillsAfterIdlePeriod) {
+    LinxRateLimiter limiter(2, 100);
+    uint64_t suppressed = 0;
+
+    ASSERT_TRUE(limiter.allow(0, &suppressed));
+    ASSERT_TRUE(limiter.allow(0, &suppressed));
+    ASSERT_FALSE(limiter.allow(0, &suppressed));
+
+    ASSERT_TRUE(limiter.allow(msToNs(1000), &suppressed));
+    ASSERT_TRUE(limiter.allow(msToNs(1000), &suppressed));
+    ASSERT_FALSE(limiter.allow(msToNs(1000), &suppressed));
+}
+
+TEST(LinxRateLimiterTests, trace_ArgumentsNotEvaluatedWhenRateLimited) {
+    int evaluated = 0;
+    [[maybe_unused]] auto argument = [&]() {
+        evaluated++;
+        return 0;
+    };
+
+    int savedLevel = LinxLogLevels::get(LinxLogModule::GENERAL);
+    LinxLogLevels::set(LinxLogModule::GENERAL, SEVERITY_ERROR);
+    for (uint32_t i = 0; i < LinxRateLimiter::defaultBurst * 10; i++) {
+        LINX_ERROR_RATELIMITED(GENERAL, "value: %d", argument());
+    }
+    LinxLogLevels::set(LinxLogModule::GENERAL, savedLevel);
+
+    ASSERT_EQ(evaluated, TRACE_LEVEL >= SEVERITY_ERROR ? static_cast<int>(LinxRateLimiter::defaultBurst) : 0);
+}
+
+TEST(LinxRateLimiterTests, reportSuppressed_ReportSiteWhichIsNotHitAgain) {
+    static LinxRateLimitedSite site(SEVERITY_ERROR, __FILE__, __LINE__);
+    uint64_t suppressed = 0;
+
+    LinxRateLimitedSite::reportSuppressed();
+    for (uint32_t i = 0; i < LinxRateLimiter::defaultBurst + 5; i++) {
+        site.allow(&suppressed);
+    }
+
+    ASSERT_EQ(LinxRateLimitedSite::reportSuppressed(), 1u);
+    ASSERT_EQ(LinxRateLimitedSite::reportSuppressed(), 0u);
+}
+
+TEST(LinxRateLimiterTests, reportPeriodically_ReportAtMostOncePerInterval) {
+    static LinxRateLimitedSite site(SEVERITY_ERROR, __FILE__, __LINE__);
+    uint64_t suppressed = 0;
+
+    LinxRateLimitedSite::reportSuppressed();
+    auto now = std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+    uint64_t nowNs = now + msToNs(LinxRateLimitedSite::reportIntervalMs);
+
+    for (uint32_t i = 0; i < LinxRateLimiter::defaultBurst + 5; i++) {
+        site.allow(&suppressed);
+    }
+    LinxRateLimitedSite::reportPeriodically(nowNs);
+    ASSERT_EQ(LinxRateLimitedSite::reportSuppressed(), 0u);
+
+    site.allow(&suppressed);
+    LinxRateLimitedSite::reportPeriodically(nowNs + msToNs(1));
+    ASSERT_EQ(LinxRateLimitedSite::reportSuppressed(), 1u);
+}
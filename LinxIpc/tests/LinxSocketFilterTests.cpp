@@ -0,0 +1,279 @@
+#include "gtest/gtest.h"
+#include <atomic>
+#include <poll.h>
+#include <thread>
+#include "LinxSocketFilter.h"
+#include "UdpSocket.h"
+#include "AfUnixSocket.h"
+#include "UnixLinx.h"
+#include "RawMessage.h"
+#include "LinxBatch.h"
+#include "LinxMessageIds.h"
+
+using namespace ::testing;
+
+namespace {
+
+constexpr uint32_t SIG_A = IPC_SIG_BASE + 10;
+constexpr uint32_t SIG_B = IPC_SIG_BASE + 20;
+
+// True when datagram is queued on socket, filtered ones never are
+bool hasPending(int fd, int timeoutMs = 50) {
+    struct pollfd pfd = {fd, POLLIN, 0};
+    return poll(&pfd, 1, timeoutMs) > 0;
+}
+
+template<typename Socket>
+uint32_t receiveReqId(Socket &socket, int timeoutMs = 100) {
+    RawMessagePtr msg;
+    if (socket.receive(&msg, nullptr, timeoutMs) <= 0 || msg == nullptr) {
+        return 0;
+    }
+    return msg->getReqId();
+}
+
+} // namespace
+
+TEST(LinxSocketFilterTests, merge_JoinsOverlappingAndAdjacentRanges) {
+    auto ranges = LinxSocketFilter::merge({{20, 30}, {1, 3}, {4, 5}, {25, 40}, {50, 50}});
+    std::vector<LinxSocketFilter::Range> expected = {{1, 5}, {20, 40}, {50, 50}};
+    EXPECT_EQ(ranges, expected);
+}
+
+TEST(LinxSocketFilterTests, toRanges_JoinsConsecutiveReqIds) {
+    auto ranges = LinxSocketFilter::toRanges({SIG_B, SIG_A, SIG_A + 1, SIG_A});
+    std::vector<LinxSocketFilter::Range> expected = {{SIG_A, SIG_A + 1}, {SIG_B, SIG_B}};
+    EXPECT_EQ(ranges, expected);
+}
+
+TEST(LinxSocketFilterTests, build_LoadsReqIdAtPayloadOffset) {
+    auto program = LinxSocketFilter::build({{SIG_A, SIG_A}}, 8, 0, 0);
+    ASSERT_FALSE(program.empty());
+    EXPECT_EQ(program.front().code, BPF_LD | BPF_W | BPF_ABS);
+    EXPECT_EQ(program.front().k, 8u);
+    EXPECT_EQ(program.back().code, BPF_RET | BPF_K);
+    EXPECT_EQ(program.back().k, 0u);
+}
+
+TEST(LinxSocketFilterTests, build_ReturnsEmptyProgramWhenTooLarge) {
+    std::vector<LinxSocketFilter::Range> ranges;
+    for (uint32_t i = 0; i < BPF_MAXINSNS; i++) {
+        ranges.emplace_back(SIG_A + 2 * i, SIG_A + 2 * i);
+    }
+    EXPECT_TRUE(LinxSocketFilter::build(ranges, 0, 0, 0).empty());
+}
+
+class UdpSocketFilterTests : public testing::Test {
+  protected:
+    void SetUp() override {
+        receiver.open();
+        receiver.bind(0);
+        sender.open();
+        to = PortInfo("127.0.0.1", receiver.getLocalPort());
+    }
+
+    UdpSocket receiver;
+    UdpSocket sender;
+    PortInfo to;
+};
+
+TEST_F(UdpSocketFilterTests, setSignalFilter_FailsOnClosedSocket) {
+    UdpSocket socket;
+    EXPECT_EQ(socket.setSignalFilter({SIG_A}), -1);
+}
+
+TEST_F(UdpSocketFilterTests, setSignalFilter_DropsOtherReqIdsInKernel) {
+    ASSERT_EQ(receiver.setSignalFilter({SIG_A}), 0);
+
+    ASSERT_EQ(sender.send(RawMessage(SIG_B), to), 0);
+    EXPECT_FALSE(hasPending(receiver.getFd()));
+
+    ASSERT_EQ(sender.send(RawMessage(IPC_PING_REQ), to), 0);
+    ASSERT_EQ(sender.send(RawMessage(SIG_A), to), 0);
+    EXPECT_EQ(receiveReqId(receiver), (uint32_t)IPC_PING_REQ);
+    EXPECT_EQ(receiveReqId(receiver), SIG_A);
+}
+
+TEST_F(UdpSocketFilterTests, setSignalFilter_EmptyFilterDeliversEverything) {
+    ASSERT_EQ(receiver.setSignalFilter({SIG_A}), 0);
+    ASSERT_EQ(receiver.setSignalFilter({}), 0);
+
+    ASSERT_EQ(sender.send(RawMessage(SIG_B), to), 0);
+    EXPECT_EQ(receiveReqId(receiver), SIG_B);
+}
+
+TEST_F(UdpSocketFilterTests, setSignalFilter_AcceptsCompressedAndFragmentedMessages) {
+    ASSERT_EQ(receiver.setSignalFilter({SIG_A}), 0);
+    receiver.setCompression(64, nullptr);
+    sender.setCompression(64, nullptr);
+    receiver.setFragmentation(LINX_DEFAULT_DATAGRAM_SIZE, LINX_DEFAULT_REASSEMBLY_TIMEOUT, LINX_DEFAULT_REASSEMBLY_MEMORY);
+    sender.setFragmentation(LINX_DEFAULT_DATAGRAM_SIZE, LINX_DEFAULT_REASSEMBLY_TIMEOUT, LINX_DEFAULT_REASSEMBLY_MEMORY);
+
+    std::vector<uint8_t> payload(256, 0x11);
+    ASSERT_EQ(sender.send(RawMessage(SIG_B, payload), to), 0);
+    EXPECT_FALSE(hasPending(receiver.getFd()));
+
+    ASSERT_EQ(sender.send(RawMessage(SIG_A, payload), to), 0);
+    EXPECT_EQ(receiveReqId(receiver), SIG_A);
+
+    std::vector<uint8_t> large(3 * LINX_DEFAULT_DATAGRAM_SIZE);
+    for (size_t i = 0; i < large.size(); i++) {
+        large[i] = static_cast<uint8_t>(i * 7919 >> 3);
+    }
+    ASSERT_EQ(sender.send(RawMessage(SIG_B, large), to), 0);
+    EXPECT_FALSE(hasPending(receiver.getFd()));
+
+    RawMessagePtr msg;
+    ASSERT_EQ(sender.send(RawMessage(SIG_A, large), to), 0);
+    EXPECT_GT(receiver.receive(&msg, nullptr, 100), 0);
+    ASSERT_NE(msg, nullptr);
+    EXPECT_EQ(msg->getReqId(), SIG_A);
+    EXPECT_EQ(msg->getPayloadSize(), large.size());
+}
+
+TEST_F(UdpSocketFilterTests, setSubscription_DropsUnsubscribedTopicsInKernel) {
+    ASSERT_EQ(receiver.setSubscription({{SIG_A, SIG_A + 5, "239.0.0.2"}}), 0);
+
+    ASSERT_EQ(sender.send(RawMessage(SIG_B), to), 0);
+    EXPECT_FALSE(hasPending(receiver.getFd()));
+
+    // Signal filter narrows subscription, reqIds outside of it are never delivered
+    ASSERT_EQ(receiver.setSignalFilter({SIG_A + 1, SIG_B}), 0);
+    ASSERT_EQ(sender.send(RawMessage(SIG_A), to), 0);
+    ASSERT_EQ(sender.send(RawMessage(SIG_B), to), 0);
+    EXPECT_FALSE(hasPending(receiver.getFd()));
+
+    ASSERT_EQ(sender.send(RawMessage(SIG_A + 1), to), 0);
+    EXPECT_EQ(receiveReqId(receiver), SIG_A + 1);
+
+    LinxMetricsSnapshot snapshot;
+    receiver.addMetrics(snapshot);
+    EXPECT_EQ(snapshot.unsubscribedDrops, 0u);
+}
+
+TEST_F(UdpSocketFilterTests, setSignalFilter_ChangesOptionsWhileSendingAndReceiving) {
+    sender.setCompression(64, nullptr);
+    std::atomic<bool> running{true};
+    std::atomic<int> received{0};
+
+    std::thread receiving([&]() {
+        while (running.load()) {
+            if (receiveReqId(receiver, 10) == SIG_A) {
+                received++;
+            }
+        }
+    });
+    std::thread sending([&]() {
+        std::vector<uint8_t> payload(256, 0x33);
+        while (running.load()) {
+            sender.send(RawMessage(SIG_A, payload), to);
+            sender.setChecksum(false);
+            std::this_thread::sleep_for(std::chrono::microseconds(100));
+        }
+    });
+
+    for (int i = 0; i < 200; i++) {
+        EXPECT_EQ(receiver.setSignalFilter(i % 2 ? std::vector<uint32_t>{SIG_A} : std::vector<uint32_t>{SIG_A, SIG_B}), 0);
+        EXPECT_EQ(receiver.setCompression(64, nullptr), 0);
+        EXPECT_EQ(receiver.setFragmentation(i % 2 ? LINX_DEFAULT_DATAGRAM_SIZE : 0, LINX_DEFAULT_REASSEMBLY_TIMEOUT,
+                                            LINX_DEFAULT_REASSEMBLY_MEMORY), 0);
+        EXPECT_EQ(receiver.setTimestamping(i % 2 == 0), 0);
+        EXPECT_EQ(sender.setBusyPoll(i % 2 ? 10 : 0, false), 0);
+    }
+
+    running = false;
+    sending.join();
+    receiving.join();
+    EXPECT_GT(received.load(), 0);
+}
+
+class AfUnixSocketFilterTests : public testing::Test {
+  protected:
+    void SetUp() override {
+        receiver.open();
+        sender.open();
+    }
+
+    AfUnixSocket receiver{"test_filter_receiver"};
+    AfUnixSocket sender{"test_filter_sender"};
+    UnixInfo to{"test_filter_receiver"};
+};
+
+TEST_F(AfUnixSocketFilterTests, setSignalFilter_DropsOtherReqIdsInKernel) {
+    ASSERT_EQ(receiver.setSignalFilter({SIG_A}), 0);
+
+    ASSERT_EQ(sender.send(RawMessage(SIG_B), to), 0);
+    EXPECT_FALSE(hasPending(receiver.getFd()));
+
+    ASSERT_EQ(sender.send(RawMessage(IPC_PING_RSP), to), 0);
+    ASSERT_EQ(sender.send(RawMessage(SIG_A), to), 0);
+    EXPECT_EQ(receiveReqId(receiver), (uint32_t)IPC_PING_RSP);
+    EXPECT_EQ(receiveReqId(receiver), SIG_A);
+}
+
+TEST_F(AfUnixSocketFilterTests, setSignalFilter_AcceptsWholeInternalReqIdRange) {
+    ASSERT_EQ(receiver.setSignalFilter({SIG_A}), 0);
+
+    ASSERT_EQ(sender.send(RawMessage(IPC_NAME_UPDATE), to), 0);
+    ASSERT_EQ(sender.send(RawMessage(IPC_SIG_BASE - 1), to), 0);
+    ASSERT_EQ(sender.send(RawMessage(IPC_SIG_BASE), to), 0);
+    EXPECT_EQ(receiveReqId(receiver), (uint32_t)IPC_NAME_UPDATE);
+    EXPECT_EQ(receiveReqId(receiver), IPC_SIG_BASE - 1);
+    EXPECT_FALSE(hasPending(receiver.getFd()));
+}
+
+TEST_F(AfUnixSocketFilterTests, setSignalFilter_AcceptsCompressedMessages) {
+    ASSERT_EQ(receiver.setSignalFilter({SIG_A}), 0);
+    receiver.setCompression(64, nullptr);
+    sender.setCompression(64, nullptr);
+
+    std::vector<uint8_t> payload(256, 0x22);
+    ASSERT_EQ(sender.send(RawMessage(SIG_B, payload), to), 0);
+    EXPECT_FALSE(hasPending(receiver.getFd()));
+
+    ASSERT_EQ(sender.send(RawMessage(SIG_A, payload), to), 0);
+    EXPECT_EQ(receiveReqId(receiver), SIG_A);
+}
+
+TEST(SimpleServerSignalFilterTests, receive_DropsFilteredMessagesOfContainer) {
+    auto server = AfUnixFactory::createSimpleServer("test_filter_server");
+    ASSERT_NE(server, nullptr);
+    ASSERT_EQ(server->setSignalFilter({SIG_A}), 0);
+
+    AfUnixSocket sender("test_filter_sender");
+    ASSERT_EQ(sender.open(), 0);
+
+    std::vector<uint8_t> batch;
+    ASSERT_TRUE(LinxBatch::append(batch, RawMessage(SIG_B)));
+    ASSERT_TRUE(LinxBatch::append(batch, RawMessage(SIG_A)));
+    ASSERT_EQ(sender.send(RawMessage(IPC_BATCH_MSG, std::move(batch)), UnixInfo("test_filter_server")), 0);
+    ASSERT_EQ(sender.send(RawMessage(SIG_B), UnixInfo("test_filter_server")), 0);
+
+    auto msg = server->receive(100);
+    ASSERT_NE(msg, nullptr);
+    EXPECT_EQ(msg->message->getReqId(), SIG_A);
+    EXPECT_EQ(server->receive(50), nullptr);
+
+    // Container content is filtered in userspace, standalone message by socket filter
+    EXPECT_EQ(server->getMetrics().filterDrops, 1u);
+}
+
+TEST(SimpleServerSignalFilterTests, receive_DeliversInternalMessagesOfContainer) {
+    auto server = AfUnixFactory::createSimpleServer("test_filter_server");
+    ASSERT_NE(server, nullptr);
+    ASSERT_EQ(server->setSignalFilter({SIG_A}), 0);
+
+    AfUnixSocket sender("test_filter_sender");
+    ASSERT_EQ(sender.open(), 0);
+
+    std::vector<uint8_t> batch;
+    ASSERT_TRUE(LinxBatch::append(batch, RawMessage(IPC_NAME_UPDATE)));
+    ASSERT_TRUE(LinxBatch::append(batch, RawMessage(SIG_B)));
+    ASSERT_EQ(sender.send(RawMessage(IPC_BATCH_MSG, std::move(batch)), UnixInfo("test_filter_server")), 0);
+
+    auto msg = server->receive(100);
+    ASSERT_NE(msg, nullptr);
+    EXPECT_EQ(msg->message->getReqId(), (uint32_t)IPC_NAME_UPDATE);
+    EXPECT_EQ(server->receive(50), nullptr);
+    EXPECT_EQ(server->getMetrics().filterDrops, 1u);
+}
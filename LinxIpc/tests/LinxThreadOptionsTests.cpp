@@ -0,0 +1,155 @@
+#include <dirent.h>
+#include <fstream>
+#include <pthread.h>
+#include <thread>
+#include "gtest/gtest.h"
+#include "LinxThreadOptions.h"
+#include "UnixLinx.h"
+#include "UdpSocket.h"
+
+using namespace ::testing;
+
+class LinxThreadOptionsTests : public testing::Test {
+  public:
+    static bool processHasThread(const std::string &name) {
+        DIR *dir = opendir("/proc/self/task");
+        if (dir == nullptr) {
+            return false;
+        }
+        bool found = false;
+        while (struct dirent *entry = readdir(dir)) {
+            std::ifstream comm(std::string("/proc/self/task/") + entry->d_name + "/comm");
+            std::string threadName;
+            if (std::getline(comm, threadName) && threadName == name) {
+                found = true;
+                break;
+            }
+        }
+        closedir(dir);
+        return found;
+    }
+};
+
+TEST_F(LinxThreadOptionsTests, apply_DefaultOptionsDoNothing) {
+    LinxThreadOptions options;
+    ASSERT_EQ(options.applyToCurrentThread(), 0);
+}
+
+TEST_F(LinxThreadOptionsTests, apply_SetsTruncatedThreadName) {
+    char name[16] = {};
+    int result = -1;
+
+    std::thread thread([&]() {
+        LinxThreadOptions options;
+        options.name = "VeryLongWorkerThreadName";
+        result = options.applyToCurrentThread();
+        pthread_getname_np(pthread_self(), name, sizeof(name));
+    });
+    thread.join();
+
+    ASSERT_EQ(result, 0);
+    ASSERT_STREQ(name, "VeryLongWorkerT");
+}
+
+TEST_F(LinxThreadOptionsTests, apply_SetsCpuAffinity) {
+    cpu_set_t cpuset;
+    CPU_ZERO(&cpuset);
+    int result = -1;
+
+    std::thread thread([&]() {
+        LinxThreadOptions options;
+        options.cpus = {0};
+        result = options.applyToCurrentThread();
+        pthread_getaffinity_np(pthread_self(), sizeof(cpuset), &cpuset);
+    });
+    thread.join();
+
+    ASSERT_EQ(result, 0);
+    ASSERT_EQ(CPU_COUNT(&cpuset), 1);
+    ASSERT_TRUE(CPU_ISSET(0, &cpuset));
+}
+
+TEST_F(LinxThreadOptionsTests, apply_ReturnErrorForInvalidCpu) {
+    int result = 0;
+
+    std::thread thread([&]() {
+        LinxThreadOptions options;
+        options.cpus = {-1};
+        result = options.applyToCurrentThread();
+    });
+    thread.join();
+
+    ASSERT_LT(result, 0);
+}
+
+TEST_F(LinxThreadOptionsTests, apply_ReturnErrorForInvalidPriority) {
+    int result = 0;
+
+    std::thread thread([&]() {
+        LinxThreadOptions options;
+        options.policy = SCHED_FIFO;
+        options.priority = 1000;
+        result = options.applyToCurrentThread();
+    });
+    thread.join();
+
+    ASSERT_LT(result, 0);
+}
+
+TEST_F(LinxThreadOptionsTests, apply_PrefaultsStack) {
+    int result = -1;
+
+    std::thread thread([&]() {
+        LinxThreadOptions options;
+        options.stackPrefaultSize = 64 * 1024;
+        result = options.applyToCurrentThread();
+    });
+    thread.join();
+
+    ASSERT_EQ(result, 0);
+}
+
+TEST_F(LinxThreadOptionsTests, server_WorkerThreadUsesServerNameByDefault) {
+    auto server = AfUnixFactory::createServer("ThreadOptSrv");
+    server->start();
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+
+    EXPECT_TRUE(processHasThread("ThreadOptSrv"));
+    server->stop();
+}
+
+TEST_F(LinxThreadOptionsTests, server_WorkerThreadUsesConfiguredName) {
+    auto server = AfUnixFactory::createServer("ThreadOptSrv2");
+
+    LinxThreadOptions options;
+    options.name = "linx-worker";
+    options.cpus = {0};
+    server->setThreadOptions(options);
+    server->start();
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+
+    EXPECT_TRUE(processHasThread("linx-worker"));
+    server->stop();
+}
+
+TEST_F(LinxThreadOptionsTests, server_CoalescingTimerUsesServerThreadOptions) {
+    auto server = AfUnixFactory::createServer("ThreadOptSrv3");
+
+    LinxThreadOptions options;
+    options.name = "linx-worker3";
+    server->setThreadOptions(options);
+    ASSERT_EQ(server->setCoalescing(LINX_DEFAULT_DATAGRAM_SIZE, 100), 0);
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+
+    EXPECT_TRUE(processHasThread("co_linx-worker3"));
+    server->setCoalescing(0);
+}
+
+TEST_F(LinxThreadOptionsTests, socket_RetransmissionTimerIsNamed) {
+    UdpSocket socket;
+    socket.open();
+    socket.setReliable(true, LINX_DEFAULT_RELIABLE_WINDOW, LINX_DEFAULT_RELIABLE_SEND_TIMEOUT);
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+
+    EXPECT_TRUE(processHasThread("linx_retransmit"));
+}
@@ -0,0 +1,103 @@
+#include "gtest/gtest.h"
+#include "LinxIpc.h"
+#include <arpa/inet.h>
+
+using namespace ::testing;
+
+namespace {
+
+struct Telemetry {
+    BigEndian<uint32_t> counter;
+    BigEndian<int16_t> temperature;
+    LittleEndian<uint64_t> timestamp;
+    BigEndian<float> voltage;
+    uint8_t samples[4096];
+};
+
+struct Aligned {
+    uint64_t value;
+};
+
+} // namespace
+
+TEST(LinxEndianTests, bigEndian_StoredInNetworkOrder) {
+    BigEndian<uint32_t> value = 0x11223344;
+
+    uint32_t raw;
+    memcpy(&raw, &value, sizeof(raw));
+    ASSERT_EQ(sizeof(value), sizeof(uint32_t));
+    ASSERT_EQ(alignof(BigEndian<uint32_t>), 1u);
+    ASSERT_EQ(raw, htonl(0x11223344));
+    ASSERT_EQ(value.get(), 0x11223344u);
+}
+
+TEST(LinxEndianTests, littleEndian_StoredLeastSignificantByteFirst) {
+    LittleEndian<uint16_t> value = 0x1122;
+
+    const uint8_t *bytes = reinterpret_cast<const uint8_t *>(&value);
+    ASSERT_EQ(bytes[0], 0x22);
+    ASSERT_EQ(bytes[1], 0x11);
+    ASSERT_EQ(static_cast<uint16_t>(value), 0x1122);
+}
+
+TEST(LinxEndianTests, signedAndFloatingValuesRoundTrip) {
+    BigEndian<int32_t> negative = -5;
+    BigEndian<double> real = 3.25;
+    LittleEndian<int8_t> byte = -1;
+
+    ASSERT_EQ(negative.get(), -5);
+    ASSERT_EQ(real.get(), 3.25);
+    ASSERT_EQ(byte.get(), -1);
+}
+
+TEST(MessageViewTests, fromRawMessage_AccessPayloadInPlace) {
+    auto telemetry = std::make_unique<Telemetry>();
+    telemetry->counter = 7;
+    telemetry->temperature = -20;
+    telemetry->timestamp = 0x0102030405060708ULL;
+    telemetry->voltage = 3.3f;
+    telemetry->samples[4095] = 0xAB;
+    RawMessage msg(10, telemetry.get(), sizeof(Telemetry));
+
+    auto view = MessageView<Telemetry>::fromRawMessage(msg);
+
+    ASSERT_TRUE(view.has_value());
+    ASSERT_EQ(view->getReqId(), 10u);
+    ASSERT_EQ(static_cast<const void *>(view->get()), static_cast<const void *>(msg.getPayload()));
+    ASSERT_EQ((*view)->counter.get(), 7u);
+    ASSERT_EQ((*view)->temperature.get(), -20);
+    ASSERT_EQ((*view)->timestamp.get(), 0x0102030405060708ULL);
+    ASSERT_EQ((*view)->voltage.get(), 3.3f);
+    ASSERT_EQ((**view).samples[4095], 0xAB);
+}
+
+TEST(MessageViewTests, fromRawMessage_ViewDeserializedMessage) {
+    uint8_t buffer[] = {0x00, 0x00, 0x00, 0x20, 0x11, 0x22, 0x33, 0x44, 0x00, 0x01};
+    auto msg = RawMessage::deserialize(std::vector<uint8_t>(buffer, buffer + sizeof(buffer)));
+
+    struct Payload {
+        BigEndian<uint32_t> value;
+        BigEndian<uint16_t> flag;
+    };
+    auto view = MessageView<Payload>::fromRawMessage(*msg);
+
+    ASSERT_TRUE(view.has_value());
+    ASSERT_EQ(view->getReqId(), 0x20u);
+    ASSERT_EQ((*view)->value.get(), 0x11223344u);
+    ASSERT_EQ((*view)->flag.get(), 1);
+}
+
+TEST(MessageViewTests, fromRawMessage_FailWhenPayloadTooSmall) {
+    RawMessage msg(10, sizeof(Telemetry) - 1);
+
+    ASSERT_FALSE(MessageView<Telemetry>::fromRawMessage(msg).has_value());
+    ASSERT_FALSE(MessageView<Telemetry>::fromRawMessage(RawMessage(10)).has_value());
+}
+
+TEST(MessageViewTests, fromBuffer_FailWhenPayloadMisaligned) {
+    alignas(Aligned) uint8_t buffer[sizeof(Aligned) + 1] = {};
+
+    ASSERT_TRUE(MessageView<Aligned>::fromBuffer(1, buffer, sizeof(Aligned)).has_value());
+    ASSERT_FALSE(MessageView<Aligned>::fromBuffer(1, buffer + 1, sizeof(Aligned)).has_value());
+    ASSERT_FALSE(MessageView<Aligned>::fromBuffer(1, nullptr, sizeof(Aligned)).has_value());
+}
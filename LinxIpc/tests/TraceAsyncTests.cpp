@@ -0,0 +1,138 @@
+#include <atomic>
+#include <chrono>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+#include <unistd.h>
+#include "gtest/gtest.h"
+#include "trace.h"
+
+using namespace ::testing;
+
+class TraceAsyncTests : public testing::Test {
+  protected:
+    std::string path = "/tmp/linx_trace_test_" + std::to_string(getpid()) + ".log";
+
+    void SetUp() override {
+        unlink(path.c_str());
+        ASSERT_EQ(trace_start_async(path.c_str()), 0);
+    }
+
+    void TearDown() override {
+        trace_stop_async();
+        unlink(path.c_str());
+    }
+
+    std::vector<std::string> readLines() {
+        trace_flush();
+        std::ifstream file(path);
+        std::vector<std::string> lines;
+        for (std::string line; std::getline(file, line);) {
+            lines.push_back(line);
+        }
+        return lines;
+    }
+};
+
+TEST_F(TraceAsyncTests, start_ReturnErrorWhenAlreadyRunning) {
+    ASSERT_EQ(trace_start_async(path.c_str()), -1);
+}
+
+TEST_F(TraceAsyncTests, start_ReturnErrorWhenFileCannotBeOpened) {
+    trace_stop_async();
+    ASSERT_EQ(trace_start_async("/nonexistent/dir/trace.log"), -2);
+    ASSERT_EQ(trace_start_async(path.c_str()), 0);
+}
+
+TEST_F(TraceAsyncTests, log_FormatArgumentsInBackground) {
+    const char *name = "server";
+    std::string temporary = "temporary";
+    size_t size = 42;
+
+    trace_error("/src/file.cpp", 10, "[%s] reqId: 0x%x size: %zu value: %5.2f %-4d| %c %% %.3s %*d %lld",
+                name, 0xab, size, 3.14159, -7, 'z', temporary.c_str(), 4, 9, -1234567890123LL);
+    temporary = "overwritten";
+
+    auto lines = readLines();
+    ASSERT_EQ(lines.size(), 1U);
+    ASSERT_NE(lines[0].find(" ERROR [tid="), std::string::npos);
+    ASSERT_NE(lines[0].find("](file.cpp:10): [server] reqId: 0xab size: 42 value:  3.14 -7  | z % tem    9 "
+                            "-1234567890123"),
+              std::string::npos);
+}
+
+TEST_F(TraceAsyncTests, log_WriteSeverityName) {
+    trace_warning("file.cpp", 1, "warning");
+    trace_info("file.cpp", 2, "info");
+
+    auto lines = readLines();
+    ASSERT_EQ(lines.size(), 2U);
+    ASSERT_NE(lines[0].find(" WARNING "), std::string::npos);
+    ASSERT_NE(lines[1].find(" INFO "), std::string::npos);
+}
+
+TEST_F(TraceAsyncTests, log_TruncateLongArguments) {
+    std::string longText(2000, 'a');
+    trace_error("file.cpp", 1, "%s %d", longText.c_str(), 5);
+
+    auto lines = readLines();
+    ASSERT_EQ(lines.size(), 1U);
+    ASSERT_NE(lines[0].find("aaaa"), std::string::npos);
+    ASSERT_NE(lines[0].find("..."), std::string::npos);
+    ASSERT_LT(lines[0].size(), 1100U);
+}
+
+TEST_F(TraceAsyncTests, log_WriteOrDropRecordsFromManyThreads) {
+    constexpr int threadCount = 4;
+    constexpr int recordCount = 2000;
+    unsigned long droppedBefore = trace_dropped();
+
+    std::vector<std::thread> threads;
+    for (int t = 0; t < threadCount; t++) {
+        threads.emplace_back([t]() {
+            for (int i = 0; i < recordCount; i++) {
+                trace_error("file.cpp", t, "thread %d record %d", t, i);
+            }
+        });
+    }
+    for (auto &thread : threads) {
+        thread.join();
+    }
+
+    auto lines = readLines();
+    size_t records = 0;
+    for (const auto &line : lines) {
+        records += line.find(": thread ") != std::string::npos;
+    }
+    ASSERT_EQ(records + (trace_dropped() - droppedBefore), (size_t)threadCount * recordCount);
+}
+
+TEST_F(TraceAsyncTests, stop_WriteRecordsCommittedWhileStopping) {
+    std::atomic<bool> logging{true};
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; t++) {
+        threads.emplace_back([t, &logging]() {
+            for (int i = 0; logging.load(); i++) {
+                trace_error("file.cpp", t, "thread %d record %d", t, i);
+            }
+        });
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    trace_stop_async();
+    logging.store(false);
+    for (auto &thread : threads) {
+        thread.join();
+    }
+
+    // Record accepted by previous session must not be left in ring and written to next one
+    std::string nextPath = path + ".next";
+    ASSERT_EQ(trace_start_async(nextPath.c_str()), 0);
+    trace_flush();
+    std::ifstream file(nextPath);
+    std::stringstream content;
+    content << file.rdbuf();
+    EXPECT_EQ(content.str().find(": thread "), std::string::npos);
+    unlink(nextPath.c_str());
+}
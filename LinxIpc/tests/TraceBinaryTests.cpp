@@ -0,0 +1,99 @@
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <thread>
+#include <vector>
+#include <unistd.h>
+#include "gtest/gtest.h"
+#include "trace.h"
+
+using namespace ::testing;
+
+class TraceBinaryTests : public testing::Test {
+  protected:
+    std::string path = "/tmp/linx_trace_binary_" + std::to_string(getpid()) + ".bin";
+    std::string textPath = path + ".txt";
+
+    void TearDown() override {
+        trace_stop_binary();
+        unlink(path.c_str());
+        unlink(textPath.c_str());
+    }
+
+    std::vector<std::string> decode(long expectedRecords) {
+        FILE *output = fopen(textPath.c_str(), "w");
+        EXPECT_EQ(trace_decode_binary(path.c_str(), output), expectedRecords);
+        fclose(output);
+
+        std::ifstream file(textPath);
+        std::vector<std::string> lines;
+        for (std::string line; std::getline(file, line);) {
+            lines.push_back(line);
+        }
+        return lines;
+    }
+};
+
+TEST_F(TraceBinaryTests, start_ReturnErrorOnInvalidArguments) {
+    ASSERT_EQ(trace_start_binary(path.c_str(), 4096), -3);
+    ASSERT_EQ(trace_start_binary("/nonexistent/dir/trace.bin", 0), -2);
+    ASSERT_EQ(trace_start_binary(path.c_str(), 0), 0);
+    ASSERT_EQ(trace_start_binary(path.c_str(), 0), -1);
+}
+
+TEST_F(TraceBinaryTests, decode_RenderRecordsWithArguments) {
+    ASSERT_EQ(trace_start_binary(path.c_str(), 0), 0);
+    for (int i = 0; i < 3; i++) {
+        trace_info("/src/server.cpp", 20, "[%s] Received reqId: 0x%x size: %zu", "server", 0x10 + i, (size_t)i);
+    }
+    trace_error("/src/client.cpp", 30, "failed: %d%%", -5);
+    trace_stop_binary();
+
+    auto lines = decode(4);
+    ASSERT_EQ(lines.size(), 4U);
+    ASSERT_NE(lines[0].find(" INFO [tid="), std::string::npos);
+    ASSERT_NE(lines[0].find("](server.cpp:20): [server] Received reqId: 0x10 size: 0"), std::string::npos);
+    ASSERT_NE(lines[2].find("reqId: 0x12 size: 2"), std::string::npos);
+    ASSERT_NE(lines[3].find(" ERROR "), std::string::npos);
+    ASSERT_NE(lines[3].find("(client.cpp:30): failed: -5%"), std::string::npos);
+}
+
+TEST_F(TraceBinaryTests, decode_KeepNewestRecordsWhenRingWraps) {
+    // Header and format table take 260 KB, remaining space holds 64 records
+    ASSERT_EQ(trace_start_binary(path.c_str(), 4096 + 256 * 1024 + 64 * 256), 0);
+    for (int i = 0; i < 100; i++) {
+        trace_debug("file.cpp", 1, "record %d", i);
+    }
+    trace_stop_binary();
+
+    auto lines = decode(64);
+    ASSERT_EQ(lines.size(), 65U);
+    ASSERT_NE(lines[0].find("record 36"), std::string::npos);
+    ASSERT_NE(lines[63].find("record 99"), std::string::npos);
+    ASSERT_NE(lines[64].find("36 records overwritten"), std::string::npos);
+}
+
+TEST_F(TraceBinaryTests, decode_RecordsFromManyThreads) {
+    ASSERT_EQ(trace_start_binary(path.c_str(), 0), 0);
+
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; t++) {
+        threads.emplace_back([t]() {
+            for (int i = 0; i < 500; i++) {
+                trace_info("file.cpp", t, "thread %d record %d", t, i);
+            }
+        });
+    }
+    for (auto &thread : threads) {
+        thread.join();
+    }
+    trace_stop_binary();
+
+    ASSERT_EQ(decode(2000).size(), 2000U);
+}
+
+TEST_F(TraceBinaryTests, decode_ReturnErrorForInvalidFile) {
+    std::ofstream(path) << "not a trace file";
+    ASSERT_EQ(trace_decode_binary(path.c_str(), stdout), -2);
+    ASSERT_EQ(trace_decode_binary("/nonexistent/file", stdout), -1);
+}
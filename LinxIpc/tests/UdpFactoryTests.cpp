@@ -1,3 +1,4 @@
+#include <thread>
 #include "gtest/gtest.h"
 #include "gmock/gmock.h"
 #include "UdpLinx.h"
@@ -100,6 +101,47 @@ TEST_F(UdpFactoryTests, createServer_WithDifferentQueueSizes) {
     ASSERT_NE(server3, nullptr);
 }
 
+// Test sharded server creation
+TEST_F(UdpFactoryTests, createShardedServer_CreatesServersOnSamePort) {
+    auto servers = UdpFactory::createShardedServer(0, 4, 10);
+
+    ASSERT_EQ(servers.size(), 4);
+    auto port = servers[0]->getName().substr(0, servers[0]->getName().find('#'));
+    for (size_t i = 0; i < servers.size(); i++) {
+        ASSERT_NE(servers[i], nullptr);
+        EXPECT_EQ(servers[i]->getName(), port + "#" + std::to_string(i));
+    }
+    EXPECT_NE(servers[0]->getPollFd(), servers[1]->getPollFd());
+}
+
+TEST_F(UdpFactoryTests, createShardedServer_ReturnsEmptyForZeroWorkers) {
+    EXPECT_TRUE(UdpFactory::createShardedServer(0, 0, 10).empty());
+}
+
+TEST_F(UdpFactoryTests, createShardedServer_EachSenderServedByOneShard) {
+    auto servers = UdpFactory::createShardedServer(54322, 4, 10);
+    ASSERT_EQ(servers.size(), 4);
+    for (auto &server : servers) {
+        server->start();
+    }
+
+    auto client = UdpFactory::createClient("127.0.0.1", 54322);
+    for (int i = 0; i < 5; i++) {
+        ASSERT_EQ(client->send(RawMessage(IPC_SIG_BASE + 1)), 0);
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+
+    int shardsWithMessages = 0;
+    for (auto &server : servers) {
+        auto messages = server->receiveBatch(10, IMMEDIATE_TIMEOUT);
+        if (!messages.empty()) {
+            EXPECT_EQ(messages.size(), 5);
+            shardsWithMessages++;
+        }
+    }
+    EXPECT_EQ(shardsWithMessages, 1);
+}
+
 // Test isMulticastIp function
 TEST_F(UdpFactoryTests, isMulticastIp_ReturnsTrueForMulticastAddresses) {
     EXPECT_TRUE(UdpFactory::isMulticastIp("224.0.0.0"));
@@ -166,6 +208,18 @@ TEST_F(UdpFactoryTests, createServer_ReturnsNullWhenJoinMulticastFails) {
     EXPECT_EQ(server, nullptr);
 }
 
+TEST_F(UdpFactoryTests, createShardedServer_ReturnsEmptyWhenSetReusePortFails) {
+    SystemMock mock;
+    EXPECT_CALL(mock, socket(AF_INET, SOCK_DGRAM, 0))
+        .WillOnce(Return(100));
+    EXPECT_CALL(mock, setsockopt(100, SOL_SOCKET, SO_REUSEPORT, _, _))
+        .WillOnce(Return(-1));
+    EXPECT_CALL(mock, close(100))
+        .WillOnce(Return(0));
+
+    EXPECT_TRUE(UdpFactory::createShardedServer(12345, 2, 10).empty());
+}
+
 TEST_F(UdpFactoryTests, createClient_ReturnsNullWhenSocketOpenFails) {
     SystemMock mock;
     EXPECT_CALL(mock, socket(AF_INET, SOCK_DGRAM, 0))
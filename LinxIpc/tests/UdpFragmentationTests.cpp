@@ -0,0 +1,206 @@
+#include "gtest/gtest.h"
+#include "UdpFragmentation.h"
+#include "UdpSocket.h"
+#include <arpa/inet.h>
+
+using namespace ::testing;
+
+namespace {
+
+constexpr uint64_t sender = 1;
+
+std::vector<uint8_t> fragment(uint32_t messageId, const std::vector<uint8_t> &frame, uint32_t offset,
+                              uint32_t fragmentSize) {
+    UdpFragmentHeader header{};
+    header.reqId = htonl(7 | LINX_FRAGMENT_FLAG);
+    header.messageId = htonl(messageId);
+    header.frameSize = htonl(frame.size());
+    header.offset = htonl(offset);
+    header.fragmentSize = htonl(fragmentSize);
+
+    std::vector<uint8_t> datagram((uint8_t *)&header, (uint8_t *)&header + sizeof(header));
+    uint32_t end = std::min<uint32_t>(offset + fragmentSize, frame.size());
+    datagram.insert(datagram.end(), frame.begin() + offset, frame.begin() + end);
+    return datagram;
+}
+
+std::vector<uint8_t> makeFrame(size_t size) {
+    std::vector<uint8_t> frame(size);
+    for (size_t i = 0; i < size; i++) {
+        frame[i] = (uint8_t)(i * 7);
+    }
+    return frame;
+}
+
+bool add(UdpReassembler &reassembler, const std::vector<uint8_t> &datagram, uint64_t nowMs,
+         std::vector<uint8_t> *frame, uint64_t from = sender) {
+    return reassembler.add(from, datagram.data(), datagram.size(), nowMs, frame);
+}
+
+} // namespace
+
+TEST(UdpReassemblerTests, add_ReassembleFragmentsOutOfOrder) {
+    UdpReassembler reassembler;
+    auto frame = makeFrame(250);
+    std::vector<uint8_t> result;
+
+    ASSERT_FALSE(add(reassembler, fragment(1, frame, 200, 100), 0, &result));
+    ASSERT_FALSE(add(reassembler, fragment(1, frame, 0, 100), 0, &result));
+    ASSERT_EQ(reassembler.getPendingCount(), 1u);
+    ASSERT_TRUE(add(reassembler, fragment(1, frame, 100, 100), 0, &result));
+
+    ASSERT_EQ(result, frame);
+    ASSERT_EQ(reassembler.getPendingCount(), 0u);
+
+    LinxMetricsSnapshot snapshot{};
+    reassembler.addMetrics(snapshot);
+    ASSERT_EQ(snapshot.fragmentsReceived, 3u);
+    ASSERT_EQ(snapshot.reassembledMessages, 1u);
+}
+
+TEST(UdpReassemblerTests, add_IgnoreDuplicateFragment) {
+    UdpReassembler reassembler;
+    auto frame = makeFrame(200);
+    std::vector<uint8_t> result;
+
+    ASSERT_FALSE(add(reassembler, fragment(1, frame, 0, 100), 0, &result));
+    ASSERT_FALSE(add(reassembler, fragment(1, frame, 0, 100), 0, &result));
+    ASSERT_TRUE(add(reassembler, fragment(1, frame, 100, 100), 0, &result));
+    ASSERT_EQ(result, frame);
+}
+
+TEST(UdpReassemblerTests, add_SeparateMessagesBySenderAndId) {
+    UdpReassembler reassembler;
+    auto frame1 = makeFrame(200);
+    auto frame2 = std::vector<uint8_t>(200, 0xAA);
+    std::vector<uint8_t> result;
+
+    ASSERT_FALSE(add(reassembler, fragment(1, frame1, 0, 100), 0, &result));
+    ASSERT_FALSE(add(reassembler, fragment(2, frame2, 0, 100), 0, &result));
+    ASSERT_FALSE(add(reassembler, fragment(1, frame2, 0, 100), 0, &result, sender + 1));
+    ASSERT_EQ(reassembler.getPendingCount(), 3u);
+
+    ASSERT_TRUE(add(reassembler, fragment(2, frame2, 100, 100), 0, &result));
+    ASSERT_EQ(result, frame2);
+    ASSERT_TRUE(add(reassembler, fragment(1, frame1, 100, 100), 0, &result));
+    ASSERT_EQ(result, frame1);
+}
+
+TEST(UdpReassemblerTests, add_DropIncompleteMessageAfterTimeout) {
+    UdpReassembler reassembler;
+    reassembler.configure(100, LINX_DEFAULT_REASSEMBLY_MEMORY);
+    auto frame = makeFrame(200);
+    std::vector<uint8_t> result;
+
+    ASSERT_FALSE(add(reassembler, fragment(1, frame, 0, 100), 0, &result));
+    ASSERT_FALSE(add(reassembler, fragment(1, frame, 100, 100), 150, &result));
+
+    LinxMetricsSnapshot snapshot{};
+    reassembler.addMetrics(snapshot);
+    ASSERT_EQ(snapshot.reassemblyTimeouts, 1u);
+    ASSERT_EQ(reassembler.getPendingCount(), 1u);
+}
+
+TEST(UdpReassemblerTests, add_EvictOldestMessageOnMemoryLimit) {
+    UdpReassembler reassembler;
+    reassembler.configure(LINX_DEFAULT_REASSEMBLY_TIMEOUT, 500);
+    auto frame = makeFrame(200);
+    std::vector<uint8_t> result;
+
+    ASSERT_FALSE(add(reassembler, fragment(1, frame, 0, 100), 0, &result));
+    ASSERT_FALSE(add(reassembler, fragment(2, frame, 0, 100), 1, &result));
+    ASSERT_FALSE(add(reassembler, fragment(3, frame, 0, 100), 2, &result));
+    ASSERT_EQ(reassembler.getPendingCount(), 2u);
+
+    // Message 1 was evicted, message 2 still completes
+    ASSERT_TRUE(add(reassembler, fragment(2, frame, 100, 100), 3, &result));
+    ASSERT_FALSE(add(reassembler, fragment(1, frame, 100, 100), 3, &result));
+
+    LinxMetricsSnapshot snapshot{};
+    reassembler.addMetrics(snapshot);
+    ASSERT_GE(snapshot.reassemblyDrops, 1u);
+}
+
+TEST(UdpReassemblerTests, add_RejectMalformedFragments) {
+    UdpReassembler reassembler;
+    auto frame = makeFrame(200);
+    std::vector<uint8_t> result;
+
+    auto truncated = fragment(1, frame, 0, 100);
+    truncated.pop_back();
+    ASSERT_FALSE(add(reassembler, truncated, 0, &result));
+    ASSERT_FALSE(add(reassembler, fragment(1, frame, 50, 100), 0, &result));
+    ASSERT_FALSE(add(reassembler, std::vector<uint8_t>(sizeof(UdpFragmentHeader)), 0, &result));
+    ASSERT_EQ(reassembler.getPendingCount(), 0u);
+
+    LinxMetricsSnapshot snapshot{};
+    reassembler.addMetrics(snapshot);
+    ASSERT_EQ(snapshot.reassemblyDrops, 3u);
+}
+
+TEST(UdpFragmentationSocketTests, send_FragmentMessageAboveDatagramSize) {
+    UdpSocket receiver;
+    receiver.open();
+    receiver.bind(0);
+    ASSERT_EQ(receiver.setFragmentation(8192, LINX_DEFAULT_REASSEMBLY_TIMEOUT, LINX_DEFAULT_REASSEMBLY_MEMORY), 0);
+
+    UdpSocket sender;
+    sender.open();
+    ASSERT_EQ(sender.setFragmentation(8192, LINX_DEFAULT_REASSEMBLY_TIMEOUT, LINX_DEFAULT_REASSEMBLY_MEMORY), 0);
+
+    auto payload = makeFrame(100 * 1024);
+    PortInfo to("127.0.0.1", receiver.getLocalPort());
+    ASSERT_EQ(sender.send(RawMessage(7, payload), to), 0);
+    ASSERT_EQ(sender.send(RawMessage(8, {1, 2, 3}), to), 0);
+
+    RawMessagePtr msg;
+    std::unique_ptr<IIdentifier> from;
+    ASSERT_EQ(receiver.receive(&msg, &from, 1000), (int)(sizeof(uint32_t) + payload.size()));
+    ASSERT_NE(msg, nullptr);
+    EXPECT_EQ(msg->getReqId(), 7U);
+    ASSERT_EQ(msg->getPayloadSize(), payload.size());
+    EXPECT_EQ(memcmp(msg->getPayload(), payload.data(), payload.size()), 0);
+
+    ASSERT_GT(receiver.receive(&msg, &from, 1000), 0);
+    EXPECT_EQ(msg->getReqId(), 8U);
+
+    LinxMetricsSnapshot sent{};
+    sender.addMetrics(sent);
+    LinxMetricsSnapshot received{};
+    receiver.addMetrics(received);
+    EXPECT_EQ(sent.fragmentsSent, 13u);
+    EXPECT_EQ(received.fragmentsReceived, 13u);
+    EXPECT_EQ(received.reassembledMessages, 1u);
+}
+
+TEST(UdpFragmentationSocketTests, receive_TimeoutOnIncompleteMessage) {
+    UdpSocket receiver;
+    receiver.open();
+    receiver.bind(0);
+    receiver.setFragmentation(LINX_DEFAULT_DATAGRAM_SIZE, LINX_DEFAULT_REASSEMBLY_TIMEOUT, LINX_DEFAULT_REASSEMBLY_MEMORY);
+
+    UdpSocket sender;
+    sender.open();
+    sender.bind(0);
+    auto frame = makeFrame(3000);
+    auto datagram = fragment(1, frame, 0, 1000);
+    sockaddr_in addr{};
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(receiver.getLocalPort());
+    inet_pton(AF_INET, "127.0.0.1", &addr.sin_addr);
+    ASSERT_EQ(sendto(sender.getFd(), datagram.data(), datagram.size(), 0, (sockaddr *)&addr, sizeof(addr)),
+              (ssize_t)datagram.size());
+
+    RawMessagePtr msg;
+    std::unique_ptr<IIdentifier> from;
+    EXPECT_EQ(receiver.receive(&msg, &from, 50), 0);
+    EXPECT_EQ(msg, nullptr);
+}
+
+TEST(UdpFragmentationSocketTests, setFragmentation_RejectInvalidDatagramSize) {
+    UdpSocket socket;
+
+    EXPECT_EQ(socket.setFragmentation(sizeof(UdpFragmentHeader), 100, 1024), -1);
+    EXPECT_EQ(socket.setFragmentation(65508, 100, 1024), -1);
+    EXPECT_EQ(socket.setFragmentation(0, 100, 1024), 0);
+}
@@ -0,0 +1,161 @@
+#include <future>
+#include <thread>
+#include "gtest/gtest.h"
+#include "UdpSocket.h"
+#include "UdpLinx.h"
+#include "RawMessage.h"
+#include "LinxBatch.h"
+
+using namespace ::testing;
+
+namespace {
+
+constexpr uint32_t TOPIC_A = IPC_SIG_BASE + 100;
+constexpr uint32_t TOPIC_B = IPC_SIG_BASE + 200;
+
+uint32_t receiveReqId(UdpSocket &socket, int timeoutMs = 100) {
+    RawMessagePtr msg;
+    if (socket.receive(&msg, nullptr, timeoutMs) <= 0 || msg == nullptr) {
+        return 0;
+    }
+    return msg->getReqId();
+}
+
+uint64_t unsubscribedDrops(const UdpSocket &socket) {
+    LinxMetricsSnapshot snapshot;
+    socket.addMetrics(snapshot);
+    return snapshot.unsubscribedDrops;
+}
+
+} // namespace
+
+class UdpSubscriptionTests : public testing::Test {
+  protected:
+    void SetUp() override {
+        receiver.open();
+        receiver.bind(0);
+        sender.open();
+        to = PortInfo("127.0.0.1", receiver.getLocalPort());
+    }
+
+    UdpSocket receiver;
+    UdpSocket sender;
+    PortInfo to;
+};
+
+TEST_F(UdpSubscriptionTests, receive_DropsMessagesOfTopicsNotSubscribed) {
+    ASSERT_EQ(receiver.setSubscription({{TOPIC_A, TOPIC_A + 9, "239.0.0.2"}}), 0);
+
+    ASSERT_EQ(sender.send(RawMessage(TOPIC_B), to), 0);
+    ASSERT_EQ(sender.send(RawMessage(TOPIC_A + 9), to), 0);
+    ASSERT_EQ(sender.send(RawMessage(TOPIC_A + 10), to), 0);
+    ASSERT_EQ(sender.send(RawMessage(IPC_PING_REQ), to), 0);
+    ASSERT_EQ(sender.send(RawMessage(TOPIC_A), to), 0);
+
+    EXPECT_EQ(receiveReqId(receiver), TOPIC_A + 9);
+    EXPECT_EQ(receiveReqId(receiver), (uint32_t)IPC_PING_REQ);
+    EXPECT_EQ(receiveReqId(receiver), TOPIC_A);
+    EXPECT_EQ(receiveReqId(receiver, 0), 0u);
+    // Dropped by socket filter before reaching userspace
+    EXPECT_EQ(unsubscribedDrops(receiver), 0u);
+}
+
+TEST_F(UdpSubscriptionTests, receive_DropsUnsubscribedMessagesOfContainer) {
+    ASSERT_EQ(receiver.setSubscription({{TOPIC_B, TOPIC_B, "239.0.0.2"}, {TOPIC_A, TOPIC_A, "239.0.0.3"}}), 0);
+
+    std::vector<uint8_t> batch;
+    ASSERT_TRUE(LinxBatch::append(batch, RawMessage(TOPIC_A + 1)));
+    ASSERT_TRUE(LinxBatch::append(batch, RawMessage(TOPIC_B)));
+    ASSERT_TRUE(LinxBatch::append(batch, RawMessage(TOPIC_A + 2)));
+    ASSERT_EQ(sender.send(RawMessage(IPC_BATCH_MSG, std::move(batch)), to), 0);
+
+    EXPECT_EQ(receiveReqId(receiver), TOPIC_B);
+    EXPECT_EQ(receiveReqId(receiver, 0), 0u);
+    EXPECT_EQ(unsubscribedDrops(receiver), 2u);
+}
+
+TEST_F(UdpSubscriptionTests, receive_DropsFragmentsOfTopicsNotSubscribed) {
+    ASSERT_EQ(receiver.setSubscription({{TOPIC_A, TOPIC_A, "239.0.0.2"}}), 0);
+    receiver.setFragmentation(LINX_DEFAULT_DATAGRAM_SIZE, LINX_DEFAULT_REASSEMBLY_TIMEOUT, LINX_DEFAULT_REASSEMBLY_MEMORY);
+    sender.setFragmentation(LINX_DEFAULT_DATAGRAM_SIZE, LINX_DEFAULT_REASSEMBLY_TIMEOUT, LINX_DEFAULT_REASSEMBLY_MEMORY);
+
+    std::vector<uint8_t> payload(3 * LINX_DEFAULT_DATAGRAM_SIZE, 0x11);
+    ASSERT_EQ(sender.send(RawMessage(TOPIC_B, payload), to), 0);
+    ASSERT_EQ(sender.send(RawMessage(TOPIC_A, payload), to), 0);
+
+    RawMessagePtr msg;
+    EXPECT_GT(receiver.receive(&msg, nullptr, 100), 0);
+    ASSERT_NE(msg, nullptr);
+    EXPECT_EQ(msg->getReqId(), TOPIC_A);
+    EXPECT_EQ(msg->getPayloadSize(), payload.size());
+
+    LinxMetricsSnapshot snapshot;
+    receiver.addMetrics(snapshot);
+    // Every fragment carries reqId, so all are dropped by socket filter
+    EXPECT_EQ(snapshot.unsubscribedDrops, 0u);
+    EXPECT_EQ(snapshot.reassembledMessages, 1u);
+}
+
+TEST_F(UdpSubscriptionTests, setSubscription_NotBlockedByReceiveInProgress) {
+    std::thread receiverThread([&]() {
+        EXPECT_EQ(receiveReqId(receiver, INFINITE_TIMEOUT), TOPIC_A);
+    });
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+
+    auto result = std::async(std::launch::async, [&]() {
+        return receiver.setSubscription({{TOPIC_A, TOPIC_A, "239.0.0.2"}});
+    });
+    EXPECT_EQ(result.wait_for(std::chrono::seconds(1)), std::future_status::ready);
+    EXPECT_EQ(result.get(), 0);
+
+    // Receive in progress applies new subscription
+    ASSERT_EQ(sender.send(RawMessage(TOPIC_B), to), 0);
+    ASSERT_EQ(sender.send(RawMessage(TOPIC_A), to), 0);
+    receiverThread.join();
+}
+
+TEST_F(UdpSubscriptionTests, setSubscription_FailsOnInvalidRange) {
+    EXPECT_EQ(receiver.setSubscription({{TOPIC_B, TOPIC_A, "239.0.0.2"}}), -1);
+}
+
+TEST(UdpPubSubTests, createSubscriber_FailsOnInvalidTopics) {
+    EXPECT_EQ(UdpFactory::createSubscriber({}, 0), nullptr);
+    EXPECT_EQ(UdpFactory::createSubscriber({{TOPIC_A, TOPIC_A, "127.0.0.1"}}, 0), nullptr);
+    EXPECT_EQ(UdpFactory::createPublisher({{TOPIC_A, TOPIC_A, "10.0.0.1"}}, 0), nullptr);
+}
+
+TEST(UdpPubSubTests, publish_DeliversMessagesToSubscribersOfTopic) {
+    constexpr uint16_t port = 12360;
+    std::vector<LinxTopic> topics = {
+        {TOPIC_A, TOPIC_A + 9, "239.0.0.2"},
+        {TOPIC_B, TOPIC_B + 9, "239.0.0.3"},
+        {TOPIC_B + 5, TOPIC_B + 5, "239.0.0.3"},
+    };
+
+    auto subscriberA = UdpFactory::createSubscriber({topics[0]}, port, 10);
+    auto subscriberB = UdpFactory::createSubscriber({topics[1]}, port, 10);
+    auto publisher = UdpFactory::createPublisher(topics, port);
+    ASSERT_NE(subscriberA, nullptr);
+    ASSERT_NE(subscriberB, nullptr);
+    ASSERT_NE(publisher, nullptr);
+    ASSERT_TRUE(subscriberA->start());
+    ASSERT_TRUE(subscriberB->start());
+
+    EXPECT_EQ(publisher->publish(RawMessage(TOPIC_A + 1)), 1);
+    EXPECT_EQ(publisher->publish(RawMessage(TOPIC_B + 5)), 1);
+    EXPECT_EQ(publisher->publish(RawMessage(IPC_SIG_BASE + 300)), 0);
+
+    auto msg = subscriberA->receive(1000);
+    ASSERT_NE(msg, nullptr);
+    EXPECT_EQ(msg->message->getReqId(), TOPIC_A + 1);
+    msg = subscriberB->receive(1000);
+    ASSERT_NE(msg, nullptr);
+    EXPECT_EQ(msg->message->getReqId(), TOPIC_B + 5);
+
+    EXPECT_EQ(subscriberA->receive(50), nullptr);
+    EXPECT_EQ(subscriberB->receive(50), nullptr);
+    EXPECT_EQ(publisher->getMetrics().txMessages, 2u);
+
+    subscriberA->stop();
+    subscriberB->stop();
+}
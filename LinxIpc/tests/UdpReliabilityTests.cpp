@@ -0,0 +1,438 @@
+#include <atomic>
+#include <poll.h>
+#include <thread>
+#include "gtest/gtest.h"
+#include "UdpReliability.h"
+#include "UdpSocket.h"
+#include "mocks/LossyUdpSocket.h"
+#include <arpa/inet.h>
+
+using namespace ::testing;
+
+namespace {
+
+using Datagrams = std::vector<std::vector<uint8_t>>;
+
+sockaddr_in peerAddress(uint16_t port = 5000) {
+    sockaddr_in addr{};
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(port);
+    inet_pton(AF_INET, "127.0.0.1", &addr.sin_addr);
+    return addr;
+}
+
+UdpReliability::Transmit capture(Datagrams *sent) {
+    return [sent](const struct iovec *iov, int iovCount, const sockaddr_in &) {
+        std::vector<uint8_t> datagram;
+        for (int i = 0; i < iovCount; i++) {
+            const uint8_t *data = static_cast<const uint8_t *>(iov[i].iov_base);
+            datagram.insert(datagram.end(), data, data + iov[i].iov_len);
+        }
+        sent->push_back(datagram);
+        return (ssize_t)datagram.size();
+    };
+}
+
+int noDrive(int) {
+    return 0;
+}
+
+std::vector<uint8_t> data(uint32_t session, uint32_t sequence, uint32_t lowest = 0,
+                          const std::vector<uint8_t> &frame = {0, 0, 0, 7}) {
+    UdpReliableHeader header{};
+    header.reqId = htonl(7 | LINX_RELIABLE_FLAG);
+    header.type = UdpReliability::dataType;
+    header.session = htonl(session);
+    header.sequence = htonl(sequence);
+    header.lowest = htonl(lowest);
+
+    std::vector<uint8_t> datagram((uint8_t *)&header, (uint8_t *)&header + sizeof(header));
+    datagram.insert(datagram.end(), frame.begin(), frame.end());
+    return datagram;
+}
+
+std::vector<uint8_t> ack(uint32_t session, uint32_t cumulative, const std::vector<UdpSackBlock> &blocks = {}) {
+    UdpReliableHeader header{};
+    header.reqId = htonl(LINX_RELIABLE_FLAG);
+    header.type = UdpReliability::ackType;
+    header.sackCount = blocks.size();
+    header.session = htonl(session);
+    header.sequence = htonl(cumulative);
+
+    std::vector<uint8_t> datagram((uint8_t *)&header, (uint8_t *)&header + sizeof(header));
+    for (auto block : blocks) {
+        block.start = htonl(block.start);
+        block.end = htonl(block.end);
+        datagram.insert(datagram.end(), (uint8_t *)&block, (uint8_t *)&block + sizeof(block));
+    }
+    return datagram;
+}
+
+UdpReliableHeader header(const std::vector<uint8_t> &datagram) {
+    UdpReliableHeader header;
+    memcpy(&header, datagram.data(), sizeof(header));
+    return header;
+}
+
+std::vector<std::pair<uint32_t, uint32_t>> sackBlocks(const std::vector<uint8_t> &datagram) {
+    std::vector<std::pair<uint32_t, uint32_t>> blocks;
+    for (size_t i = 0; i < header(datagram).sackCount; i++) {
+        UdpSackBlock block;
+        memcpy(&block, datagram.data() + sizeof(UdpReliableHeader) + i * sizeof(block), sizeof(block));
+        blocks.emplace_back(ntohl(block.start), ntohl(block.end));
+    }
+    return blocks;
+}
+
+int send(UdpReliability &reliability, const std::vector<uint8_t> &frame, const sockaddr_in &addr = peerAddress()) {
+    struct iovec iov = {const_cast<uint8_t *>(frame.data()), frame.size()};
+    return reliability.send(&iov, 1, addr);
+}
+
+} // namespace
+
+TEST(UdpReliabilityTests, onReceive_DeliverOnceAndAcknowledgeDuplicates) {
+    Datagrams sent;
+    UdpReliability reliability(capture(&sent), noDrive);
+    reliability.configure(true, LINX_DEFAULT_RELIABLE_WINDOW, LINX_DEFAULT_RELIABLE_SEND_TIMEOUT);
+
+    auto datagram = data(10, 0);
+    ASSERT_TRUE(reliability.onReceive(datagram, peerAddress()));
+    EXPECT_EQ(datagram, std::vector<uint8_t>({0, 0, 0, 7}));
+
+    datagram = data(10, 0);
+    ASSERT_FALSE(reliability.onReceive(datagram, peerAddress()));
+
+    ASSERT_EQ(sent.size(), 2u);
+    for (const auto &acknowledgement : sent) {
+        EXPECT_EQ(header(acknowledgement).type, UdpReliability::ackType);
+        EXPECT_EQ(ntohl(header(acknowledgement).session), 10u);
+        EXPECT_EQ(ntohl(header(acknowledgement).sequence), 1u);
+    }
+
+    LinxMetricsSnapshot snapshot{};
+    reliability.addMetrics(snapshot);
+    EXPECT_EQ(snapshot.duplicatesReceived, 1u);
+}
+
+TEST(UdpReliabilityTests, onReceive_SelectiveAckForOutOfOrderDatagrams) {
+    Datagrams sent;
+    UdpReliability reliability(capture(&sent), noDrive);
+    reliability.configure(true, LINX_DEFAULT_RELIABLE_WINDOW, LINX_DEFAULT_RELIABLE_SEND_TIMEOUT);
+
+    for (uint32_t sequence : {0, 2, 3, 5}) {
+        auto datagram = data(10, sequence);
+        ASSERT_TRUE(reliability.onReceive(datagram, peerAddress()));
+    }
+    EXPECT_EQ(ntohl(header(sent.back()).sequence), 1u);
+    EXPECT_EQ(sackBlocks(sent.back()), (std::vector<std::pair<uint32_t, uint32_t>>{{2, 4}, {5, 6}}));
+
+    auto datagram = data(10, 1);
+    ASSERT_TRUE(reliability.onReceive(datagram, peerAddress()));
+    EXPECT_EQ(ntohl(header(sent.back()).sequence), 4u);
+    EXPECT_EQ(sackBlocks(sent.back()), (std::vector<std::pair<uint32_t, uint32_t>>{{5, 6}}));
+}
+
+TEST(UdpReliabilityTests, onReceive_ResetStateWhenSenderSessionChanges) {
+    Datagrams sent;
+    UdpReliability reliability(capture(&sent), noDrive);
+    reliability.configure(true, LINX_DEFAULT_RELIABLE_WINDOW, LINX_DEFAULT_RELIABLE_SEND_TIMEOUT);
+
+    auto datagram = data(10, 0);
+    ASSERT_TRUE(reliability.onReceive(datagram, peerAddress()));
+    datagram = data(11, 0);
+    ASSERT_TRUE(reliability.onReceive(datagram, peerAddress()));
+    EXPECT_EQ(ntohl(header(sent.back()).session), 11u);
+}
+
+TEST(UdpReliabilityTests, onReceive_AckRemovesCumulativeAndSelectiveAcked) {
+    Datagrams sent;
+    UdpReliability reliability(capture(&sent), noDrive);
+    reliability.configure(true, LINX_DEFAULT_RELIABLE_WINDOW, LINX_DEFAULT_RELIABLE_SEND_TIMEOUT);
+
+    for (int i = 0; i < 4; i++) {
+        ASSERT_EQ(send(reliability, {0, 0, 0, 7, (uint8_t)i}), 0);
+    }
+    ASSERT_EQ(sent.size(), 4u);
+    EXPECT_EQ(ntohl(header(sent[3]).sequence), 3u);
+    EXPECT_EQ(ntohl(header(sent[3]).reqId), 7 | LINX_RELIABLE_FLAG);
+    uint32_t session = ntohl(header(sent[0]).session);
+
+    auto datagram = ack(session + 1, 4);
+    ASSERT_FALSE(reliability.onReceive(datagram, peerAddress()));
+    EXPECT_EQ(reliability.getUnackedCount(), 4u);
+
+    datagram = ack(session, 1, {{2, 3}});
+    ASSERT_FALSE(reliability.onReceive(datagram, peerAddress()));
+    EXPECT_EQ(reliability.getUnackedCount(), 2u);
+
+    datagram = ack(session, 4);
+    ASSERT_FALSE(reliability.onReceive(datagram, peerAddress()));
+    EXPECT_EQ(reliability.getUnackedCount(), 0u);
+}
+
+TEST(UdpReliabilityTests, retransmit_ResendUnackedDatagramAfterTimeout) {
+    Datagrams sent;
+    UdpReliability reliability(capture(&sent), noDrive);
+    reliability.configure(true, LINX_DEFAULT_RELIABLE_WINDOW, LINX_DEFAULT_RELIABLE_SEND_TIMEOUT);
+
+    ASSERT_EQ(reliability.retransmit(), INFINITE_TIMEOUT);
+    ASSERT_EQ(send(reliability, {0, 0, 0, 7}), 0);
+    EXPECT_GT(reliability.retransmit(), 0);
+    ASSERT_EQ(sent.size(), 1u);
+
+    std::this_thread::sleep_for(std::chrono::nanoseconds(UdpReliability::initialRtoNs + 10000000));
+    int nextMs = reliability.retransmit();
+
+    ASSERT_EQ(sent.size(), 2u);
+    EXPECT_EQ(sent[1], sent[0]);
+    EXPECT_GT(nextMs, (int)(UdpReliability::initialRtoNs / 1000000));
+
+    LinxMetricsSnapshot snapshot{};
+    reliability.addMetrics(snapshot);
+    EXPECT_EQ(snapshot.retransmits, 1u);
+}
+
+TEST(UdpReliabilityTests, send_FailWhenWindowStaysFull) {
+    Datagrams sent;
+    int drives = 0;
+    UdpReliability reliability(capture(&sent), [&drives](int) {
+        drives++;
+        return 0;
+    });
+    reliability.configure(true, 2, 20);
+
+    ASSERT_EQ(send(reliability, {0, 0, 0, 7}), 0);
+    ASSERT_EQ(send(reliability, {0, 0, 0, 7}), 0);
+    ASSERT_EQ(send(reliability, {0, 0, 0, 7}, peerAddress(5001)), 0);
+    EXPECT_EQ(send(reliability, {0, 0, 0, 7}), -2);
+    EXPECT_GT(drives, 0);
+    EXPECT_EQ(sent.size(), 3u);
+}
+
+TEST(UdpReliabilityTests, onReceive_MoveWindowPastSequenceGivenUpBySender) {
+    Datagrams senderSent;
+    Datagrams receiverSent;
+    UdpReliability sender(capture(&senderSent), noDrive);
+    UdpReliability receiver(capture(&receiverSent), noDrive);
+    sender.configure(true, 4, LINX_DEFAULT_RELIABLE_SEND_TIMEOUT);
+    receiver.configure(true, LINX_DEFAULT_RELIABLE_WINDOW, LINX_DEFAULT_RELIABLE_SEND_TIMEOUT);
+
+    ASSERT_EQ(send(sender, {0, 0, 0, 7}), 0);
+    ASSERT_TRUE(receiver.onReceive(senderSent[0], peerAddress()));
+    auto acknowledgement = receiverSent.back();
+    ASSERT_FALSE(sender.onReceive(acknowledgement, peerAddress()));
+
+    // Sequence 1 and all its retransmissions are lost until sender gives up
+    ASSERT_EQ(send(sender, {0, 0, 0, 7}), 0);
+    uint64_t now = std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+    for (int i = 0; i <= UdpReliability::maxRetransmits; i++) {
+        now += UdpReliability::maxRtoNs;
+        sender.retransmit(now);
+    }
+    ASSERT_EQ(sender.getUnackedCount(), 0u);
+
+    // Following datagrams are acknowledged cumulatively, so sender window does not stay full
+    for (uint32_t sequence = 2; sequence < 10; sequence++) {
+        ASSERT_EQ(send(sender, {0, 0, 0, 7}), 0);
+        EXPECT_EQ(ntohl(header(senderSent.back()).lowest), sequence);
+        ASSERT_TRUE(receiver.onReceive(senderSent.back(), peerAddress()));
+
+        acknowledgement = receiverSent.back();
+        EXPECT_EQ(ntohl(header(acknowledgement).sequence), sequence + 1);
+        EXPECT_TRUE(sackBlocks(acknowledgement).empty());
+        ASSERT_FALSE(sender.onReceive(acknowledgement, peerAddress()));
+        ASSERT_EQ(sender.getUnackedCount(), 0u);
+    }
+
+    LinxMetricsSnapshot snapshot{};
+    sender.addMetrics(snapshot);
+    EXPECT_EQ(snapshot.deliveryFailures, 1u);
+}
+
+TEST(UdpReliabilityTests, onReceive_StartWindowAtSenderLowestAfterReceiverRestart) {
+    Datagrams sent;
+    UdpReliability reliability(capture(&sent), noDrive);
+    reliability.configure(true, LINX_DEFAULT_RELIABLE_WINDOW, LINX_DEFAULT_RELIABLE_SEND_TIMEOUT);
+
+    // Sender session continues at sequence 1000, 998 and 999 are still unacknowledged
+    auto datagram = data(10, 1000, 998);
+    ASSERT_TRUE(reliability.onReceive(datagram, peerAddress()));
+    EXPECT_EQ(ntohl(header(sent.back()).sequence), 998u);
+    EXPECT_EQ(sackBlocks(sent.back()), (std::vector<std::pair<uint32_t, uint32_t>>{{1000, 1001}}));
+
+    datagram = data(10, 998, 998);
+    ASSERT_TRUE(reliability.onReceive(datagram, peerAddress()));
+    datagram = data(10, 999, 998);
+    ASSERT_TRUE(reliability.onReceive(datagram, peerAddress()));
+    EXPECT_EQ(ntohl(header(sent.back()).sequence), 1001u);
+
+    datagram = data(10, 997, 997);
+    ASSERT_FALSE(reliability.onReceive(datagram, peerAddress()));
+}
+
+TEST(UdpReliabilitySocketTests, send_RetransmitWithoutReceiveOnSender) {
+    constexpr uint32_t count = 50;
+    LossyUdpSocket receiver(0.0);
+    receiver.open();
+    receiver.bind(0);
+    receiver.setReliable(true, LINX_DEFAULT_RELIABLE_WINDOW, LINX_DEFAULT_RELIABLE_SEND_TIMEOUT);
+
+    LossyUdpSocket sender(0.2, 0.0, 0.0, 4);
+    sender.open();
+    sender.setReliable(true, count, 5000);
+
+    std::atomic<bool> done{false};
+    std::atomic<uint32_t> delivered{0};
+    std::thread receiverThread([&]() {
+        while (!done) {
+            RawMessagePtr msg;
+            if (receiver.receive(&msg, nullptr, 10) > 0) {
+                delivered++;
+            }
+        }
+    });
+
+    PortInfo to("127.0.0.1", receiver.getLocalPort());
+    for (uint32_t i = 0; i < count; i++) {
+        ASSERT_EQ(sender.send(RawMessage(IPC_SIG_BASE + i, {1, 2, 3}), to), 0);
+    }
+
+    // Sender never calls receive(), ACKs and retransmissions are handled by its timer
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+    while ((sender.getUnackedCount() != 0 || delivered != count) && std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+    done = true;
+    receiverThread.join();
+
+    EXPECT_EQ(sender.getUnackedCount(), 0u);
+    EXPECT_EQ(delivered, count);
+    EXPECT_GT(sender.getDroppedCount(), 0u);
+}
+
+TEST(UdpReliabilitySocketTests, send_DeliverAllMessagesExactlyOnceOverLossyNetwork) {
+    constexpr uint32_t count = 200;
+    LossyUdpSocket receiver(0.1, 0.05);
+    receiver.open();
+    receiver.bind(0);
+    receiver.setReliable(true, LINX_DEFAULT_RELIABLE_WINDOW, LINX_DEFAULT_RELIABLE_SEND_TIMEOUT);
+
+    LossyUdpSocket sender(0.1, 0.05, 0.1, 2);
+    sender.open();
+    sender.setReliable(true, 16, 5000);
+
+    std::atomic<bool> done{false};
+    std::vector<int> delivered(count, 0);
+    std::thread receiverThread([&]() {
+        while (!done) {
+            RawMessagePtr msg;
+            if (receiver.receive(&msg, nullptr, 10) > 0 && msg->getReqId() - IPC_SIG_BASE < count) {
+                delivered[msg->getReqId() - IPC_SIG_BASE]++;
+            }
+        }
+    });
+
+    PortInfo to("127.0.0.1", receiver.getLocalPort());
+    for (uint32_t i = 0; i < count; i++) {
+        ASSERT_EQ(sender.send(RawMessage(IPC_SIG_BASE + i, {1, 2, 3}), to), 0);
+    }
+
+    // Sender has to receive to process ACKs and retransmit
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+    while (sender.getUnackedCount() != 0 && std::chrono::steady_clock::now() < deadline) {
+        sender.receive(nullptr, nullptr, 10);
+    }
+    done = true;
+    receiverThread.join();
+
+    EXPECT_EQ(sender.getUnackedCount(), 0u);
+    EXPECT_EQ(std::count(delivered.begin(), delivered.end(), 1), (int)count);
+    EXPECT_GT(sender.getDroppedCount(), 0u);
+
+    LinxMetricsSnapshot snapshot{};
+    sender.addMetrics(snapshot);
+    EXPECT_GT(snapshot.retransmits, 0u);
+    EXPECT_EQ(snapshot.deliveryFailures, 0u);
+}
+
+TEST(UdpReliabilitySocketTests, send_RecoverLostFragments) {
+    LossyUdpSocket receiver(0.0);
+    receiver.open();
+    receiver.bind(0);
+    receiver.setFragmentation(LINX_DEFAULT_DATAGRAM_SIZE, LINX_DEFAULT_REASSEMBLY_TIMEOUT, LINX_DEFAULT_REASSEMBLY_MEMORY);
+    receiver.setReliable(true, LINX_DEFAULT_RELIABLE_WINDOW, LINX_DEFAULT_RELIABLE_SEND_TIMEOUT);
+
+    LossyUdpSocket sender(0.2, 0.0, 0.0, 3);
+    sender.open();
+    sender.setFragmentation(LINX_DEFAULT_DATAGRAM_SIZE, LINX_DEFAULT_REASSEMBLY_TIMEOUT, LINX_DEFAULT_REASSEMBLY_MEMORY);
+    sender.setReliable(true, LINX_DEFAULT_RELIABLE_WINDOW, LINX_DEFAULT_RELIABLE_SEND_TIMEOUT);
+
+    std::vector<uint8_t> payload(20000);
+    for (size_t i = 0; i < payload.size(); i++) {
+        payload[i] = (uint8_t)(i * 13);
+    }
+    ASSERT_EQ(sender.send(RawMessage(7, payload), PortInfo("127.0.0.1", receiver.getLocalPort())), 0);
+    ASSERT_GT(sender.getDroppedCount(), 0u);
+
+    std::atomic<bool> done{false};
+    std::thread senderThread([&]() {
+        while (!done && sender.getUnackedCount() != 0) {
+            sender.receive(nullptr, nullptr, 10);
+        }
+    });
+
+    RawMessagePtr msg;
+    int ret = receiver.receive(&msg, nullptr, 5000);
+    done = true;
+    senderThread.join();
+
+    ASSERT_GT(ret, 0);
+    EXPECT_EQ(msg->getReqId(), 7u);
+    ASSERT_EQ(msg->getPayloadSize(), payload.size());
+    EXPECT_EQ(memcmp(msg->getPayload(), payload.data(), payload.size()), 0);
+}
+
+TEST(UdpReliabilitySocketTests, send_FailOnReservedReqId) {
+    UdpSocket socket;
+    socket.open();
+    socket.setReliable(true, LINX_DEFAULT_RELIABLE_WINDOW, LINX_DEFAULT_RELIABLE_SEND_TIMEOUT);
+
+    EXPECT_EQ(socket.send(RawMessage(LINX_RELIABLE_FLAG | 1), PortInfo("127.0.0.1", 5000)), -6);
+}
+
+TEST(UdpReliabilitySocketTests, send_FailToMulticastAndBroadcast) {
+    UdpSocket socket;
+    socket.open();
+    socket.setReliable(true, LINX_DEFAULT_RELIABLE_WINDOW, LINX_DEFAULT_RELIABLE_SEND_TIMEOUT);
+
+    EXPECT_EQ(socket.send(RawMessage(7), PortInfo("239.1.2.3", 5000)), -8);
+    EXPECT_EQ(socket.send(RawMessage(7), PortInfo("255.255.255.255", 5000)), -8);
+}
+
+TEST(UdpReliabilitySocketTests, getPollFd_ReadableForMessageReadWhileWaitingForAck) {
+    UdpSocket peer;
+    peer.open();
+    peer.bind(0);
+    peer.setReliable(true, LINX_DEFAULT_RELIABLE_WINDOW, LINX_DEFAULT_RELIABLE_SEND_TIMEOUT);
+
+    UdpSocket socket;
+    socket.open();
+    socket.bind(0);
+    socket.setReliable(true, 1, 50);
+    struct pollfd pfd = {socket.getPollFd(), POLLIN, 0};
+
+    ASSERT_EQ(peer.send(RawMessage(7), PortInfo("127.0.0.1", socket.getLocalPort())), 0);
+
+    // Peer does not receive, so second send waits for ACK and reads message of peer from socket
+    PortInfo to("127.0.0.1", peer.getLocalPort());
+    ASSERT_EQ(socket.send(RawMessage(8), to), 0);
+    ASSERT_LT(socket.send(RawMessage(9), to), 0);
+
+    ASSERT_EQ(poll(&pfd, 1, 0), 1);
+    RawMessagePtr msg;
+    ASSERT_GT(socket.receive(&msg, nullptr, IMMEDIATE_TIMEOUT), 0);
+    EXPECT_EQ(msg->getReqId(), 7u);
+    EXPECT_EQ(poll(&pfd, 1, 0), 0);
+}
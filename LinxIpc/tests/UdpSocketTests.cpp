@@ -148,6 +148,205 @@ TEST_F(UdpSocketTests, setMulticastTtl_SuccessfullySets) {
     socket.close();
 }
 
+// Test setReusePort
+TEST_F(UdpSocketTests, setReusePort_FailsOnInvalidSocket) {
+    UdpSocket socket;
+    EXPECT_EQ(socket.setReusePort(true), -1);
+}
+
+TEST_F(UdpSocketTests, setReusePort_AllowsTwoSocketsOnSamePort) {
+    UdpSocket socket1;
+    UdpSocket socket2;
+    socket1.open();
+    socket2.open();
+
+    EXPECT_EQ(socket1.setReusePort(true), 0);
+    EXPECT_EQ(socket2.setReusePort(true), 0);
+    EXPECT_EQ(socket1.bind(0), 0);
+
+    int port = socket1.getLocalPort();
+    EXPECT_GT(port, 0);
+    EXPECT_EQ(socket2.bind(port), 0);
+    EXPECT_EQ(socket2.getLocalPort(), port);
+}
+
+// Test busy poll
+TEST_F(UdpSocketTests, setBusyPoll_FailsOnInvalidSocket) {
+    UdpSocket socket;
+    EXPECT_EQ(socket.setBusyPoll(50, false), -1);
+}
+
+TEST_F(UdpSocketTests, setBusyPoll_AppliesKernelBusyPoll) {
+    UdpSocket socket;
+    socket.open();
+
+    SystemMock mock;
+    EXPECT_CALL(mock, setsockopt(socket.getFd(), SOL_SOCKET, SO_BUSY_POLL, _, sizeof(int)))
+        .WillOnce(Return(0));
+    EXPECT_EQ(socket.setBusyPoll(50, true), 0);
+}
+
+TEST_F(UdpSocketTests, receive_WithBusyPoll_ReturnsZeroOnTimeout) {
+    UdpSocket socket;
+    socket.open();
+    socket.bind(0);
+    EXPECT_EQ(socket.setBusyPoll(100, false), 0);
+
+    RawMessagePtr msg;
+    std::unique_ptr<IIdentifier> from;
+    EXPECT_EQ(socket.receive(&msg, &from, 10), 0);
+}
+
+// Test kernel receive timestamps
+TEST_F(UdpSocketTests, setTimestamping_FailsOnInvalidSocket) {
+    UdpSocket socket;
+    EXPECT_EQ(socket.setTimestamping(true), -1);
+}
+
+TEST_F(UdpSocketTests, receive_WithTimestamping_RecordsKernelTime) {
+    UdpSocket receiver;
+    receiver.open();
+    receiver.bind(0);
+    ASSERT_EQ(receiver.setTimestamping(true), 0);
+
+    UdpSocket sender;
+    sender.open();
+
+    uint64_t before = LinxMessageTimestamps::now();
+    ASSERT_EQ(sender.send(RawMessage(7), PortInfo("127.0.0.1", receiver.getLocalPort())), 0);
+
+    RawMessagePtr msg;
+    std::unique_ptr<IIdentifier> from;
+    uint64_t rxTimestamp = 0;
+    EXPECT_GT(receiver.receive(&msg, &from, 100, &rxTimestamp), 0);
+    uint64_t after = LinxMessageTimestamps::now();
+
+    ASSERT_NE(msg, nullptr);
+    EXPECT_EQ(msg->getReqId(), 7U);
+    EXPECT_GE(rxTimestamp, before);
+    EXPECT_LE(rxTimestamp, after);
+    ASSERT_NE(from, nullptr);
+    EXPECT_EQ(static_cast<PortInfo *>(from.get())->ip, "127.0.0.1");
+}
+
+// Test payload compression
+TEST_F(UdpSocketTests, send_WithCompression_CompressesPayloadAboveThreshold) {
+    UdpSocket receiver;
+    receiver.open();
+    receiver.bind(0);
+    ASSERT_EQ(receiver.setCompression(256, nullptr), 0);
+
+    UdpSocket sender;
+    sender.open();
+    ASSERT_EQ(sender.setCompression(256, nullptr), 0);
+
+    std::vector<uint8_t> payload(8192);
+    for (size_t i = 0; i < payload.size(); i++) {
+        payload[i] = (uint8_t)(i % 16);
+    }
+    PortInfo to("127.0.0.1", receiver.getLocalPort());
+    ASSERT_EQ(sender.send(RawMessage(7, payload), to), 0);
+    ASSERT_EQ(sender.send(RawMessage(8, payload.data(), 16), to), 0);
+
+    RawMessagePtr msg;
+    std::unique_ptr<IIdentifier> from;
+    int len = receiver.receive(&msg, &from, 100);
+    EXPECT_GT(len, 0);
+    EXPECT_LT(len, 1024);
+    ASSERT_NE(msg, nullptr);
+    EXPECT_EQ(msg->getReqId(), 7U);
+    ASSERT_EQ(msg->getPayloadSize(), payload.size());
+    EXPECT_EQ(memcmp(msg->getPayload(), payload.data(), payload.size()), 0);
+
+    EXPECT_EQ(receiver.receive(&msg, &from, 100), (int)(sizeof(uint32_t) + 16));
+    ASSERT_NE(msg, nullptr);
+    EXPECT_EQ(msg->getReqId(), 8U);
+    EXPECT_EQ(msg->getPayloadSize(), 16U);
+}
+
+TEST_F(UdpSocketTests, send_WithCompression_FailsOnReservedReqId) {
+    UdpSocket sender;
+    sender.open();
+    sender.setCompression(256, nullptr);
+
+    EXPECT_EQ(sender.send(RawMessage(LINX_COMPRESSED_FLAG | 7), PortInfo("127.0.0.1", 12345)), -6);
+}
+
+// Flips one bit of every datagram leaving the socket
+class CorruptingUdpSocket : public UdpSocket {
+  protected:
+    ssize_t transmit(const struct iovec *iov, int iovCount, const sockaddr_in &addr) override {
+        std::vector<uint8_t> datagram;
+        for (int i = 0; i < iovCount; i++) {
+            const uint8_t *data = static_cast<const uint8_t *>(iov[i].iov_base);
+            datagram.insert(datagram.end(), data, data + iov[i].iov_len);
+        }
+        datagram[datagram.size() / 2] ^= 0x10;
+        struct iovec corrupted = {datagram.data(), datagram.size()};
+        return UdpSocket::transmit(&corrupted, 1, addr);
+    }
+};
+
+// Test CRC32C trailer
+TEST_F(UdpSocketTests, send_WithChecksum_DeliversCompressedAndPlainMessages) {
+    UdpSocket receiver;
+    receiver.open();
+    receiver.bind(0);
+    ASSERT_EQ(receiver.setChecksum(true), 0);
+    ASSERT_EQ(receiver.setCompression(256, nullptr), 0);
+
+    UdpSocket sender;
+    sender.open();
+    ASSERT_EQ(sender.setChecksum(true), 0);
+    ASSERT_EQ(sender.setCompression(256, nullptr), 0);
+
+    std::vector<uint8_t> payload(4096, 0xAB);
+    PortInfo to("127.0.0.1", receiver.getLocalPort());
+    ASSERT_EQ(sender.send(RawMessage(7, payload), to), 0);
+    ASSERT_EQ(sender.send(RawMessage(8, payload.data(), 16), to), 0);
+
+    RawMessagePtr msg;
+    std::unique_ptr<IIdentifier> from;
+    EXPECT_GT(receiver.receive(&msg, &from, 100), 0);
+    ASSERT_NE(msg, nullptr);
+    EXPECT_EQ(msg->getReqId(), 7U);
+    ASSERT_EQ(msg->getPayloadSize(), payload.size());
+    EXPECT_EQ(memcmp(msg->getPayload(), payload.data(), payload.size()), 0);
+
+    EXPECT_EQ(receiver.receive(&msg, &from, 100), (int)(2 * sizeof(uint32_t) + 16));
+    ASSERT_NE(msg, nullptr);
+    EXPECT_EQ(msg->getReqId(), 8U);
+    EXPECT_EQ(msg->getPayloadSize(), 16U);
+}
+
+TEST_F(UdpSocketTests, receive_WithChecksum_DropsCorruptedMessage) {
+    UdpSocket receiver;
+    receiver.open();
+    receiver.bind(0);
+    receiver.setChecksum(true);
+
+    CorruptingUdpSocket sender;
+    sender.open();
+    sender.setChecksum(true);
+
+    std::vector<uint8_t> payload(64, 0x5A);
+    ASSERT_EQ(sender.send(RawMessage(7, payload), PortInfo("127.0.0.1", receiver.getLocalPort())), 0);
+
+    RawMessagePtr msg;
+    EXPECT_EQ(receiver.receive(&msg, nullptr, 100), -7);
+    EXPECT_EQ(msg, nullptr);
+
+    LinxMetricsSnapshot snapshot;
+    receiver.addMetrics(snapshot);
+    EXPECT_EQ(snapshot.checksumErrors, 1u);
+}
+
+// Test getLocalPort on invalid socket
+TEST_F(UdpSocketTests, getLocalPort_FailsOnInvalidSocket) {
+    UdpSocket socket;
+    EXPECT_EQ(socket.getLocalPort(), -1);
+}
+
 // Test joinMulticastGroup
 TEST_F(UdpSocketTests, joinMulticastGroup_SuccessfullyJoins) {
     UdpSocket socket;
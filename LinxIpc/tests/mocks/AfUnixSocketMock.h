@@ -8,11 +8,15 @@ class AfUnixSocketMock : public AfUnixSocket {
     AfUnixSocketMock() : AfUnixSocket("MOCK_SOCKET") {}
     ~AfUnixSocketMock() override = default;
     MOCK_METHOD(int, send, (const IMessage &message, const UnixInfo &to));
-    MOCK_METHOD(int, receive, (RawMessagePtr * msg, std::unique_ptr<IIdentifier> *from, int timeout));
+    MOCK_METHOD(int, receive, (RawMessagePtr * msg, std::unique_ptr<IIdentifier> *from, int timeout,
+                               uint64_t *rxTimestamp));
     MOCK_METHOD(int, flush, ());
     MOCK_METHOD(int, open, ());
     MOCK_METHOD(void, close, ());
+    MOCK_METHOD(int, setBusyPoll, (int spinUs, bool kernelBusyPoll));
+    MOCK_METHOD(int, setTimestamping, (bool enable));
 
     MOCK_METHOD(std::string, getName, (), (const));
     MOCK_METHOD(int, getFd, (), (const));
+    MOCK_METHOD(int, getPollFd, (), (const));
 };
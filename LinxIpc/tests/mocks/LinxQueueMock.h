@@ -11,9 +11,14 @@ class LinxQueueMock : public LinxQueue {
 
     MOCK_METHOD(int, add, (LinxReceivedMessagePtr &&msg));
     MOCK_METHOD(int, size, (), (const));
+    MOCK_METHOD(int, getHighWater, (), (const));
     MOCK_METHOD(int, getFd, (), (const));
     MOCK_METHOD(void, clear, ());
     MOCK_METHOD(void, stop, ());
+    MOCK_METHOD(void, setSpinTime, (int spinUs));
     MOCK_METHOD(LinxReceivedMessagePtr, get, (int timeoutMs, const std::vector<uint32_t> &sigsel,
                                               const IIdentifier *from));
+    MOCK_METHOD(std::vector<LinxReceivedMessagePtr>, getBatch, (size_t maxCount, int timeoutMs,
+                                              const std::vector<uint32_t> &sigsel,
+                                              const IIdentifier *from));
 };
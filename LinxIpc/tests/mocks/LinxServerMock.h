@@ -6,6 +6,10 @@ class LinxServerMock : public LinxServer {
     MOCK_METHOD(LinxReceivedMessageSharedPtr, receive, (int timeoutMs,
                                              const std::vector<uint32_t> &sigsel,
                                              const IIdentifier *from));
+    MOCK_METHOD(std::vector<LinxReceivedMessageSharedPtr>, receiveBatch, (size_t maxCount,
+                                             int timeoutMs,
+                                             const std::vector<uint32_t> &sigsel,
+                                             const IIdentifier *from));
 
     MOCK_METHOD(int, getPollFd, (), (const));
     MOCK_METHOD(bool, start, ());
@@ -0,0 +1,67 @@
+#pragma once
+
+#include <mutex>
+#include <random>
+#include "UdpSocket.h"
+
+// UdpSocket simulating lossy network: outgoing datagrams (including ACKs and retransmissions) are dropped,
+// duplicated or delayed behind next datagram with given probabilities, generator is seeded for repeatable runs
+class LossyUdpSocket : public UdpSocket {
+  public:
+    LossyUdpSocket(double lossRate, double duplicateRate = 0.0, double reorderRate = 0.0, uint32_t seed = 1)
+        : lossRate(lossRate), duplicateRate(duplicateRate), reorderRate(reorderRate), generator(seed) {}
+    // Retransmission timer calls transmit(), it has to stop before members of this class are destroyed
+    ~LossyUdpSocket() override { close(); }
+
+    size_t getUnackedCount() const { return reliability.getUnackedCount(); }
+    uint64_t getDroppedCount() const { return dropped; }
+
+  protected:
+    ssize_t transmit(const struct iovec *iov, int iovCount, const sockaddr_in &addr) override {
+        std::lock_guard<std::mutex> lock(mutex);
+        std::vector<uint8_t> datagram;
+        for (int i = 0; i < iovCount; i++) {
+            const uint8_t *data = static_cast<const uint8_t *>(iov[i].iov_base);
+            datagram.insert(datagram.end(), data, data + iov[i].iov_len);
+        }
+
+        // Lost datagram was sent successfully from sender point of view
+        if (random() < lossRate) {
+            dropped++;
+            return datagram.size();
+        }
+        if (random() < reorderRate && delayed.empty()) {
+            delayed = datagram;
+            delayedAddr = addr;
+            return datagram.size();
+        }
+
+        ssize_t len = forward(datagram, addr);
+        if (random() < duplicateRate) {
+            forward(datagram, addr);
+        }
+        if (!delayed.empty()) {
+            forward(delayed, delayedAddr);
+            delayed.clear();
+        }
+        return len;
+    }
+
+  private:
+    double lossRate;
+    double duplicateRate;
+    double reorderRate;
+    std::mt19937 generator;
+    std::uniform_real_distribution<double> distribution{0.0, 1.0};
+    std::vector<uint8_t> delayed;
+    sockaddr_in delayedAddr{};
+    uint64_t dropped = 0;
+    std::mutex mutex;
+
+    double random() { return distribution(generator); }
+
+    ssize_t forward(std::vector<uint8_t> &datagram, const sockaddr_in &addr) {
+        struct iovec iov = {datagram.data(), datagram.size()};
+        return UdpSocket::transmit(&iov, 1, addr);
+    }
+};
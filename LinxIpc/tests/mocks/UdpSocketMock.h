@@ -10,7 +10,13 @@ class UdpSocketMock : public UdpSocket {
     MOCK_METHOD(int, joinMulticastGroup, (const std::string &multicastAddress), (override));
     MOCK_METHOD(int, setMulticastTtl, (int ttl), (override));
     MOCK_METHOD(int, setBroadcast, (bool enable), (override));
+    MOCK_METHOD(int, setReusePort, (bool enable), (override));
+    MOCK_METHOD(int, getLocalPort, (), (const, override));
     MOCK_METHOD(int, getFd, (), (const, override));
-    MOCK_METHOD(int, receive, (RawMessagePtr *msg, std::unique_ptr<IIdentifier> *from, int timeoutMs), (override));
+    MOCK_METHOD(int, getPollFd, (), (const, override));
+    MOCK_METHOD(int, receive, (RawMessagePtr *msg, std::unique_ptr<IIdentifier> *from, int timeoutMs,
+                               uint64_t *rxTimestamp), (override));
     MOCK_METHOD(int, send, (const IMessage &message, const PortInfo &to), (override));
+    MOCK_METHOD(int, setBusyPoll, (int spinUs, bool kernelBusyPoll), (override));
+    MOCK_METHOD(int, setTimestamping, (bool enable), (override));
 };
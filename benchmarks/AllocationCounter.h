@@ -0,0 +1,6 @@
+#pragma once
+
+#include <cstdint>
+
+// Number of global operator new calls made by the whole process so far
+uint64_t getAllocationCount();
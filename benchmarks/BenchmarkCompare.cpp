@@ -0,0 +1,380 @@
+// Compares linx_benchmarks JSON output (run with --benchmark_repetitions) against a baseline.
+// For every benchmark and metric the medians are compared and a two-sided Mann-Whitney U test decides
+// whether the difference is significant. A metric is reported as regression when it got worse by more
+// than the threshold and the difference is significant.
+//
+// Usage: linx_benchmark_compare <baseline.json> <current.json> [--threshold 0.05] [--alpha 0.05]
+// Exit code: 0 - no regressions, 1 - regressions found, 2 - invalid arguments or input
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <map>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace {
+
+// Minimal JSON reader, enough for Google Benchmark output
+struct JsonValue {
+    enum Type { NUL, BOOL, NUMBER, STRING, ARRAY, OBJECT } type = NUL;
+    bool boolean = false;
+    double number = 0;
+    std::string string;
+    std::vector<JsonValue> array;
+    std::map<std::string, JsonValue> object;
+
+    const JsonValue *get(const std::string &key) const {
+        auto it = object.find(key);
+        return it != object.end() ? &it->second : nullptr;
+    }
+};
+
+class JsonParser {
+  public:
+    explicit JsonParser(const std::string &text) : text(text) {}
+
+    bool parse(JsonValue *value) {
+        return parseValue(value) && (skipSpaces(), pos == text.size());
+    }
+
+  private:
+    const std::string &text;
+    size_t pos = 0;
+
+    void skipSpaces() {
+        while (pos < text.size() && isspace((unsigned char)text[pos])) {
+            pos++;
+        }
+    }
+
+    bool consume(const char *literal) {
+        size_t len = strlen(literal);
+        if (text.compare(pos, len, literal) != 0) {
+            return false;
+        }
+        pos += len;
+        return true;
+    }
+
+    bool parseValue(JsonValue *value) {
+        skipSpaces();
+        if (pos >= text.size()) {
+            return false;
+        }
+
+        char c = text[pos];
+        if (c == '{') {
+            return parseObject(value);
+        } else if (c == '[') {
+            return parseArray(value);
+        } else if (c == '"') {
+            value->type = JsonValue::STRING;
+            return parseString(&value->string);
+        } else if (consume("true")) {
+            value->type = JsonValue::BOOL;
+            value->boolean = true;
+            return true;
+        } else if (consume("false")) {
+            value->type = JsonValue::BOOL;
+            return true;
+        } else if (consume("null")) {
+            return true;
+        }
+        return parseNumber(value);
+    }
+
+    bool parseNumber(JsonValue *value) {
+        const char *start = text.c_str() + pos;
+        char *end = nullptr;
+        value->number = strtod(start, &end);
+        if (end == start) {
+            return false;
+        }
+        value->type = JsonValue::NUMBER;
+        pos += end - start;
+        return true;
+    }
+
+    bool parseString(std::string *out) {
+        pos++;
+        while (pos < text.size() && text[pos] != '"') {
+            char c = text[pos++];
+            if (c == '\\' && pos < text.size()) {
+                char escaped = text[pos++];
+                switch (escaped) {
+                    case 'n': c = '\n'; break;
+                    case 't': c = '\t'; break;
+                    case 'r': c = '\r'; break;
+                    case 'b': c = '\b'; break;
+                    case 'f': c = '\f'; break;
+                    case 'u': c = '?'; pos = std::min(pos + 4, text.size()); break;
+                    default: c = escaped; break;
+                }
+            }
+            out->push_back(c);
+        }
+        if (pos >= text.size()) {
+            return false;
+        }
+        pos++;
+        return true;
+    }
+
+    bool parseArray(JsonValue *value) {
+        value->type = JsonValue::ARRAY;
+        pos++;
+        skipSpaces();
+        if (pos < text.size() && text[pos] == ']') {
+            pos++;
+            return true;
+        }
+        while (true) {
+            value->array.emplace_back();
+            if (!parseValue(&value->array.back())) {
+                return false;
+            }
+            skipSpaces();
+            if (consume("]")) {
+                return true;
+            }
+            if (!consume(",")) {
+                return false;
+            }
+        }
+    }
+
+    bool parseObject(JsonValue *value) {
+        value->type = JsonValue::OBJECT;
+        pos++;
+        skipSpaces();
+        if (pos < text.size() && text[pos] == '}') {
+            pos++;
+            return true;
+        }
+        while (true) {
+            skipSpaces();
+            std::string key;
+            if (pos >= text.size() || text[pos] != '"' || !parseString(&key)) {
+                return false;
+            }
+            skipSpaces();
+            if (!consume(":") || !parseValue(&value->object[key])) {
+                return false;
+            }
+            skipSpaces();
+            if (consume("}")) {
+                return true;
+            }
+            if (!consume(",")) {
+                return false;
+            }
+        }
+    }
+};
+
+struct Metric {
+    const char *name;
+    bool higherIsBetter;
+};
+
+const Metric metrics[] = {
+    {"items_per_second", true},
+    {"p50_ns", false},
+    {"p99_ns", false},
+    {"allocs_per_msg", false},
+};
+
+// benchmark run name -> metric name -> samples (one per repetition)
+using Samples = std::map<std::string, std::map<std::string, std::vector<double>>>;
+
+bool loadSamples(const std::string &path, Samples *samples) {
+    std::ifstream file(path);
+    if (!file) {
+        fprintf(stderr, "Cannot open: %s\n", path.c_str());
+        return false;
+    }
+    std::stringstream content;
+    content << file.rdbuf();
+    std::string text = content.str();
+
+    JsonValue root;
+    if (!JsonParser(text).parse(&root) || root.type != JsonValue::OBJECT) {
+        fprintf(stderr, "Invalid JSON: %s\n", path.c_str());
+        return false;
+    }
+
+    const JsonValue *benchmarks = root.get("benchmarks");
+    if (benchmarks == nullptr || benchmarks->type != JsonValue::ARRAY) {
+        fprintf(stderr, "No benchmarks in: %s\n", path.c_str());
+        return false;
+    }
+
+    for (const auto &benchmark : benchmarks->array) {
+        const JsonValue *runType = benchmark.get("run_type");
+        const JsonValue *error = benchmark.get("error_occurred");
+        if ((runType && runType->string != "iteration") || (error && error->boolean)) {
+            continue;
+        }
+
+        const JsonValue *name = benchmark.get("run_name");
+        if (name == nullptr) {
+            name = benchmark.get("name");
+        }
+        if (name == nullptr) {
+            continue;
+        }
+
+        for (const auto &metric : metrics) {
+            const JsonValue *value = benchmark.get(metric.name);
+            if (value && value->type == JsonValue::NUMBER) {
+                (*samples)[name->string][metric.name].push_back(value->number);
+            }
+        }
+    }
+    return true;
+}
+
+double median(std::vector<double> values) {
+    std::sort(values.begin(), values.end());
+    size_t mid = values.size() / 2;
+    return values.size() % 2 ? values[mid] : (values[mid - 1] + values[mid]) / 2;
+}
+
+// Two-sided Mann-Whitney U test p-value, normal approximation with tie and continuity correction
+double mannWhitneyPValue(const std::vector<double> &first, const std::vector<double> &second) {
+    size_t n1 = first.size();
+    size_t n2 = second.size();
+    size_t n = n1 + n2;
+
+    std::vector<std::pair<double, int>> all;
+    for (double value : first) {
+        all.emplace_back(value, 0);
+    }
+    for (double value : second) {
+        all.emplace_back(value, 1);
+    }
+    std::sort(all.begin(), all.end());
+
+    double rankSumFirst = 0;
+    double tieCorrection = 0;
+    for (size_t i = 0; i < n;) {
+        size_t j = i;
+        while (j < n && all[j].first == all[i].first) {
+            j++;
+        }
+        double rank = (i + 1 + j) / 2.0;
+        for (size_t k = i; k < j; k++) {
+            if (all[k].second == 0) {
+                rankSumFirst += rank;
+            }
+        }
+        double ties = j - i;
+        tieCorrection += ties * ties * ties - ties;
+        i = j;
+    }
+
+    double u = rankSumFirst - n1 * (n1 + 1) / 2.0;
+    double mean = n1 * n2 / 2.0;
+    double variance = n1 * n2 / 12.0 * ((n + 1) - tieCorrection / (n * (n - 1.0)));
+    if (variance <= 0) {
+        return 1.0;
+    }
+
+    double z = (std::fabs(u - mean) - 0.5) / std::sqrt(variance);
+    return std::erfc(std::max(z, 0.0) / std::sqrt(2.0));
+}
+
+void usage(const char *program) {
+    fprintf(stderr, "Usage: %s <baseline.json> <current.json> [--threshold 0.05] [--alpha 0.05]\n", program);
+}
+
+} // namespace
+
+int main(int argc, char *argv[]) {
+    std::vector<std::string> files;
+    double threshold = 0.05;
+    double alpha = 0.05;
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--threshold") == 0 && i + 1 < argc) {
+            threshold = atof(argv[++i]);
+        } else if (strcmp(argv[i], "--alpha") == 0 && i + 1 < argc) {
+            alpha = atof(argv[++i]);
+        } else if (argv[i][0] == '-') {
+            usage(argv[0]);
+            return 2;
+        } else {
+            files.push_back(argv[i]);
+        }
+    }
+
+    if (files.size() != 2) {
+        usage(argv[0]);
+        return 2;
+    }
+
+    Samples baseline, current;
+    if (!loadSamples(files[0], &baseline) || !loadSamples(files[1], &current)) {
+        return 2;
+    }
+
+    int regressions = 0;
+    int compared = 0;
+    printf("%-70s %-17s %14s %14s %9s %8s  %s\n", "Benchmark", "Metric", "Baseline", "Current", "Change", "p-value", "Result");
+
+    for (const auto &[name, currentMetrics] : current) {
+        auto baselineIt = baseline.find(name);
+        if (baselineIt == baseline.end()) {
+            printf("%-70s %-17s %14s %14s %9s %8s  %s\n", name.c_str(), "-", "-", "-", "-", "-", "NEW");
+            continue;
+        }
+
+        for (const auto &metric : metrics) {
+            auto currentIt = currentMetrics.find(metric.name);
+            auto baseIt = baselineIt->second.find(metric.name);
+            if (currentIt == currentMetrics.end() || baseIt == baselineIt->second.end()) {
+                continue;
+            }
+
+            double before = median(baseIt->second);
+            double after = median(currentIt->second);
+            double change = before != 0 ? (after - before) / before : (after != 0 ? 1.0 : 0.0);
+            double worse = metric.higherIsBetter ? -change : change;
+
+            // Single samples can not be tested, threshold alone decides then
+            bool testable = baseIt->second.size() > 1 && currentIt->second.size() > 1;
+            double pValue = testable ? mannWhitneyPValue(baseIt->second, currentIt->second) : 0.0;
+            bool significant = !testable || pValue < alpha;
+
+            const char *result = "ok";
+            if (significant && worse > threshold) {
+                result = "REGRESSION";
+                regressions++;
+            } else if (significant && worse < -threshold) {
+                result = "improved";
+            }
+            compared++;
+
+            char pText[16];
+            snprintf(pText, sizeof(pText), testable ? "%.4f" : "n/a", pValue);
+            printf("%-70s %-17s %14.2f %14.2f %+8.1f%% %8s  %s\n",
+                   name.c_str(), metric.name, before, after, change * 100, pText, result);
+        }
+    }
+
+    for (const auto &[name, metrics] : baseline) {
+        if (current.find(name) == current.end()) {
+            printf("%-70s %-17s %14s %14s %9s %8s  %s\n", name.c_str(), "-", "-", "-", "-", "-", "MISSING");
+        }
+    }
+
+    printf("\nCompared %d metrics, threshold %.1f%%, alpha %.3f: %d regression(s)\n",
+           compared, threshold * 100, alpha, regressions);
+    return regressions ? 1 : 0;
+}
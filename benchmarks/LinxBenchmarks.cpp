@@ -0,0 +1,361 @@
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <thread>
+#include <benchmark/benchmark.h>
+#include "UnixLinx.h"
+#include "UdpLinx.h"
+#include "LinxHistogram.h"
+#include "LinxCrc32c.h"
+#include "AllocationCounter.h"
+
+namespace {
+
+constexpr uint32_t BENCH_SIG_REQ = IPC_SIG_BASE + 200;
+constexpr uint32_t BENCH_SIG_RSP = IPC_SIG_BASE + 201;
+constexpr uint32_t BENCH_SIG_NOISE = IPC_SIG_BASE + 202;
+constexpr uint16_t BENCH_BASE_PORT = 24500;
+constexpr int BENCH_TIMEOUT_MS = 1000;
+
+enum Transport { UNIX_TRANSPORT, UDP_TRANSPORT };
+enum Mode { SIMPLE_SERVER, QUEUED_SERVER, IPC_HANDLER };
+
+const char *transportNames[] = {"unix", "udp"};
+const char *modeNames[] = {"simple", "server", "handler"};
+
+// Factories are not thread safe (client name generator), creation is serialized
+std::mutex factoryMutex;
+
+// Echo server answering BENCH_SIG_REQ with BENCH_SIG_RSP carrying the same payload
+class EchoServer {
+  public:
+    EchoServer(Transport transport, Mode mode, int id, size_t queueSize = LINX_DEFAULT_QUEUE_SIZE)
+        : transport(transport) {
+        name = std::string("linx_bench_") + transportNames[transport] + "_" + modeNames[mode] + "_" + std::to_string(id);
+        port = BENCH_BASE_PORT + id;
+
+        if (mode == SIMPLE_SERVER) {
+            server = transport == UNIX_TRANSPORT ? std::static_pointer_cast<LinxServer>(AfUnixFactory::createSimpleServer(name))
+                                                 : std::static_pointer_cast<LinxServer>(UdpFactory::createSimpleServer(port));
+        } else {
+            if (transport == UNIX_TRANSPORT) {
+                auto queued = AfUnixFactory::createServer(name, queueSize);
+                metrics = [queued]() { return queued->getMetrics(); };
+                server = queued;
+            } else {
+                auto queued = UdpFactory::createServer(port, queueSize);
+                metrics = [queued]() { return queued->getMetrics(); };
+                server = queued;
+            }
+        }
+
+        if (server == nullptr) {
+            return;
+        }
+        server->start();
+        thread = std::thread(mode == IPC_HANDLER ? &EchoServer::handlerLoop : &EchoServer::receiveLoop, this);
+    }
+
+    ~EchoServer() {
+        running = false;
+        if (thread.joinable()) {
+            thread.join();
+        }
+        if (server) {
+            server->stop();
+        }
+    }
+
+    bool isValid() const {
+        return server != nullptr;
+    }
+
+    std::shared_ptr<LinxClient> createClient() const {
+        std::lock_guard<std::mutex> lock(factoryMutex);
+        if (transport == UNIX_TRANSPORT) {
+            return AfUnixFactory::createClient(name);
+        }
+        return UdpFactory::createClient("127.0.0.1", port);
+    }
+
+    // Number of messages waiting in server queue, 0 for simple server
+    uint64_t getQueueDepth() const {
+        return metrics ? metrics().queueDepth : 0;
+    }
+
+  private:
+    Transport transport;
+    std::string name;
+    uint16_t port;
+    std::shared_ptr<LinxServer> server;
+    std::function<LinxMetricsSnapshot()> metrics;
+    std::atomic<bool> running{true};
+    std::thread thread;
+
+    static RawMessage echo(const LinxReceivedMessageSharedPtr &msg) {
+        return RawMessage(BENCH_SIG_RSP, msg->message->getPayload(), msg->message->getPayloadSize());
+    }
+
+    void receiveLoop() {
+        while (running) {
+            auto msg = server->receive(100, {BENCH_SIG_REQ});
+            if (msg) {
+                server->send(echo(msg), *msg->from);
+            }
+        }
+    }
+
+    void handlerLoop() {
+        LinxIpcHandler handler(server);
+        handler.registerCallback(BENCH_SIG_REQ, [](const LinxReceivedMessageSharedPtr &msg, void *data) {
+            return msg->sendResponse(echo(msg));
+        });
+        while (running) {
+            handler.handleMessage(100);
+        }
+    }
+};
+
+// Echo servers shared by all round trip benchmarks, created on first use and kept for whole run
+EchoServer &getEchoServer(Transport transport, Mode mode) {
+    static std::mutex mutex;
+    static std::map<std::pair<int, int>, std::unique_ptr<EchoServer>> servers;
+
+    std::lock_guard<std::mutex> lock(mutex);
+    auto &server = servers[{transport, mode}];
+    if (!server) {
+        server = std::make_unique<EchoServer>(transport, mode, transport * 10 + mode);
+    }
+    return *server;
+}
+
+void roundTrip(benchmark::State &state, const EchoServer &server, size_t payloadSize) {
+    auto client = server.createClient();
+    if (client == nullptr || !client->connect(BENCH_TIMEOUT_MS)) {
+        state.SkipWithError("client cannot connect to server");
+        return;
+    }
+
+    RawMessage request(BENCH_SIG_REQ, payloadSize);
+    LinxHistogram latency;
+    uint64_t allocations = getAllocationCount();
+
+    for (auto _ : state) {
+        auto start = std::chrono::steady_clock::now();
+        auto rsp = client->sendReceive(request, BENCH_TIMEOUT_MS, {BENCH_SIG_RSP});
+        auto elapsed = std::chrono::steady_clock::now() - start;
+        if (rsp == nullptr) {
+            state.SkipWithError("response not received");
+            break;
+        }
+        latency.record(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count());
+        benchmark::DoNotOptimize(rsp);
+    }
+
+    // Allocations are counted for whole process (all clients and server) during the run
+    allocations = getAllocationCount() - allocations;
+    double messages = std::max<double>(1, state.iterations() * state.threads());
+
+    state.SetItemsProcessed(state.iterations());
+    state.SetBytesProcessed(state.iterations() * request.getSize() * 2);
+    state.counters["p50_ns"] = benchmark::Counter(latency.valueAtPercentile(50.0), benchmark::Counter::kAvgThreads);
+    state.counters["p99_ns"] = benchmark::Counter(latency.valueAtPercentile(99.0), benchmark::Counter::kAvgThreads);
+    state.counters["allocs_per_msg"] = benchmark::Counter(allocations / messages, benchmark::Counter::kAvgThreads);
+}
+
+} // namespace
+
+// Round trip latency and throughput, each benchmark thread is a separate client
+static void BM_RoundTrip(benchmark::State &state) {
+    auto transport = static_cast<Transport>(state.range(0));
+    auto mode = static_cast<Mode>(state.range(1));
+    size_t payloadSize = state.range(2);
+
+    auto &server = getEchoServer(transport, mode);
+    if (!server.isValid()) {
+        state.SkipWithError("server cannot be created");
+        return;
+    }
+
+    state.SetLabel(std::string(transportNames[transport]) + "/" + modeNames[mode]);
+    roundTrip(state, server, payloadSize);
+}
+
+BENCHMARK(BM_RoundTrip)
+    ->ArgsProduct({
+        {UNIX_TRANSPORT, UDP_TRANSPORT},
+        {SIMPLE_SERVER, QUEUED_SERVER, IPC_HANDLER},
+        {0, 64, 1024, 16 * 1024},
+    })
+    ->ArgNames({"transport", "mode", "payload"})
+    ->ThreadRange(1, 8)
+    ->UseRealTime();
+
+BENCHMARK(BM_RoundTrip)
+    ->ArgsProduct({{UNIX_TRANSPORT}, {SIMPLE_SERVER, QUEUED_SERVER, IPC_HANDLER}, {60 * 1024}})
+    ->ArgNames({"transport", "mode", "payload"})
+    ->ThreadRange(1, 8)
+    ->UseRealTime();
+
+// UDP has no flow control, 60 KB datagrams from many clients overflow default socket receive buffer
+BENCHMARK(BM_RoundTrip)
+    ->ArgsProduct({{UDP_TRANSPORT}, {SIMPLE_SERVER, QUEUED_SERVER, IPC_HANDLER}, {60 * 1024}})
+    ->ArgNames({"transport", "mode", "payload"})
+    ->Threads(1)
+    ->UseRealTime();
+
+// Cost of sigsel filtering, server queue holds given number of messages not matching consumer sigsel
+static void BM_SigselSelectivity(benchmark::State &state) {
+    auto transport = static_cast<Transport>(state.range(0));
+    size_t pending = state.range(1);
+
+    EchoServer server(transport, QUEUED_SERVER, 50 + transport * 10, pending + LINX_DEFAULT_QUEUE_SIZE);
+    if (!server.isValid()) {
+        state.SkipWithError("server cannot be created");
+        return;
+    }
+
+    // Sent in chunks so that UDP socket buffer does not overflow before worker moves messages to queue
+    static constexpr size_t chunkSize = 64;
+    auto noiseClient = server.createClient();
+    for (size_t sent = 0; sent < pending;) {
+        for (size_t i = 0; i < chunkSize && sent < pending; i++, sent++) {
+            noiseClient->send(RawMessage(BENCH_SIG_NOISE));
+        }
+
+        auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(BENCH_TIMEOUT_MS);
+        while (server.getQueueDepth() < sent && std::chrono::steady_clock::now() < deadline) {
+            std::this_thread::sleep_for(std::chrono::microseconds(100));
+        }
+        if (server.getQueueDepth() < sent) {
+            state.SkipWithError("pending messages not queued");
+            return;
+        }
+    }
+
+    state.SetLabel(std::string(transportNames[transport]) + "/server");
+    roundTrip(state, server, 0);
+}
+
+BENCHMARK(BM_SigselSelectivity)
+    ->ArgsProduct({
+        {UNIX_TRANSPORT, UDP_TRANSPORT},
+        {0, 16, 256, 1024},
+    })
+    ->ArgNames({"transport", "pending"})
+    ->UseRealTime();
+
+// One-way publishing of small messages, coalesced into containers vs one datagram per message.
+// Items are messages that reached the server, delivered is their share (UDP drops on socket buffer overflow).
+template<typename Server, typename Client>
+void publish(benchmark::State &state, const std::shared_ptr<Server> &server, const std::shared_ptr<Client> &client) {
+    bool coalesce = state.range(1) != 0;
+    size_t payloadSize = state.range(2);
+    if (!server || !client) {
+        state.SkipWithError("server cannot be created");
+        return;
+    }
+    if (coalesce) {
+        client->setCoalescing(LINX_DEFAULT_DATAGRAM_SIZE);
+    }
+
+    std::atomic<bool> running{true};
+    std::atomic<uint64_t> received{0};
+    std::thread receiver([&]() {
+        while (running) {
+            received += server->receiveBatch(64, 10).size();
+        }
+    });
+
+    RawMessage message(BENCH_SIG_REQ, std::vector<uint8_t>(payloadSize));
+    for (auto _ : state) {
+        client->send(message);
+    }
+    client->flush();
+
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(BENCH_TIMEOUT_MS);
+    while (received < (uint64_t)state.iterations() && std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    running = false;
+    receiver.join();
+
+    state.SetLabel(std::string(transportNames[state.range(0)]) + (coalesce ? "/coalesced" : "/direct"));
+    state.SetItemsProcessed(received);
+    state.counters["delivered"] = (double)received / std::max<double>(1, state.iterations());
+}
+
+static void BM_Publish(benchmark::State &state) {
+    std::lock_guard<std::mutex> lock(factoryMutex);
+    if (state.range(0) == UNIX_TRANSPORT) {
+        auto server = AfUnixFactory::createSimpleServer("linx_bench_publish");
+        publish(state, server, AfUnixFactory::createClient("linx_bench_publish"));
+    } else {
+        auto server = UdpFactory::createSimpleServer(BENCH_BASE_PORT + 90);
+        publish(state, server, UdpFactory::createClient("127.0.0.1", BENCH_BASE_PORT + 90));
+    }
+}
+
+BENCHMARK(BM_Publish)
+    ->ArgsProduct({{UNIX_TRANSPORT, UDP_TRANSPORT}, {0, 1}, {16, 64}})
+    ->ArgNames({"transport", "coalesce", "payload"})
+    ->UseRealTime();
+
+// Typed access to 4 KB payload of received message: copy into typed message vs in place view
+struct BenchTelemetry {
+    BigEndian<uint32_t> counter;
+    BigEndian<uint64_t> timestamp;
+    uint8_t samples[4096 - sizeof(uint32_t) - sizeof(uint64_t)];
+};
+
+static void BM_PayloadAccess(benchmark::State &state) {
+    bool useView = state.range(0) != 0;
+    std::vector<uint8_t> wire(sizeof(uint32_t) + sizeof(BenchTelemetry));
+    auto msg = RawMessage::deserialize(std::vector<uint8_t>(wire));
+    uint64_t allocations = getAllocationCount();
+
+    for (auto _ : state) {
+        uint64_t counter;
+        if (useView) {
+            auto view = MessageView<BenchTelemetry>::fromRawMessage(*msg);
+            counter = (*view)->counter;
+        } else {
+            auto typed = ILinxMessage<BenchTelemetry>::deserialize(wire.data(), wire.size());
+            counter = typed->getPayload()->counter;
+        }
+        benchmark::DoNotOptimize(counter);
+    }
+
+    double messages = std::max<double>(1, state.iterations());
+    state.SetLabel(useView ? "view" : "copy");
+    state.SetItemsProcessed(state.iterations());
+    state.counters["allocs_per_msg"] = (getAllocationCount() - allocations) / messages;
+}
+
+BENCHMARK(BM_PayloadAccess)->Arg(0)->Arg(1)->ArgName("view");
+
+// CRC32C of message frame, dispatched (hardware when available) vs table based implementation
+static void BM_Crc32c(benchmark::State &state) {
+    bool software = state.range(0) != 0;
+    std::vector<uint8_t> frame(state.range(1), 0x5A);
+
+    for (auto _ : state) {
+        uint32_t crc = software ? LinxCrc32c::computeSoftware(frame.data(), frame.size())
+                                : LinxCrc32c::compute(frame.data(), frame.size());
+        benchmark::DoNotOptimize(crc);
+    }
+
+    state.SetLabel(software || !LinxCrc32c::isHardwareAccelerated() ? "software" : "hardware");
+    state.SetBytesProcessed(state.iterations() * frame.size());
+    state.counters["ns_per_byte"] = benchmark::Counter(state.iterations() * frame.size(),
+                                                       benchmark::Counter::kIsRate | benchmark::Counter::kInvert);
+}
+
+BENCHMARK(BM_Crc32c)
+    ->ArgsProduct({{0, 1}, {64, 1500, 65536}})
+    ->ArgNames({"software", "bytes"});
+
+BENCHMARK_MAIN();
@@ -0,0 +1,103 @@
+#!/bin/bash
+# LinxIpc Performance Regression Check
+# Builds and runs linx_benchmarks with repetitions and compares results against stored baseline
+
+set -e
+
+PROJECT_ROOT=$(cd "$(dirname "$0")/.." && pwd)
+
+# Default values
+BASELINE="$PROJECT_ROOT/benchmarks/baseline.json"
+BUILD_DIR="$PROJECT_ROOT/build_bench"
+REPETITIONS=10
+FILTER="."
+THRESHOLD=0.05
+ALPHA=0.05
+UPDATE_BASELINE=0
+
+# Usage function
+usage() {
+    echo "Usage: $0 [-b baseline] [-r repetitions] [-f filter] [-t threshold] [-a alpha] [-u] [-h]"
+    echo ""
+    echo "Options:"
+    echo "  -b BASELINE     Baseline JSON file (default: benchmarks/baseline.json)"
+    echo "  -r REPETITIONS  Repetitions of every benchmark (default: 10)"
+    echo "  -f FILTER       Benchmark filter regex (default: all)"
+    echo "  -t THRESHOLD    Relative change reported as regression (default: 0.05)"
+    echo "  -a ALPHA        Significance level of Mann-Whitney U test (default: 0.05)"
+    echo "  -u              Store current results as new baseline instead of comparing"
+    echo "  -h              Show this help message"
+    echo ""
+    echo "Examples:"
+    echo "  $0 -u                             # Record baseline on this machine"
+    echo "  $0                                # Compare against recorded baseline"
+    echo "  $0 -f 'BM_RoundTrip/transport:0' -r 5"
+    exit 2
+}
+
+# Parse arguments using getopts
+while getopts "b:r:f:t:a:uh" opt; do
+    case $opt in
+        b)
+            BASELINE="$OPTARG"
+            ;;
+        r)
+            REPETITIONS="$OPTARG"
+            ;;
+        f)
+            FILTER="$OPTARG"
+            ;;
+        t)
+            THRESHOLD="$OPTARG"
+            ;;
+        a)
+            ALPHA="$OPTARG"
+            ;;
+        u)
+            UPDATE_BASELINE=1
+            ;;
+        h)
+            usage
+            ;;
+        \?)
+            echo "Invalid option: -$OPTARG" >&2
+            usage
+            ;;
+        :)
+            echo "Option -$OPTARG requires an argument." >&2
+            usage
+            ;;
+    esac
+done
+
+if [ "$UPDATE_BASELINE" -eq 0 ] && [ ! -f "$BASELINE" ]; then
+    echo "Baseline not found: $BASELINE" >&2
+    echo "Record one on this machine with: $0 -u" >&2
+    exit 2
+fi
+
+echo "Building benchmarks..."
+cd "$PROJECT_ROOT"
+cmake --preset bench > /dev/null
+cmake --build "$BUILD_DIR" --target linx_benchmarks linx_benchmark_compare
+
+BIN_DIR="$BUILD_DIR/output/bin"
+RESULT=$(mktemp --suffix=.json)
+trap 'rm -f "$RESULT"' EXIT
+
+echo "Running benchmarks ($REPETITIONS repetitions)..."
+"$BIN_DIR/linx_benchmarks" \
+    --benchmark_filter="$FILTER" \
+    --benchmark_repetitions="$REPETITIONS" \
+    --benchmark_report_aggregates_only=false \
+    --benchmark_out="$RESULT" \
+    --benchmark_out_format=json
+
+if [ "$UPDATE_BASELINE" -eq 1 ]; then
+    cp "$RESULT" "$BASELINE"
+    echo "Baseline stored in $BASELINE"
+    exit 0
+fi
+
+echo ""
+"$BIN_DIR/linx_benchmark_compare" "$BASELINE" "$RESULT" --threshold "$THRESHOLD" --alpha "$ALPHA"
@@ -163,8 +163,12 @@ if(UNIT_TESTS)
 else()
     message(STATUS "     TARGET: PROD")
 endif()
+if(BENCHMARKS)
+    message(STATUS "     BENCHMARKS: ON")
+endif()
 message(STATUS "#################################")
 
 add_option(VAR TRACE_LEVEL)
 add_option(VAR UNIT_TESTS)
+add_option(VAR BENCHMARKS)
 determine_project_version()
\ No newline at end of file
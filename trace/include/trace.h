@@ -11,6 +11,8 @@
 #define SEVERITY_INFO 3
 #define SEVERITY_DEBUG 4
 
+#include <stdio.h>
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -19,6 +21,28 @@ void trace_debug(const char *fileName, int lineNum, const char *format, ...);
 void trace_info(const char *fileName, int lineNum, const char *format, ...);
 void trace_warning(const char *fileName, int lineNum, const char *format, ...);
 void trace_error(const char *fileName, int lineNum, const char *format, ...);
+// Writes record without checking LOG_LEVEL, for callers filtering by their own levels
+void trace_log(int severity, const char *fileName, int lineNum, const char *format, ...);
+
+// Asynchronous backend: calling thread only copies arguments into its own lock-free ring, background thread
+// formats records and writes them to syslog (filePath NULL) or appends to file. When ring is full record is
+// dropped and counted instead of blocking caller. File name and format must be string literals.
+// Started by trace_init() when LOG_ASYNC=1 (LOG_FILE selects file), returns -1 if running, -2 if file cannot be opened
+int trace_start_async(const char *filePath);
+// Writes all pending records and stops background thread, following records are logged synchronously
+void trace_stop_async();
+// Blocks until records logged before the call are written
+void trace_flush();
+unsigned long trace_dropped();
+
+// Binary logging: records store format ID and raw arguments in memory mapped ring file (sizeBytes, 0 - 16 MB),
+// text is rendered offline by trace_decode. Oldest records are overwritten when ring is full. Takes precedence
+// over other backends. Started by trace_init() when LOG_BINARY=<file> is set (LOG_BINARY_SIZE selects size).
+// Returns -1 if running, -2 if file cannot be created or mapped, -3 if size is too small
+int trace_start_binary(const char *filePath, unsigned long sizeBytes);
+void trace_stop_binary();
+// Writes records of binary log file as text, returns number of records or -1 if file cannot be opened, -2 if invalid
+long trace_decode_binary(const char *filePath, FILE *output);
 
 #ifdef __cplusplus
 }
@@ -1,3 +1,4 @@
+#include <atomic>
 #include <cstdarg>
 #include <cstdio>
 #include <cstdlib>
@@ -5,6 +6,8 @@
 #include <syslog.h>
 #include <unordered_map>
 #include "trace.h"
+#include "traceAsync.h"
+#include "traceBinary.h"
 #include <sys/syscall.h>
 #include <unistd.h>
 
@@ -15,8 +18,18 @@ static const std::unordered_map<int, int> severityMap{{SEVERITY_DEBUG, LOG_DEBUG
                                                       {SEVERITY_WARNING, LOG_WARNING},
                                                       {SEVERITY_ERROR, LOG_ERR}};
 
+static std::atomic<int> traceSeverity{TRACE_LEVEL > 0 ? TRACE_LEVEL : SEVERITY_DEBUG};
+
 static void vtrace(int severity, const char *fileName, int lineNum, const char *format, va_list argptr) {
 
+    if (trace_binary_log(severity, fileName, lineNum, format, argptr)) {
+        return;
+    }
+
+    if (trace_async_log(severity, fileName, lineNum, format, argptr)) {
+        return;
+    }
+
     pid_t tid = syscall(SYS_gettid);
 
     char formatBuffer[1000];
@@ -27,6 +40,10 @@ static void vtrace(int severity, const char *fileName, int lineNum, const char *
     vsyslog(severityMap.at(severity), formatBuffer, argptr);
 }
 
+static bool isEnabled(int severity) {
+    return severity <= traceSeverity.load(std::memory_order_relaxed);
+}
+
 void trace_init() {
     int defaultSeverity = TRACE_LEVEL;
     openlog( NULL, LOG_CONS | LOG_PID | LOG_NDELAY, LOG_USER );
@@ -39,15 +56,33 @@ void trace_init() {
         }
     }
 
-    setlogmask( LOG_UPTO( severityMap.at( defaultSeverity ) ) );
+    traceSeverity = defaultSeverity;
+
+    if (const char* env_binary = std::getenv( "LOG_BINARY" )) {
+        const char* env_size = std::getenv( "LOG_BINARY_SIZE" );
+        trace_start_binary( env_binary, env_size ? strtoul( env_size, NULL, 0 ) : 0 );
+    }
+
+    if (const char* env_async = std::getenv( "LOG_ASYNC" )) {
+        if (atoi( env_async ) == 1) {
+            trace_start_async( std::getenv( "LOG_FILE" ) );
+        }
+    }
+
     TRACE_INFO( "Set LOG_LEVEL: %d", defaultSeverity );
 }
 
 void trace_close() {
+    trace_stop_binary();
+    trace_stop_async();
     closelog();
 }
 
 void trace_error(const char *fileName, int lineNum, const char *format, ...) {
+    if (!isEnabled(SEVERITY_ERROR)) {
+        return;
+    }
+
     va_list argptr;
     va_start(argptr, format);
     vtrace(SEVERITY_ERROR, fileName, lineNum, format, argptr);
@@ -55,6 +90,10 @@ void trace_error(const char *fileName, int lineNum, const char *format, ...) {
 }
 
 void trace_warning(const char *fileName, int lineNum, const char *format, ...) {
+    if (!isEnabled(SEVERITY_WARNING)) {
+        return;
+    }
+
     va_list argptr;
     va_start(argptr, format);
     vtrace(SEVERITY_WARNING, fileName, lineNum, format, argptr);
@@ -62,6 +101,10 @@ void trace_warning(const char *fileName, int lineNum, const char *format, ...) {
 }
 
 void trace_info(const char *fileName, int lineNum, const char *format, ...) {
+    if (!isEnabled(SEVERITY_INFO)) {
+        return;
+    }
+
     va_list argptr;
     va_start(argptr, format);
     vtrace(SEVERITY_INFO, fileName, lineNum, format, argptr);
@@ -69,10 +112,25 @@ void trace_info(const char *fileName, int lineNum, const char *format, ...) {
 }
 
 void trace_debug(const char *fileName, int lineNum, const char *format, ...) {
+    if (!isEnabled(SEVERITY_DEBUG)) {
+        return;
+    }
+
     va_list argptr;
     va_start(argptr, format);
     vtrace(SEVERITY_DEBUG, fileName, lineNum, format, argptr);
     va_end(argptr);
 }
 
+void trace_log(int severity, const char *fileName, int lineNum, const char *format, ...) {
+    if (severityMap.find(severity) == severityMap.end()) {
+        return;
+    }
+
+    va_list argptr;
+    va_start(argptr, format);
+    vtrace(severity, fileName, lineNum, format, argptr);
+    va_end(argptr);
+}
+
 //LCOV_EXCL_STOP
@@ -0,0 +1,343 @@
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <syslog.h>
+#include <thread>
+#include <vector>
+#include "trace.h"
+#include "traceAsync.h"
+#include "traceFormat.h"
+
+//LCOV_EXCL_START
+
+namespace {
+
+constexpr size_t ringSize = 256;
+constexpr size_t argsCapacity = 400;
+constexpr auto idleSleep = std::chrono::milliseconds(1);
+
+// Record holds raw arguments only, file and format must be string literals (as passed by TRACE_* macros)
+struct TraceRecord {
+    uint64_t timestampNs;
+    const char *file;
+    const char *format;
+    int32_t line;
+    int32_t tid;
+    int32_t severity;
+    uint16_t argsSize;
+    uint8_t args[argsCapacity];
+};
+
+// Single producer (owning thread), single consumer (backend thread)
+class TraceRing {
+  public:
+    TraceRecord *reserve() {
+        uint64_t current = head.load(std::memory_order_relaxed);
+        if (current - tail.load(std::memory_order_acquire) == ringSize) {
+            return nullptr;
+        }
+        return &slots[current % ringSize];
+    }
+
+    void commit() {
+        head.store(head.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+    }
+
+    const TraceRecord *front() const {
+        uint64_t current = tail.load(std::memory_order_relaxed);
+        if (current == head.load(std::memory_order_acquire)) {
+            return nullptr;
+        }
+        return &slots[current % ringSize];
+    }
+
+    void pop() {
+        tail.store(tail.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+    }
+
+    // Set when owning thread exits, backend drops ring once drained
+    std::atomic<bool> orphaned{false};
+
+  private:
+    alignas(64) std::atomic<uint64_t> head{0};
+    alignas(64) std::atomic<uint64_t> tail{0};
+    TraceRecord slots[ringSize];
+};
+
+class TraceBackend {
+  public:
+    ~TraceBackend() {
+        stop();
+    }
+
+    int start(const char *filePath) {
+        std::lock_guard<std::mutex> lock(controlMutex);
+        if (running.load()) {
+            return -1;
+        }
+
+        if (filePath != nullptr) {
+            output = fopen(filePath, "a");
+            if (output == nullptr) {
+                return -2;
+            }
+        }
+
+        stopRequested = false;
+        thread = std::thread(&TraceBackend::run, this);
+        running.store(true, std::memory_order_release);
+        return 0;
+    }
+
+    void stop() {
+        std::lock_guard<std::mutex> lock(controlMutex);
+        if (!running.load()) {
+            return;
+        }
+
+        // New records are refused first, records already being written are committed before final drain
+        running.store(false);
+        while (writers.load() != 0) {
+            std::this_thread::yield();
+        }
+        {
+            std::lock_guard<std::mutex> passLock(passMutex);
+            stopRequested = true;
+        }
+        thread.join();
+
+        if (output != nullptr) {
+            fclose(output);
+            output = nullptr;
+        }
+    }
+
+    void flush() {
+        if (!running.load(std::memory_order_acquire)) {
+            return;
+        }
+
+        // Two passes guarantee that one complete drain started after records were committed
+        std::unique_lock<std::mutex> lock(passMutex);
+        uint64_t target = passes + 2;
+        passCondition.wait(lock, [&]() { return passes >= target || stopRequested; });
+    }
+
+    bool isRunning() const {
+        return running.load(std::memory_order_acquire);
+    }
+
+    // Commit barrier: producer writes record between successful beginWrite() and endWrite(), stop() waits
+    // for such writes before final drain
+    bool beginWrite() {
+        writers.fetch_add(1);
+        if (!running.load()) {
+            writers.fetch_sub(1, std::memory_order_release);
+            return false;
+        }
+        return true;
+    }
+
+    void endWrite() {
+        writers.fetch_sub(1, std::memory_order_release);
+    }
+
+    uint64_t getDropped() const {
+        return dropped.load(std::memory_order_relaxed);
+    }
+
+    void onDropped() {
+        dropped.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    std::shared_ptr<TraceRing> registerRing() {
+        auto ring = std::make_shared<TraceRing>();
+        std::lock_guard<std::mutex> lock(ringsMutex);
+        rings.push_back(ring);
+        return ring;
+    }
+
+  private:
+    std::mutex controlMutex;
+    std::atomic<bool> running{false};
+    std::atomic<int> writers{0};
+    std::thread thread;
+    FILE *output = nullptr;
+
+    std::mutex ringsMutex;
+    std::vector<std::shared_ptr<TraceRing>> rings;
+
+    std::mutex passMutex;
+    std::condition_variable passCondition;
+    uint64_t passes = 0;
+    bool stopRequested = false;
+
+    std::atomic<uint64_t> dropped{0};
+    uint64_t reportedDropped = 0;
+
+    void run() {
+        while (true) {
+            bool stopping;
+            {
+                std::lock_guard<std::mutex> lock(passMutex);
+                stopping = stopRequested;
+            }
+
+            // Final pass drains until all rings are empty, not only up to ring size
+            size_t drained = drain();
+            while (stopping && drained != 0) {
+                drained = drain();
+            }
+            {
+                std::lock_guard<std::mutex> lock(passMutex);
+                passes++;
+            }
+            passCondition.notify_all();
+
+            if (stopping) {
+                break;
+            }
+            if (drained == 0) {
+                std::this_thread::sleep_for(idleSleep);
+            }
+        }
+    }
+
+    size_t drain() {
+        std::vector<std::shared_ptr<TraceRing>> snapshot;
+        {
+            std::lock_guard<std::mutex> lock(ringsMutex);
+            snapshot = rings;
+        }
+
+        std::vector<std::pair<uint64_t, std::pair<int, std::string>>> lines;
+        for (auto &ring : snapshot) {
+            // Records are taken up to ring size so that busy producer can not starve others
+            for (size_t i = 0; i < ringSize; i++) {
+                const TraceRecord *record = ring->front();
+                if (record == nullptr) {
+                    break;
+                }
+                lines.emplace_back(record->timestampNs, std::make_pair(record->severity, format(*record)));
+                ring->pop();
+            }
+        }
+
+        // Merge records of all threads in time order
+        std::stable_sort(lines.begin(), lines.end(),
+                         [](const auto &a, const auto &b) { return a.first < b.first; });
+        for (const auto &[timestamp, line] : lines) {
+            emit(timestamp, line.first, line.second);
+        }
+
+        uint64_t droppedNow = getDropped();
+        if (droppedNow != reportedDropped) {
+            std::string message = "trace: dropped " + std::to_string(droppedNow - reportedDropped) + " records";
+            reportedDropped = droppedNow;
+            emit(lines.empty() ? 0 : lines.back().first, SEVERITY_WARNING, message);
+        }
+
+        if (output != nullptr) {
+            fflush(output);
+        }
+
+        std::lock_guard<std::mutex> lock(ringsMutex);
+        rings.erase(std::remove_if(rings.begin(), rings.end(),
+                                   [](const auto &ring) { return ring->orphaned.load() && ring->front() == nullptr; }),
+                    rings.end());
+        return lines.size();
+    }
+
+    void emit(uint64_t timestampNs, int severity, const std::string &line) {
+        static const int priorities[] = {LOG_ERR, LOG_ERR, LOG_WARNING, LOG_INFO, LOG_DEBUG};
+        severity = std::clamp(severity, SEVERITY_ERROR, SEVERITY_DEBUG);
+
+        if (output == nullptr) {
+            syslog(priorities[severity], "%s", line.c_str());
+            return;
+        }
+
+        timestampNs = timestampNs ? timestampNs : traceRealtimeNs();
+        fprintf(output, "%s %s\n", traceTimeAndSeverity(timestampNs, severity).c_str(), line.c_str());
+    }
+
+    static std::string format(const TraceRecord &record) {
+        return tracePrefix(record.tid, record.file, record.line) +
+               traceDecodeArgs(record.format, record.args, record.argsSize);
+    }
+};
+
+TraceBackend backend;
+
+// Ring of calling thread, created on first record and released by backend after thread exit
+class ThreadRing {
+  public:
+    ~ThreadRing() {
+        if (ring) {
+            ring->orphaned.store(true);
+        }
+    }
+
+    TraceRing *get() {
+        if (!ring) {
+            ring = backend.registerRing();
+        }
+        return ring.get();
+    }
+
+  private:
+    std::shared_ptr<TraceRing> ring;
+};
+
+thread_local ThreadRing threadRing;
+
+} // namespace
+
+bool trace_async_log(int severity, const char *fileName, int lineNum, const char *format, va_list argptr) {
+    if (!backend.beginWrite()) {
+        return false;
+    }
+
+    TraceRing *ring = threadRing.get();
+    TraceRecord *record = ring->reserve();
+    if (record == nullptr) {
+        // Logging must not slow down overloaded caller, record is lost and reported later
+        backend.onDropped();
+        backend.endWrite();
+        return true;
+    }
+
+    record->timestampNs = traceRealtimeNs();
+    record->file = fileName;
+    record->format = format;
+    record->line = lineNum;
+    record->tid = traceThreadId();
+    record->severity = severity;
+    record->argsSize = traceEncodeArgs(record->args, argsCapacity, format, argptr);
+    ring->commit();
+    backend.endWrite();
+    return true;
+}
+
+int trace_start_async(const char *filePath) {
+    return backend.start(filePath);
+}
+
+void trace_stop_async() {
+    backend.stop();
+}
+
+void trace_flush() {
+    backend.flush();
+}
+
+unsigned long trace_dropped() {
+    return backend.getDropped();
+}
+
+//LCOV_EXCL_STOP
@@ -0,0 +1,7 @@
+#pragma once
+
+#include <cstdarg>
+
+// Asynchronous trace backend, see trace_start_async() in trace.h
+// Returns false when backend is not running and record has to be written synchronously
+bool trace_async_log(int severity, const char *fileName, int lineNum, const char *format, va_list argptr);
@@ -0,0 +1,308 @@
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <map>
+#include <mutex>
+#include <new>
+#include <string>
+#include <thread>
+#include <vector>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "trace.h"
+#include "traceBinary.h"
+#include "traceFormat.h"
+
+//LCOV_EXCL_START
+
+using namespace traceBinary;
+
+namespace {
+
+constexpr size_t formatIndexSize = 4096;
+
+// Lock-free lookup of format IDs, entries are only added (under mutex) while binary log is active
+struct FormatIndexEntry {
+    std::atomic<const char *> format{nullptr};
+    const char *file = nullptr;
+    int line = 0;
+    uint32_t id = 0;
+};
+
+class BinaryLog {
+  public:
+    ~BinaryLog() {
+        stop();
+    }
+
+    int start(const char *filePath, uint64_t fileSize) {
+        std::lock_guard<std::mutex> lock(controlMutex);
+        if (header != nullptr) {
+            return -1;
+        }
+
+        fileSize = fileSize ? fileSize : defaultFileSize;
+        if (filePath == nullptr || fileSize < headerSize + formatsCapacity + 16 * slotSize) {
+            return -3;
+        }
+
+        int fd = open(filePath, O_RDWR | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+        if (fd < 0) {
+            return -2;
+        }
+
+        // Pages are populated upfront so that page faults do not hit logging threads
+        void *memory = MAP_FAILED;
+        if (ftruncate(fd, fileSize) == 0) {
+            memory = mmap(nullptr, fileSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, fd, 0);
+        }
+        close(fd);
+        if (memory == MAP_FAILED) {
+            return -2;
+        }
+
+        mappedSize = fileSize;
+        base = static_cast<uint8_t *>(memory);
+        auto *fileHeader = new (memory) FileHeader{};
+        memcpy(fileHeader->magic, magic, sizeof(magic));
+        fileHeader->version = version;
+        fileHeader->slotSize = slotSize;
+        fileHeader->formatsOffset = headerSize;
+        fileHeader->formatsCapacity = formatsCapacity;
+        fileHeader->slotsOffset = headerSize + formatsCapacity;
+        fileHeader->slotCount = (fileSize - fileHeader->slotsOffset) / slotSize;
+
+        for (auto &entry : formatIndex) {
+            entry.format.store(nullptr, std::memory_order_relaxed);
+        }
+        nextId = 1;
+
+        header = fileHeader;
+        active.store(true, std::memory_order_release);
+        return 0;
+    }
+
+    void stop() {
+        std::lock_guard<std::mutex> lock(controlMutex);
+        if (header == nullptr) {
+            return;
+        }
+
+        // Writers check active flag after announcing themselves, mapping is released once all left
+        active.store(false, std::memory_order_seq_cst);
+        while (writers.load(std::memory_order_seq_cst) != 0) {
+            std::this_thread::yield();
+        }
+
+        msync(base, mappedSize, MS_SYNC);
+        munmap(base, mappedSize);
+        header = nullptr;
+        base = nullptr;
+    }
+
+    bool log(int severity, const char *fileName, int lineNum, const char *format, va_list argptr) {
+        if (!active.load(std::memory_order_acquire)) {
+            return false;
+        }
+
+        writers.fetch_add(1, std::memory_order_seq_cst);
+        if (!active.load(std::memory_order_seq_cst)) {
+            writers.fetch_sub(1, std::memory_order_release);
+            return false;
+        }
+
+        uint32_t id = getFormatId(fileName, lineNum, format);
+        if (id == 0) {
+            header->dropped.fetch_add(1, std::memory_order_relaxed);
+        } else {
+            uint64_t sequence = header->nextSequence.fetch_add(1, std::memory_order_relaxed) + 1;
+            Slot *slot = reinterpret_cast<Slot *>(base + header->slotsOffset) + (sequence - 1) % header->slotCount;
+
+            slot->sequence.store(0, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_release);
+            slot->timestampNs = traceRealtimeNs();
+            slot->formatId = id;
+            slot->tid = traceThreadId();
+            slot->severity = severity;
+            slot->argsSize = traceEncodeArgs(slot->args, sizeof(slot->args), format, argptr);
+            slot->sequence.store(sequence, std::memory_order_release);
+        }
+
+        writers.fetch_sub(1, std::memory_order_release);
+        return true;
+    }
+
+  private:
+    std::mutex controlMutex;
+    std::atomic<bool> active{false};
+    std::atomic<int> writers{0};
+    FileHeader *header = nullptr;
+    uint8_t *base = nullptr;
+    uint64_t mappedSize = 0;
+
+    std::mutex formatMutex;
+    FormatIndexEntry formatIndex[formatIndexSize];
+    uint32_t nextId = 1;
+
+    static size_t hash(const char *format, int line) {
+        return (reinterpret_cast<uintptr_t>(format) >> 3) * 31 + line;
+    }
+
+    // Returns 0 when format table is full
+    uint32_t getFormatId(const char *fileName, int lineNum, const char *format) {
+        size_t start = hash(format, lineNum);
+        for (size_t i = 0; i < formatIndexSize; i++) {
+            auto &entry = formatIndex[(start + i) % formatIndexSize];
+            const char *known = entry.format.load(std::memory_order_acquire);
+            if (known == nullptr) {
+                return addFormat(fileName, lineNum, format);
+            }
+            if (known == format && entry.line == lineNum && entry.file == fileName) {
+                return entry.id;
+            }
+        }
+        return 0;
+    }
+
+    uint32_t addFormat(const char *fileName, int lineNum, const char *format) {
+        std::lock_guard<std::mutex> lock(formatMutex);
+
+        size_t start = hash(format, lineNum);
+        for (size_t i = 0; i < formatIndexSize; i++) {
+            auto &entry = formatIndex[(start + i) % formatIndexSize];
+            const char *known = entry.format.load(std::memory_order_relaxed);
+            if (known == format && entry.line == lineNum && entry.file == fileName) {
+                return entry.id;
+            }
+            if (known != nullptr) {
+                continue;
+            }
+
+            size_t fileLength = std::min<size_t>(strlen(fileName), UINT16_MAX);
+            size_t formatLength = std::min<size_t>(strlen(format), UINT16_MAX);
+            uint64_t used = header->formatsUsed.load(std::memory_order_relaxed);
+            uint64_t size = sizeof(FormatEntry) + fileLength + formatLength;
+            if (used + size > header->formatsCapacity) {
+                return 0;
+            }
+
+            uint8_t *out = base + header->formatsOffset + used;
+            FormatEntry formatEntry{nextId, lineNum, (uint16_t)fileLength, (uint16_t)formatLength};
+            memcpy(out, &formatEntry, sizeof(formatEntry));
+            memcpy(out + sizeof(formatEntry), fileName, fileLength);
+            memcpy(out + sizeof(formatEntry) + fileLength, format, formatLength);
+            header->formatsUsed.store(used + size, std::memory_order_release);
+
+            entry.file = fileName;
+            entry.line = lineNum;
+            entry.id = nextId++;
+            entry.format.store(format, std::memory_order_release);
+            return entry.id;
+        }
+        return 0;
+    }
+};
+
+BinaryLog binaryLog;
+
+struct DecodedFormat {
+    std::string file;
+    int line;
+    std::string format;
+};
+
+} // namespace
+
+bool trace_binary_log(int severity, const char *fileName, int lineNum, const char *format, va_list argptr) {
+    return binaryLog.log(severity, fileName, lineNum, format, argptr);
+}
+
+int trace_start_binary(const char *filePath, unsigned long sizeBytes) {
+    return binaryLog.start(filePath, sizeBytes);
+}
+
+void trace_stop_binary() {
+    binaryLog.stop();
+}
+
+long trace_decode_binary(const char *filePath, FILE *output) {
+    int fd = open(filePath, O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        return -1;
+    }
+
+    struct stat fileStat;
+    if (fstat(fd, &fileStat) != 0 || (uint64_t)fileStat.st_size < headerSize) {
+        close(fd);
+        return -2;
+    }
+
+    uint64_t fileSize = fileStat.st_size;
+    void *memory = mmap(nullptr, fileSize, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (memory == MAP_FAILED) {
+        return -2;
+    }
+
+    const uint8_t *base = static_cast<const uint8_t *>(memory);
+    const auto *fileHeader = static_cast<const FileHeader *>(memory);
+    uint64_t formatsUsed = fileHeader->formatsUsed.load();
+    if (memcmp(fileHeader->magic, magic, sizeof(magic)) != 0 || fileHeader->version != version ||
+        fileHeader->slotSize != slotSize || fileHeader->formatsOffset < sizeof(FileHeader) ||
+        formatsUsed > fileHeader->formatsCapacity ||
+        fileHeader->formatsOffset + fileHeader->formatsCapacity > fileHeader->slotsOffset ||
+        fileHeader->slotsOffset > fileSize || fileHeader->slotCount > (fileSize - fileHeader->slotsOffset) / slotSize) {
+        munmap(memory, fileSize);
+        return -2;
+    }
+
+    std::map<uint32_t, DecodedFormat> formats;
+    for (uint64_t offset = 0; offset + sizeof(FormatEntry) <= formatsUsed;) {
+        FormatEntry entry;
+        memcpy(&entry, base + fileHeader->formatsOffset + offset, sizeof(entry));
+        offset += sizeof(entry);
+        if (offset + entry.fileLength + entry.formatLength > formatsUsed) {
+            break;
+        }
+        const char *text = reinterpret_cast<const char *>(base + fileHeader->formatsOffset + offset);
+        formats[entry.id] = {std::string(text, entry.fileLength), entry.line,
+                             std::string(text + entry.fileLength, entry.formatLength)};
+        offset += entry.fileLength + entry.formatLength;
+    }
+
+    const Slot *slots = reinterpret_cast<const Slot *>(base + fileHeader->slotsOffset);
+    std::vector<const Slot *> records;
+    for (uint64_t i = 0; i < fileHeader->slotCount; i++) {
+        if (slots[i].sequence.load() != 0) {
+            records.push_back(&slots[i]);
+        }
+    }
+    std::sort(records.begin(), records.end(),
+              [](const Slot *a, const Slot *b) { return a->sequence.load() < b->sequence.load(); });
+
+    long decoded = 0;
+    for (const Slot *slot : records) {
+        auto format = formats.find(slot->formatId);
+        if (format == formats.end()) {
+            continue;
+        }
+        std::string text = traceDecodeArgs(format->second.format.c_str(), slot->args,
+                                           std::min<size_t>(slot->argsSize, sizeof(slot->args)));
+        fprintf(output, "%s %s%s\n", traceTimeAndSeverity(slot->timestampNs, slot->severity).c_str(),
+                tracePrefix(slot->tid, format->second.file.c_str(), format->second.line).c_str(), text.c_str());
+        decoded++;
+    }
+
+    uint64_t overwritten = fileHeader->nextSequence.load() - records.size();
+    if (overwritten != 0 || fileHeader->dropped.load() != 0) {
+        fprintf(output, "# %llu records overwritten, %llu dropped (format table full)\n",
+                (unsigned long long)overwritten, (unsigned long long)fileHeader->dropped.load());
+    }
+
+    munmap(memory, fileSize);
+    return decoded;
+}
+
+//LCOV_EXCL_STOP
@@ -0,0 +1,57 @@
+#pragma once
+
+#include <atomic>
+#include <cstdarg>
+#include <cstdint>
+
+// Binary trace file: header, table of format strings and ring of fixed size records holding format ID and raw
+// arguments (see traceFormat.h). Oldest records are overwritten when ring wraps, format table is append only.
+namespace traceBinary {
+
+constexpr char magic[8] = {'L', 'X', 'T', 'R', 'A', 'C', 'E', 'B'};
+constexpr uint32_t version = 1;
+constexpr uint32_t slotSize = 256;
+constexpr uint64_t headerSize = 4096;
+constexpr uint64_t formatsCapacity = 256 * 1024;
+constexpr uint64_t defaultFileSize = 16 * 1024 * 1024;
+
+struct FileHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t slotSize;
+    uint64_t formatsOffset;
+    uint64_t formatsCapacity;
+    uint64_t slotsOffset;
+    uint64_t slotCount;
+    std::atomic<uint64_t> formatsUsed;
+    std::atomic<uint64_t> nextSequence;
+    // Records lost because format table is full
+    std::atomic<uint64_t> dropped;
+};
+
+// Followed by file name and format, not NUL terminated
+struct FormatEntry {
+    uint32_t id;
+    int32_t line;
+    uint16_t fileLength;
+    uint16_t formatLength;
+};
+
+struct Slot {
+    // 0 while slot is written, sequence number of record otherwise
+    std::atomic<uint64_t> sequence;
+    uint64_t timestampNs;
+    uint32_t formatId;
+    int32_t tid;
+    uint16_t severity;
+    uint16_t argsSize;
+    uint8_t args[slotSize - 28];
+};
+
+static_assert(sizeof(FileHeader) <= headerSize);
+static_assert(sizeof(Slot) == slotSize);
+
+} // namespace traceBinary
+
+// Returns false when binary log is not active and record has to be written by other backend
+bool trace_binary_log(int severity, const char *fileName, int lineNum, const char *format, va_list argptr);
@@ -0,0 +1,377 @@
+#include <algorithm>
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <ctime>
+#include <sys/syscall.h>
+#include <sys/types.h>
+#include <unistd.h>
+#include "trace.h"
+#include "traceFormat.h"
+
+//LCOV_EXCL_START
+
+namespace {
+
+constexpr size_t lineCapacity = 1024;
+
+enum Length { NONE, CHAR, SHORT, LONG, LONG_LONG, INTMAX, SIZE, PTRDIFF, LONG_DOUBLE };
+
+// Conversion specification, shared by encoding and decoding so both walk arguments identically
+struct FormatSpec {
+    // Flags, width and precision as written in format, without leading '%'
+    const char *modifiers;
+    size_t modifiersLength;
+    const char *end;
+    bool widthStar = false;
+    bool precisionStar = false;
+    Length length = NONE;
+    char conversion = 0;
+};
+
+Length parseLength(const char *begin, const char *end) {
+    switch (end - begin) {
+        case 0:
+            return NONE;
+        case 1:
+            switch (*begin) {
+                case 'h': return SHORT;
+                case 'l': return LONG;
+                case 'q': return LONG_LONG;
+                case 'j': return INTMAX;
+                case 'z': return SIZE;
+                case 't': return PTRDIFF;
+                case 'L': return LONG_DOUBLE;
+            }
+            return NONE;
+        default:
+            return begin[0] == 'h' ? CHAR : LONG_LONG;
+    }
+}
+
+bool isSigned(char conversion) {
+    return conversion == 'd' || conversion == 'i';
+}
+
+bool isInteger(char conversion) {
+    switch (conversion) {
+        case 'd': case 'i': case 'o': case 'u': case 'x': case 'X': case 'c':
+            return true;
+    }
+    return false;
+}
+
+bool isFloat(char conversion) {
+    switch (conversion) {
+        case 'f': case 'F': case 'e': case 'E': case 'g': case 'G': case 'a': case 'A':
+            return true;
+    }
+    return false;
+}
+
+// Parses specification starting at '%', returns false on unsupported conversion
+bool parseSpec(const char *p, FormatSpec *spec) {
+    spec->modifiers = ++p;
+    while (*p == '-' || *p == '+' || *p == ' ' || *p == '#' || *p == '0' || *p == '\'') {
+        p++;
+    }
+    if (*p == '*') {
+        spec->widthStar = true;
+        p++;
+    }
+    while (*p >= '0' && *p <= '9') {
+        p++;
+    }
+    if (*p == '.') {
+        p++;
+        if (*p == '*') {
+            spec->precisionStar = true;
+            p++;
+        }
+        while (*p >= '0' && *p <= '9') {
+            p++;
+        }
+    }
+    spec->modifiersLength = p - spec->modifiers;
+
+    const char *length = p;
+    while (*p == 'h' || *p == 'l' || *p == 'L' || *p == 'q' || *p == 'j' || *p == 'z' || *p == 't') {
+        p++;
+    }
+    spec->length = parseLength(length, p);
+
+    if (!isInteger(*p) && !isFloat(*p) && *p != 's' && *p != 'p' && *p != 'n' && *p != 'm' && *p != '%') {
+        return false;
+    }
+    spec->conversion = *p++;
+    spec->end = p;
+    return true;
+}
+
+int64_t readInteger(const FormatSpec &spec, va_list &args) {
+    bool sign = isSigned(spec.conversion);
+    switch (spec.length) {
+        case LONG:
+            return sign ? (int64_t)va_arg(args, long) : (int64_t)va_arg(args, unsigned long);
+        case LONG_LONG:
+            return sign ? (int64_t)va_arg(args, long long) : (int64_t)va_arg(args, unsigned long long);
+        case INTMAX:
+            return sign ? (int64_t)va_arg(args, intmax_t) : (int64_t)va_arg(args, uintmax_t);
+        case SIZE:
+            return sign ? (int64_t)va_arg(args, ssize_t) : (int64_t)va_arg(args, size_t);
+        case PTRDIFF:
+            return (int64_t)va_arg(args, ptrdiff_t);
+        default:
+            break;
+    }
+
+    // int, short and char are promoted to int
+    int value = va_arg(args, int);
+    if (spec.length == CHAR) {
+        return sign ? (int64_t)(signed char)value : (int64_t)(unsigned char)value;
+    } else if (spec.length == SHORT) {
+        return sign ? (int64_t)(short)value : (int64_t)(unsigned short)value;
+    }
+    return sign ? (int64_t)value : (int64_t)(unsigned int)value;
+}
+
+class ArgsWriter {
+  public:
+    ArgsWriter(uint8_t *buffer, size_t capacity) : buffer(buffer), capacity(capacity) {}
+
+    template <typename T>
+    bool put(const T &value) {
+        if (size + sizeof(T) > capacity) {
+            return false;
+        }
+        memcpy(buffer + size, &value, sizeof(T));
+        size += sizeof(T);
+        return true;
+    }
+
+    // String is truncated to remaining space
+    bool putString(const char *text) {
+        text = text ? text : "(null)";
+        if (size + sizeof(uint16_t) >= capacity) {
+            return false;
+        }
+        uint16_t length = (uint16_t)strnlen(text, std::min<size_t>(capacity - size - sizeof(uint16_t), UINT16_MAX));
+        put(length);
+        memcpy(buffer + size, text, length);
+        size += length;
+        return true;
+    }
+
+    size_t getSize() const {
+        return size;
+    }
+
+  private:
+    uint8_t *buffer;
+    size_t capacity;
+    size_t size = 0;
+};
+
+class ArgsReader {
+  public:
+    ArgsReader(const uint8_t *args, size_t size) : args(args), size(size) {}
+
+    template <typename T>
+    bool get(T *value) {
+        if (offset + sizeof(T) > size) {
+            return false;
+        }
+        memcpy(value, args + offset, sizeof(T));
+        offset += sizeof(T);
+        return true;
+    }
+
+    bool getString(std::string *text) {
+        uint16_t length;
+        if (!get(&length) || offset + length > size) {
+            return false;
+        }
+        text->assign((const char *)args + offset, length);
+        offset += length;
+        return true;
+    }
+
+  private:
+    const uint8_t *args;
+    size_t size;
+    size_t offset = 0;
+};
+
+template <typename T>
+void printValue(char *out, size_t outSize, const std::string &pattern, const int32_t *stars, int starCount, T value) {
+    if (starCount == 2) {
+        snprintf(out, outSize, pattern.c_str(), stars[0], stars[1], value);
+    } else if (starCount == 1) {
+        snprintf(out, outSize, pattern.c_str(), stars[0], value);
+    } else {
+        snprintf(out, outSize, pattern.c_str(), value);
+    }
+}
+
+} // namespace
+
+size_t traceEncodeArgs(uint8_t *buffer, size_t capacity, const char *format, va_list argptr) {
+    va_list args;
+    va_copy(args, argptr);
+    ArgsWriter writer(buffer, capacity);
+    int savedErrno = errno;
+
+    for (const char *p = strchr(format, '%'); p; p = strchr(p, '%')) {
+        FormatSpec spec;
+        if (!parseSpec(p, &spec)) {
+            break;
+        }
+        p = spec.end;
+
+        if ((spec.widthStar && !writer.put<int32_t>(va_arg(args, int))) ||
+            (spec.precisionStar && !writer.put<int32_t>(va_arg(args, int)))) {
+            break;
+        }
+
+        bool stored = true;
+        if (isInteger(spec.conversion)) {
+            stored = writer.put(readInteger(spec, args));
+        } else if (isFloat(spec.conversion)) {
+            stored = writer.put(spec.length == LONG_DOUBLE ? (double)va_arg(args, long double) : va_arg(args, double));
+        } else if (spec.conversion == 's') {
+            stored = writer.putString(va_arg(args, const char *));
+        } else if (spec.conversion == 'p') {
+            stored = writer.put(va_arg(args, void *));
+        } else if (spec.conversion == 'n') {
+            (void)va_arg(args, void *);
+        } else if (spec.conversion == 'm') {
+            stored = writer.put<int32_t>(savedErrno);
+        }
+        if (!stored) {
+            break;
+        }
+    }
+    va_end(args);
+    return writer.getSize();
+}
+
+std::string traceDecodeArgs(const char *format, const uint8_t *args, size_t size) {
+    char value[lineCapacity];
+    std::string text;
+    ArgsReader reader(args, size);
+
+    for (const char *p = format; *p && text.size() < lineCapacity;) {
+        FormatSpec spec;
+        if (*p != '%') {
+            const char *next = strchr(p, '%');
+            next = next ? next : p + strlen(p);
+            text.append(p, next - p);
+            p = next;
+            continue;
+        }
+        if (!parseSpec(p, &spec)) {
+            text.append(p);
+            break;
+        }
+        p = spec.end;
+
+        if (spec.conversion == '%') {
+            text += '%';
+            continue;
+        }
+        if (spec.conversion == 'n') {
+            continue;
+        }
+
+        int32_t stars[2];
+        int starCount = 0;
+        if ((spec.widthStar && !reader.get(&stars[starCount++])) ||
+            (spec.precisionStar && !reader.get(&stars[starCount++]))) {
+            text += "...";
+            break;
+        }
+
+        std::string pattern = "%" + std::string(spec.modifiers, spec.modifiersLength);
+        bool loaded = true;
+        if (isInteger(spec.conversion)) {
+            int64_t number;
+            if ((loaded = reader.get(&number)) && spec.conversion == 'c') {
+                printValue(value, sizeof(value), pattern + 'c', stars, starCount, (int)number);
+            } else if (loaded) {
+                printValue(value, sizeof(value), pattern + "ll" + spec.conversion, stars, starCount, (long long)number);
+            }
+        } else if (isFloat(spec.conversion)) {
+            double number;
+            if ((loaded = reader.get(&number))) {
+                printValue(value, sizeof(value), pattern + spec.conversion, stars, starCount, number);
+            }
+        } else if (spec.conversion == 'p') {
+            void *pointer;
+            if ((loaded = reader.get(&pointer))) {
+                printValue(value, sizeof(value), pattern + 'p', stars, starCount, pointer);
+            }
+        } else {
+            // 's' and 'm' are both printed as string
+            std::string string;
+            if (spec.conversion == 'm') {
+                int32_t errnum;
+                char errorText[128];
+                loaded = reader.get(&errnum);
+                string = loaded ? strerror_r(errnum, errorText, sizeof(errorText)) : "";
+            } else {
+                loaded = reader.getString(&string);
+            }
+            if (loaded) {
+                printValue(value, sizeof(value), pattern + 's', stars, starCount, string.c_str());
+            }
+        }
+
+        if (!loaded) {
+            text += "...";
+            break;
+        }
+        text += value;
+    }
+
+    if (text.size() > lineCapacity) {
+        text.resize(lineCapacity);
+    }
+    return text;
+}
+
+std::string tracePrefix(int tid, const char *fileName, int lineNum) {
+    char prefix[256];
+    const char *file = strrchr(fileName, '/');
+    file = file ? file + 1 : fileName;
+    snprintf(prefix, sizeof(prefix), "[tid=%d](%s:%d): ", tid, file, lineNum);
+    return prefix;
+}
+
+std::string traceTimeAndSeverity(uint64_t timestampNs, int severity) {
+    static const char *names[] = {"ERROR", "ERROR", "WARNING", "INFO", "DEBUG"};
+    severity = std::clamp(severity, SEVERITY_ERROR, SEVERITY_DEBUG);
+
+    time_t seconds = timestampNs / 1000000000ULL;
+    struct tm local;
+    localtime_r(&seconds, &local);
+    char timeText[32];
+    strftime(timeText, sizeof(timeText), "%Y-%m-%d %H:%M:%S", &local);
+
+    char text[64];
+    snprintf(text, sizeof(text), "%s.%06u %s", timeText, (unsigned)(timestampNs % 1000000000ULL / 1000),
+             names[severity]);
+    return text;
+}
+
+uint64_t traceRealtimeNs() {
+    struct timespec now;
+    clock_gettime(CLOCK_REALTIME, &now);
+    return (uint64_t)now.tv_sec * 1000000000ULL + now.tv_nsec;
+}
+
+int traceThreadId() {
+    static thread_local int tid = syscall(SYS_gettid);
+    return tid;
+}
+
+//LCOV_EXCL_STOP
@@ -0,0 +1,20 @@
+#pragma once
+
+#include <cstdarg>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+// Deferred printf formatting: caller copies arguments of format as raw bytes (strings by value, integers widened
+// to 64 bits, %m as errno), text is rendered later by background thread or offline decoder.
+// Encoding stops at argument which does not fit, decoding renders "..." in its place.
+size_t traceEncodeArgs(uint8_t *buffer, size_t capacity, const char *format, va_list argptr);
+std::string traceDecodeArgs(const char *format, const uint8_t *args, size_t size);
+
+// "[tid=..](file:line): " prefix as written by synchronous trace
+std::string tracePrefix(int tid, const char *fileName, int lineNum);
+// "YYYY-mm-dd HH:MM:SS.uuuuuu SEVERITY" prefix of file output
+std::string traceTimeAndSeverity(uint64_t timestampNs, int severity);
+uint64_t traceRealtimeNs();
+// Kernel thread id, cached per thread
+int traceThreadId();
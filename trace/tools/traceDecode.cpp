@@ -0,0 +1,17 @@
+#include <cstdio>
+#include "trace.h"
+
+// Renders binary trace file written by trace_start_binary() as text
+int main(int argc, char *argv[]) {
+    if (argc != 2) {
+        fprintf(stderr, "Usage: %s <binary trace file>\n", argv[0]);
+        return 2;
+    }
+
+    long records = trace_decode_binary(argv[1], stdout);
+    if (records < 0) {
+        fprintf(stderr, "%s: %s\n", argv[1], records == -1 ? "cannot open file" : "not a binary trace file");
+        return 1;
+    }
+    return 0;
+}